@@ -76,6 +76,7 @@
 #include "DREAM3DWidgetsLib/FilterWidgetManager.h"
 
 #include "DREAM3DWidgetsLib/FilterParameterWidgets/FilterParameterWidgetsDialogs.h"
+#include "DREAM3DWidgetsLib/FilterParameterWidgets/FilterParameterWidget.h"
 
 // Include the MOC generated CPP file which has all the QMetaObject methods/data
 #include "moc_PipelineViewWidget.cpp"
@@ -105,6 +106,12 @@ PipelineViewWidget::PipelineViewWidget(QWidget* parent) :
   m_LastDragPoint = QPoint(-1, -1);
   m_autoScrollTimer.setParent(this);
 
+  // Collapse bursts of preflight requests (typing into a field, dragging a filter) into a single preflight
+  m_PreflightTimer.setParent(this);
+  m_PreflightTimer.setSingleShot(true);
+  m_PreflightTimer.setInterval(250);
+  connect(&m_PreflightTimer, SIGNAL(timeout()), this, SLOT(doPreflightPipeline()));
+
   setContextMenuPolicy(Qt::CustomContextMenu);
   setFocusPolicy(Qt::StrongFocus);
 
@@ -130,6 +137,8 @@ void PipelineViewWidget::setPipelineMessageObserver(QObject* pipelineMessageObse
           m_PipelineMessageObserver, SLOT(clearIssues()) );
   connect(this, SIGNAL(preflightPipelineComplete()),
           m_PipelineMessageObserver, SLOT(displayCachedMessages()));
+  connect(this, SIGNAL(preflightHasMessage(PipelineMessage)),
+          m_PipelineMessageObserver, SLOT(processPipelineMessage(const PipelineMessage&)));
 }
 
 // -----------------------------------------------------------------------------
@@ -618,13 +627,46 @@ bool PipelineViewWidget::eventFilter(QObject* o, QEvent* e)
 //
 // -----------------------------------------------------------------------------
 void PipelineViewWidget::preflightPipeline()
+{
+  m_PreflightTimer.start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineViewWidget::doPreflightPipeline()
 {
   emit pipelineIssuesCleared();
   // Create a Pipeline Object and fill it with the filters from this View
   FilterPipeline::Pointer pipeline = getFilterPipeline();
+  pipeline->addMessageReceiver(this);
 
   FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
-  for(int i = 0; i < filters.size(); i++)
+
+  // Find the first filter that was edited, inserted, removed or moved since the last preflight. The filters in
+  // front of it still hold the structure they produced last time, so the preflight can pick up from there.
+  int startIndex = 0;
+  while (startIndex < filters.size() && startIndex < m_PreflightedFilters.size()
+         && filters.at(startIndex) == m_PreflightedFilters.at(startIndex)
+         && m_ModifiedFilters.contains(filters.at(startIndex).get()) == false)
+  {
+    startIndex++;
+  }
+
+  // Report the messages of the filters that are not preflighted again and forget everything else
+  QMap<AbstractFilter*, QVector<PipelineMessage> > cachedMessages;
+  for(int i = 0; i < startIndex; i++)
+  {
+    QVector<PipelineMessage> messages = m_PreflightMessages.value(filters.at(i).get());
+    for(int m = 0; m < messages.size(); m++)
+    {
+      emit preflightHasMessage(messages.at(m));
+    }
+    cachedMessages.insert(filters.at(i).get(), messages);
+  }
+  m_PreflightMessages = cachedMessages;
+
+  for(int i = startIndex; i < filters.size(); i++)
   {
     PipelineFilterWidget* fw = filterWidgetAt(i);
     if (fw)
@@ -639,13 +681,16 @@ void PipelineViewWidget::preflightPipeline()
   progress.setWindowModality(Qt::WindowModal);
 
   // Preflight the pipeline
-  int err = pipeline->preflightPipeline();
+  int err = pipeline->preflightPipeline(startIndex);
   if (err < 0)
   {
     //FIXME: Implement this
   }
   progress.setValue(1);
 
+  m_PreflightedFilters = filters;
+  m_ModifiedFilters.clear();
+
   int count = pipeline->getFilterContainer().size();
   //Now that the preflight has been executed loop through the filters and check their error condition and set the
   // outline on the filter widget if there were errors or warnings
@@ -661,6 +706,18 @@ void PipelineViewWidget::preflightPipeline()
   emit preflightPipelineComplete();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineViewWidget::processPipelineMessage(const PipelineMessage& msg)
+{
+  AbstractFilter* filter = qobject_cast<AbstractFilter*>(sender());
+  if (NULL != filter)
+  {
+    m_PreflightMessages[filter].push_back(msg);
+  }
+}
+
 
 // -----------------------------------------------------------------------------
 //
@@ -1293,6 +1350,32 @@ QStatusBar* PipelineViewWidget::getStatusBar()
 // -----------------------------------------------------------------------------
 void PipelineViewWidget::handleFilterParameterChanged()
 {
+  // Remember which filter was edited so the next preflight starts with it. The preflight is deferred, so push
+  // the values from the widgets into the filter now while the widget that changed is still flagged as the
+  // one that caused the preflight.
+  AbstractFilter* filter = NULL;
+  PipelineFilterWidget* fw = qobject_cast<PipelineFilterWidget*>(sender());
+  FilterParameterWidget* pw = qobject_cast<FilterParameterWidget*>(sender());
+  if (fw)
+  {
+    filter = fw->getFilter().get();
+  }
+  else if (pw)
+  {
+    filter = pw->getFilter();
+  }
+
+  if (NULL != filter)
+  {
+    m_ModifiedFilters.insert(filter);
+    emit filter->updateFilterParameters(filter);
+  }
+  else
+  {
+    // We can not tell which filter changed so preflight everything
+    m_PreflightedFilters.clear();
+  }
+
   emit filterInputWidgetEdited();
 }
 
@@ -40,6 +40,9 @@
 #include <vector>
 
 #include <QtCore/QTimer>
+#include <QtCore/QSet>
+#include <QtCore/QMap>
+#include <QtCore/QVector>
 #include <QtWidgets/QFrame>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QVBoxLayout>
@@ -232,7 +235,8 @@ class DREAM3DWidgetsLib_EXPORT PipelineViewWidget : public QFrame
     void setStatusBar(QStatusBar* statusBar);
 
     /**
-     * @brief preflightPipeline
+     * @brief preflightPipeline Schedules a preflight of the pipeline. Requests that arrive in quick succession
+     * are collapsed into a single preflight that only starts at the first filter that changed since the last one.
      */
     void preflightPipeline();
 
@@ -315,6 +319,18 @@ class DREAM3DWidgetsLib_EXPORT PipelineViewWidget : public QFrame
   protected slots:
     void handleFilterParameterChanged();
 
+    /**
+     * @brief doPreflightPipeline This does the actual preflight of the pipeline once the preflight timer fires
+     */
+    void doPreflightPipeline();
+
+    /**
+     * @brief processPipelineMessage Keeps the messages each filter generates during a preflight so they can be
+     * reported again when that filter is not preflighted the next time around
+     * @param msg
+     */
+    void processPipelineMessage(const PipelineMessage& msg);
+
   private:
     PipelineFilterWidget*     m_SelectedFilterWidget;
     QVBoxLayout*              m_FilterWidgetLayout;
@@ -335,6 +351,10 @@ class DREAM3DWidgetsLib_EXPORT PipelineViewWidget : public QFrame
     QMenu                     m_Menu;
     QStatusBar*               m_StatusBar;
     QList<QAction*>           m_MenuActions;
+    QTimer                    m_PreflightTimer;
+    FilterPipeline::FilterContainerType                    m_PreflightedFilters;
+    QSet<AbstractFilter*>                                  m_ModifiedFilters;
+    QMap<AbstractFilter*, QVector<PipelineMessage> >       m_PreflightMessages;
 
     PipelineViewWidget(const PipelineViewWidget&); // Copy Constructor Not Implemented
     void operator=(const PipelineViewWidget&); // Operator '=' Not Implemented
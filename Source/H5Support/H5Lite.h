@@ -1107,6 +1107,104 @@ namespace H5Support_NAMESPACE
         return retErr;
       }
 
+      /**
+       * @brief Reads a hyperslab (a rectangular block) of a dataset from the HDF5 File into a preallocated
+       * array. The block is stored contiguously in the array in the same order as it is in the dataset.
+       * @param loc_id The parent location that contains the dataset to read
+       * @param dsetName The name of the dataset to read
+       * @param start The first index of the block along each dimension of the dataset (slowest to fastest)
+       * @param count The number of elements of the block along each dimension of the dataset (slowest to fastest)
+       * @param data A Pointer to the PreAllocated Array of Data. It must hold the product of count elements.
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t readPointerDatasetHyperslab(hid_t loc_id,
+                                                const std::string& dsetName,
+                                                const std::vector<hsize_t>& start,
+                                                const std::vector<hsize_t>& count,
+                                                T* data)
+      {
+        hid_t did;
+        hid_t spaceId;
+        hid_t memSpaceId;
+        herr_t err = 0;
+        herr_t retErr = 0;
+        hid_t dataType = 0;
+        T test = 0x00;
+        dataType = H5Lite::HDFTypeForPrimitive(test);
+        if (dataType == -1)
+        {
+          std::cout  << "dataType was not supported." << std::endl;
+          return -10;
+        }
+        if (loc_id < 0)
+        {
+          std::cout  << "loc_id was Negative: This is not allowed." << std::endl;
+          return -2;
+        }
+        if (NULL == data)
+        {
+          std::cout  << "The Pointer to hold the data is NULL. This is NOT allowed." << std::endl;
+          return -3;
+        }
+        if (start.size() != count.size() || start.empty())
+        {
+          std::cout  << "The start and count of the hyperslab must have the same non zero rank." << std::endl;
+          return -4;
+        }
+        did = H5Dopen( loc_id, dsetName.c_str(), H5P_DEFAULT );
+        if ( did < 0 )
+        {
+          std::cout  << " Error opening Dataset: " << did << std::endl;
+          return -1;
+        }
+        spaceId = H5Dget_space(did);
+        if (spaceId < 0)
+        {
+          std::cout  << "Error Getting the Dataspace of the Dataset." << std::endl;
+          H5Dclose(did);
+          return -1;
+        }
+        if (H5Sget_simple_extent_ndims(spaceId) != static_cast<int>(start.size()))
+        {
+          std::cout  << "The rank of the hyperslab does not match the rank of the Dataset." << std::endl;
+          H5Sclose(spaceId);
+          H5Dclose(did);
+          return -4;
+        }
+        err = H5Sselect_hyperslab(spaceId, H5S_SELECT_SET, &(start.front()), NULL, &(count.front()), NULL);
+        if (err < 0)
+        {
+          std::cout  << "Error Selecting the Hyperslab." << std::endl;
+          H5Sclose(spaceId);
+          H5Dclose(did);
+          return err;
+        }
+        memSpaceId = H5Screate_simple(static_cast<int>(count.size()), &(count.front()), NULL);
+        if (memSpaceId < 0)
+        {
+          std::cout  << "Error Creating the Memory Dataspace." << std::endl;
+          H5Sclose(spaceId);
+          H5Dclose(did);
+          return -1;
+        }
+        err = H5Dread(did, dataType, memSpaceId, spaceId, H5P_DEFAULT, data );
+        if (err < 0)
+        {
+          std::cout  << "Error Reading Data." << std::endl;
+          retErr = err;
+        }
+        H5Sclose(memSpaceId);
+        H5Sclose(spaceId);
+        err = H5Dclose( did );
+        if (err < 0 )
+        {
+          std::cout  << "Error Closing Dataset id" << std::endl;
+          retErr = err;
+        }
+        return retErr;
+      }
+
 
       /**
        * @brief Reads data from the HDF5 File into an std::vector<T> object. If the dataset
@@ -448,6 +448,26 @@ namespace H5Support_NAMESPACE
         return H5Lite::readPointerDataset(loc_id, dsetName.toStdString(), data);
       }
 
+      /**
+       * @brief Reads a hyperslab (a rectangular block) of a dataset from the HDF5 File into a preallocated
+       * array. The block is stored contiguously in the array in the same order as it is in the dataset.
+       * @param loc_id The parent location that contains the dataset to read
+       * @param dsetName The name of the dataset to read
+       * @param start The first index of the block along each dimension of the dataset (slowest to fastest)
+       * @param count The number of elements of the block along each dimension of the dataset (slowest to fastest)
+       * @param data A Pointer to the PreAllocated Array of Data. It must hold the product of count elements.
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t readPointerDatasetHyperslab(hid_t loc_id,
+                                                const QString& dsetName,
+                                                const QVector<hsize_t>& start,
+                                                const QVector<hsize_t>& count,
+                                                T* data)
+      {
+        return H5Lite::readPointerDatasetHyperslab(loc_id, dsetName.toStdString(), start.toStdVector(), count.toStdVector(), data);
+      }
+
 
 
       /**
@@ -993,6 +993,43 @@ herr_t testReadPointer2DArrayDataset(hid_t file_id)
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+herr_t testReadPointer2DArrayDatasetHyperslab(hid_t file_id)
+{
+  T value = 0x0;
+  herr_t err = 1;
+  QString dsetName = QH5Lite::HDFTypeForPrimitiveAsStr(value);
+  qDebug() << "Running testReadPointer2DArrayDatasetHyperslab<" << dsetName << "> ... ";
+  dsetName = "Pointer2DArrayDataset<" + dsetName + ">";
+
+  // Read rows 1 and 2 and columns 1 and 2 of the DIM0 x DIM1 dataset written by testWritePointer2DArrayDataset
+  QVector<hsize_t> start(2, 1);
+  QVector<hsize_t> count(2, 2);
+  QVector<T> data(4, 0);
+  err = QH5Lite::readPointerDatasetHyperslab(file_id, dsetName, start, count, data.data() );
+  DREAM3D_REQUIRE(err >= 0);
+  for (hsize_t r = 0; r < count[0]; ++r)
+  {
+    for (hsize_t c = 0; c < count[1]; ++c)
+    {
+      hsize_t index = (r + start[0]) * DIM1 + (c + start[1]);
+      DREAM3D_REQUIRE(data[r * count[1] + c] == static_cast<T>(index * 5));
+    }
+  }
+
+  // The rank of the block must match the rank of the dataset
+  start.resize(1);
+  count.resize(1);
+  err = QH5Lite::readPointerDatasetHyperslab(file_id, dsetName, start, count, data.data() );
+  DREAM3D_REQUIRE(err < 0);
+
+  qDebug() << " Passed" << "\n";
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1171,6 +1208,13 @@ void QH5LiteTest()
   DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<float32>(file_id) >= 0);
   DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<float64>(file_id) >= 0);
 
+  DREAM3D_REQUIRE ( testReadPointer2DArrayDatasetHyperslab<int8_t>(file_id) >= 0);
+  DREAM3D_REQUIRE ( testReadPointer2DArrayDatasetHyperslab<uint16_t>(file_id) >= 0);
+  DREAM3D_REQUIRE ( testReadPointer2DArrayDatasetHyperslab<int32_t>(file_id) >= 0);
+  DREAM3D_REQUIRE ( testReadPointer2DArrayDatasetHyperslab<uint64_t>(file_id) >= 0);
+  DREAM3D_REQUIRE ( testReadPointer2DArrayDatasetHyperslab<float32>(file_id) >= 0);
+  DREAM3D_REQUIRE ( testReadPointer2DArrayDatasetHyperslab<float64>(file_id) >= 0);
+
 
   DREAM3D_REQUIRE ( testReadVectorDataset<int8_t>(file_id) >= 0);
   DREAM3D_REQUIRE ( testReadVectorDataset<uint8_t>(file_id) >= 0);
@@ -46,10 +46,146 @@
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
+#define OC_DECLARE_TUPLE_CONVERSION(CONVERSION_METHOD)\
+  static void CONVERSION_METHOD(const OrientationArray<T>& in, OrientationArray<T>& out)\
+  { OrientationTransforms<OrientationArray<T>, T>::CONVERSION_METHOD(in, out); }
+
+/**
+ * @brief The OrientationTupleConversions class wraps each of the OrientationTransforms
+ * functions into a plain function with a common signature so that a conversion can be
+ * handed to the batch conversion functions of OrientationConverter as a function pointer.
+ */
+template<typename T>
+class OrientationTupleConversions
+{
+  public:
+    typedef void (*ConversionFunction)(const OrientationArray<T>&, OrientationArray<T>&);
+
+    OC_DECLARE_TUPLE_CONVERSION(eu2om)
+    OC_DECLARE_TUPLE_CONVERSION(eu2qu)
+    OC_DECLARE_TUPLE_CONVERSION(eu2ax)
+    OC_DECLARE_TUPLE_CONVERSION(eu2ro)
+    OC_DECLARE_TUPLE_CONVERSION(eu2ho)
+    OC_DECLARE_TUPLE_CONVERSION(eu2cu)
+
+    OC_DECLARE_TUPLE_CONVERSION(om2eu)
+    OC_DECLARE_TUPLE_CONVERSION(om2qu)
+    OC_DECLARE_TUPLE_CONVERSION(om2ax)
+    OC_DECLARE_TUPLE_CONVERSION(om2ro)
+    OC_DECLARE_TUPLE_CONVERSION(om2ho)
+    OC_DECLARE_TUPLE_CONVERSION(om2cu)
+
+    OC_DECLARE_TUPLE_CONVERSION(qu2eu)
+    OC_DECLARE_TUPLE_CONVERSION(qu2om)
+    OC_DECLARE_TUPLE_CONVERSION(qu2ax)
+    OC_DECLARE_TUPLE_CONVERSION(qu2ro)
+    OC_DECLARE_TUPLE_CONVERSION(qu2ho)
+    OC_DECLARE_TUPLE_CONVERSION(qu2cu)
+
+    OC_DECLARE_TUPLE_CONVERSION(ax2eu)
+    OC_DECLARE_TUPLE_CONVERSION(ax2om)
+    OC_DECLARE_TUPLE_CONVERSION(ax2qu)
+    OC_DECLARE_TUPLE_CONVERSION(ax2ro)
+    OC_DECLARE_TUPLE_CONVERSION(ax2ho)
+    OC_DECLARE_TUPLE_CONVERSION(ax2cu)
+
+    OC_DECLARE_TUPLE_CONVERSION(ro2eu)
+    OC_DECLARE_TUPLE_CONVERSION(ro2om)
+    OC_DECLARE_TUPLE_CONVERSION(ro2qu)
+    OC_DECLARE_TUPLE_CONVERSION(ro2ax)
+    OC_DECLARE_TUPLE_CONVERSION(ro2ho)
+    OC_DECLARE_TUPLE_CONVERSION(ro2cu)
+
+    OC_DECLARE_TUPLE_CONVERSION(ho2eu)
+    OC_DECLARE_TUPLE_CONVERSION(ho2om)
+    OC_DECLARE_TUPLE_CONVERSION(ho2qu)
+    OC_DECLARE_TUPLE_CONVERSION(ho2ax)
+    OC_DECLARE_TUPLE_CONVERSION(ho2ro)
+    OC_DECLARE_TUPLE_CONVERSION(ho2cu)
+
+    OC_DECLARE_TUPLE_CONVERSION(cu2eu)
+    OC_DECLARE_TUPLE_CONVERSION(cu2om)
+    OC_DECLARE_TUPLE_CONVERSION(cu2qu)
+    OC_DECLARE_TUPLE_CONVERSION(cu2ax)
+    OC_DECLARE_TUPLE_CONVERSION(cu2ro)
+    OC_DECLARE_TUPLE_CONVERSION(cu2ho)
+};
+
+/**
+ * @brief The OrientationConversionImpl class converts a range of orientations from one
+ * representation to another. The components of each orientation are addressed through a
+ * pointer per component and a tuple stride so that both interleaved (Array of Structures)
+ * and separate component (Structure of Arrays) buffers can be converted by the same code.
+ * Each orientation is gathered into a small local buffer before it is converted which
+ * also allows the input and output buffers to be the same memory.
+ */
+template<typename T>
+class OrientationConversionImpl
+{
+  public:
+    typedef typename OrientationTupleConversions<T>::ConversionFunction ConversionFunction;
+
+    OrientationConversionImpl(T* const* inComps, int inNumComps, size_t inTupleStride,
+                              T* const* outComps, int outNumComps, size_t outTupleStride,
+                              ConversionFunction convert) :
+      m_InNumComps(inNumComps),
+      m_InTupleStride(inTupleStride),
+      m_OutNumComps(outNumComps),
+      m_OutTupleStride(outTupleStride),
+      m_Convert(convert)
+    {
+      for (int c = 0; c < m_InNumComps; c++) { m_InComps[c] = inComps[c]; }
+      for (int c = 0; c < m_OutNumComps; c++) { m_OutComps[c] = outComps[c]; }
+    }
+    virtual ~OrientationConversionImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      T inTuple[k_MaxComponents];
+      T outTuple[k_MaxComponents];
+      OrientationArray<T> in(inTuple, m_InNumComps);
+      OrientationArray<T> out(outTuple, m_OutNumComps);
+      for (size_t i = start; i < end; i++)
+      {
+        const size_t inOffset = i * m_InTupleStride;
+        for (int c = 0; c < m_InNumComps; c++) { inTuple[c] = m_InComps[c][inOffset]; }
+        for (int c = 0; c < m_OutNumComps; c++) { outTuple[c] = static_cast<T>(0); }
+        m_Convert(in, out);
+        const size_t outOffset = i * m_OutTupleStride;
+        for (int c = 0; c < m_OutNumComps; c++) { m_OutComps[c][outOffset] = outTuple[c]; }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+    static const int k_MaxComponents = 9;
+
+  private:
+    T* m_InComps[k_MaxComponents];
+    int m_InNumComps;
+    size_t m_InTupleStride;
+    T* m_OutComps[k_MaxComponents];
+    int m_OutNumComps;
+    size_t m_OutTupleStride;
+    ConversionFunction m_Convert;
+};
+
 template<typename T>
 class OrientationConverter
 {
@@ -97,6 +233,69 @@ class OrientationConverter
       else if(repType == Cubochoric) { toCubochoric(); }
     }
 
+    /**
+    * @brief convertRepresentationTo Converts the input orientations and stores the
+    * result in an already allocated array instead of creating a new one. The destination
+    * may be the input array itself if both representations have the same number of
+    * components, in which case the conversion is done in place. If the destination does
+    * not have the correct number of tuples or components a new array is created instead.
+    * @param repType The representation to convert to
+    * @param destination The array to store the converted orientations into
+    */
+    void convertRepresentationTo(OrientationType repType, typename DataArray<T>::Pointer destination)
+    {
+      m_Destination = destination;
+      convertRepresentationTo(repType);
+      m_Destination = typename DataArray<T>::Pointer();
+    }
+
+    /**
+    * @brief convertRepresentationInPlace Converts the input orientations overwriting
+    * the input array. This is only possible if both representations have the same
+    * number of components, otherwise a new output array is created.
+    * @param repType The representation to convert to
+    */
+    void convertRepresentationInPlace(OrientationType repType)
+    {
+      convertRepresentationTo(repType, getInputData());
+    }
+
+    /**
+     * @brief ConvertTuples Converts orientations that are stored interleaved in contiguous
+     * memory (Array of Structures). The conversion is run in parallel over blocks of
+     * orientations. The input and output may point to the same memory if the strides are equal.
+     * @param input Pointer to the input orientations
+     * @param inStride Number of components of the input representation
+     * @param output Pointer to the output orientations
+     * @param outStride Number of components of the output representation
+     * @param nTuples Number of orientations to convert
+     * @param convert The conversion function, i.e., &OrientationTupleConversions<T>::eu2qu
+     */
+    static void ConvertTuples(T* input, int inStride, T* output, int outStride, size_t nTuples,
+                              typename OrientationTupleConversions<T>::ConversionFunction convert)
+    {
+      T* inComps[OrientationConversionImpl<T>::k_MaxComponents];
+      T* outComps[OrientationConversionImpl<T>::k_MaxComponents];
+      for (int c = 0; c < inStride; c++) { inComps[c] = input + c; }
+      for (int c = 0; c < outStride; c++) { outComps[c] = output + c; }
+      ConvertTuples(inComps, inStride, inStride, outComps, outStride, outStride, nTuples, convert);
+    }
+
+    /**
+     * @brief ConvertTuples Converts orientations whose components are each stored in a
+     * separate contiguous array (Structure of Arrays). The conversion is run in parallel
+     * over blocks of orientations. The input and output arrays may be the same.
+     * @param input One pointer per component of the input representation
+     * @param output One pointer per component of the output representation
+     * @param nTuples Number of orientations to convert
+     * @param convert The conversion function, i.e., &OrientationTupleConversions<T>::eu2qu
+     */
+    static void ConvertTuples(const QVector<T*>& input, const QVector<T*>& output, size_t nTuples,
+                              typename OrientationTupleConversions<T>::ConversionFunction convert)
+    {
+      ConvertTuples(input.data(), input.size(), 1, output.data(), output.size(), 1, nTuples, convert);
+    }
+
     /**
      * @brief toEulers Converts the input orientations to Euler Angles
      */
@@ -233,31 +432,92 @@ class OrientationConverter
   protected:
     OrientationConverter() {}
 
+    /**
+     * @brief convertTuples Converts the input data with the given conversion function
+     * and stores the results as the output data.
+     * @param outStride Number of components of the output representation
+     * @param outputName Name of the output array if one needs to be created
+     * @param convert The conversion function
+     */
+    void convertTuples(int outStride, const QString& outputName,
+                       typename OrientationTupleConversions<T>::ConversionFunction convert)
+    {
+      typename DataArray<T>::Pointer input = this->getInputData();
+      typename DataArray<T>::Pointer output = prepareOutputData(outStride, outputName);
+      ConvertTuples(input->getPointer(0), input->getNumberOfComponents(), output->getPointer(0), outStride,
+                    input->getNumberOfTuples(), convert);
+      this->setOutputData(output);
+    }
+
+    /**
+     * @brief copyTuples Copies the input data to the output data. This is used when the
+     * input and output representations are the same.
+     */
+    void copyTuples()
+    {
+      typename DataArray<T>::Pointer input = this->getInputData();
+      typename DataArray<T>::Pointer output = m_Destination;
+      if(NULL == output.get() || output->getNumberOfTuples() != input->getNumberOfTuples()
+          || output->getNumberOfComponents() != input->getNumberOfComponents())
+      {
+        output = boost::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
+      }
+      else if(output != input)
+      {
+        input->copyIntoArray(output);
+      }
+      this->setOutputData(output);
+    }
+
+    /**
+     * @brief prepareOutputData Returns the destination array if one was given and has the
+     * correct size or creates a new array for the output otherwise.
+     * @param outStride Number of components of the output representation
+     * @param outputName Name of the created array
+     * @return
+     */
+    typename DataArray<T>::Pointer prepareOutputData(int outStride, const QString& outputName)
+    {
+      typename DataArray<T>::Pointer input = this->getInputData();
+      size_t nTuples = input->getNumberOfTuples();
+      typename DataArray<T>::Pointer output = m_Destination;
+      if(NULL != output.get() && output->getNumberOfTuples() == nTuples && output->getNumberOfComponents() == outStride)
+      {
+        // The destination can only be the input array if the strides match
+        if(output != input || input->getNumberOfComponents() == outStride)
+        {
+          return output;
+        }
+      }
+      QVector<size_t> cDims(1, outStride); /* Create the n component (nx1) based array.*/
+      output = DataArray<T>::CreateArray(nTuples, cDims, outputName);
+      output->initializeWithZeros(); /* Intialize the array with Zeros */
+      return output;
+    }
+
+    static void ConvertTuples(T* const* inComps, int inNumComps, size_t inTupleStride,
+                              T* const* outComps, int outNumComps, size_t outTupleStride, size_t nTuples,
+                              typename OrientationTupleConversions<T>::ConversionFunction convert)
+    {
+      OrientationConversionImpl<T> impl(inComps, inNumComps, inTupleStride, outComps, outNumComps, outTupleStride, convert);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), impl, tbb::auto_partitioner());
+#else
+      impl.convert(0, nTuples);
+#endif
+    }
+
   private:
+    typename DataArray<T>::Pointer m_Destination;
+
     OrientationConverter(const OrientationConverter&); // Copy Constructor Not Implemented
     void operator=( const OrientationConverter& ); // Operator '=' Not Implemented
 
 };
 
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD)\
-  typedef OrientationArray<T> OrientationArray_t;\
-  typename DataArray<T>::Pointer input = this->getInputData();\
-  T* inPtr = input->getPointer(0);\
-  size_t nTuples = input->getNumberOfTuples();\
-  int inStride = input->getNumberOfComponents();\
-  int outStride = OUTSTRIDE;\
-  QVector<size_t> cDims(1, outStride); /* Create the n component (nx1) based array.*/ \
-  typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
-  output->initializeWithZeros(); /* Intialize the array with Zeros */ \
-  T* OUT_ARRAY_NAME##Ptr = output->getPointer(0);\
-  for (size_t i = 0; i < nTuples; ++i) { \
-    OrientationArray_t rot(inPtr, inStride); \
-    OrientationArray_t res(OUT_ARRAY_NAME##Ptr, outStride); \
-    OrientationTransforms<OrientationArray_t, T>::CONVERSION_METHOD(rot, res); \
-    inPtr = inPtr + inStride; /* Increment input pointer */ \
-    OUT_ARRAY_NAME##Ptr = OUT_ARRAY_NAME##Ptr + outStride; /* Increment output pointer*/ \
-  }\
-  this->setOutputData(output);
+  this->convertTuples(OUTSTRIDE, #OUT_ARRAY_NAME, &OrientationTupleConversions<T>::CONVERSION_METHOD);
 
 
 
@@ -281,10 +541,7 @@ class EulerConverter : public OrientationConverter<T>
 
     virtual void toEulers()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = boost::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyTuples();
     }
 
     virtual void toOrientationMatrix()
@@ -403,10 +660,7 @@ class OrientationMatrixConverter : public OrientationConverter<T>
 
     virtual void toOrientationMatrix()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = boost::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyTuples();
     }
 
     virtual void toQuaternion()
@@ -530,10 +784,7 @@ class QuaternionConverter : public OrientationConverter<T>
 
     virtual void toQuaternion()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = boost::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyTuples();
     }
 
     virtual void toAxisAngle()
@@ -635,10 +886,7 @@ class AxisAngleConverter : public OrientationConverter<T>
 
     virtual void toAxisAngle()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = boost::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyTuples();
     }
 
     virtual void toRodrigues()
@@ -735,10 +983,7 @@ class RodriguesConverter : public OrientationConverter<T>
 
     virtual void toRodrigues()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = boost::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyTuples();
     }
 
     virtual void toHomochoric()
@@ -835,10 +1080,7 @@ class HomochoricConverter : public OrientationConverter<T>
 
     virtual void toHomochoric()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = boost::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyTuples();
     }
 
     virtual void toCubochoric()
@@ -936,10 +1178,7 @@ class CubochoricConverter : public OrientationConverter<T>
 
     virtual void toCubochoric()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = boost::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyTuples();
     }
 
     virtual void sanityCheckInputData()
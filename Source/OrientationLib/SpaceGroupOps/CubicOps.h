@@ -70,6 +70,7 @@ class OrientationLib_EXPORT CubicOps : public SpaceGroupOps
 
     virtual bool getHasInversion() { return true; }
     virtual int getODFSize() { return k_OdfSize; }
+    virtual void getOdfNumBins(int bins[3]) { bins[0] = 18; bins[1] = 18; bins[2] = 18; }
     virtual int getMDFSize() { return k_MdfSize; }
     virtual int getNumSymOps() { return k_NumSymQuats; }
     QString getSymmetryName() { return "Cubic-High m3m"; }
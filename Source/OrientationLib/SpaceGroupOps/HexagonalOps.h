@@ -70,6 +70,7 @@ class OrientationLib_EXPORT HexagonalOps : public SpaceGroupOps
 
     virtual bool getHasInversion() { return true; }
     virtual int getODFSize() { return k_OdfSize; }
+    virtual void getOdfNumBins(int bins[3]) { bins[0] = 36; bins[1] = 36; bins[2] = 12; }
     virtual int getMDFSize() { return k_MdfSize; }
     virtual int getNumSymOps() { return k_NumSymQuats; }
     QString getSymmetryName() { return "Hexagonal-High 6/mmm"; }
@@ -70,6 +70,7 @@ class OrientationLib_EXPORT MonoclinicOps : public SpaceGroupOps
 
     virtual bool getHasInversion() { return true; }
     virtual int getODFSize() { return k_OdfSize; }
+    virtual void getOdfNumBins(int bins[3]) { bins[0] = 72; bins[1] = 36; bins[2] = 72; }
     virtual int getMDFSize() { return k_MdfSize; }
     virtual int getNumSymOps() { return k_NumSymQuats; }
     QString getSymmetryName() { return "Monoclinic 2/m"; }
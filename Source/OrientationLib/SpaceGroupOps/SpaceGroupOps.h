@@ -87,6 +87,13 @@ class OrientationLib_EXPORT SpaceGroupOps
      */
     virtual int getODFSize() = 0;
 
+    /**
+     * @brief getOdfNumBins Returns the number of ODF bins along each of the 3 homochoric
+     * dimensions. The product of the 3 values is equal to getODFSize()
+     * @param bins (OUT) The number of bins along each dimension
+     */
+    virtual void getOdfNumBins(int bins[3]) = 0;
+
     /**
     * @brief getHasInversion Returns a bool whether the symmetry class is centro-symmetric
     * @return
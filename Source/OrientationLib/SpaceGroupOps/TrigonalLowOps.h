@@ -72,6 +72,7 @@ class OrientationLib_EXPORT TrigonalLowOps : public SpaceGroupOps
 
     virtual bool getHasInversion() { return true; }
     virtual int getODFSize() { return k_OdfSize; }
+    virtual void getOdfNumBins(int bins[3]) { bins[0] = 72; bins[1] = 72; bins[2] = 24; }
     virtual int getMDFSize() { return k_MdfSize; }
     virtual int getNumSymOps() { return k_NumSymQuats; }
     QString getSymmetryName() { return "Trigonal-Low -3"; }
@@ -182,6 +182,61 @@ void TestFilterDesign()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestBatchConversions()
+{
+  size_t nTuples = 1000;
+  QVector<size_t> cDims(1, 3);
+  FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(nTuples, cDims, "Eulers");
+  for(size_t i = 0; i < nTuples; i++)
+  {
+    eulers->setComponent(i, 0, fmod(i * 0.37f, SIMPLib::Constants::k_2Pi));
+    eulers->setComponent(i, 1, fmod(i * 0.11f, SIMPLib::Constants::k_Pi));
+    eulers->setComponent(i, 2, fmod(i * 0.53f, SIMPLib::Constants::k_2Pi));
+  }
+
+  // Reference conversion into a newly created array
+  EulerConverter<float>::Pointer euConv = EulerConverter<float>::New();
+  euConv->setInputData(eulers);
+  euConv->convertRepresentationTo(OrientationConverter<float>::Homochoric);
+  FloatArrayType::Pointer reference = euConv->getOutputData();
+
+  // Conversion into a preallocated array
+  FloatArrayType::Pointer destination = FloatArrayType::CreateArray(nTuples, cDims, "Homochoric");
+  euConv->convertRepresentationTo(OrientationConverter<float>::Homochoric, destination);
+  DREAM3D_REQUIRE_EQUAL(euConv->getOutputData().get(), destination.get());
+
+  // Structure of Arrays conversion
+  std::vector<float> e1(nTuples), e2(nTuples), e3(nTuples);
+  for(size_t i = 0; i < nTuples; i++)
+  {
+    e1[i] = eulers->getComponent(i, 0);
+    e2[i] = eulers->getComponent(i, 1);
+    e3[i] = eulers->getComponent(i, 2);
+  }
+  QVector<float*> components(3);
+  components[0] = &(e1.front());
+  components[1] = &(e2.front());
+  components[2] = &(e3.front());
+  OrientationConverter<float>::ConvertTuples(components, components, nTuples, &OrientationTupleConversions<float>::eu2ho);
+
+  // In place conversion, which overwrites the Euler angles
+  euConv->convertRepresentationInPlace(OrientationConverter<float>::Homochoric);
+  DREAM3D_REQUIRE_EQUAL(euConv->getOutputData().get(), eulers.get());
+
+  for(size_t i = 0; i < nTuples; i++)
+  {
+    for(int c = 0; c < 3; c++)
+    {
+      DREAM3D_REQUIRE_EQUAL(reference->getComponent(i, c), destination->getComponent(i, c));
+      DREAM3D_REQUIRE_EQUAL(reference->getComponent(i, c), eulers->getComponent(i, c));
+      DREAM3D_REQUIRE_EQUAL(reference->getComponent(i, c), components[c][i]);
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //  Use test framework
 // -----------------------------------------------------------------------------
@@ -192,6 +247,7 @@ int main(int argc, char* argv[])
 
   DREAM3D_REGISTER_TEST( TestEulerConversion() );
   DREAM3D_REGISTER_TEST( TestFilterDesign() );
+  DREAM3D_REGISTER_TEST( TestBatchConversions() );
 
   return err;
 }
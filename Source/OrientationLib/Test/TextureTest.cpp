@@ -35,55 +35,282 @@
 
 
 
+#include <stdlib.h>
+
 #include <iostream>
 #include <vector>
 #include <string>
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
 #include "OrientationLib/Texture/Texture.hpp"
 #include "OrientationLib/SpaceGroupOps/CubicOps.h"
+#include "OrientationLib/SpaceGroupOps/HexagonalOps.h"
+#include "OrientationLib/SpaceGroupOps/OrthoRhombicOps.h"
+#include "OrientationLib/SpaceGroupOps/TrigonalOps.h"
 
+namespace TextureTestConsts
+{
+  // The kernel weights are summed in a different order than the serial version
+  // so allow for some round off in each ODF bin.
+  static const int k_MaxUlps = 256;
+}
 
-/**
- * @brief These tests are just here to make sure the code compiles. The tests will
- * not actually work or would probably produced undefined results.
- * @param argc
- * @param argv
- * @return
- */
-int main(int argc, char** argv)
+// -----------------------------------------------------------------------------
+// This is the serial ODF kernel smoothing that Texture used to carry one copy of
+// for each of the Cubic, Hexagonal and OrthoRhombic symmetries. The copies only
+// differed in the number of bins along each axis.
+// -----------------------------------------------------------------------------
+template<typename T, class SpaceGroupOpsType>
+void SerialODFData(T* e1s, T* e2s, T* e3s, T* weights, T* sigmas, bool normalize, T* odf, size_t numEntries)
 {
+  SpaceGroupOpsType ops;
+  int numBins[3] = { 0, 0, 0 };
+  ops.getOdfNumBins(numBins);
+  QVector<int> TextureBins(static_cast<int>(numEntries));
 
-  QVector<float> e1s;
-  QVector<float> e2s;
-  QVector<float> e3s;
-  QVector<float> weights;
-  QVector<float> sigmas;
-  QVector<float> odf;
+  float addweight = 0;
+  float totaladdweight = 0;
+  float totalweight = float(ops.getODFSize());
+  int bin, addbin;
+  int bin1, bin2, bin3;
+  int addbin1, addbin2, addbin3;
+  float dist, fraction;
 
-  CubicOps cubicOps;
-  HexagonalOps hexagonalOps;
-  OrthoRhombicOps orthOps;
+  for (size_t i = 0; i < numEntries; i++)
+  {
+    FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
+    FOrientArrayType rod(4);
+    OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
+
+    rod = ops.getODFFZRod(rod);
+    bin = ops.getOdfBin(rod);
+    TextureBins[i] = static_cast<int>(bin);
+  }
+
+  for (int i = 0; i < ops.getODFSize(); i++)
+  {
+    odf[i] = 0;
+  }
+  for (size_t i = 0; i < numEntries; i++)
+  {
+    bin = TextureBins[i];
+    bin1 = bin % numBins[0];
+    bin2 = (bin / numBins[0]) % numBins[1];
+    bin3 = bin / (numBins[0] * numBins[1]);
+    for (int j = -sigmas[i]; j <= sigmas[i]; j++)
+    {
+      int jsqrd = j * j;
+      for (int k = -sigmas[i]; k <= sigmas[i]; k++)
+      {
+        int ksqrd = k * k;
+        for (int l = -sigmas[i]; l <= sigmas[i]; l++)
+        {
+          int lsqrd = l * l;
+          addbin1 = bin1 + int(j);
+          addbin2 = bin2 + int(k);
+          addbin3 = bin3 + int(l);
+          int good = 1;
+          if(addbin1 < 0) { good = 0; }
+          if(addbin1 >= numBins[0]) { good = 0; }
+          if(addbin2 < 0) { good = 0; }
+          if(addbin2 >= numBins[1]) { good = 0; }
+          if(addbin3 < 0) { good = 0; }
+          if(addbin3 >= numBins[2]) { good = 0; }
+          addbin = (addbin3 * numBins[0] * numBins[1]) + (addbin2 * numBins[0]) + (addbin1);
+          dist = powf((jsqrd + ksqrd + lsqrd), 0.5);
+          fraction = 1.0 - (double(dist / int(sigmas[i])) * double(dist / int(sigmas[i])));
+          if(dist <= int(sigmas[i]) && good == 1)
+          {
+            addweight = (weights[i] * fraction);
+            if(sigmas[i] == 0.0) { addweight = weights[i]; }
+            odf[addbin] = odf[addbin] + addweight;
+            totaladdweight = totaladdweight + addweight;
+          }
+        }
+      }
+    }
+  }
+  if(totaladdweight > totalweight)
+  {
+    float scale = (totaladdweight / totalweight);
+    for (int i = 0; i < ops.getODFSize(); i++)
+    {
+      odf[i] = odf[i] / scale;
+    }
+  }
+  else
+  {
+    float remainingweight = totalweight - totaladdweight;
+    float background = remainingweight / static_cast<float>(ops.getODFSize());
+    for (int i = 0; i < ops.getODFSize(); i++)
+    {
+      odf[i] += background;
+    }
+  }
+  if (normalize == true)
+  {
+    for (int i = 0; i < ops.getODFSize(); i++)
+    {
+      odf[i] = odf[i] / totalweight;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RequireSameODF(QVector<float>& expected, QVector<float>& odf)
+{
+  DREAM3D_REQUIRE_EQUAL(expected.size(), odf.size())
+  for (int i = 0; i < odf.size(); i++)
+  {
+    DREAM3D_COMPARE_FLOATS(&(expected[i]), &(odf[i]), TextureTestConsts::k_MaxUlps)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<class SpaceGroupOpsType>
+void CompareODFData(int numEntries, bool normalize)
+{
+  SpaceGroupOpsType ops;
+
+  QVector<float> e1s(numEntries);
+  QVector<float> e2s(numEntries);
+  QVector<float> e3s(numEntries);
+  QVector<float> weights(numEntries);
+  QVector<float> sigmas(numEntries);
+
+  srand(static_cast<unsigned int>(numEntries));
+  for (int i = 0; i < numEntries; i++)
+  {
+    e1s[i] = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * SIMPLib::Constants::k_2Pi;
+    e2s[i] = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * SIMPLib::Constants::k_Pi;
+    e3s[i] = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * SIMPLib::Constants::k_2Pi;
+    weights[i] = static_cast<float>(rand() % 100000) / 100.0f;
+    // Zero sigma exercises the single bin path of the kernel
+    sigmas[i] = static_cast<float>(rand() % 5);
+  }
+
+  QVector<float> serialOdf(ops.getODFSize());
+  QVector<float> odf(ops.getODFSize());
+  SerialODFData<float, SpaceGroupOpsType>(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), normalize, serialOdf.data(), numEntries);
+  Texture::CalculateODFData<float, SpaceGroupOpsType>(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), normalize, odf.data(), numEntries);
+
+  RequireSameODF(serialOdf, odf);
+}
 
-  size_t numEntries = e1s.size();
-  odf.resize(cubicOps.getODFSize());
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestCubicODFData()
+{
+  CompareODFData<CubicOps>(1, true);
+  CompareODFData<CubicOps>(50, false);
+  CompareODFData<CubicOps>(500, true);
+  CompareODFData<CubicOps>(500, false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestHexagonalODFData()
+{
+  CompareODFData<HexagonalOps>(1, true);
+  CompareODFData<HexagonalOps>(50, false);
+  CompareODFData<HexagonalOps>(500, true);
+  CompareODFData<HexagonalOps>(500, false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestOrthoRhombicODFData()
+{
+  CompareODFData<OrthoRhombicOps>(1, true);
+  CompareODFData<OrthoRhombicOps>(50, false);
+  CompareODFData<OrthoRhombicOps>(500, true);
+  CompareODFData<OrthoRhombicOps>(500, false);
+}
+
+// -----------------------------------------------------------------------------
+// The symmetry specific wrappers must produce what the generic template does
+// -----------------------------------------------------------------------------
+void TestODFWrappers()
+{
+  const int numEntries = 20;
+  QVector<float> e1s(numEntries, 0.3f);
+  QVector<float> e2s(numEntries, 0.7f);
+  QVector<float> e3s(numEntries, 1.1f);
+  QVector<float> weights(numEntries, 500.0f);
+  QVector<float> sigmas(numEntries, 2.0f);
+  for (int i = 0; i < numEntries; i++)
+  {
+    e1s[i] += 0.25f * i;
+    e3s[i] += 0.1f * i;
+  }
+
+  CubicOps cubicOps;
+  QVector<float> odf(cubicOps.getODFSize());
+  QVector<float> generic(cubicOps.getODFSize());
   Texture::CalculateCubicODFData(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), true, odf.data(), numEntries);
-  odf.resize(hexagonalOps.getODFSize());
-  Texture::CalculateHexODFData(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), true,
-                               odf.data(), numEntries);
+  Texture::CalculateODFData<float, CubicOps>(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), true, generic.data(), numEntries);
+  RequireSameODF(odf, generic);
 
+  HexagonalOps hexagonalOps;
+  odf.resize(hexagonalOps.getODFSize());
+  generic.resize(hexagonalOps.getODFSize());
+  Texture::CalculateHexODFData(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), true, odf.data(), numEntries);
+  Texture::CalculateODFData<float, HexagonalOps>(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), true, generic.data(), numEntries);
+  RequireSameODF(odf, generic);
 
+  OrthoRhombicOps orthOps;
   odf.resize(orthOps.getODFSize());
-  Texture::CalculateOrthoRhombicODFData(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), true,
-                                        odf.data(), numEntries);
+  generic.resize(orthOps.getODFSize());
+  Texture::CalculateOrthoRhombicODFData(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), true, odf.data(), numEntries);
+  Texture::CalculateODFData<float, OrthoRhombicOps>(e1s.data(), e2s.data(), e3s.data(), weights.data(), sigmas.data(), true, generic.data(), numEntries);
+  RequireSameODF(odf, generic);
+}
 
+// -----------------------------------------------------------------------------
+// With no texture components the ODF is the uniform background
+// -----------------------------------------------------------------------------
+void TestEmptyODFData()
+{
+  QVector<float> empty;
+  TrigonalOps trigonalOps;
+  QVector<float> odf(trigonalOps.getODFSize(), -1.0f);
+  Texture::CalculateODFData<float, TrigonalOps>(empty.data(), empty.data(), empty.data(), empty.data(), empty.data(), false,
+                                                odf.data(), 0);
+  for (int i = 0; i < odf.size(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(odf[i], 1.0f)
+  }
 
-  //int size = 1000;
-  // Now generate the actual XY point data that gets plotted.
-  // These are the output vectors
   QVector<float> angles;
   QVector<float> axes;
   QVector<float> mdf(CubicOps::k_MdfSize);
+  Texture::CalculateMDFData<float, CubicOps>(angles.data(), axes.data(), empty.data(), odf.data(), mdf.data(), angles.size());
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
 
-  Texture::CalculateMDFData<float, CubicOps>(angles.data(), axes.data(), weights.data(), odf.data(), mdf.data(), angles.size());
+  DREAM3D_REGISTER_TEST( TestCubicODFData() )
+  DREAM3D_REGISTER_TEST( TestHexagonalODFData() )
+  DREAM3D_REGISTER_TEST( TestOrthoRhombicODFData() )
+  DREAM3D_REGISTER_TEST( TestODFWrappers() )
+  DREAM3D_REGISTER_TEST( TestEmptyODFData() )
 
-  return EXIT_SUCCESS;
+  PRINT_TEST_SUMMARY();
+  return err;
 }
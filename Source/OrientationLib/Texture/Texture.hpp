@@ -38,6 +38,8 @@
 #define _TEXTURE_H_
 
 #include <vector>
+#include <map>
+#include <algorithm>
 #include <QtCore/QString>
 #include <fstream>
 
@@ -45,6 +47,14 @@
 
 
 #include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
@@ -74,8 +84,11 @@ class Texture
 
     /**
     * @brief This will calculate ODF data based on an array of weights that are
-    * passed in and a Cubic Crystal Structure. The input data for the
-    * euler angles is in Columnar fashion instead of row major format.
+    * passed in and the crystal symmetry described by the SpaceGroupOpsType template
+    * parameter. The input data for the euler angles is in Columnar fashion instead
+    * of row major format. Each texture component is smeared over the neighboring
+    * ODF bins that lie within 'sigma' bins of the component's bin using the
+    * kernel weight (1 - (dist/sigma)^2). The components are accumulated in parallel.
     * @param e1s Pointer to first Euler Angles
     * @param e2s Pointer to the second euler angles
     * @param e3s Pointer to the third euler angles
@@ -87,24 +100,23 @@ class Texture
     * for this MUST have already been allocated. Use ops.getODFSize() to allocate the proper amount
     * @param numEntries The number of entries of Angle/Weight/Sigmas
     */
-    template<typename T>
-    static void CalculateCubicODFData(T* e1s, T* e2s, T* e3s,
-                                      T* weights, T* sigmas,
-                                      bool normalize, T* odf, size_t numEntries)
+    template<typename T, class SpaceGroupOpsType>
+    static void CalculateODFData(T* e1s, T* e2s, T* e3s,
+                                 T* weights, T* sigmas,
+                                 bool normalize, T* odf, size_t numEntries)
     {
-      SIMPL_RANDOMNG_NEW()
-      CubicOps ops;
+      SpaceGroupOpsType ops;
+      const int odfSize = ops.getODFSize();
+      int numBins[3] = { 0, 0, 0 };
+      ops.getOdfNumBins(numBins);
+
       Int32ArrayType::Pointer textureBins = Int32ArrayType::CreateArray(numEntries, "TextureBins");
       int32_t* TextureBins = textureBins->getPointer(0);
+      Int32ArrayType::Pointer kernelSizes = Int32ArrayType::CreateArray(numEntries, "KernelSizes");
+      int32_t* KernelSizes = kernelSizes->getPointer(0);
 
-      float addweight = 0;
-      float totaladdweight = 0;
-      float totalweight = float(ops.getODFSize());
-      int bin, addbin;
-      int bin1, bin2, bin3;
-      int addbin1, addbin2, addbin3;
-      float dist, fraction;
-
+      // Each distinct kernel size only needs its kernel table generated once
+      KernelTableMap kernelTables;
       for (size_t i = 0; i < numEntries; i++)
       {
         FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
@@ -112,80 +124,47 @@ class Texture
         OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
 
         rod = ops.getODFFZRod(rod);
-        bin = ops.getOdfBin(rod);
-        TextureBins[i] = static_cast<int>(bin);
-      }
-
-      for (int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = 0;
-      }
-      for (size_t i = 0; i < numEntries; i++)
-      {
-        bin = TextureBins[i];
-        bin1 = bin % 18;
-        bin2 = (bin / 18) % 18;
-        bin3 = bin / (18 * 18);
-        for (int j = -sigmas[i]; j <= sigmas[i]; j++)
+        TextureBins[i] = ops.getOdfBin(rod);
+        // The sigma values are a number of bins. Fractional values are truncated
+        KernelSizes[i] = static_cast<int32_t>(sigmas[i]);
+        if (KernelSizes[i] >= 0 && kernelTables.find(KernelSizes[i]) == kernelTables.end())
         {
-          int jsqrd = j * j;
-          for (int k = -sigmas[i]; k <= sigmas[i]; k++)
-          {
-            int ksqrd = k * k;
-            for (int l = -sigmas[i]; l <= sigmas[i]; l++)
-            {
-              int lsqrd = l * l;
-              addbin1 = bin1 + int(j);
-              addbin2 = bin2 + int(k);
-              addbin3 = bin3 + int(l);
-              //if(addbin1 < 0) addbin1 = addbin1 + 18;
-              //if(addbin1 >= 18) addbin1 = addbin1 - 18;
-              //if(addbin2 < 0) addbin2 = addbin2 + 18;
-              //if(addbin2 >= 18) addbin2 = addbin2 - 18;
-              //if(addbin3 < 0) addbin3 = addbin3 + 18;
-              //if(addbin3 >= 18) addbin3 = addbin3 - 18;
-              int good = 1;
-              if(addbin1 < 0) { good = 0; }
-              if(addbin1 >= 18) { good = 0; }
-              if(addbin2 < 0) { good = 0; }
-              if(addbin2 >= 18) { good = 0; }
-              if(addbin3 < 0) { good = 0; }
-              if(addbin3 >= 18) { good = 0; }
-              addbin = (addbin3 * 18 * 18) + (addbin2 * 18) + (addbin1);
-              dist = powf((jsqrd + ksqrd + lsqrd), 0.5);
-              fraction = 1.0 - (double(dist / int(sigmas[i])) * double(dist / int(sigmas[i])));
-              if(dist <= int(sigmas[i]) && good == 1)
-              {
-                addweight = (weights[i] * fraction);
-                if(sigmas[i] == 0.0) { addweight = weights[i]; }
-                odf[addbin] = odf[addbin] + addweight;
-                totaladdweight = totaladdweight + addweight;
-              }
-            }
-          }
+          kernelTables[KernelSizes[i]] = GenerateKernelTable(KernelSizes[i]);
         }
       }
+
+      ODFKernelAccumulator<T> accumulator(TextureBins, weights, KernelSizes, kernelTables, numBins, odfSize);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      tbb::parallel_reduce(tbb::blocked_range<size_t>(0, numEntries), accumulator, tbb::auto_partitioner());
+#else
+      accumulator.accumulate(0, numEntries);
+#endif
+
+      const std::vector<T>& addedOdf = accumulator.getOdf();
+      float totaladdweight = static_cast<float>(accumulator.getTotalAddWeight());
+      float totalweight = float(odfSize);
       if(totaladdweight > totalweight)
       {
         float scale = (totaladdweight / totalweight);
-        for (int i = 0; i < ops.getODFSize(); i++)
+        for (int i = 0; i < odfSize; i++)
         {
-          odf[i] = odf[i] / scale;
+          odf[i] = addedOdf[i] / scale;
         }
       }
       else
       {
         float remainingweight = totalweight - totaladdweight;
-        float background = remainingweight / static_cast<float>(ops.getODFSize());
-        for (int i = 0; i < ops.getODFSize(); i++)
+        float background = remainingweight / static_cast<float>(odfSize);
+        for (int i = 0; i < odfSize; i++)
         {
-          odf[i] += background;
+          odf[i] = addedOdf[i] + background;
         }
       }
       if (normalize == true)
       {
         // Normalize the odf
-        for (int i = 0; i < ops.getODFSize(); i++)
+        for (int i = 0; i < odfSize; i++)
         {
           odf[i] = odf[i] / totalweight;
         }
@@ -194,9 +173,30 @@ class Texture
 
     /**
     * @brief This will calculate ODF data based on an array of weights that are
-    * passed in and a Hexagonal Crystal Structure. This is templated on the container
-    * type that holds the data. Containers that adhere to the STL Vector API
-    * should be usable. QVector falls into this category. The input data for the
+    * passed in and a Cubic Crystal Structure. The input data for the
+    * euler angles is in Columnar fashion instead of row major format.
+    * @param e1s Pointer to first Euler Angles
+    * @param e2s Pointer to the second euler angles
+    * @param e3s Pointer to the third euler angles
+    * @param weights Pointer to the Array of weights values.
+    * @param sigmas Pointer to the Array of sigma values.
+    * @param normalize Should the ODF data be normalized by the totalWeight value
+    * before returning.
+    * @param odf (OUT) Pointer to the ODF array that is generated from this function. NOTE: The memory
+    * for this MUST have already been allocated. Use ops.getODFSize() to allocate the proper amount
+    * @param numEntries The number of entries of Angle/Weight/Sigmas
+    */
+    template<typename T>
+    static void CalculateCubicODFData(T* e1s, T* e2s, T* e3s,
+                                      T* weights, T* sigmas,
+                                      bool normalize, T* odf, size_t numEntries)
+    {
+      CalculateODFData<T, CubicOps>(e1s, e2s, e3s, weights, sigmas, normalize, odf, numEntries);
+    }
+
+    /**
+    * @brief This will calculate ODF data based on an array of weights that are
+    * passed in and a Hexagonal Crystal Structure. The input data for the
     * euler angles is in Columnar fashion instead of row major format.
     * @param e1s The first euler angles
     * @param e2s The second euler angles
@@ -206,115 +206,17 @@ class Texture
     * @param normalize Should the ODF data be normalized by the totalWeight value
     * before returning.
     * @param odf (OUT) The ODF data that is generated from this function.
-    * @param numEntries (OUT) The TotalWeight value that is also calculated
+    * @param numEntries The number of entries of Angle/Weight/Sigmas
     */
     template<typename T>
     static void CalculateHexODFData(T* e1s, T* e2s, T* e3s, T* weights, T* sigmas, bool normalize, T* odf, size_t numEntries)
     {
-      HexagonalOps hexOps;
-      SIMPL_RANDOMNG_NEW()
-      Int32ArrayType::Pointer textureBins = Int32ArrayType::CreateArray(numEntries, "TextureBins");
-      int32_t* TextureBins = textureBins->getPointer(0);
-      float addweight = 0;
-      float totaladdweight = 0;
-      float totalweight = float(hexOps.getODFSize());
-      int bin, addbin;
-      int bin1, bin2, bin3;
-      int addbin1, addbin2, addbin3;
-      float dist, fraction;
-      HexagonalOps ops;
-      for (size_t i = 0; i < numEntries; i++)
-      {
-        FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
-        FOrientArrayType rod(4);
-        OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
-
-        rod = ops.getODFFZRod(rod);
-        bin = ops.getOdfBin(rod);
-        TextureBins[i] = static_cast<int>(bin);
-      }
-
-      for (int i = 0; i < hexOps.getODFSize(); i++)
-      {
-        odf[i] = 0;
-      }
-      for (size_t i = 0; i < numEntries; i++)
-      {
-        bin = TextureBins[i];
-        bin1 = bin % 36;
-        bin2 = (bin / 36) % 36;
-        bin3 = bin / (36 * 36);
-        for (int j = -sigmas[i]; j <= sigmas[i]; j++)
-        {
-          int jsqrd = j * j;
-          for (int k = -sigmas[i]; k <= sigmas[i]; k++)
-          {
-            int ksqrd = k * k;
-            for (int l = -sigmas[i]; l <= sigmas[i]; l++)
-            {
-              int lsqrd = l * l;
-              addbin1 = bin1 + int(j);
-              addbin2 = bin2 + int(k);
-              addbin3 = bin3 + int(l);
-              //if(addbin1 < 0) addbin1 = addbin1 + 36;
-              //if(addbin1 >= 36) addbin1 = addbin1 - 36;
-              //if(addbin2 < 0) addbin2 = addbin2 + 36;
-              //if(addbin2 >= 36) addbin2 = addbin2 - 36;
-              //if(addbin3 < 0) addbin3 = addbin3 + 12;
-              //if(addbin3 >= 12) addbin3 = addbin3 - 12;
-              int good = 1;
-              if(addbin1 < 0) { good = 0; }
-              if(addbin1 >= 36) { good = 0; }
-              if(addbin2 < 0) { good = 0; }
-              if(addbin2 >= 36) { good = 0; }
-              if(addbin3 < 0) { good = 0; }
-              if(addbin3 >= 12) { good = 0; }
-              addbin = (addbin3 * 36 * 36) + (addbin2 * 36) + (addbin1);
-              dist = powf((jsqrd + ksqrd + lsqrd), 0.5);
-              fraction = 1.0 - (double(dist / int(sigmas[i])) * double(dist / int(sigmas[i])));
-              if(dist <= int(sigmas[i]) && good == 1)
-              {
-                addweight = (weights[i] * fraction);
-                if(sigmas[i] == 0.0) { addweight = weights[i]; }
-                odf[addbin] = odf[addbin] + addweight;
-                totaladdweight = totaladdweight + addweight;
-              }
-            }
-          }
-        }
-      }
-      if (totaladdweight > totalweight)
-      {
-        float scale = (totaladdweight / totalweight);
-        for (int i = 0; i < ops.getODFSize(); i++)
-        {
-          odf[i] = odf[i] / scale;
-        }
-      }
-      else
-      {
-        float remainingweight = totalweight - totaladdweight;
-        float background = remainingweight / static_cast<float>(ops.getODFSize());
-        for (int i = 0; i < ops.getODFSize(); i++)
-        {
-          odf[i] += background;
-        }
-      }
-      if (normalize == true)
-      {
-        // Normalize the odf
-        for (int i = 0; i < ops.getODFSize(); i++)
-        {
-          odf[i] = odf[i] / totalweight;
-        }
-      }
+      CalculateODFData<T, HexagonalOps>(e1s, e2s, e3s, weights, sigmas, normalize, odf, numEntries);
     }
 
     /**
     * @brief This will calculate ODF data based on an array of weights that are
-    * passed in and a OrthoRhombic Crystal Structure. This is templated on the container
-    * type that holds the data. Containers that adhere to the STL Vector API
-    * should be usable. QVector falls into this category. The input data for the
+    * passed in and a OrthoRhombic Crystal Structure. The input data for the
     * euler angles is in Columnar fashion instead of row major format.
     * @param e1s The first euler angles
     * @param e2s The second euler angles
@@ -324,107 +226,12 @@ class Texture
     * @param normalize Should the ODF data be normalized by the totalWeight value
     * before returning.
     * @param odf (OUT) The ODF data that is generated from this function.
-    * @param numEntries The TotalWeight value that is also calculated
+    * @param numEntries The number of entries of Angle/Weight/Sigmas
     */
     template<typename T>
     static void CalculateOrthoRhombicODFData(T* e1s, T* e2s, T* e3s, T* weights, T* sigmas, bool normalize, T* odf, size_t numEntries)
     {
-      OrthoRhombicOps ops;
-      SIMPL_RANDOMNG_NEW()
-      Int32ArrayType::Pointer textureBins = Int32ArrayType::CreateArray(numEntries, "TextureBins");
-      int32_t* TextureBins = textureBins->getPointer(0);
-      float addweight = 0;
-      float totaladdweight = 0;
-      float totalweight = float(ops.getODFSize());
-      int bin, addbin;
-      int bin1, bin2, bin3;
-      int addbin1, addbin2, addbin3;
-      float dist, fraction;
-      for (size_t i = 0; i < numEntries; i++)
-      {
-        FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
-        FOrientArrayType rod(4);
-        OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
-
-        rod = ops.getODFFZRod(rod);
-        bin = ops.getOdfBin(rod);
-        TextureBins[i] = static_cast<int>(bin);
-      }
-
-      for (int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = 0;
-      }
-      for (size_t i = 0; i < numEntries; i++)
-      {
-        bin = TextureBins[i];
-        bin1 = bin % 36;
-        bin2 = (bin / 36) % 36;
-        bin3 = bin / (36 * 36);
-        for (int j = -sigmas[i]; j <= sigmas[i]; j++)
-        {
-          int jsqrd = j * j;
-          for (int k = -sigmas[i]; k <= sigmas[i]; k++)
-          {
-            int ksqrd = k * k;
-            for (int l = -sigmas[i]; l <= sigmas[i]; l++)
-            {
-              int lsqrd = l * l;
-              addbin1 = bin1 + int(j);
-              addbin2 = bin2 + int(k);
-              addbin3 = bin3 + int(l);
-              //if (addbin1 < 0) addbin1 = addbin1 + 36;
-              //if (addbin1 >= 36) addbin1 = addbin1 - 36;
-              //if (addbin2 < 0) addbin2 = addbin2 + 36;
-              //if (addbin2 >= 36) addbin2 = addbin2 - 36;
-              //if (addbin3 < 0) addbin3 = addbin3 + 36;
-              //if (addbin3 >= 36) addbin3 = addbin3 - 36;
-              int good = 1;
-              if (addbin1 < 0) { good = 0; }
-              if (addbin1 >= 36) { good = 0; }
-              if (addbin2 < 0) { good = 0; }
-              if (addbin2 >= 36) { good = 0; }
-              if (addbin3 < 0) { good = 0; }
-              if (addbin3 >= 36) { good = 0; }
-              addbin = (addbin3 * 36 * 36) + (addbin2 * 36) + (addbin1);
-              dist = sqrtf(jsqrd + ksqrd + lsqrd);
-              fraction = 1.0 - (float(dist / int(sigmas[i])) * float(dist / int(sigmas[i])));
-              if (dist <= int(sigmas[i]) && good == 1)
-              {
-                addweight = (weights[i] * fraction);
-                if(sigmas[i] == 0.0) { addweight = weights[i]; }
-                odf[addbin] = odf[addbin] + addweight;
-                totaladdweight = totaladdweight + addweight;
-              }
-            }
-          }
-        }
-      }
-      if (totaladdweight > totalweight)
-      {
-        float scale = (totaladdweight / totalweight);
-        for (int i = 0; i < ops.getODFSize(); i++)
-        {
-          odf[i] = odf[i] / scale;
-        }
-      }
-      else
-      {
-        float remainingweight = totalweight - totaladdweight;
-        float background = remainingweight / static_cast<float>(ops.getODFSize());
-        for (int i = 0; i < ops.getODFSize(); i++)
-        {
-          odf[i] += background;
-        }
-      }
-      if (normalize == true)
-      {
-        // Normalize the odf
-        for (int i = 0; i < ops.getODFSize(); i++)
-        {
-          odf[i] = odf[i] / totalweight;
-        }
-      }
+      CalculateODFData<T, OrthoRhombicOps>(e1s, e2s, e3s, weights, sigmas, normalize, odf, numEntries);
     }
 
     /**
@@ -527,6 +334,162 @@ class Texture
   protected:
     Texture() {}
 
+    /**
+     * @brief The kernel table holds, for each (k, l) row of the (2 * sigma + 1)^3 kernel
+     * cube, the largest |j| that still lies within the sphere of radius sigma. A value
+     * of -1 marks an empty row. The kernel weight only depends on j^2 + k^2 + l^2 so
+     * the table together with the row index is enough to evaluate it.
+     */
+    typedef std::vector<int32_t> KernelTable;
+    typedef std::map<int32_t, KernelTable> KernelTableMap;
+
+    /**
+     * @brief GenerateKernelTable Creates the kernel table for the given kernel size
+     * @param sigma Kernel size in number of bins
+     * @return
+     */
+    static KernelTable GenerateKernelTable(int32_t sigma)
+    {
+      const int32_t width = 2 * sigma + 1;
+      const int32_t sigmaSqrd = sigma * sigma;
+      KernelTable table(width * width, -1);
+      for (int32_t l = -sigma; l <= sigma; l++)
+      {
+        for (int32_t k = -sigma; k <= sigma; k++)
+        {
+          int32_t remaining = sigmaSqrd - (k * k) - (l * l);
+          if (remaining < 0) { continue; }
+          int32_t halfWidth = 0;
+          while ((halfWidth + 1) * (halfWidth + 1) <= remaining) { halfWidth++; }
+          table[(l + sigma) * width + (k + sigma)] = halfWidth;
+        }
+      }
+      return table;
+    }
+
+    /**
+     * @brief The ODFKernelAccumulator class adds the smoothed contribution of a range
+     * of texture components into its own ODF buffer. Each split copy owns its own
+     * buffer so the components can be accumulated concurrently and merged in join().
+     */
+    template<typename T>
+    class ODFKernelAccumulator
+    {
+      public:
+        ODFKernelAccumulator(const int32_t* textureBins, const T* weights, const int32_t* kernelSizes,
+                             const KernelTableMap& kernelTables, const int numBins[3], int odfSize) :
+          m_TextureBins(textureBins),
+          m_Weights(weights),
+          m_KernelSizes(kernelSizes),
+          m_KernelTables(kernelTables),
+          m_OdfSize(odfSize),
+          m_Odf(odfSize, 0),
+          m_TotalAddWeight(0)
+        {
+          m_NumBins[0] = numBins[0];
+          m_NumBins[1] = numBins[1];
+          m_NumBins[2] = numBins[2];
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        ODFKernelAccumulator(ODFKernelAccumulator& other, tbb::split) :
+          m_TextureBins(other.m_TextureBins),
+          m_Weights(other.m_Weights),
+          m_KernelSizes(other.m_KernelSizes),
+          m_KernelTables(other.m_KernelTables),
+          m_OdfSize(other.m_OdfSize),
+          m_Odf(other.m_OdfSize, 0),
+          m_TotalAddWeight(0)
+        {
+          m_NumBins[0] = other.m_NumBins[0];
+          m_NumBins[1] = other.m_NumBins[1];
+          m_NumBins[2] = other.m_NumBins[2];
+        }
+#endif
+
+        virtual ~ODFKernelAccumulator() {}
+
+        void accumulate(size_t start, size_t end)
+        {
+          const int32_t nb0 = m_NumBins[0];
+          const int32_t nb1 = m_NumBins[1];
+          const int32_t nb2 = m_NumBins[2];
+          T* odf = &(m_Odf.front());
+          for (size_t i = start; i < end; i++)
+          {
+            const int32_t sigma = m_KernelSizes[i];
+            if (sigma < 0) { continue; }
+            const T weight = m_Weights[i];
+            const int32_t bin = m_TextureBins[i];
+            const int32_t bin1 = bin % nb0;
+            const int32_t bin2 = (bin / nb0) % nb1;
+            const int32_t bin3 = bin / (nb0 * nb1);
+            if (sigma == 0)
+            {
+              odf[bin] += weight;
+              m_TotalAddWeight += weight;
+              continue;
+            }
+
+            const int32_t width = 2 * sigma + 1;
+            const int32_t* table = &(m_KernelTables.find(sigma)->second.front());
+            const T invSigmaSqrd = T(1.0) / T(sigma * sigma);
+            // Clip the kernel to the ODF bins instead of testing every offset
+            const int32_t lMin = std::max(-sigma, -bin3);
+            const int32_t lMax = std::min(sigma, nb2 - 1 - bin3);
+            const int32_t kMin = std::max(-sigma, -bin2);
+            const int32_t kMax = std::min(sigma, nb1 - 1 - bin2);
+            for (int32_t l = lMin; l <= lMax; l++)
+            {
+              for (int32_t k = kMin; k <= kMax; k++)
+              {
+                const int32_t halfWidth = table[(l + sigma) * width + (k + sigma)];
+                if (halfWidth < 0) { continue; }
+                const int32_t jMin = std::max(-halfWidth, -bin1);
+                const int32_t jMax = std::min(halfWidth, nb0 - 1 - bin1);
+                const int32_t klSqrd = (k * k) + (l * l);
+                T* row = odf + ((bin3 + l) * nb0 * nb1) + ((bin2 + k) * nb0) + bin1;
+                for (int32_t j = jMin; j <= jMax; j++)
+                {
+                  T addweight = weight * (T(1.0) - T(j * j + klSqrd) * invSigmaSqrd);
+                  row[j] += addweight;
+                  m_TotalAddWeight += addweight;
+                }
+              }
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r)
+        {
+          accumulate(r.begin(), r.end());
+        }
+
+        void join(const ODFKernelAccumulator& rhs)
+        {
+          for (int i = 0; i < m_OdfSize; i++)
+          {
+            m_Odf[i] += rhs.m_Odf[i];
+          }
+          m_TotalAddWeight += rhs.m_TotalAddWeight;
+        }
+#endif
+
+        const std::vector<T>& getOdf() const { return m_Odf; }
+        T getTotalAddWeight() const { return m_TotalAddWeight; }
+
+      private:
+        const int32_t* m_TextureBins;
+        const T* m_Weights;
+        const int32_t* m_KernelSizes;
+        const KernelTableMap& m_KernelTables;
+        int32_t m_NumBins[3];
+        int m_OdfSize;
+        std::vector<T> m_Odf;
+        T m_TotalAddWeight;
+    };
+
   private:
     Texture(const Texture&); // Copy Constructor Not Implemented
     void operator=(const Texture&); // Operator '=' Not Implemented
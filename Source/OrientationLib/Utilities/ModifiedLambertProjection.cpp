@@ -36,6 +36,16 @@
 
 #include "ModifiedLambertProjection.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include <QtCore/QSet>
 
 
@@ -44,6 +54,187 @@
 
 #define WRITE_LAMBERT_SQUARE_COORD_VTK 0
 
+// The XYZ coordinates are binned in chunks of at least this many points, and never in more than
+// k_MaxLambertChunks chunks, so the extra squares stay small and the sums only depend on the point count
+static const size_t k_LambertPointsPerChunk = 262144;
+static const size_t k_MaxLambertChunks = 16;
+
+/**
+ * @brief The LambertBinningImpl class bins a range of chunks of XYZ coordinates into a projection. Each chunk adds
+ * its points, in order, into its own pair of squares so the sums do not depend on how the chunks are threaded.
+ */
+class LambertBinningImpl
+{
+  public:
+    LambertBinningImpl(ModifiedLambertProjection* projection, FloatArrayType* coords, size_t pointsPerChunk,
+                       const std::vector<double*>& northSquares, const std::vector<double*>& southSquares) :
+      m_Projection(projection),
+      m_Coords(coords),
+      m_PointsPerChunk(pointsPerChunk),
+      m_NorthSquares(northSquares),
+      m_SouthSquares(southSquares)
+    {}
+    virtual ~LambertBinningImpl() {}
+
+    void bin(size_t start, size_t end) const
+    {
+      size_t npoints = m_Coords->getNumberOfTuples();
+      float sqCoord[2] = { 0.0f, 0.0f };
+      for (size_t c = start; c < end; c++)
+      {
+        size_t pointEnd = std::min((c + 1) * m_PointsPerChunk, npoints);
+        for (size_t i = c * m_PointsPerChunk; i < pointEnd; ++i)
+        {
+          sqCoord[0] = 0.0;
+          sqCoord[1] = 0.0;
+          //get coordinates in square projection of crystal normal parallel to boundary normal
+          if (m_Projection->getSquareCoord(m_Coords->getPointer(i * 3), sqCoord) == true)
+          {
+            m_Projection->addInterpolatedValues(m_NorthSquares[c], sqCoord, 1.0);
+          }
+          else
+          {
+            m_Projection->addInterpolatedValues(m_SouthSquares[c], sqCoord, 1.0);
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      bin(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    ModifiedLambertProjection* m_Projection;
+    FloatArrayType* m_Coords;
+    size_t m_PointsPerChunk;
+    const std::vector<double*>& m_NorthSquares;
+    const std::vector<double*>& m_SouthSquares;
+};
+
+/**
+ * @brief The LambertReduceImpl class adds the squares of chunks 1..n-1 into those of chunk 0 over a range of bins,
+ * always in chunk order.
+ */
+class LambertReduceImpl
+{
+  public:
+    LambertReduceImpl(const std::vector<double*>& northSquares, const std::vector<double*>& southSquares) :
+      m_NorthSquares(northSquares),
+      m_SouthSquares(southSquares)
+    {}
+    virtual ~LambertReduceImpl() {}
+
+    void reduce(size_t start, size_t end) const
+    {
+      double* north = m_NorthSquares[0];
+      double* south = m_SouthSquares[0];
+      for (size_t c = 1; c < m_NorthSquares.size(); c++)
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          north[i] += m_NorthSquares[c][i];
+          south[i] += m_SouthSquares[c][i];
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      reduce(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const std::vector<double*>& m_NorthSquares;
+    const std::vector<double*>& m_SouthSquares;
+};
+
+/**
+ * @brief The StereographicProjectionImpl class fills a range of rows of a stereographic intensity image from the
+ * squares of a projection.
+ */
+class StereographicProjectionImpl
+{
+  public:
+    StereographicProjectionImpl(ModifiedLambertProjection* projection, int dim, double* intensity) :
+      m_Projection(projection),
+      m_Dim(dim),
+      m_Intensity(intensity)
+    {}
+    virtual ~StereographicProjectionImpl() {}
+
+    void project(int64_t start, int64_t end) const
+    {
+      int xpoints = m_Dim;
+      int ypoints = m_Dim;
+
+      int xpointshalf = xpoints / 2;
+      int ypointshalf = ypoints / 2;
+
+      float xres = 2.0 / (float)(xpoints);
+      float yres = 2.0 / (float)(ypoints);
+      float xtmp, ytmp;
+      float sqCoord[2];
+      float xyz[3];
+      bool nhCheck = false;
+
+      for (int64_t y = start; y < end; y++)
+      {
+        for (int64_t x = 0; x < xpoints; x++)
+        {
+          //get (x,y) for stereographic projection pixel
+          xtmp = float(x - xpointshalf) * xres + (xres * 0.5);
+          ytmp = float(y - ypointshalf) * yres + (yres * 0.5);
+          int index = y * xpoints + x;
+          if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
+          {
+            //project xy from stereo projection to the unit spehere
+            xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
+            xyz[0] = xtmp * (1 + xyz[2]);
+            xyz[1] = ytmp * (1 + xyz[2]);
+
+            for( int64_t m = 0; m < 2; m++)
+            {
+              if(m == 1)
+              {
+                MatrixMath::Multiply3x1withConstant(xyz, -1.0);
+              }
+              nhCheck = m_Projection->getSquareCoord(xyz, sqCoord);
+              if (nhCheck == true)
+              {
+                //get Value from North square
+                m_Intensity[index] += m_Projection->getInterpolatedValue(ModifiedLambertProjection::NorthSquare, sqCoord);
+              }
+              else
+              {
+                //get Value from South square
+                m_Intensity[index] += m_Projection->getInterpolatedValue(ModifiedLambertProjection::SouthSquare, sqCoord);
+              }
+            }
+            m_Intensity[index]  = m_Intensity[index] * 0.5;
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      project(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    ModifiedLambertProjection* m_Projection;
+    int m_Dim;
+    double* m_Intensity;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -72,9 +263,6 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::CreateProjectionFr
 {
 
   size_t npoints = coords->getNumberOfTuples();
-  bool nhCheck = false;
-  float sqCoord[2];
-  //int sqIndex = 0;
   ModifiedLambertProjection::Pointer squareProj = ModifiedLambertProjection::New();
   squareProj->initializeSquares(dimension, sphereRadius);
 
@@ -99,17 +287,16 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::CreateProjectionFr
   fprintf(f, "\n");
 
   fprintf(f, "DATASET UNSTRUCTURED_GRID\nPOINTS %lu float\n", coords->getNumberOfTuples() );
-#endif
 
+  bool nhCheck = false;
+  float sqCoord[2];
   for(size_t i = 0; i < npoints; ++i)
   {
     sqCoord[0] = 0.0;
     sqCoord[1] = 0.0;
     //get coordinates in square projection of crystal normal parallel to boundary normal
     nhCheck = squareProj->getSquareCoord(coords->getPointer(i * 3), sqCoord);
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
     fprintf(f, "%f %f 0\n", sqCoord[0], sqCoord[1]);
-#endif
 
     // Based on the XY coordinate, get the pointer index that the value corresponds to in the proper square
 //    sqIndex = squareProj->getSquareIndex(sqCoord);
@@ -126,8 +313,39 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::CreateProjectionFr
       squareProj->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
     }
   }
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
   fclose(f);
+#else
+  // Bin a fixed number of chunks of points concurrently, each into its own pair of squares, then add the squares
+  // together in chunk order. Chunk 0 bins straight into the projection's own squares.
+  size_t pointsPerChunk = std::max(k_LambertPointsPerChunk, (npoints + k_MaxLambertChunks - 1) / k_MaxLambertChunks);
+  size_t numChunks = std::max<size_t>(1, (npoints + pointsPerChunk - 1) / pointsPerChunk);
+  size_t numBins = squareProj->getNorthSquare()->getNumberOfTuples();
+
+  std::vector<std::vector<double> > chunkSquares(2 * (numChunks - 1), std::vector<double>(numBins, 0.0));
+  std::vector<double*> northSquares(numChunks, squareProj->getNorthSquare()->getPointer(0));
+  std::vector<double*> southSquares(numChunks, squareProj->getSouthSquare()->getPointer(0));
+  for (size_t c = 1; c < numChunks; c++)
+  {
+    northSquares[c] = &(chunkSquares[2 * (c - 1)].front());
+    southSquares[c] = &(chunkSquares[2 * (c - 1) + 1].front());
+  }
+
+  LambertBinningImpl binning(squareProj.get(), coords, pointsPerChunk, northSquares, southSquares);
+  LambertReduceImpl reduce(northSquares, southSquares);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), binning, tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBins), reduce, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    binning.bin(0, numChunks);
+    reduce.reduce(0, numBins);
+  }
 #endif
 
   return squareProj;
@@ -184,6 +402,21 @@ int ModifiedLambertProjection::readHDF5Data(hid_t groupId)
 //
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCoord, double value)
+{
+  if (square == NorthSquare)
+  {
+    addInterpolatedValues(m_NorthSquare->getPointer(0), sqCoord, value);
+  }
+  else
+  {
+    addInterpolatedValues(m_SouthSquare->getPointer(0), sqCoord, value);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addInterpolatedValues(double* squareData, float* sqCoord, double value)
 {
   int abin1 = 0, bbin1 = 0;
   int abin2 = 0, bbin2 = 0;
@@ -249,28 +482,14 @@ void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCo
   int index2 = bbin2 * m_Dimension + abin2;
   int index3 = bbin3 * m_Dimension + abin3;
   int index4 = bbin4 * m_Dimension + abin4;
-  if (square == NorthSquare)
-  {
-    double v1 = m_NorthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
-    double v2 = m_NorthSquare->getValue(index2) + value * (modX) * (1.0 - modY);
-    double v3 = m_NorthSquare->getValue(index3) + value * (1.0 - modX) * (modY);
-    double v4 = m_NorthSquare->getValue(index4) + value * (modX) * (modY);
-    m_NorthSquare->setValue(index1, v1);
-    m_NorthSquare->setValue(index2, v2);
-    m_NorthSquare->setValue(index3, v3);
-    m_NorthSquare->setValue(index4, v4);
-  }
-  else
-  {
-    double v1 = m_SouthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
-    double v2 = m_SouthSquare->getValue(index2) + value * (modX) * (1.0 - modY);
-    double v3 = m_SouthSquare->getValue(index3) + value * (1.0 - modX) * (modY);
-    double v4 = m_SouthSquare->getValue(index4) + value * (modX) * (modY);
-    m_SouthSquare->setValue(index1, v1);
-    m_SouthSquare->setValue(index2, v2);
-    m_SouthSquare->setValue(index3, v3);
-    m_SouthSquare->setValue(index4, v4);
-  }
+  double v1 = squareData[index1] + value * (1.0 - modX) * (1.0 - modY);
+  double v2 = squareData[index2] + value * (modX) * (1.0 - modY);
+  double v3 = squareData[index3] + value * (1.0 - modX) * (modY);
+  double v4 = squareData[index4] + value * (modX) * (modY);
+  squareData[index1] = v1;
+  squareData[index2] = v2;
+  squareData[index3] = v3;
+  squareData[index4] = v4;
 }
 
 // -----------------------------------------------------------------------------
@@ -531,63 +750,20 @@ void ModifiedLambertProjection::normalizeSquaresToMRD()
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::createStereographicProjection(int dim, DoubleArrayType* stereoIntensity)
 {
-  int xpoints = dim;
-  int ypoints = dim;
-
-  int xpointshalf = xpoints / 2;
-  int ypointshalf = ypoints / 2;
-
-  float xres = 2.0 / (float)(xpoints);
-  float yres = 2.0 / (float)(ypoints);
-  float xtmp, ytmp;
-  float sqCoord[2];
-  float xyz[3];
-  bool nhCheck = false;
-
   stereoIntensity->initializeWithZeros();
-  double* intensity = stereoIntensity->getPointer(0);
-// int sqIndex = 0;
+  StereographicProjectionImpl serial(this, dim, stereoIntensity->getPointer(0));
 
-  for (int64_t y = 0; y < ypoints; y++)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
   {
-    for (int64_t x = 0; x < xpoints; x++)
-    {
-      //get (x,y) for stereographic projection pixel
-      xtmp = float(x - xpointshalf) * xres + (xres * 0.5);
-      ytmp = float(y - ypointshalf) * yres + (yres * 0.5);
-      int index = y * xpoints + x;
-      if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
-      {
-        //project xy from stereo projection to the unit spehere
-        xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
-        xyz[0] = xtmp * (1 + xyz[2]);
-        xyz[1] = ytmp * (1 + xyz[2]);
-
-
-        for( int64_t m = 0; m < 2; m++)
-        {
-          if(m == 1)
-          {
-            MatrixMath::Multiply3x1withConstant(xyz, -1.0);
-          }
-          nhCheck = getSquareCoord(xyz, sqCoord);
-          //sqIndex = getSquareIndex(sqCoord);
-          if (nhCheck == true)
-          {
-            //get Value from North square
-            intensity[index] += getInterpolatedValue(ModifiedLambertProjection::NorthSquare, sqCoord);
-            //intensity[index] += getValue(ModifiedLambertProjection::NorthSquare, sqIndex);
-          }
-          else
-          {
-            //get Value from South square
-            intensity[index] += getInterpolatedValue(ModifiedLambertProjection::SouthSquare, sqCoord);
-            //intensity[index] += getValue(ModifiedLambertProjection::SouthSquare, sqIndex);
-          }
-        }
-        intensity[index]  = intensity[index] * 0.5;
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, dim), serial, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    serial.project(0, dim);
   }
 }
 
@@ -106,6 +106,15 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     void addInterpolatedValues(Square square, float* sqCoord, double value);
 
+    /**
+     * @brief addInterpolatedValues Adds the value into a caller owned square that has the same dimensions as the
+     * squares of this projection, for example a per thread copy that is summed into this projection later.
+     * @param squareData Pointer to the Dimension * Dimension bins of the square
+     * @param sqCoord
+     * @param value
+     */
+    void addInterpolatedValues(double* squareData, float* sqCoord, double value);
+
     /**
      * @brief addValue
      * @param square
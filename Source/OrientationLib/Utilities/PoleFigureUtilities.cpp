@@ -35,6 +35,13 @@
 
 #include "PoleFigureUtilities.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include <QtCore/QFile>
 #include <QtCore/QByteArray>
 #include <QtCore/QTextStream>
@@ -52,6 +59,95 @@
 #define WRITE_XYZ_SPHERE_COORD_VTK 0
 #define WRITE_LAMBERT_SQUARES 0
 
+/**
+ * @brief The PoleFigureColorImageImpl class colors a range of rows of a pole figure image from its intensity image
+ */
+class PoleFigureColorImageImpl
+{
+  public:
+    PoleFigureColorImageImpl(double* dataPtr, int width, int height, const QVector<float>& colors, int numColors,
+                             float min, float max, uint32_t* rgbaPtr) :
+      m_DataPtr(dataPtr),
+      m_Width(width),
+      m_Height(height),
+      m_Colors(colors),
+      m_NumColors(numColors),
+      m_Min(min),
+      m_Max(max),
+      m_RgbaPtr(rgbaPtr)
+    {}
+    virtual ~PoleFigureColorImageImpl() {}
+
+    void color(int64_t start, int64_t end) const
+    {
+      int halfWidth = m_Width / 2;
+      int halfHeight = m_Height / 2;
+
+      float xres = 2.0 / (float)(m_Width);
+      float yres = 2.0 / (float)(m_Height);
+      float xtmp, ytmp;
+
+      float r = 0.0, g = 0.0, b = 0.0;
+
+      size_t idx = 0;
+      double value;
+      int bin;
+      for (int64_t y = start; y < end; y++)
+      {
+        for (int64_t x = 0; x < m_Width; x++)
+        {
+          xtmp = float(x - halfWidth) * xres + (xres * 0.5);
+          ytmp = float(y - halfHeight) * yres + (yres * 0.5);
+          idx = (m_Width * y) + x;
+          if( ( xtmp * xtmp + ytmp * ytmp) <= 1.0) // Inside the circle
+          {
+            value = m_DataPtr[y * m_Width + x];
+            value = (value - m_Min) / (m_Max - m_Min);
+            bin = int(value * m_NumColors);
+            if(bin > m_NumColors - 1)
+            {
+              bin = m_NumColors - 1;
+            }
+            if (bin < 0 || bin >= m_Colors.size())
+            {
+              r = 0x00;
+              b = 0x00;
+              g = 0x00;
+            }
+            else
+            {
+              r = m_Colors[3 * bin];
+              g = m_Colors[3 * bin + 1];
+              b = m_Colors[3 * bin + 2];
+            }
+            m_RgbaPtr[idx] = RgbColor::dRgb(r * 255, g * 255, b * 255, 255);
+          }
+          else // Outside the Circle - Set pixel to White
+          {
+            m_RgbaPtr[idx] = 0xFFFFFFFF; // White
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      color(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    double* m_DataPtr;
+    int m_Width;
+    int m_Height;
+    const QVector<float>& m_Colors;
+    int m_NumColors;
+    float m_Min;
+    float m_Max;
+    uint32_t* m_RgbaPtr;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -121,13 +217,6 @@ void PoleFigureUtilities::CreateColorImage(DoubleArrayType* data, PoleFigureConf
   int width = config.imageDim ;
   int height = config.imageDim ;
 
-  int halfWidth = width / 2;
-  int halfHeight = height / 2;
-
-  float xres = 2.0 / (float)(width);
-  float yres = 2.0 / (float)(height);
-  float xtmp, ytmp;
-
   float max = static_cast<float>(config.maxScale);
   float min = static_cast<float>(config.minScale);
 
@@ -139,49 +228,20 @@ void PoleFigureUtilities::CreateColorImage(DoubleArrayType* data, PoleFigureConf
   QVector<float> colors(numColors * 3, 0.0);
   DREAM3DColorTable::GetColorTable(config.numColors, colors);
 
-  float r = 0.0, g = 0.0, b = 0.0;
+  PoleFigureColorImageImpl serial(data->getPointer(0), width, height, colors, numColors, min, max, rgbaPtr);
 
-  double* dataPtr = data->getPointer(0);
-  size_t idx = 0;
-  double value;
-  int bin;
-  for (int64_t y = 0; y < height; y++)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
   {
-    for (int64_t x = 0; x < width; x++)
-    {
-      xtmp = float(x - halfWidth) * xres + (xres * 0.5);
-      ytmp = float(y - halfHeight) * yres + (yres * 0.5);
-      idx = (width * y) + x;
-      if( ( xtmp * xtmp + ytmp * ytmp) <= 1.0) // Inside the circle
-      {
-        value = dataPtr[y * width + x];
-        value = (value - min) / (max - min);
-        bin = int(value * numColors);
-        if(bin > numColors - 1)
-        {
-          bin = numColors - 1;
-        }
-        if (bin < 0 || bin >= colors.size())
-        {
-          r = 0x00;
-          b = 0x00;
-          g = 0x00;
-        }
-        else
-        {
-          r = colors[3 * bin];
-          g = colors[3 * bin + 1];
-          b = colors[3 * bin + 2];
-        }
-        rgbaPtr[idx] = RgbColor::dRgb(r * 255, g * 255, b * 255, 255);
-      }
-      else // Outside the Circle - Set pixel to White
-      {
-        rgbaPtr[idx] = 0xFFFFFFFF; // White
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, height), serial, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    serial.color(0, height);
   }
-
 }
 
 // -----------------------------------------------------------------------------
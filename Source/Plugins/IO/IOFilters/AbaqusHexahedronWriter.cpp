@@ -53,6 +53,130 @@
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/FormattedOutputWriter.hpp"
+
+/**
+ * @brief The AbaqusNodeFormatter class formats the line of one node of the _nodes.inp file
+ */
+class AbaqusNodeFormatter
+{
+  public:
+    AbaqusNodeFormatter(size_t* pDims, float* origin, float* spacing) :
+      m_PDims(pDims),
+      m_Origin(origin),
+      m_Spacing(spacing)
+    {}
+    virtual ~AbaqusNodeFormatter() {}
+
+    void format(size_t node, FormattedOutputBuffer& buffer) const
+    {
+      size_t x = node % m_PDims[0];
+      size_t y = (node / m_PDims[0]) % m_PDims[1];
+      size_t z = node / (m_PDims[0] * m_PDims[1]);
+      buffer.appendUInt(node + 1);
+      buffer.append(", ");
+      buffer.appendFloat(m_Origin[0] + (x * m_Spacing[0]));
+      buffer.append(", ");
+      buffer.appendFloat(m_Origin[1] + (y * m_Spacing[1]));
+      buffer.append(", ");
+      buffer.appendFloat(m_Origin[2] + (z * m_Spacing[2]));
+      buffer.append('\n');
+    }
+
+  private:
+    size_t* m_PDims;
+    float* m_Origin;
+    float* m_Spacing;
+};
+
+/**
+ * @brief The AbaqusElementFormatter class formats the line of one C3D8 element of the _elems.inp file. The 8 node
+ * Ids are listed in the order Abaqus expects for the hexahedron:
+ *
+ *           4-------5
+ *          /|      /|
+ *         6-------7 |
+ *         | 0-----|-1
+ *         |/      |/
+ *         2-------3
+ */
+class AbaqusElementFormatter
+{
+  public:
+    AbaqusElementFormatter(size_t* cDims, size_t* pDims) :
+      m_CDims(cDims),
+      m_PDims(pDims)
+    {}
+    virtual ~AbaqusElementFormatter() {}
+
+    void format(size_t element, FormattedOutputBuffer& buffer) const
+    {
+      size_t x = element % m_CDims[0];
+      size_t y = (element / m_CDims[0]) % m_CDims[1];
+      size_t z = element / (m_CDims[0] * m_CDims[1]);
+      size_t plane = m_PDims[0] * m_PDims[1];
+      size_t n0 = 1 + (plane * z) + (m_PDims[0] * y) + x;
+      size_t n2 = n0 + m_PDims[0];
+      size_t n4 = n0 + plane;
+      size_t n6 = n2 + plane;
+
+      buffer.appendUInt(element + 1);
+      appendNode(n4 + 1, buffer);
+      appendNode(n0 + 1, buffer);
+      appendNode(n0, buffer);
+      appendNode(n4, buffer);
+      appendNode(n6 + 1, buffer);
+      appendNode(n2 + 1, buffer);
+      appendNode(n2, buffer);
+      appendNode(n6, buffer);
+      buffer.append('\n');
+    }
+
+  private:
+    size_t* m_CDims;
+    size_t* m_PDims;
+
+    void appendNode(size_t node, FormattedOutputBuffer& buffer) const
+    {
+      buffer.append(", ");
+      buffer.appendInt(static_cast<int64_t>(node));
+    }
+};
+
+/**
+ * @brief The AbaqusElsetFormatter class formats the element set of one Grain of the _elset.inp file. The elements
+ * of each Grain are listed in ascending order, 16 per line.
+ */
+class AbaqusElsetFormatter
+{
+  public:
+    AbaqusElsetFormatter(const std::vector<size_t>& offsets, const std::vector<size_t>& elements) :
+      m_Offsets(offsets),
+      m_Elements(elements)
+    {}
+    virtual ~AbaqusElsetFormatter() {}
+
+    void format(size_t grainIndex, FormattedOutputBuffer& buffer) const
+    {
+      buffer.append("\n*Elset, elset=Grain");
+      buffer.appendInt(static_cast<int64_t>(grainIndex + 1));
+      buffer.append("_set\n");
+      size_t first = m_Offsets[grainIndex];
+      size_t last = m_Offsets[grainIndex + 1];
+      for (size_t i = first; i < last; i++)
+      {
+        if (i != first) // no comma at start
+        {
+          buffer.append((i - first) % 16 ? ", " : ",\n"); // 16 per line
+        }
+        buffer.appendUInt(m_Elements[i] + 1);
+      }
+    }
+
+  private:
+    const std::vector<size_t>& m_Offsets;
+    const std::vector<size_t>& m_Elements;
+};
 
 // Include the MOC generated file for this class
 #include "moc_AbaqusHexahedronWriter.cpp"
@@ -310,13 +434,8 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   QTextStream ss(&buf);
 
   size_t pDims[3] = { cDims[0] + 1, cDims[1] + 1, cDims[2] + 1 };
-  size_t nodeIndex = 1;
   size_t totalPoints = pDims[0] * pDims[1] * pDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if (increment == 0)  // check to prevent divide by 0
-  {
-    increment = 1;
-  }
+  const size_t k_NodesPerWrite = 1048576;
 
   int32_t err = 0;
   FILE* f = NULL;
@@ -329,36 +448,30 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   fprintf(f, "** Generated by : %s\n", SIMPLib::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Node\n");
 
-  for (size_t z = 0; z < pDims[2]; z++)
+  AbaqusNodeFormatter formatter(pDims, origin, spacing);
+  FormattedOutputWriter<AbaqusNodeFormatter> writer(formatter);
+  for (size_t nodeIndex = 0; nodeIndex < totalPoints; nodeIndex += k_NodesPerWrite)
   {
-    for (size_t y = 0; y < pDims[1]; y++)
+    size_t nodeEnd = (totalPoints - nodeIndex > k_NodesPerWrite) ? nodeIndex + k_NodesPerWrite : totalPoints;
+    if (writer.write(f, nodeIndex, nodeEnd) == false)
+    {
+      fclose(f);
+      return -1;
+    }
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if (currentMillis - millis > 1000)
     {
-      for (size_t x = 0; x < pDims[0]; x++)
+      buf.clear();
+      ss << getMessagePrefix() << " Writing Nodes (File 1/5) " << static_cast<int>((float)(nodeEnd) / (float)(totalPoints) * 100) << "% Completed ";
+      timeDiff = ((float)nodeEnd / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalPoints - nodeEnd) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(getHumanLabel(), buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+      if (getCancel() == true)   // Filter has been cancelled
       {
-        float xCoord = origin[0] + (x * spacing[0]);
-        float yCoord = origin[1] + (y * spacing[1]);
-        float zCoord = origin[2] + (z * spacing[2]);
-        fprintf(f, "%lu, %f, %f, %f\n", nodeIndex, xCoord, yCoord, zCoord);
-        if (nodeIndex % increment == 0)
-        {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if (currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << getMessagePrefix() << " Writing Nodes (File 1/5) " << static_cast<int>((float)(nodeIndex) / (float)(totalPoints) * 100) << "% Completed ";
-            timeDiff = ((float)nodeIndex / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - nodeIndex) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(getHumanLabel(), buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if (getCancel() == true)   // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
-        }
-        ++nodeIndex;
+        fclose(f);
+        return 1;
       }
     }
   }
@@ -386,11 +499,7 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
   QString buf;
   QTextStream ss(&buf);
   size_t totalPoints = cDims[0] * cDims[1] * cDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if (increment == 0)  // check to prevent divide by 0
-  {
-    increment = 1;
-  }
+  const size_t k_ElementsPerWrite = 524288;
 
   int32_t err = 0;
   FILE* f = NULL;
@@ -400,40 +509,33 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
     return -1;
   }
 
-  // Get a typedef to shorten up the printf codes
-  typedef long long int _lli_t_;
-
-  size_t index = 1;
   fprintf(f, "** Generated by : %s\n", SIMPLib::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Element, type=C3D8\n");
-  for (size_t z = 0; z < cDims[2]; z++)
+
+  AbaqusElementFormatter formatter(cDims, pDims);
+  FormattedOutputWriter<AbaqusElementFormatter> writer(formatter);
+  for (size_t index = 0; index < totalPoints; index += k_ElementsPerWrite)
   {
-    for (size_t y = 0; y < cDims[1]; y++)
+    size_t indexEnd = (totalPoints - index > k_ElementsPerWrite) ? index + k_ElementsPerWrite : totalPoints;
+    if (writer.write(f, index, indexEnd) == false)
     {
-      for (size_t x = 0; x < cDims[0]; x++)
+      fclose(f);
+      return -1;
+    }
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if (currentMillis - millis > 1000)
+    {
+      buf.clear();
+      ss << getMessagePrefix() << " Writing Elements (File 2/5) " << static_cast<int>((float)(indexEnd) / (float)(totalPoints) * 100) << "% Completed ";
+      timeDiff = ((float)indexEnd / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalPoints - indexEnd) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(getHumanLabel(), buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+      if (getCancel() == true)   // Filter has been cancelled
       {
-        std::vector<int64_t> nodeId = getNodeIds(x, y, z, pDims);
-        fprintf(f, "%llu, %lld, %lld, %lld, %lld, %lld, %lld, %lld, %lld\n", (_lli_t_)index, (_lli_t_)nodeId[5], (_lli_t_)nodeId[1], (_lli_t_)nodeId[0], (_lli_t_)nodeId[4], (_lli_t_)nodeId[7], (_lli_t_)nodeId[3], (_lli_t_)nodeId[2], (_lli_t_)nodeId[6]);
-        if (index % increment == 0)
-        {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if (currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << getMessagePrefix() << " Writing Elements (File 2/5) " << static_cast<int>((float)(index) / (float)(totalPoints) * 100) << "% Completed ";
-            timeDiff = ((float)index / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - index) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(getHumanLabel(), buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if (getCancel() == true)   // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
-        }
-        ++index;
+        fclose(f);
+        return 1;
       }
     }
   }
@@ -484,57 +586,58 @@ int32_t AbaqusHexahedronWriter::writeElset(const QList<QString>& fileNames, size
     }
   }
 
-  int32_t increment = static_cast<int32_t>(maxGrainId * 0.1f);
+  // Bucket the elements by Grain so every set is gathered in one pass over the volume
+  std::vector<size_t> offsets(static_cast<size_t>(maxGrainId) + 2, 0);
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    if (m_FeatureIds[i] > 0) { offsets[m_FeatureIds[i] + 1]++; }
+  }
+  for (size_t g = 1; g < offsets.size(); g++)
+  {
+    offsets[g] += offsets[g - 1];
+  }
+  std::vector<size_t> elements(offsets.back(), 0);
+  std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    if (m_FeatureIds[i] > 0) { elements[next[m_FeatureIds[i]]++] = i; }
+  }
+  // Grain 0 is not written, so drop its (empty) entry and index the sets by Grain - 1
+  offsets.erase(offsets.begin());
+
+  size_t numGrains = static_cast<size_t>(maxGrainId);
+  size_t increment = static_cast<size_t>(numGrains * 0.1f);
   if (increment == 0)  // check to prevent divide by 0
   {
     increment = 1;
   }
 
-  int32_t voxelId = 1;
-  while (voxelId <= maxGrainId)
+  AbaqusElsetFormatter formatter(offsets, elements);
+  FormattedOutputWriter<AbaqusElsetFormatter> writer(formatter, 16);
+  for (size_t grain = 0; grain < numGrains; grain += increment)
   {
-    size_t elementPerLine = 0;
-    fprintf(f, "\n*Elset, elset=Grain%d_set\n", voxelId);
-
-    for (size_t i = 0; i < totalPoints + 1; i++)
+    size_t grainEnd = (numGrains - grain > increment) ? grain + increment : numGrains;
+    if (writer.write(f, grain, grainEnd) == false)
     {
-      if (m_FeatureIds[i] == voxelId)
-      {
-        if (elementPerLine != 0) // no comma at start
-        {
-          if (elementPerLine % 16) // 16 per line
-          {
-            fprintf(f, ", ");
-          }
-          else
-          {
-            fprintf(f, ",\n");
-          }
-        }
-        fprintf(f, "%lu", i + 1);
-        elementPerLine++;
-      }
+      fclose(f);
+      return -1;
     }
-    if (voxelId % increment == 0)
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if (currentMillis - millis > 1000)
     {
-      currentMillis = QDateTime::currentMSecsSinceEpoch();
-      if (currentMillis - millis > 1000)
+      buf.clear();
+      ss << getMessagePrefix() << " Writing Element Sets (File 4/5) " << static_cast<int>((float)(grainEnd) / (float)(numGrains) * 100) << "% Completed ";
+      timeDiff = ((float)grainEnd / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(numGrains - grainEnd) / timeDiff;
+      ss <<  " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(getHumanLabel(), buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+      if (getCancel() == true)   // Filter has been cancelled
       {
-        buf.clear();
-        ss << getMessagePrefix() << " Writing Element Sets (File 4/5) " << static_cast<int>((float)(voxelId) / (float)(maxGrainId) * 100) << "% Completed ";
-        timeDiff = ((float)voxelId / (float)(currentMillis - startMillis));
-        estimatedTime = (float)(maxGrainId - voxelId) / timeDiff;
-        ss <<  " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-        notifyStatusMessage(getHumanLabel(), buf);
-        millis = QDateTime::currentMSecsSinceEpoch();
-        if (getCancel() == true)   // Filter has been cancelled
-        {
-          fclose(f);
-          return 1;
-        }
+        fclose(f);
+        return 1;
       }
     }
-    voxelId++;
   }
   fprintf(f, "\n**\n** ----------------------------------------------------------------\n**\n");
 
@@ -618,39 +721,6 @@ int32_t AbaqusHexahedronWriter::writeSects(const QString& file, size_t totalPoin
   return err;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, size_t* pDims)
-{
-  std::vector<int64_t> nodeId(8, 0);
-
-  nodeId[0] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + x);
-  nodeId[1] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + (x + 1));
-  nodeId[2] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * (y + 1)) + x);
-  nodeId[3] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * (y + 1)) + (x + 1));
-
-  nodeId[4] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * (z + 1)) + (pDims[0] * y) + x);
-  nodeId[5] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * (z + 1)) + (pDims[0] * y) + (x + 1));
-  nodeId[6] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * (z + 1)) + (pDims[0] * (y + 1)) + x);
-  nodeId[7] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * (z + 1)) + (pDims[0] * (y + 1)) + (x + 1));
-
-  if (0)
-  {
-    printf("           %lld-------%lld  \n", static_cast<long long int>(nodeId[4]), static_cast<long long int>(nodeId[5]) );
-    printf("            /|        /|   \n");
-    printf("           / |       / |   \n");
-    printf("          /  |      /  |   \n");
-    printf("       %lld--------%lld  |   \n", static_cast<long long int>(nodeId[6]), static_cast<long long int>(nodeId[7]));
-    printf("         |   |      |  |   \n");
-    printf("         | %lld------|-%lld  \n", static_cast<long long int>(nodeId[0]), static_cast<long long int>(nodeId[1]));
-    printf("         |  /       | /    \n");
-    printf("         | /        |/     \n");
-    printf("        %lld--------%lld     \n", static_cast<long long int>(nodeId[2]), static_cast<long long int>(nodeId[3]));
-  }
-  return nodeId;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
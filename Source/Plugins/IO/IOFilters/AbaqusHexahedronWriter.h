@@ -197,17 +197,6 @@ class AbaqusHexahedronWriter : public AbstractFilter
      */
     int32_t writeMaster(const QString& file);
 
-    /**
-     * @brief getNodeIds Returns a vector of node Ids for a given
-     * set of dimensional indices
-     * @param x X coordinate
-     * @param y Y coordinate
-     * @param z Z coordinate
-     * @param pDims Dimensions of incoming volume
-     * @return  Vector of node Ids
-     */
-    std::vector<int64_t> getNodeIds(size_t x, size_t y, size_t z, size_t* pDims);
-
     /**
      * @brief deleteFile Removes written files
      * @param fileNames QList of output file names
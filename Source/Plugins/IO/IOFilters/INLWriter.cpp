@@ -52,6 +52,73 @@
 #include "EbsdLib/TSL/AngConstants.h"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/FormattedOutputWriter.hpp"
+
+/**
+ * @brief The INLCellFormatter class formats the line of one cell of the INL file
+ */
+class INLCellFormatter
+{
+  public:
+    INLCellFormatter(size_t* dims, float* res, float* origin, float* eulers, int32_t* featureIds, int32_t* phases, unsigned int* crystalStructures) :
+      m_Dims(dims),
+      m_Res(res),
+      m_Origin(origin),
+      m_CellEulerAngles(eulers),
+      m_FeatureIds(featureIds),
+      m_CellPhases(phases),
+      m_CrystalStructures(crystalStructures)
+    {}
+    virtual ~INLCellFormatter() {}
+
+    void format(size_t index, FormattedOutputBuffer& buffer) const
+    {
+      size_t x = index % m_Dims[0];
+      size_t y = (index / m_Dims[0]) % m_Dims[1];
+      size_t z = index / (m_Dims[0] * m_Dims[1]);
+      int32_t phaseId = m_CellPhases[index];
+      uint32_t symmetry = Ebsd::Ang::PhaseSymmetry::UnknownSymmetry;
+      if (phaseId > 0)
+      {
+        if (m_CrystalStructures[phaseId] == Ebsd::CrystalStructure::Cubic_High)
+        {
+          symmetry = Ebsd::Ang::PhaseSymmetry::Cubic;
+        }
+        else if (m_CrystalStructures[phaseId] == Ebsd::CrystalStructure::Hexagonal_High)
+        {
+          symmetry = Ebsd::Ang::PhaseSymmetry::DiHexagonal;
+        }
+      }
+
+      buffer.appendFloat(m_CellEulerAngles[index * 3]);
+      buffer.append(' ');
+      buffer.appendFloat(m_CellEulerAngles[index * 3 + 1]);
+      buffer.append(' ');
+      buffer.appendFloat(m_CellEulerAngles[index * 3 + 2]);
+      buffer.append(' ');
+      buffer.appendFloat(m_Origin[0] + (x * m_Res[0]));
+      buffer.append(' ');
+      buffer.appendFloat(m_Origin[1] + (y * m_Res[1]));
+      buffer.append(' ');
+      buffer.appendFloat(m_Origin[2] + (z * m_Res[2]));
+      buffer.append(' ');
+      buffer.appendInt(m_FeatureIds[index]);
+      buffer.append(' ');
+      buffer.appendInt(phaseId);
+      buffer.append(' ');
+      buffer.appendInt(static_cast<int32_t>(symmetry));
+      buffer.append("\r\n");
+    }
+
+  private:
+    size_t* m_Dims;
+    float* m_Res;
+    float* m_Origin;
+    float* m_CellEulerAngles;
+    int32_t* m_FeatureIds;
+    int32_t* m_CellPhases;
+    unsigned int* m_CrystalStructures;
+};
 
 // Include the MOC generated file for this class
 #include "moc_INLWriter.cpp"
@@ -384,51 +451,15 @@ int32_t INLWriter::writeFile()
 
   fprintf(f, "# phi1 PHI phi2 x y z FeatureId PhaseId Symmetry\r\n");
 
-  float phi1 = 0.0f, phi = 0.0f, phi2 = 0.0f;
-  float xPos = 0.0f, yPos = 0.0f, zPos = 0.0f;
-  int32_t featureId = 0;
-  int32_t phaseId = 0;
-
-  size_t index = 0;
-  for (size_t z = 0; z < dims[2]; ++z)
+  INLCellFormatter formatter(dims, res, origin, m_CellEulerAngles, m_FeatureIds, m_CellPhases, m_CrystalStructures);
+  FormattedOutputWriter<INLCellFormatter> writer(formatter);
+  if (writer.write(f, 0, totalPoints) == false)
   {
-    for (size_t y = 0; y < dims[1]; ++y)
-    {
-      for (size_t x = 0; x < dims[0]; ++x)
-      {
-        index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
-        phi1 = m_CellEulerAngles[index * 3];
-        phi = m_CellEulerAngles[index * 3 + 1];
-        phi2 = m_CellEulerAngles[index * 3 + 2];
-        xPos = origin[0] + (x * res[0]);
-        yPos = origin[1] + (y * res[1]);
-        zPos = origin[2] + (z * res[2]);
-        featureId = m_FeatureIds[index];
-        phaseId = m_CellPhases[index];
-        symmetry = m_CrystalStructures[phaseId];
-        if (phaseId > 0)
-        {
-          if (symmetry == Ebsd::CrystalStructure::Cubic_High)
-          {
-            symmetry = Ebsd::Ang::PhaseSymmetry::Cubic;
-          }
-          else if (symmetry == Ebsd::CrystalStructure::Hexagonal_High)
-          {
-            symmetry = Ebsd::Ang::PhaseSymmetry::DiHexagonal;
-          }
-          else
-          {
-            symmetry = Ebsd::Ang::PhaseSymmetry::UnknownSymmetry;
-          }
-        }
-        else
-        {
-          symmetry = Ebsd::Ang::PhaseSymmetry::UnknownSymmetry;
-        }
-
-        fprintf(f, "%f %f %f %f %f %f %d %d %d\r\n", phi1, phi, phi2, xPos, yPos, zPos, featureId, phaseId, symmetry);
-      }
-    }
+    fclose(f);
+    QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-1);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return -1;
   }
 
   fclose(f);
@@ -40,6 +40,13 @@
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/ScopedFileMonitor.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -52,6 +59,8 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/FeatureFaceBuckets.hpp"
+#include "IO/IOFilters/util/StlFeatureWriter.hpp"
 
 // Include the MOC generated file for this class
 #include "moc_NodesTrianglesToStl.cpp"
@@ -285,134 +294,68 @@ void NodesTrianglesToStl::execute()
   DataArray<int32_t>::Pointer faceLabelPtr = DataArray<int32_t>::CreateArray(nTriangles, DREAM3D::FaceData::SurfaceMeshFaceLabels);
   int32_t* faceLabels = faceLabelPtr->getPointer(0);
 
-  // Store all the unique Spins
-  QSet<int> uniqueSpins;
   for (int i = 0; i < nTriangles; i++)
   {
     // Read from the Input Triangles Temp File
     nread = fscanf(triFile, "%d %d %d %d %d %d %d %d %d", tData, tData + 1, tData + 2, tData + 3, tData + 4, tData + 5, tData + 6, tData + 7, tData + 8);
-    triangles[i * 3] = tData[1];
-    triangles[i * 3 + 1] = tData[2];
-    triangles[i * 3 + 2] = tData[3];
+    // Store the true indices of the 3 nodes
+    triangles[i * 3] = nodeIdToIndex.value(tData[1]);
+    triangles[i * 3 + 1] = nodeIdToIndex.value(tData[2]);
+    triangles[i * 3 + 2] = nodeIdToIndex.value(tData[3]);
     faceLabels[i * 2] = tData[7];
     faceLabels[i * 2 + 1] = tData[8];
-    uniqueSpins.insert(tData[7]);
-    uniqueSpins.insert(tData[8]);
   }
 
+  // Bucket the triangles by Feature in one pass instead of scanning every triangle for every Feature
+  FeatureFaceBuckets::Pointer buckets = FeatureFaceBuckets::New();
+  buckets->generate(faceLabels, nTriangles);
+  size_t numFeatures = buckets->getNumberOfFeatures();
 
-  unsigned char data[50];
-  float* normal = (float*)data;
-  float* vert1 = (float*)(data + 12);
-  float* vert2 = (float*)(data + 24);
-  float* vert3 = (float*)(data + 36);
-  uint16_t* attrByteCount = (uint16_t*)(data + 48);
-  *attrByteCount = 0;
-
-  size_t totalWritten = 0;
-  float u[3], w[3];
-  float length;
-
-  int spin = 0;
-  int triCount = 0;
-
-  //Loop over the unique Spins
-  for (QSet<int>::iterator spinIter = uniqueSpins.begin(); spinIter != uniqueSpins.end(); ++spinIter )
+  QVector<QString> fileNames(numFeatures);
+  QVector<QString> headers(numFeatures);
+  for (size_t b = 0; b < numFeatures; b++)
   {
-    spin = *spinIter;
-
-    // Generate the output file name
-
-    QString filename = getOutputStlDirectory() + "/" + getOutputStlPrefix() + QString::number(spin) + ".stl";
-    FILE* f = fopen(filename.toLatin1().data(), "wb");
-    ScopedFileMonitor fPtr(f);
+    int spin = buckets->getFeatureId(b);
+    fileNames[b] = getOutputStlDirectory() + "/" + getOutputStlPrefix() + QString::number(spin) + ".stl";
+    headers[b] = "DREAM3D Generated For Feature ID " + QString::number(spin);
+  }
 
-    {
-      QString ss = QObject::tr("Writing STL for Feature Id %1").arg(spin);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    }
+  {
+    QString ss = QObject::tr("Writing STL files for %1 Features").arg(numFeatures);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+  }
 
-    {
-      QString ss = "DREAM3D Generated For Feature ID " + QString::number(spin);
-      int err = writeHeader(f, ss, 0);
-      if(err < 0)
-      {
-        QString ss = QObject::tr("Error Writing STL header").arg(spin);
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      }
-    }
-    triCount = 0; // Reset this to Zero. Increment for every triangle written
+  std::vector<int32_t> errors(numFeatures + 1, 0);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures),
+                      StlFeatureWriter(nodes, triangles, buckets.get(), &fileNames, &headers, &(errors.front())), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    StlFeatureWriter serial(nodes, triangles, buckets.get(), &fileNames, &headers, &(errors.front()));
+    serial.generate(0, numFeatures);
+  }
 
-    // Loop over all the triangles for this spin
-    for(int t = 0; t < nTriangles; ++t)
+  for (size_t b = 0; b < numFeatures; b++)
+  {
+    if (errors[b] == -1)
     {
-      // Get the true indices of the 3 nodes
-      int nId0 = nodeIdToIndex[triangles[t * 3]];
-      int nId1 = nodeIdToIndex[triangles[t * 3 + 1]];
-      int nId2 = nodeIdToIndex[triangles[t * 3 + 2]];
-
-      vert1[0] = static_cast<float>(nodes[nId0 * 3]);
-      vert1[1] = static_cast<float>(nodes[nId0 * 3 + 1]);
-      vert1[2] = static_cast<float>(nodes[nId0 * 3 + 2]);
-
-      if (faceLabels[t * 2] == spin)
-      {
-        // winding = 0; // 0 = Write it using forward spin
-      }
-      else if (faceLabels[t * 2 + 1] == spin)
-      {
-        //winding = 1; // Write it using backward spin
-        // Switch the 2 node indices
-        int temp = nId1;
-        nId1 = nId2;
-        nId2 = temp;
-      }
-      else
-      {
-        continue; // We do not match either spin so move to the next triangle
-      }
-
-      vert2[0] = static_cast<float>(nodes[nId1 * 3]);
-      vert2[1] = static_cast<float>(nodes[nId1 * 3 + 1]);
-      vert2[2] = static_cast<float>(nodes[nId1 * 3 + 2]);
-
-      vert3[0] = static_cast<float>(nodes[nId2 * 3]);
-      vert3[1] = static_cast<float>(nodes[nId2 * 3 + 1]);
-      vert3[2] = static_cast<float>(nodes[nId2 * 3 + 2]);
-
-      //
-      // Compute the normal
-      u[0] = vert2[0] - vert1[0];
-      u[1] = vert2[1] - vert1[1];
-      u[2] = vert2[2] - vert1[2];
-
-      w[0] = vert3[0] - vert1[0];
-      w[1] = vert3[1] - vert1[1];
-      w[2] = vert3[2] - vert1[2];
-
-      normal[0] = u[1] * w[2] - u[2] * w[1];
-      normal[1] = u[2] * w[0] - u[0] * w[2];
-      normal[2] = u[0] * w[1] - u[1] * w[0];
-
-      length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
-      normal[0] = normal[0] / length;
-      normal[1] = normal[1] / length;
-      normal[2] = normal[2] / length;
-
-      totalWritten = fwrite(data, 1, 50, f);
-      if (totalWritten != 50)
-      {
-
-        QString ss = QObject::tr("Error Writing STL File. Not enough elements written for feature id %1 Wrote %2 of 50.").arg(spin).arg(totalWritten);
-        notifyErrorMessage(getHumanLabel(), ss, -1201);
-      }
-      triCount++;
+      QString ss = QObject::tr("Error opening STL file '%1' for writing").arg(fileNames[b]);
+      setErrorCondition(-1200);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
     }
-    int err = writeNumTrianglesToFile(filename, triCount);
-    if(err < 0)
+    else if (errors[b] < 0)
     {
-      QString ss = QObject::tr("Error writing number of Triangles to STL file");
-      notifyErrorMessage(getHumanLabel(), ss, -1201);
+      QString ss = QObject::tr("Error Writing STL File. Not enough elements written for feature id %1").arg(buckets->getFeatureId(b));
+      setErrorCondition(-1201);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
     }
   }
 
@@ -423,46 +366,6 @@ void NodesTrianglesToStl::execute()
 }
 
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int NodesTrianglesToStl::writeHeader(FILE* f, const QString& header, int triCount)
-{
-  if (NULL == f)
-  {
-    return -1;
-  }
-  char h[80];
-  size_t headlength = 80;
-  if(header.length() < 80) { headlength = header.length(); }
-  ::memset(h, 0, 80);
-  ::memcpy(h, header.data(), headlength);
-  // Return the number of bytes written - which should be 80
-  fwrite(h, 1, 80, f);
-  fwrite(&triCount, 1, 4, f);
-  return 0;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int NodesTrianglesToStl::writeNumTrianglesToFile(const QString& filename, int triCount)
-{
-  // We need to update the number of triangles in the file
-  int err = 0;
-
-  FILE* out = fopen(filename.toLatin1().data(), "r+b");
-  fseek(out, 80L, SEEK_SET);
-  fwrite( (char*)(&triCount), 1, 4, out);
-  fclose(out);
-
-  return err;
-}
-
-
-
-
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -164,9 +164,6 @@ class NodesTrianglesToStl : public AbstractFilter
     int writeASCIIPointData(const QString& NodesFile, FILE* vtkFile, int nNodes, bool conformalMesh);
 
   private:
-    int writeHeader(FILE* f, const QString& header, int triCount);
-    int writeNumTrianglesToFile(const QString& filename, int triCount);
-
     NodesTrianglesToStl(const NodesTrianglesToStl&); // Copy Constructor Not Implemented
     void operator=(const NodesTrianglesToStl&); // Operator '=' Not Implemented
 };
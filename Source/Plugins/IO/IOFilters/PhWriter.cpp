@@ -47,6 +47,28 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/FormattedOutputWriter.hpp"
+
+/**
+ * @brief The PhFeatureIdFormatter class formats the line of one cell of the Ph file
+ */
+class PhFeatureIdFormatter
+{
+  public:
+    PhFeatureIdFormatter(int32_t* featureIds) :
+      m_FeatureIds(featureIds)
+    {}
+    virtual ~PhFeatureIdFormatter() {}
+
+    void format(size_t index, FormattedOutputBuffer& buffer) const
+    {
+      buffer.appendInt(m_FeatureIds[index]);
+      buffer.append('\n');
+    }
+
+  private:
+    int32_t* m_FeatureIds;
+};
 
 // Include the MOC generated file for this class
 #include "moc_PhWriter.cpp"
@@ -209,9 +231,8 @@ int32_t PhWriter::writeFile()
     return -1;
   }
 
-  std::ofstream outfile;
-  outfile.open(getOutputFile().toLatin1().data(), std::ios_base::binary);
-  if (!outfile)
+  FILE* f = fopen(getOutputFile().toLatin1().data(), "wb");
+  if (NULL == f)
   {
     QString ss = QObject::tr("Error opening output file '%1'").arg(getOutputFile());
     setErrorCondition(-100);
@@ -236,20 +257,21 @@ int32_t PhWriter::writeFile()
     }
   }
 
-  // Buffer the output with 4096 Bytes which is typically the size of a "Block" on a
-  // modern Hard Drive. This should speed up the writes considerably
-  char buffer[4096];
-  outfile.rdbuf()->pubsetbuf(buffer, 4096);
-
-  outfile << "     " << dims[0] << "     " << dims[1] << "     " << dims[2] << "\n";
-  outfile << "\'DREAM3\'              52.00  1.000  1.0       " << features << "\n";
-  outfile << " 0.000 0.000 0.000          0        \n"; // << features << endl;
+  fprintf(f, "     %lld     %lld     %lld\n", static_cast<long long int>(dims[0]), static_cast<long long int>(dims[1]), static_cast<long long int>(dims[2]));
+  fprintf(f, "\'DREAM3\'              52.00  1.000  1.0       %d\n", features);
+  fprintf(f, " 0.000 0.000 0.000          0        \n");
 
-  for (size_t k = 0; k < totalpoints; k++)
+  PhFeatureIdFormatter formatter(m_FeatureIds);
+  FormattedOutputWriter<PhFeatureIdFormatter> writer(formatter);
+  bool written = writer.write(f, 0, totalpoints);
+  fclose(f);
+  if (written == false)
   {
-    outfile << m_FeatureIds[k] << '\n';
+    QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+    setErrorCondition(-101);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return getErrorCondition();
   }
-  outfile.close();
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Writing Ph File Complete");
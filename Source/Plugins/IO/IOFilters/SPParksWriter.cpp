@@ -49,6 +49,30 @@
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/FormattedOutputWriter.hpp"
+
+/**
+ * @brief The SPParksSiteFormatter class formats the line of one site of the SPParks file
+ */
+class SPParksSiteFormatter
+{
+  public:
+    SPParksSiteFormatter(int32_t* featureIds) :
+      m_FeatureIds(featureIds)
+    {}
+    virtual ~SPParksSiteFormatter() {}
+
+    void format(size_t index, FormattedOutputBuffer& buffer) const
+    {
+      buffer.appendUInt(index + 1);
+      buffer.append(' ');
+      buffer.appendInt(m_FeatureIds[index]);
+      buffer.append('\n');
+    }
+
+  private:
+    int32_t* m_FeatureIds;
+};
 
 // Include the MOC generated file for this class
 #include "moc_SPParksWriter.cpp"
@@ -195,9 +219,8 @@ int32_t SPParksWriter::writeFile()
 
   size_t totalpoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
 
-  std::ofstream outfile;
-  outfile.open(getOutputFile().toLatin1().data(), std::ios_base::binary | std::ios_base::app);
-  if (!outfile)
+  FILE* f = fopen(getOutputFile().toLatin1().data(), "ab");
+  if (NULL == f)
   {
     QString ss = QObject::tr("Error opening output file '%1'").arg(getOutputFile());
     setErrorCondition(-100);
@@ -211,38 +234,35 @@ int32_t SPParksWriter::writeFile()
   qint64 estimatedTime = 0;
   float timeDiff = 0.0f;
 
-  int64_t increment = static_cast<int64_t>(totalpoints * 0.01f);
-  size_t count = 0;
+  const size_t k_SitesPerWrite = 1048576;
   QString buf;
   QTextStream ss(&buf);
-  // Buffer the output with 4096 Bytes which is typically the size of a "Block" on a
-  // modern Hard Drive. This should speed up the writes considerably
-  char buffer[4096];
-  outfile.rdbuf()->pubsetbuf(buffer, 4096);
-  for (size_t k = 0; k < totalpoints; k++)
+
+  SPParksSiteFormatter formatter(m_FeatureIds);
+  FormattedOutputWriter<SPParksSiteFormatter> writer(formatter);
+  for (size_t k = 0; k < totalpoints; k += k_SitesPerWrite)
   {
-    if (count % increment == 0)
+    size_t kEnd = (totalpoints - k > k_SitesPerWrite) ? k + k_SitesPerWrite : totalpoints;
+    if (writer.write(f, k, kEnd) == false)
     {
-      currentMillis = QDateTime::currentMSecsSinceEpoch();
-      if (currentMillis - millis > 1000)
-      {
-        buf.clear();
-        ss << getMessagePrefix() << " " << static_cast<int>((float)(k) / (float)(totalpoints) * 100) << " % Completed ";
-        timeDiff = ((float)k / (float)(currentMillis - startMillis));
-        estimatedTime = (float)(totalpoints - k) / timeDiff;
-        ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-        notifyStatusMessage(getHumanLabel(),  buf );
-        millis = QDateTime::currentMSecsSinceEpoch();
-      }
+      fclose(f);
+      setErrorCondition(-101);
+      notifyErrorMessage(getHumanLabel(), QObject::tr("Error writing output file '%1'").arg(getOutputFile()), getErrorCondition());
+      return getErrorCondition();
+    }
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if (currentMillis - millis > 1000)
+    {
+      buf.clear();
+      ss << getMessagePrefix() << " " << static_cast<int>((float)(kEnd) / (float)(totalpoints) * 100) << " % Completed ";
+      timeDiff = ((float)kEnd / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalpoints - kEnd) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(getHumanLabel(),  buf );
+      millis = QDateTime::currentMSecsSinceEpoch();
     }
-    count++;
-//    double temp0 = 0.0;
-//    double temp1 = 0.0;
-    outfile << k + 1 << " " << m_FeatureIds[k]
-            /* << " " << temp0 << " " << temp1 */
-            << "\n";
   }
-  outfile.close();
+  fclose(f);
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -78,6 +78,10 @@ endforeach()
 #-------------
 # These are files that need to be compiled into DREAM3DLib but are NOT filters
 ADD_DREAM3D_SUPPORT_HEADER_SUBDIR(${IO_SOURCE_DIR} ${_filterGroupName} GenericDataParser.hpp util)
+ADD_DREAM3D_SUPPORT_HEADER_SUBDIR(${IO_SOURCE_DIR} ${_filterGroupName} FeatureFaceBuckets.hpp util)
+ADD_DREAM3D_SUPPORT_HEADER_SUBDIR(${IO_SOURCE_DIR} ${_filterGroupName} StlFeatureWriter.hpp util)
+ADD_DREAM3D_SUPPORT_HEADER_SUBDIR(${IO_SOURCE_DIR} ${_filterGroupName} FormattedOutputWriter.hpp util)
+ADD_DREAM3D_SUPPORT_HEADER_SUBDIR(${IO_SOURCE_DIR} ${_filterGroupName} GBCDPoleFigureRenderer.hpp util)
 
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
@@ -51,6 +51,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/GBCDPoleFigureRenderer.hpp"
 
 // Include the MOC generated file for this class
 #include "moc_VisualizeGBCDGMT.cpp"
@@ -249,89 +250,17 @@ void VisualizeGBCDGMT::execute()
     return;
   }
 
-  FloatArrayType::Pointer gbcdDeltasArray = FloatArrayType::CreateArray(5, "GBCDDeltas");
-  gbcdDeltasArray->initializeWithZeros();
-
-  FloatArrayType::Pointer gbcdLimitsArray = FloatArrayType::CreateArray(10, "GBCDLimits");
-  gbcdLimitsArray->initializeWithZeros();
-
-  Int32ArrayType::Pointer gbcdSizesArray = Int32ArrayType::CreateArray(5, "GBCDSizes");
-  gbcdSizesArray->initializeWithZeros();
-
-  float* gbcdDeltas = gbcdDeltasArray->getPointer(0);
-  int32_t* gbcdSizes = gbcdSizesArray->getPointer(0);
-  float* gbcdLimits = gbcdLimitsArray->getPointer(0);
-
-  // Original Ranges from Dave R.
-  //m_GBCDlimits[0] = 0.0f;
-  //m_GBCDlimits[1] = cosf(1.0f*m_pi);
-  //m_GBCDlimits[2] = 0.0f;
-  //m_GBCDlimits[3] = 0.0f;
-  //m_GBCDlimits[4] = cosf(1.0f*m_pi);
-  //m_GBCDlimits[5] = 2.0f*m_pi;
-  //m_GBCDlimits[6] = cosf(0.0f);
-  //m_GBCDlimits[7] = 2.0f*m_pi;
-  //m_GBCDlimits[8] = 2.0f*m_pi;
-  //m_GBCDlimits[9] = cosf(0.0f);
-
-  // Greg R. Ranges
-  gbcdLimits[0] = 0.0f;
-  gbcdLimits[1] = 0.0f;
-  gbcdLimits[2] = 0.0f;
-  gbcdLimits[3] = -sqrtf(SIMPLib::Constants::k_Pi / 2.0f);
-  gbcdLimits[4] = -sqrtf(SIMPLib::Constants::k_Pi / 2.0f);
-  gbcdLimits[5] = SIMPLib::Constants::k_Pi / 2.0f;
-  gbcdLimits[6] = 1.0f;
-  gbcdLimits[7] = SIMPLib::Constants::k_Pi / 2.0f;
-  gbcdLimits[8] = sqrtf(SIMPLib::Constants::k_Pi / 2.0f);
-  gbcdLimits[9] = sqrtf(SIMPLib::Constants::k_Pi / 2.0f);
-
   // get num components of GBCD
   QVector<size_t> cDims = m_GBCDPtr.lock()->getComponentDimensions();
-
-  gbcdSizes[0] = cDims[0];
-  gbcdSizes[1] = cDims[1];
-  gbcdSizes[2] = cDims[2];
-  gbcdSizes[3] = cDims[3];
-  gbcdSizes[4] = cDims[4];
-
-  gbcdDeltas[0] = (gbcdLimits[5] - gbcdLimits[0]) / float(gbcdSizes[0]);
-  gbcdDeltas[1] = (gbcdLimits[6] - gbcdLimits[1]) / float(gbcdSizes[1]);
-  gbcdDeltas[2] = (gbcdLimits[7] - gbcdLimits[2]) / float(gbcdSizes[2]);
-  gbcdDeltas[3] = (gbcdLimits[8] - gbcdLimits[3]) / float(gbcdSizes[3]);
-  gbcdDeltas[4] = (gbcdLimits[9] - gbcdLimits[4]) / float(gbcdSizes[4]);
-
-  float vec[3] = { 0.0f, 0.0f, 0.0f };
-  float vec2[3] = { 0.0f, 0.0f, 0.0f };
-  float rotNormal[3] = { 0.0f, 0.0f, 0.0f };
-  float rotNormal2[3] = { 0.0f, 0.0f, 0.0f };
-  float sqCoord[2] = { 0.0f, 0.0f };
-  float dg[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float dgt[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float dg1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float dg2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float sym1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float sym2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float sym2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float mis_euler1[3] = { 0.0f, 0.0f, 0.0f };
-
-  float misAngle = m_MisorientationRotation.angle * SIMPLib::Constants::k_PiOver180;
-  float normAxis[3] = { m_MisorientationRotation.h, m_MisorientationRotation.k, m_MisorientationRotation.l };
-  MatrixMath::Normalize3x1(normAxis);
-  // convert axis angle to matrix representation of misorientation
-  FOrientArrayType om(9, 0.0f);
-  FOrientTransformsType::ax2om(FOrientArrayType(normAxis[0], normAxis[1], normAxis[2], misAngle), om);
-  om.toGMatrix(dg);
-
-  // take inverse of misorientation variable to use for switching symmetry
-  MatrixMath::Transpose3x3(dg, dgt);
+  int64_t totalGBCDBins = cDims[0] * cDims[1] * cDims[2] * cDims[3] * cDims[4] * 2;
 
   // Get our SpaceGroupOps pointer for the selected crystal structure
   SpaceGroupOps::Pointer orientOps = m_OrientationOps[m_CrystalStructures[m_PhaseOfInterest]];
 
-  // get number of symmetry operators
-  int32_t n_sym = orientOps->getNumSymOps();
+  GBCDPoleFigureRenderer renderer(orientOps, m_GBCD + (m_PhaseOfInterest * totalGBCDBins), cDims);
+  renderer.setMisorientation(m_MisorientationRotation);
 
+  float vec[3] = { 0.0f, 0.0f, 0.0f };
   int32_t thetaPoints = 120;
   int32_t phiPoints = 30;
   float thetaRes = 360.0f / float(thetaPoints);
@@ -341,15 +270,6 @@ void VisualizeGBCDGMT::execute()
   float degToRad = SIMPLib::Constants::k_PiOver180;
   float sum = 0.0f;
   int32_t count = 0;
-  bool nhCheck = false;
-  int32_t hemisphere = 0;
-
-  int32_t shift1 = gbcdSizes[0];
-  int32_t shift2 = gbcdSizes[0] * gbcdSizes[1];
-  int32_t shift3 = gbcdSizes[0] * gbcdSizes[1] * gbcdSizes[2];
-  int32_t shift4 = gbcdSizes[0] * gbcdSizes[1] * gbcdSizes[2] * gbcdSizes[3];
-
-  int64_t totalGBCDBins = gbcdSizes[0] * gbcdSizes[1] * gbcdSizes[2] * gbcdSizes[3] * gbcdSizes[4] * 2;
 
   std::vector<float> gmtValues;
 
@@ -362,84 +282,10 @@ void VisualizeGBCDGMT::execute()
       phi = float(k) * phiRes;
       thetaRad = theta * degToRad;
       phiRad = phi * degToRad;
-      sum = 0.0f;
-      count = 0;
       vec[0] = sinf(phiRad) * cosf(thetaRad);
       vec[1] = sinf(phiRad) * sinf(thetaRad);
       vec[2] = cosf(phiRad);
-      MatrixMath::Multiply3x3with3x1(dgt, vec, vec2);
-
-      // Loop over all the symetry operators in the given cystal symmetry
-      for (int32_t i = 0; i < n_sym; i++)
-      {
-        // get symmetry operator1
-        orientOps->getMatSymOp(i, sym1);
-        for (int32_t j = 0; j < n_sym; j++)
-        {
-          // get symmetry operator2
-          orientOps->getMatSymOp(j, sym2);
-          MatrixMath::Transpose3x3(sym2, sym2t);
-          // calculate symmetric misorientation
-          MatrixMath::Multiply3x3with3x3(dg, sym2t, dg1);
-          MatrixMath::Multiply3x3with3x3(sym1, dg1, dg2);
-          // convert to euler angle
-          FOrientArrayType mEuler(mis_euler1, 3);
-          FOrientTransformsType::om2eu(FOrientArrayType(dg2), mEuler);
-          if (mis_euler1[0] < SIMPLib::Constants::k_PiOver2 && mis_euler1[1] < SIMPLib::Constants::k_PiOver2 && mis_euler1[2] < SIMPLib::Constants::k_PiOver2)
-          {
-            mis_euler1[1] = cosf(mis_euler1[1]);
-            // find bins in GBCD
-            int32_t location1 = int32_t((mis_euler1[0] - gbcdLimits[0]) / gbcdDeltas[0]);
-            int32_t location2 = int32_t((mis_euler1[1] - gbcdLimits[1]) / gbcdDeltas[1]);
-            int32_t location3 = int32_t((mis_euler1[2] - gbcdLimits[2]) / gbcdDeltas[2]);
-            // find symmetric poles using the first symmetry operator
-            MatrixMath::Multiply3x3with3x1(sym1, vec, rotNormal);
-            // get coordinates in square projection of crystal normal parallel to boundary normal
-            nhCheck = getSquareCoord(rotNormal, sqCoord);
-            // Note the switch to have theta in the 4 slot and cos(Phi) int he 3 slot
-            int32_t location4 = int32_t((sqCoord[0] - gbcdLimits[3]) / gbcdDeltas[3]);
-            int32_t location5 = int32_t((sqCoord[1] - gbcdLimits[4]) / gbcdDeltas[4]);
-            if (location1 >= 0 && location2 >= 0 && location3 >= 0 && location4 >= 0 && location5 >= 0 &&
-                location1 < gbcdSizes[0] && location2 < gbcdSizes[1] && location3 < gbcdSizes[2] && location4 < gbcdSizes[3] && location5 < gbcdSizes[4])
-            {
-              hemisphere = 0;
-              if (nhCheck == false) { hemisphere = 1; }
-              sum += m_GBCD[(m_PhaseOfInterest * totalGBCDBins) + 2 * ((location5 * shift4) + (location4 * shift3) + (location3 * shift2) + (location2 * shift1) + location1) + hemisphere];
-              count++;
-            }
-          }
-
-          // again in second crystal reference frame
-          // calculate symmetric misorientation
-          MatrixMath::Multiply3x3with3x3(dgt, sym2, dg1);
-          MatrixMath::Multiply3x3with3x3(sym1, dg1, dg2);
-          // convert to euler angle
-          FOrientTransformsType::om2eu(FOrientArrayType(dg2), mEuler);
-          if (mis_euler1[0] < SIMPLib::Constants::k_PiOver2 && mis_euler1[1] < SIMPLib::Constants::k_PiOver2 && mis_euler1[2] < SIMPLib::Constants::k_PiOver2)
-          {
-            mis_euler1[1] = cosf(mis_euler1[1]);
-            // find bins in GBCD
-            int32_t location1 = int32_t((mis_euler1[0] - gbcdLimits[0]) / gbcdDeltas[0]);
-            int32_t location2 = int32_t((mis_euler1[1] - gbcdLimits[1]) / gbcdDeltas[1]);
-            int32_t location3 = int32_t((mis_euler1[2] - gbcdLimits[2]) / gbcdDeltas[2]);
-            // find symmetric poles using the first symmetry operator
-            MatrixMath::Multiply3x3with3x1(sym1, vec2, rotNormal2);
-            // get coordinates in square projection of crystal normal parallel to boundary normal
-            nhCheck = getSquareCoord(rotNormal2, sqCoord);
-            // Note the switch to have theta in the 4 slot and cos(Phi) int he 3 slot
-            int32_t location4 = int32_t((sqCoord[0] - gbcdLimits[3]) / gbcdDeltas[3]);
-            int32_t location5 = int32_t((sqCoord[1] - gbcdLimits[4]) / gbcdDeltas[4]);
-            if (location1 >= 0 && location2 >= 0 && location3 >= 0 && location4 >= 0 && location5 >= 0 &&
-                location1 < gbcdSizes[0] && location2 < gbcdSizes[1] && location3 < gbcdSizes[2] && location4 < gbcdSizes[3] && location5 < gbcdSizes[4])
-            {
-              hemisphere = 0;
-              if (nhCheck == false) { hemisphere = 1; }
-              sum += m_GBCD[(m_PhaseOfInterest * totalGBCDBins) + 2 * ((location5 * shift4) + (location4 * shift3) + (location3 * shift2) + (location2 * shift1) + location1) + hemisphere];
-              count++;
-            }
-          }
-        }
-      }
+      renderer.evaluate(vec, sum, count);
       gmtValues.push_back(theta);
       gmtValues.push_back((90.0f - phi));
       gmtValues.push_back(sum / float(count));
@@ -470,8 +316,6 @@ void VisualizeGBCDGMT::execute()
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
-// -----------------------------------------------------------------------------
-//
 // -----------------------------------------------------------------------------
 bool VisualizeGBCDGMT::getSquareCoord(float* xstl1_norm1, float* sqCoord)
 {
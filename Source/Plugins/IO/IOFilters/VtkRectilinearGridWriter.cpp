@@ -34,7 +34,7 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "VtkRectilinearGridWriter.h"
 
-#include <sstream>
+#include <limits>
 
 #include <QtCore/QFileInfo>
 #include <QtCore/QDir>
@@ -52,11 +52,74 @@
 #include "SIMPLib/VTKUtils/VTKUtil.hpp"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/FormattedOutputWriter.hpp"
 
 
 namespace Detail
 {
 
+  /**
+   * @brief The VtkAsciiFormatter class formats one value of a data array for the ASCII flavor of the file, 20 values
+   * per line. Integers are always written as numbers (including 8 bit ones) and floating point values as "%g".
+   */
+  template<typename T>
+  class VtkAsciiFormatter
+  {
+    public:
+      VtkAsciiFormatter(const T* data) :
+        m_Data(data)
+      {}
+      virtual ~VtkAsciiFormatter() {}
+
+      void format(size_t i, FormattedOutputBuffer& buffer) const
+      {
+        if(i % 20 == 0 && i > 0)
+        {
+          buffer.append('\n');
+        }
+        buffer.append(' ');
+        if (std::numeric_limits<T>::is_integer == false)
+        {
+          buffer.appendFormatted("%g", static_cast<double>(m_Data[i]));
+        }
+        else if (std::numeric_limits<T>::is_signed == true)
+        {
+          buffer.appendInt(static_cast<int64_t>(m_Data[i]));
+        }
+        else
+        {
+          buffer.appendUInt(static_cast<uint64_t>(m_Data[i]));
+        }
+      }
+
+    private:
+      const T* m_Data;
+  };
+
+  /**
+   * @brief The VtkBinaryFormatter class copies one value of a data array into the output as big endian, so the
+   * array itself does not have to be byte swapped in place
+   */
+  template<typename T>
+  class VtkBinaryFormatter
+  {
+    public:
+      VtkBinaryFormatter(const T* data) :
+        m_Data(data)
+      {}
+      virtual ~VtkBinaryFormatter() {}
+
+      void format(size_t i, FormattedOutputBuffer& buffer) const
+      {
+        T value = m_Data[i];
+        SIMPLib::Endian::FromSystemToBig::convert(value);
+        buffer.appendBytes(&value, sizeof(T));
+      }
+
+    private:
+      const T* m_Data;
+  };
+
 
   // -----------------------------------------------------------------------------
   //
@@ -165,28 +228,27 @@ namespace Detail
 
       fprintf(f, "SCALARS %s %s %d\n", dName.toLatin1().data(), VtkType.toLatin1().data(), numComps);
       fprintf(f, "LOOKUP_TABLE default\n");
+      bool written = false;
       if ( writeBinary )
       {
-        if(BIGENDIAN == 0) { array->byteSwapElements(); }
-        size_t totalWritten = fwrite(val, array->getTypeSize(), totalElements, f);
-        if(totalWritten != totalElements) {}
-        fprintf(f, "\n");
-        if(BIGENDIAN == 0) { array->byteSwapElements(); }
+        VtkBinaryFormatter<T> formatter(val);
+        FormattedOutputWriter<VtkBinaryFormatter<T> > writer(formatter, 65536);
+        written = writer.write(f, 0, totalElements);
       }
       else
       {
-        std::stringstream ss;
-        for (size_t i = 0; i < totalElements; i++)
-        {
-          if(i % 20 == 0 && i > 0)
-          {
-            ss << "\n";
-          }
-          ss << " " << val[i];
-        }
-        ss << "\n";
-        fprintf(f, "%s", ss.str().c_str());
+        VtkAsciiFormatter<T> formatter(val);
+        FormattedOutputWriter<VtkAsciiFormatter<T> > writer(formatter);
+        written = writer.write(f, 0, totalElements);
       }
+      if (written == false)
+      {
+        QString ss = QObject::tr("Error writing Cell Data %1 to the vtk file").arg(iDataPtr->getName());
+        filter->setErrorCondition(-2031003);
+        filter->notifyErrorMessage(filter->getHumanLabel(), ss, filter->getErrorCondition());
+        return;
+      }
+      fprintf(f, "\n");
     }
   }
 
@@ -421,6 +483,7 @@ void VtkRectilinearGridWriter::execute()
     IDataArray::Pointer iDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, arrayPath);
 
     EXECUTE_FUNCTION_TEMPLATE(this, Detail::WriteDataArray, iDataPtr, this, f, iDataPtr, m_WriteBinaryFile);
+    if (getErrorCondition() < 0) { return; }
 
 #if 0
     QString className = iDataPtr->getNameOfClass();
@@ -38,6 +38,13 @@
 
 #include <QtCore/QDir>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -50,6 +57,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/FeatureFaceBuckets.hpp"
+#include "IO/IOFilters/util/StlFeatureWriter.hpp"
 
 // Include the MOC generated file for this class
 #include "moc_WriteStlFile.cpp"
@@ -180,7 +189,6 @@ void WriteStlFile::preflight()
 // -----------------------------------------------------------------------------
 void WriteStlFile::execute()
 {
-  int32_t err = 0;
   setErrorCondition(0);
   dataCheck();
   if(getErrorCondition() < 0) { return; }
@@ -209,134 +217,77 @@ void WriteStlFile::execute()
     return;
   }
 
-  // Store all the unique Spins
-  QMap<int32_t, int32_t> uniqueGrainIdtoPhase;
+  // Bucket the triangles by Feature in one pass instead of scanning every triangle for every Feature
+  FeatureFaceBuckets::Pointer buckets = FeatureFaceBuckets::New();
+  buckets->generate(m_SurfaceMeshFaceLabels, nTriangles);
+  size_t numFeatures = buckets->getNumberOfFeatures();
+
+  // Each Feature is grouped with the phase of the last face side it was found on
+  QMap<int32_t, int32_t> featureIdToPhase;
   if (m_GroupByPhase == true)
   {
     for (int64_t i = 0; i < nTriangles; i++)
     {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], m_SurfaceMeshFacePhases[i * 2]);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], m_SurfaceMeshFacePhases[i * 2 + 1]);
-    }
-  }
-  else
-  {
-    for (int64_t i = 0; i < nTriangles; i++)
-    {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], 0);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], 0);
+      featureIdToPhase.insert(m_SurfaceMeshFaceLabels[i * 2], m_SurfaceMeshFacePhases[i * 2]);
+      featureIdToPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], m_SurfaceMeshFacePhases[i * 2 + 1]);
     }
   }
 
-  unsigned char data[50];
-  float* normal = (float*)data;
-  float* vert1 = (float*)(data + 12);
-  float* vert2 = (float*)(data + 24);
-  float* vert3 = (float*)(data + 36);
-  uint16_t* attrByteCount = (uint16_t*)(data + 48);
-  *attrByteCount = 0;
-
-  size_t totalWritten = 0;
-  float u[3] = { 0.0f, 0.0f, 0.0f }, w[3] = { 0.0f, 0.0f, 0.0f };
-  float length = 0.0f;
-
-  int32_t spin = 0;
-  int32_t triCount = 0;
-
-  //Loop over the unique Spins
-  for (QMap<int32_t, int32_t>::iterator spinIter = uniqueGrainIdtoPhase.begin(); spinIter != uniqueGrainIdtoPhase.end(); ++spinIter )
+  QVector<QString> fileNames(numFeatures);
+  QVector<QString> headers(numFeatures);
+  for (size_t b = 0; b < numFeatures; b++)
   {
-    spin = spinIter.key();
+    int32_t spin = buckets->getFeatureId(b);
 
     // Generate the output file name
     QString filename = getOutputStlDirectory() + "/" + getOutputStlPrefix();
-    if (m_GroupByPhase == true)
-    {
-      filename = filename + QString("Ensemble_") + QString::number(spinIter.value()) + QString("_");
-    }
-    filename = filename + QString("Feature_") + QString::number(spin) + ".stl";
-    FILE* f = fopen(filename.toLatin1().data(), "wb");
-    {
-      QString ss = QObject::tr("Writing STL for Feature Id %1").arg(spin);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    }
-
     QString header = "DREAM3D Generated For Feature ID " + QString::number(spin);
     if (m_GroupByPhase == true)
     {
-      header = header + " Phase " + QString::number(spinIter.value());
+      filename = filename + QString("Ensemble_") + QString::number(featureIdToPhase.value(spin)) + QString("_");
+      header = header + " Phase " + QString::number(featureIdToPhase.value(spin));
     }
-    err = writeHeader(f, header, 0);
-    if (err < 0)
+    fileNames[b] = filename + QString("Feature_") + QString::number(spin) + ".stl";
+    headers[b] = header;
+  }
+
+  {
+    QString ss = QObject::tr("Writing STL files for %1 Features").arg(numFeatures);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+  }
+
+  std::vector<int32_t> errors(numFeatures + 1, 0);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures),
+                      StlFeatureWriter(nodes, triangles, buckets.get(), &fileNames, &headers, &(errors.front())), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    StlFeatureWriter serial(nodes, triangles, buckets.get(), &fileNames, &headers, &(errors.front()));
+    serial.generate(0, numFeatures);
+  }
+
+  for (size_t b = 0; b < numFeatures; b++)
+  {
+    if (errors[b] == -1)
     {
+      QString ss = QObject::tr("Error opening STL file '%1' for writing").arg(fileNames[b]);
+      setErrorCondition(-1200);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
     }
-    triCount = 0; // Reset this to Zero. Increment for every triangle written
-
-    // Loop over all the triangles for this spin
-    for (int64_t t = 0; t < nTriangles; ++t)
+    else if (errors[b] < 0)
     {
-      // Get the true indices of the 3 nodes
-      int64_t nId0 = triangles[t * 3];
-      int64_t nId1 = triangles[t * 3 + 1];
-      int64_t nId2 = triangles[t * 3 + 2];
-
-      vert1[0] = static_cast<float>(nodes[nId0 * 3]);
-      vert1[1] = static_cast<float>(nodes[nId0 * 3 + 1]);
-      vert1[2] = static_cast<float>(nodes[nId0 * 3 + 2]);
-
-      if (m_SurfaceMeshFaceLabels[t * 2] == spin)
-      {
-        //winding = 0; // 0 = Write it using forward spin
-      }
-      else if (m_SurfaceMeshFaceLabels[t * 2 + 1] == spin)
-      {
-        //winding = 1; // Write it using backward spin
-        // Switch the 2 node indices
-        int64_t temp = nId1;
-        nId1 = nId2;
-        nId2 = temp;
-      }
-      else
-      {
-        continue; // We do not match either spin so move to the next triangle
-      }
-
-      vert2[0] = static_cast<float>(nodes[nId1 * 3]);
-      vert2[1] = static_cast<float>(nodes[nId1 * 3 + 1]);
-      vert2[2] = static_cast<float>(nodes[nId1 * 3 + 2]);
-
-      vert3[0] = static_cast<float>(nodes[nId2 * 3]);
-      vert3[1] = static_cast<float>(nodes[nId2 * 3 + 1]);
-      vert3[2] = static_cast<float>(nodes[nId2 * 3 + 2]);
-
-      // Compute the normal
-      u[0] = vert2[0] - vert1[0];
-      u[1] = vert2[1] - vert1[1];
-      u[2] = vert2[2] - vert1[2];
-
-      w[0] = vert3[0] - vert1[0];
-      w[1] = vert3[1] - vert1[1];
-      w[2] = vert3[2] - vert1[2];
-
-      normal[0] = u[1] * w[2] - u[2] * w[1];
-      normal[1] = u[2] * w[0] - u[0] * w[2];
-      normal[2] = u[0] * w[1] - u[1] * w[0];
-
-      length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
-      normal[0] = normal[0] / length;
-      normal[1] = normal[1] / length;
-      normal[2] = normal[2] / length;
-
-      totalWritten = fwrite(data, 1, 50, f);
-      if (totalWritten != 50)
-      {
-        QString ss = QObject::tr("Error Writing STL File. Not enough elements written for Feature Id %1. Wrote %2 of 50.").arg(spin).arg(totalWritten);
-        notifyErrorMessage(getHumanLabel(), ss, -1201);
-      }
-      triCount++;
+      QString ss = QObject::tr("Error Writing STL File. Not enough elements written for Feature Id %1.").arg(buckets->getFeatureId(b));
+      setErrorCondition(-1201);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
     }
-    fclose(f);
-    err = writeNumTrianglesToFile(filename, triCount);
   }
 
   setErrorCondition(0);
@@ -345,42 +296,6 @@ void WriteStlFile::execute()
   return;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeHeader(FILE* f, const QString& header, int32_t triCount)
-{
-  if (NULL == f)
-  {
-    return -1;
-  }
-  char h[80];
-  size_t headlength = 80;
-  if (header.length() < 80) { headlength = header.length(); }
-  ::memset(h, 0, 80);
-  ::memcpy(h, header.data(), headlength);
-  // Return the number of bytes written - which should be 80
-  fwrite(h, 1, 80, f);
-  fwrite(&triCount, 1, 4, f);
-  return 0;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeNumTrianglesToFile(const QString& filename, int32_t triCount)
-{
-  // We need to update the number of triangles in the file
-  int32_t err = 0;
-
-  FILE* out = fopen(filename.toLatin1().data(), "r+b");
-  fseek(out, 80L, SEEK_SET);
-  fwrite( (char*)(&triCount), 1, 4, out);
-  fclose(out);
-
-  return err;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -155,23 +155,6 @@ class WriteStlFile : public AbstractFilter
     DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFaceLabels)
     DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFacePhases)
 
-    /**
-     * @brief writeHeader Writes the header of the STL file
-     * @param f File instance pointer
-     * @param header Header to write to file
-     * @param triCount Number of triangles
-     * @return Integer error value
-     */
-    int32_t writeHeader(FILE* f, const QString& header, int32_t triCount);
-
-    /**
-     * @brief writeNumTrianglesToFile Writes the number of triangles to the STL file
-     * @param filename Name of the output file
-     * @param triCount Number of triangles
-     * @return Integer error value
-     */
-    int32_t writeNumTrianglesToFile(const QString& filename, int32_t triCount);
-
     WriteStlFile(const WriteStlFile&); // Copy Constructor Not Implemented
     void operator=(const WriteStlFile&); // Operator '=' Not Implemented
 };
@@ -0,0 +1,141 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _FeatureFaceBuckets_hpp_
+#define _FeatureFaceBuckets_hpp_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+/**
+ * @brief The FeatureFaceBuckets class groups the faces of a surface mesh by the Feature labels on either side of
+ * them. Every face is listed under both of its labels using a single counting sort pass over the face labels, so
+ * the faces of any Feature can be visited without scanning the whole mesh. Each entry encodes the face index and
+ * the side of the face the Feature is on as (2 * face + side), where side 0 is the first label of the face and
+ * side 1 is the second label. Faces with the same label on both sides are only listed once, on side 0.
+ */
+class FeatureFaceBuckets
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureFaceBuckets)
+    SIMPL_STATIC_NEW_MACRO(FeatureFaceBuckets)
+    SIMPL_TYPE_MACRO(FeatureFaceBuckets)
+
+    virtual ~FeatureFaceBuckets() {}
+
+    /**
+     * @brief generate Buckets the faces by label
+     * @param faceLabels Two labels per face
+     * @param numFaces Number of faces
+     */
+    void generate(const int32_t* faceLabels, int64_t numFaces)
+    {
+      m_Features.clear();
+      m_Offsets.clear();
+      m_Entries.clear();
+      if (numFaces <= 0) { m_Offsets.push_back(0); return; }
+
+      int32_t minLabel = faceLabels[0];
+      int32_t maxLabel = faceLabels[0];
+      for (int64_t i = 0; i < 2 * numFaces; i++)
+      {
+        if (faceLabels[i] < minLabel) { minLabel = faceLabels[i]; }
+        if (faceLabels[i] > maxLabel) { maxLabel = faceLabels[i]; }
+      }
+
+      // Count the faces of each label, then turn the counts into offsets
+      size_t numLabels = static_cast<size_t>(static_cast<int64_t>(maxLabel) - static_cast<int64_t>(minLabel)) + 1;
+      std::vector<int64_t> counts(numLabels + 1, 0);
+      for (int64_t t = 0; t < numFaces; t++)
+      {
+        counts[faceLabels[2 * t] - minLabel]++;
+        if (faceLabels[2 * t + 1] != faceLabels[2 * t]) { counts[faceLabels[2 * t + 1] - minLabel]++; }
+      }
+
+      std::vector<int64_t> insert(numLabels, 0);
+      m_Offsets.push_back(0);
+      for (size_t l = 0; l < numLabels; l++)
+      {
+        if (counts[l] == 0) { continue; }
+        insert[l] = m_Offsets.back();
+        m_Features.push_back(static_cast<int32_t>(static_cast<int64_t>(minLabel) + static_cast<int64_t>(l)));
+        m_Offsets.push_back(m_Offsets.back() + counts[l]);
+      }
+
+      // Scatter the faces into their buckets. Faces keep their mesh order within each bucket
+      m_Entries.resize(m_Offsets.back());
+      for (int64_t t = 0; t < numFaces; t++)
+      {
+        m_Entries[insert[faceLabels[2 * t] - minLabel]++] = 2 * t;
+        if (faceLabels[2 * t + 1] != faceLabels[2 * t]) { m_Entries[insert[faceLabels[2 * t + 1] - minLabel]++] = 2 * t + 1; }
+      }
+    }
+
+    /**
+     * @brief getNumberOfFeatures Returns the number of distinct labels, which are stored in ascending order
+     */
+    size_t getNumberOfFeatures() const { return m_Features.size(); }
+
+    /**
+     * @brief getFeatureId Returns the label of bucket b
+     */
+    int32_t getFeatureId(size_t b) const { return m_Features[b]; }
+
+    /**
+     * @brief getNumberOfFaces Returns the number of faces in bucket b
+     */
+    int64_t getNumberOfFaces(size_t b) const { return m_Offsets[b + 1] - m_Offsets[b]; }
+
+    /**
+     * @brief getFaces Returns the encoded face entries of bucket b
+     */
+    const int64_t* getFaces(size_t b) const { return &(m_Entries.front()) + m_Offsets[b]; }
+
+  protected:
+    FeatureFaceBuckets() {}
+
+  private:
+    std::vector<int32_t> m_Features;
+    std::vector<int64_t> m_Offsets;
+    std::vector<int64_t> m_Entries;
+
+    FeatureFaceBuckets(const FeatureFaceBuckets&); // Copy Constructor Not Implemented
+    void operator=(const FeatureFaceBuckets&); // Operator '=' Not Implemented
+};
+
+#endif /* _FeatureFaceBuckets_hpp_ */
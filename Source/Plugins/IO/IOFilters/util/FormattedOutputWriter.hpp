@@ -0,0 +1,302 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _FormattedOutputWriter_hpp_
+#define _FormattedOutputWriter_hpp_
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The FormattedOutputBuffer class is a growable character buffer with formatting routines for the values
+ * the text writers emit. The integer and float routines produce exactly what printf("%lld"), printf("%llu") and
+ * printf("%f") would, without going through the C library for every value.
+ */
+class FormattedOutputBuffer
+{
+  public:
+    FormattedOutputBuffer() :
+      m_Size(0)
+    {}
+
+    virtual ~FormattedOutputBuffer() {}
+
+    void clear() { m_Size = 0; }
+    size_t size() const { return m_Size; }
+    const char* data() const { return m_Data.empty() ? NULL : &(m_Data.front()); }
+
+    void append(char c)
+    {
+      *reserve(1) = c;
+      m_Size++;
+    }
+
+    void append(const char* str)
+    {
+      appendBytes(str, strlen(str));
+    }
+
+    void appendBytes(const void* bytes, size_t count)
+    {
+      if (count == 0) { return; }
+      ::memcpy(reserve(count), bytes, count);
+      m_Size += count;
+    }
+
+    /**
+     * @brief appendInt Appends value as printf("%lld") would
+     */
+    void appendInt(int64_t value)
+    {
+      if (value < 0)
+      {
+        append('-');
+        appendUInt(static_cast<uint64_t>(0) - static_cast<uint64_t>(value));
+      }
+      else
+      {
+        appendUInt(static_cast<uint64_t>(value));
+      }
+    }
+
+    /**
+     * @brief appendUInt Appends value as printf("%llu") would
+     */
+    void appendUInt(uint64_t value)
+    {
+      char digits[20];
+      size_t n = 0;
+      do
+      {
+        digits[n++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+      }
+      while (value != 0);
+      char* out = reserve(n);
+      for (size_t i = 0; i < n; i++)
+      {
+        out[i] = digits[n - 1 - i];
+      }
+      m_Size += n;
+    }
+
+    /**
+     * @brief appendFloat Appends value as printf("%f") would. A float times 10^6 is exact in a double, so
+     * rounding that product to an integer matches the correctly rounded conversion of the C library. Values
+     * that are not finite or too large for the integer path are handed to snprintf.
+     */
+    void appendFloat(float value)
+    {
+      if (value != value || value >= 1.0e12f || value <= -1.0e12f)
+      {
+        appendFormatted("%f", static_cast<double>(value));
+        return;
+      }
+      double scaled = static_cast<double>(value) * 1000000.0;
+      if (value < 0.0f || (value == 0.0f && 1.0f / value < 0.0f))
+      {
+        append('-');
+        scaled = -scaled;
+      }
+      uint64_t units = static_cast<uint64_t>(nearbyint(scaled));
+      appendUInt(units / 1000000);
+      char* out = reserve(7);
+      out[0] = '.';
+      uint64_t fraction = units % 1000000;
+      for (int32_t i = 6; i > 0; i--)
+      {
+        out[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+      }
+      m_Size += 7;
+    }
+
+    /**
+     * @brief appendFormatted Appends a single value formatted by snprintf. This is the fallback for formats
+     * without a dedicated routine, e.g. "%g" for doubles.
+     */
+    void appendFormatted(const char* format, double value)
+    {
+      char text[512];
+      int n = snprintf(text, sizeof(text), format, value);
+      if (n > 0) { appendBytes(text, static_cast<size_t>(n) < sizeof(text) ? static_cast<size_t>(n) : sizeof(text) - 1); }
+    }
+
+  private:
+    std::vector<char> m_Data;
+    size_t m_Size;
+
+    char* reserve(size_t count)
+    {
+      if (m_Size + count > m_Data.size())
+      {
+        size_t capacity = m_Data.size() * 2;
+        if (capacity < m_Size + count) { capacity = m_Size + count + 4096; }
+        m_Data.resize(capacity);
+      }
+      return &(m_Data.front()) + m_Size;
+    }
+};
+
+/**
+ * @brief The FormattedOutputWriter class writes a sequence of items to a file through a Formatter. The items are
+ * cut into fixed size chunks that are formatted in parallel into their own buffers, and the buffers are then
+ * written in order with one fwrite each, so the file is identical to the one a serial loop would produce. The
+ * Formatter must provide
+ *
+ *   void format(size_t item, FormattedOutputBuffer& buffer) const;
+ *
+ * which appends the text (or bytes) of a single item and must be safe to call from several threads at once.
+ */
+template<typename Formatter>
+class FormattedOutputWriter
+{
+  public:
+    FormattedOutputWriter(const Formatter& formatter, size_t chunkSize = 8192) :
+      m_Formatter(formatter),
+      m_ChunkSize(chunkSize > 0 ? chunkSize : 1)
+    {}
+
+    virtual ~FormattedOutputWriter() {}
+
+    /**
+     * @brief write Formats the items [start, end) and appends them to the file
+     * @param f Open file to write to
+     * @param start First item
+     * @param end One past the last item
+     * @return true if every byte was written
+     */
+    bool write(FILE* f, size_t start, size_t end)
+    {
+      // Bound the memory held in buffers by formatting a limited number of chunks at a time
+      const size_t k_ChunksPerBatch = 64;
+      size_t batchSize = m_ChunkSize * k_ChunksPerBatch;
+      if (m_Buffers.size() < k_ChunksPerBatch) { m_Buffers.resize(k_ChunksPerBatch); }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+#endif
+
+      for (size_t batchStart = start; batchStart < end; batchStart += batchSize)
+      {
+        size_t batchEnd = (end - batchStart > batchSize) ? batchStart + batchSize : end;
+        size_t numChunks = (batchEnd - batchStart + m_ChunkSize - 1) / m_ChunkSize;
+        FormatChunks chunks(&m_Formatter, &(m_Buffers.front()), batchStart, batchEnd, m_ChunkSize);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        if (doParallel == true && numChunks > 1)
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), chunks, tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          chunks.generate(0, numChunks);
+        }
+
+        for (size_t c = 0; c < numChunks; c++)
+        {
+          const FormattedOutputBuffer& buffer = m_Buffers[c];
+          if (buffer.size() > 0 && fwrite(buffer.data(), 1, buffer.size(), f) != buffer.size()) { return false; }
+        }
+      }
+      return true;
+    }
+
+  private:
+    const Formatter& m_Formatter;
+    size_t m_ChunkSize;
+    std::vector<FormattedOutputBuffer> m_Buffers;
+
+    class FormatChunks
+    {
+      public:
+        FormatChunks(const Formatter* formatter, FormattedOutputBuffer* buffers, size_t start, size_t end, size_t chunkSize) :
+          m_Formatter(formatter),
+          m_Buffers(buffers),
+          m_Start(start),
+          m_End(end),
+          m_ChunkSize(chunkSize)
+        {}
+
+        void generate(size_t start, size_t end) const
+        {
+          for (size_t c = start; c < end; c++)
+          {
+            FormattedOutputBuffer& buffer = m_Buffers[c];
+            buffer.clear();
+            size_t first = m_Start + c * m_ChunkSize;
+            size_t last = (m_End - first > m_ChunkSize) ? first + m_ChunkSize : m_End;
+            for (size_t i = first; i < last; i++)
+            {
+              m_Formatter->format(i, buffer);
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          generate(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        const Formatter* m_Formatter;
+        FormattedOutputBuffer* m_Buffers;
+        size_t m_Start;
+        size_t m_End;
+        size_t m_ChunkSize;
+    };
+
+    FormattedOutputWriter(const FormattedOutputWriter&); // Copy Constructor Not Implemented
+    void operator=(const FormattedOutputWriter&); // Operator '=' Not Implemented
+};
+
+#endif /* _FormattedOutputWriter_hpp_ */
@@ -0,0 +1,416 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _GBCDPoleFigureRenderer_hpp_
+#define _GBCDPoleFigureRenderer_hpp_
+
+#include <math.h>
+
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Math/MatrixMath.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+/**
+ * @brief The GBCDPoleFigureRenderer class evaluates the grain boundary character distribution (GBCD) of one phase
+ * at a fixed misorientation, averaged over all the symmetrically equivalent ways of looking up a boundary plane
+ * normal. The misorientation half of the lookup does not depend on the normal, so setMisorientation() tabulates the
+ * GBCD bins of every pair of symmetry operators once; each normal then only has to be rotated by each symmetry
+ * operator and combined with the table. The sums are accumulated in the same order as a direct evaluation.
+ */
+class GBCDPoleFigureRenderer
+{
+  public:
+    /**
+     * @brief GBCDPoleFigureRenderer
+     * @param orientOps Symmetry operators of the phase
+     * @param gbcd Pointer to the GBCD values of the phase
+     * @param gbcdDims Component dimensions of the GBCD array
+     */
+    GBCDPoleFigureRenderer(SpaceGroupOps::Pointer orientOps, const double* gbcd, const QVector<size_t>& gbcdDims) :
+      m_Gbcd(gbcd),
+      m_NumSymOps(orientOps->getNumSymOps())
+    {
+      m_GbcdLimits[0] = 0.0f;
+      m_GbcdLimits[1] = 0.0f;
+      m_GbcdLimits[2] = 0.0f;
+      m_GbcdLimits[3] = -sqrtf(SIMPLib::Constants::k_PiOver2);
+      m_GbcdLimits[4] = -sqrtf(SIMPLib::Constants::k_PiOver2);
+      m_GbcdLimits[5] = SIMPLib::Constants::k_PiOver2;
+      m_GbcdLimits[6] = 1.0f;
+      m_GbcdLimits[7] = SIMPLib::Constants::k_PiOver2;
+      m_GbcdLimits[8] = sqrtf(SIMPLib::Constants::k_PiOver2);
+      m_GbcdLimits[9] = sqrtf(SIMPLib::Constants::k_PiOver2);
+      for (int32_t i = 0; i < 5; i++)
+      {
+        m_GbcdSizes[i] = static_cast<int32_t>(gbcdDims[i]);
+        m_GbcdDeltas[i] = (m_GbcdLimits[i + 5] - m_GbcdLimits[i]) / float(m_GbcdSizes[i]);
+      }
+      m_Shift1 = m_GbcdSizes[0];
+      m_Shift2 = m_GbcdSizes[0] * m_GbcdSizes[1];
+      m_Shift3 = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2];
+      m_Shift4 = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3];
+
+      m_SymOps.resize(m_NumSymOps);
+      for (int32_t i = 0; i < m_NumSymOps; i++)
+      {
+        orientOps->getMatSymOp(i, m_SymOps[i].g);
+      }
+      MatrixMath::Identity3x3(m_Dg);
+      MatrixMath::Identity3x3(m_Dgt);
+    }
+
+    virtual ~GBCDPoleFigureRenderer() {}
+
+    /**
+     * @brief setMisorientation Tabulates the GBCD bins of the symmetrically equivalent misorientations
+     * @param misorientation Misorientation as an axis and an angle in degrees
+     */
+    void setMisorientation(const AxisAngleInput_t& misorientation)
+    {
+      float misAngle = misorientation.angle * SIMPLib::Constants::k_PiOver180;
+      float normAxis[3] = { misorientation.h, misorientation.k, misorientation.l };
+      MatrixMath::Normalize3x1(normAxis);
+      // convert axis angle to matrix representation of misorientation
+      FOrientArrayType om(9, 0.0f);
+      FOrientTransformsType::ax2om(FOrientArrayType(normAxis[0], normAxis[1], normAxis[2], misAngle), om);
+      om.toGMatrix(m_Dg);
+      // take inverse of misorientation variable to use for switching symmetry
+      MatrixMath::Transpose3x3(m_Dg, m_Dgt);
+
+      float dg1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float dg2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float sym2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+
+      m_MisorientationBins.clear();
+      for (int32_t i = 0; i < m_NumSymOps; i++)
+      {
+        for (int32_t j = 0; j < m_NumSymOps; j++)
+        {
+          // calculate symmetric misorientation
+          MatrixMath::Transpose3x3(m_SymOps[j].g, sym2t);
+          MatrixMath::Multiply3x3with3x3(m_Dg, sym2t, dg1);
+          MatrixMath::Multiply3x3with3x3(m_SymOps[i].g, dg1, dg2);
+          addMisorientationBin(dg2, i, 0);
+
+          // again in second crystal reference frame
+          MatrixMath::Multiply3x3with3x3(m_Dgt, m_SymOps[j].g, dg1);
+          MatrixMath::Multiply3x3with3x3(m_SymOps[i].g, dg1, dg2);
+          addMisorientationBin(dg2, i, 1);
+        }
+      }
+    }
+
+    /**
+     * @brief evaluate Sums the GBCD over the symmetrically equivalent bins of a boundary plane normal
+     * @param normal Boundary plane normal in the frame of the first crystal
+     * @param sum Sum of the GBCD values found
+     * @param count Number of GBCD values found
+     */
+    void evaluate(const float normal[3], float& sum, int32_t& count) const
+    {
+      std::vector<int32_t> normalBins(2 * m_NumSymOps, -1);
+      evaluate(normal, &(normalBins.front()), sum, count);
+    }
+
+    /**
+     * @brief renderStereographic Renders a stereographic pole figure of the GBCD for each misorientation.
+     * The rows of all the pole figures are rendered in parallel.
+     * @param misorientations Misorientations as an axis and an angle in degrees
+     * @param xpoints Number of pixels along x
+     * @param ypoints Number of pixels along y
+     * @return Pole figure intensities of each misorientation, row by row
+     */
+    QVector<DoubleArrayType::Pointer> renderStereographic(const QVector<AxisAngleInput_t>& misorientations, int32_t xpoints, int32_t ypoints) const
+    {
+      std::vector<GBCDPoleFigureRenderer> renderers(misorientations.size(), *this);
+      std::vector<double*> figures(misorientations.size(), NULL);
+      QVector<DoubleArrayType::Pointer> poleFigures(misorientations.size());
+      QVector<size_t> dims(1, 1);
+      for (int32_t m = 0; m < misorientations.size(); m++)
+      {
+        renderers[m].setMisorientation(misorientations[m]);
+        poleFigures[m] = DoubleArrayType::CreateArray(xpoints * ypoints, dims, "PoleFigure");
+        poleFigures[m]->initializeWithZeros();
+        figures[m] = poleFigures[m]->getPointer(0);
+      }
+      if (misorientations.isEmpty() || xpoints <= 0 || ypoints <= 0) { return poleFigures; }
+
+      StereographicRows rows(&(renderers.front()), &(figures.front()), xpoints, ypoints);
+      size_t numRows = static_cast<size_t>(misorientations.size()) * static_cast<size_t>(ypoints);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), rows, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        rows.render(0, numRows);
+      }
+      return poleFigures;
+    }
+
+    /**
+     * @brief GetSquareCoord Computes the square based coordinate based on the incoming normal
+     * @param xstl1_norm1 Incoming normal
+     * @param sqCoord Computed square coordinate
+     * @return Boolean value for whether coordinate lies in the norther hemisphere
+     */
+    static bool GetSquareCoord(const float* xstl1_norm1, float* sqCoord)
+    {
+      bool nhCheck = false;
+      float adjust = 1.0;
+      if (xstl1_norm1[2] >= 0.0)
+      {
+        adjust = -1.0;
+        nhCheck = true;
+      }
+      if (fabsf(xstl1_norm1[0]) >= fabsf(xstl1_norm1[1]))
+      {
+        sqCoord[0] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
+        sqCoord[1] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[1] / xstl1_norm1[0]));
+      }
+      else
+      {
+        sqCoord[0] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[0] / xstl1_norm1[1]));
+        sqCoord[1] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
+      }
+      return nhCheck;
+    }
+
+  protected:
+    /**
+     * @brief addMisorientationBin Adds the misorientation bins of a symmetric misorientation to the table if the
+     * misorientation lies in the GBCD
+     */
+    void addMisorientationBin(float dg[3][3], int32_t symOp, int32_t frame)
+    {
+      float mis_euler1[3] = { 0.0f, 0.0f, 0.0f };
+      // convert to euler angle
+      FOrientArrayType eu(mis_euler1, 3);
+      FOrientTransformsType::om2eu(FOrientArrayType(dg), eu);
+      if (mis_euler1[0] < SIMPLib::Constants::k_PiOver2 && mis_euler1[1] < SIMPLib::Constants::k_PiOver2 && mis_euler1[2] < SIMPLib::Constants::k_PiOver2)
+      {
+        mis_euler1[1] = cosf(mis_euler1[1]);
+        // find bins in GBCD
+        int32_t location1 = int32_t((mis_euler1[0] - m_GbcdLimits[0]) / m_GbcdDeltas[0]);
+        int32_t location2 = int32_t((mis_euler1[1] - m_GbcdLimits[1]) / m_GbcdDeltas[1]);
+        int32_t location3 = int32_t((mis_euler1[2] - m_GbcdLimits[2]) / m_GbcdDeltas[2]);
+        if (location1 >= 0 && location2 >= 0 && location3 >= 0 &&
+            location1 < m_GbcdSizes[0] && location2 < m_GbcdSizes[1] && location3 < m_GbcdSizes[2])
+        {
+          MisorientationBin bin;
+          bin.normalBin = 2 * symOp + frame;
+          bin.offset = 2 * ((location3 * m_Shift2) + (location2 * m_Shift1) + location1);
+          m_MisorientationBins.push_back(bin);
+        }
+      }
+    }
+
+    /**
+     * @brief evaluate Sums the GBCD over the symmetrically equivalent bins of a boundary plane normal using
+     * normalBins (2 entries per symmetry operator) as scratch space
+     */
+    void evaluate(const float normal[3], int32_t* normalBins, float& sum, int32_t& count) const
+    {
+      float vec[3] = { normal[0], normal[1], normal[2] };
+      float vec2[3] = { 0.0f, 0.0f, 0.0f };
+      float rotNormal[3] = { 0.0f, 0.0f, 0.0f };
+      float sqCoord[2] = { 0.0f, 0.0f };
+      MatrixMath::Multiply3x3with3x1(m_Dgt, vec, vec2);
+
+      // find symmetric poles using the first symmetry operator, in the first and then the second crystal reference frame
+      for (int32_t i = 0; i < m_NumSymOps; i++)
+      {
+        for (int32_t frame = 0; frame < 2; frame++)
+        {
+          MatrixMath::Multiply3x3with3x1(m_SymOps[i].g, (frame == 0) ? vec : vec2, rotNormal);
+          // get coordinates in square projection of crystal normal parallel to boundary normal
+          bool nhCheck = GetSquareCoord(rotNormal, sqCoord);
+          // Note the switch to have theta in the 4 slot and cos(Phi) int he 3 slot
+          int32_t location4 = int32_t((sqCoord[0] - m_GbcdLimits[3]) / m_GbcdDeltas[3]);
+          int32_t location5 = int32_t((sqCoord[1] - m_GbcdLimits[4]) / m_GbcdDeltas[4]);
+          normalBins[2 * i + frame] = -1;
+          if (location4 >= 0 && location5 >= 0 && location4 < m_GbcdSizes[3] && location5 < m_GbcdSizes[4])
+          {
+            int32_t hemisphere = 0;
+            if (nhCheck == false) { hemisphere = 1; }
+            normalBins[2 * i + frame] = 2 * ((location5 * m_Shift4) + (location4 * m_Shift3)) + hemisphere;
+          }
+        }
+      }
+
+      sum = 0.0f;
+      count = 0;
+      size_t numBins = m_MisorientationBins.size();
+      for (size_t b = 0; b < numBins; b++)
+      {
+        const MisorientationBin& bin = m_MisorientationBins[b];
+        int32_t normalBin = normalBins[bin.normalBin];
+        if (normalBin >= 0)
+        {
+          sum += m_Gbcd[bin.offset + normalBin];
+          count++;
+        }
+      }
+    }
+
+    /**
+     * @brief renderStereographicRow Renders one row of pixels of a stereographic pole figure
+     */
+    void renderStereographicRow(int32_t k, int32_t xpoints, int32_t ypoints, double* poleFigure, int32_t* normalBins) const
+    {
+      int32_t xpointshalf = xpoints / 2;
+      int32_t ypointshalf = ypoints / 2;
+      float xres = 2.0f / float(xpoints);
+      float yres = 2.0f / float(ypoints);
+      float x = 0.0f, y = 0.0f;
+      float vec[3] = { 0.0f, 0.0f, 0.0f };
+      float sum = 0.0f;
+      int32_t count = 0;
+      for (int32_t l = 0; l < xpoints; l++)
+      {
+        // get (x,y) for stereographic projection pixel
+        x = float(l - xpointshalf) * xres + (xres / 2.0);
+        y = float(k - ypointshalf) * yres + (yres / 2.0);
+        if ((x * x + y * y) <= 1.0)
+        {
+          vec[2] = -((x * x + y * y) - 1) / ((x * x + y * y) + 1);
+          vec[0] = x * (1 + vec[2]);
+          vec[1] = y * (1 + vec[2]);
+          evaluate(vec, normalBins, sum, count);
+          if (count > 0)
+          {
+            poleFigure[(k * xpoints) + l] = sum / float(count);
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief The StereographicRows class renders a range of the rows of a batch of stereographic pole figures,
+     * numbered figure by figure
+     */
+    class StereographicRows
+    {
+      public:
+        StereographicRows(const GBCDPoleFigureRenderer* renderers, double* const* figures, int32_t xpoints, int32_t ypoints) :
+          m_Renderers(renderers),
+          m_Figures(figures),
+          m_XPoints(xpoints),
+          m_YPoints(ypoints)
+        {}
+
+        virtual ~StereographicRows() {}
+
+        void render(size_t start, size_t end) const
+        {
+          std::vector<int32_t> normalBins(2 * m_Renderers[0].m_NumSymOps, -1);
+          for (size_t r = start; r < end; r++)
+          {
+            size_t figure = r / static_cast<size_t>(m_YPoints);
+            int32_t k = static_cast<int32_t>(r % static_cast<size_t>(m_YPoints));
+            m_Renderers[figure].renderStereographicRow(k, m_XPoints, m_YPoints, m_Figures[figure], &(normalBins.front()));
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          render(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        const GBCDPoleFigureRenderer* m_Renderers;
+        double* const* m_Figures;
+        int32_t m_XPoints;
+        int32_t m_YPoints;
+    };
+
+  private:
+    /**
+     * @brief The MisorientationBin struct holds the part of a GBCD index given by a symmetric misorientation and
+     * the slot of the normal bins (2 * symmetry operator + crystal reference frame) to complete it with
+     */
+    struct MisorientationBin
+    {
+      int32_t normalBin;
+      int32_t offset;
+    };
+
+    struct SymOp
+    {
+      float g[3][3];
+    };
+
+    const double* m_Gbcd;
+    int32_t m_NumSymOps;
+    int32_t m_GbcdSizes[5];
+    float m_GbcdLimits[10];
+    float m_GbcdDeltas[5];
+    int32_t m_Shift1;
+    int32_t m_Shift2;
+    int32_t m_Shift3;
+    int32_t m_Shift4;
+    std::vector<SymOp> m_SymOps;
+    float m_Dg[3][3];
+    float m_Dgt[3][3];
+    std::vector<MisorientationBin> m_MisorientationBins;
+};
+
+#endif /* _GBCDPoleFigureRenderer_hpp_ */
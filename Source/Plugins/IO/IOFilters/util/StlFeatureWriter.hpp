@@ -0,0 +1,187 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _StlFeatureWriter_hpp_
+#define _StlFeatureWriter_hpp_
+
+#include <stdio.h>
+#include <string.h>
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#endif
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "IO/IOFilters/util/FeatureFaceBuckets.hpp"
+
+/**
+ * @brief The StlFeatureWriter class writes one binary STL file per bucket of a FeatureFaceBuckets object. Faces on
+ * the second side of a Feature are written with reversed winding so every surface faces out of its Feature. Each
+ * file is assembled in a memory buffer and written with a few large writes, and the files of different Features
+ * can be written in parallel. The outcome for each bucket is stored in errors: 0 on success, -1 if the file could
+ * not be opened and -2 if it could not be fully written.
+ */
+class StlFeatureWriter
+{
+  public:
+    StlFeatureWriter(const float* nodes, const int64_t* triangles, const FeatureFaceBuckets* buckets,
+                     const QVector<QString>* fileNames, const QVector<QString>* headers, int32_t* errors) :
+      m_Nodes(nodes),
+      m_Triangles(triangles),
+      m_Buckets(buckets),
+      m_FileNames(fileNames),
+      m_Headers(headers),
+      m_Errors(errors)
+    {}
+
+    virtual ~StlFeatureWriter() {}
+
+    void generate(size_t start, size_t end) const
+    {
+      const size_t k_TrianglesPerWrite = 65536;
+      std::vector<unsigned char> buffer;
+
+      for (size_t b = start; b < end; b++)
+      {
+        m_Errors[b] = 0;
+        FILE* f = fopen(m_FileNames->at(b).toLatin1().data(), "wb");
+        if (NULL == f)
+        {
+          m_Errors[b] = -1;
+          continue;
+        }
+
+        int64_t nFaces = m_Buckets->getNumberOfFaces(b);
+        const int64_t* faces = m_Buckets->getFaces(b);
+
+        // The triangle count is known up front, so the header is complete from the start
+        unsigned char header[84];
+        ::memset(header, 0, 84);
+        QByteArray headerText = m_Headers->at(b).toLatin1();
+        ::memcpy(header, headerText.data(), headerText.size() < 80 ? headerText.size() : 80);
+        int32_t triCount = static_cast<int32_t>(nFaces);
+        ::memcpy(header + 80, &triCount, 4);
+        if (fwrite(header, 1, 84, f) != 84) { m_Errors[b] = -2; }
+
+        for (int64_t t0 = 0; t0 < nFaces && m_Errors[b] == 0; t0 += k_TrianglesPerWrite)
+        {
+          int64_t t1 = t0 + static_cast<int64_t>(k_TrianglesPerWrite);
+          if (t1 > nFaces) { t1 = nFaces; }
+          buffer.resize(static_cast<size_t>(t1 - t0) * 50);
+          for (int64_t t = t0; t < t1; t++)
+          {
+            packTriangle(faces[t], &(buffer.front()) + (t - t0) * 50);
+          }
+          if (fwrite(&(buffer.front()), 1, buffer.size(), f) != buffer.size()) { m_Errors[b] = -2; }
+        }
+        fclose(f);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const float* m_Nodes;
+    const int64_t* m_Triangles;
+    const FeatureFaceBuckets* m_Buckets;
+    const QVector<QString>* m_FileNames;
+    const QVector<QString>* m_Headers;
+    int32_t* m_Errors;
+
+    /**
+     * @brief packTriangle Fills the 50 byte STL record of an encoded face entry
+     */
+    void packTriangle(int64_t entry, unsigned char* data) const
+    {
+      float normal[3] = { 0.0f, 0.0f, 0.0f };
+      float vert1[3] = { 0.0f, 0.0f, 0.0f };
+      float vert2[3] = { 0.0f, 0.0f, 0.0f };
+      float vert3[3] = { 0.0f, 0.0f, 0.0f };
+      float u[3] = { 0.0f, 0.0f, 0.0f }, w[3] = { 0.0f, 0.0f, 0.0f };
+      uint16_t attrByteCount = 0;
+
+      int64_t t = entry / 2;
+      int64_t nId0 = m_Triangles[t * 3];
+      int64_t nId1 = m_Triangles[t * 3 + 1];
+      int64_t nId2 = m_Triangles[t * 3 + 2];
+      if ((entry & 1) == 1)
+      {
+        // Write it using backward spin
+        int64_t temp = nId1;
+        nId1 = nId2;
+        nId2 = temp;
+      }
+
+      for (int32_t i = 0; i < 3; i++)
+      {
+        vert1[i] = m_Nodes[nId0 * 3 + i];
+        vert2[i] = m_Nodes[nId1 * 3 + i];
+        vert3[i] = m_Nodes[nId2 * 3 + i];
+        u[i] = vert2[i] - vert1[i];
+        w[i] = vert3[i] - vert1[i];
+      }
+
+      normal[0] = u[1] * w[2] - u[2] * w[1];
+      normal[1] = u[2] * w[0] - u[0] * w[2];
+      normal[2] = u[0] * w[1] - u[1] * w[0];
+
+      float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      normal[0] = normal[0] / length;
+      normal[1] = normal[1] / length;
+      normal[2] = normal[2] / length;
+
+      ::memcpy(data, normal, 12);
+      ::memcpy(data + 12, vert1, 12);
+      ::memcpy(data + 24, vert2, 12);
+      ::memcpy(data + 36, vert3, 12);
+      ::memcpy(data + 48, &attrByteCount, 2);
+    }
+};
+
+#endif /* _StlFeatureWriter_hpp_ */
@@ -0,0 +1,226 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdio.h>
+
+#include <iostream>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "IO/IOFilters/util/FormattedOutputWriter.hpp"
+
+#include "IOTestFileLocations.h"
+
+/**
+ * @brief Formats a node line the way the Abaqus node file does: "%lu, %f, %f, %f\n"
+ */
+class NodeLineFormatter
+{
+  public:
+    NodeLineFormatter(size_t* dims, float* origin, float* spacing) :
+      m_Dims(dims),
+      m_Origin(origin),
+      m_Spacing(spacing)
+    {}
+    virtual ~NodeLineFormatter() {}
+
+    void format(size_t node, FormattedOutputBuffer& buffer) const
+    {
+      buffer.appendUInt(node + 1);
+      buffer.append(", ");
+      buffer.appendFloat(m_Origin[0] + ((node % m_Dims[0]) * m_Spacing[0]));
+      buffer.append(", ");
+      buffer.appendFloat(m_Origin[1] + (((node / m_Dims[0]) % m_Dims[1]) * m_Spacing[1]));
+      buffer.append(", ");
+      buffer.appendFloat(m_Origin[2] + ((node / (m_Dims[0] * m_Dims[1])) * m_Spacing[2]));
+      buffer.append('\n');
+    }
+
+  private:
+    size_t* m_Dims;
+    float* m_Origin;
+    float* m_Spacing;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+#if REMOVE_TEST_FILES
+  QFile::remove(UnitTest::FormattedOutputWriterTest::TestFile);
+  QFile::remove(UnitTest::FormattedOutputWriterTest::ReferenceFile);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray ReadFile(const QString& fileName)
+{
+  QFile file(fileName);
+  if (file.open(QIODevice::ReadOnly) == false) { return QByteArray(); }
+  return file.readAll();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CheckFloat(float value)
+{
+  char expected[512];
+  snprintf(expected, sizeof(expected), "%f", value);
+  FormattedOutputBuffer buffer;
+  buffer.appendFloat(value);
+  QByteArray actual(buffer.data(), static_cast<int>(buffer.size()));
+  DREAM3D_REQUIRE_EQUAL(QString(actual), QString(expected))
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFormattedOutputBuffer()
+{
+  // Values that exercise rounding, ties, signs and the snprintf fallback
+  float values[] = { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 1.0f / 128.0f, 3.0f / 128.0f, -5.0f / 128.0f, 0.0000005f, -0.0000004f,
+                     0.1f, 0.25f, 123.456789f, -98765.4321f, 999999.9f, 16777216.0f, 1.0e11f, 1.0e12f, -3.0e20f, 1.0e-30f
+                   };
+  for (size_t i = 0; i < sizeof(values) / sizeof(float); i++)
+  {
+    CheckFloat(values[i]);
+  }
+
+  // Walk through a large range of bit patterns, which covers every exponent
+  for (uint32_t bits = 0; bits < 0xFFFFFFFFu - 65521u; bits += 65521u)
+  {
+    float value = 0.0f;
+    ::memcpy(&value, &bits, sizeof(float));
+    CheckFloat(value);
+  }
+
+  FormattedOutputBuffer buffer;
+  buffer.appendInt(0);
+  buffer.append(' ');
+  buffer.appendInt(-2147483647 - 1);
+  buffer.append(' ');
+  buffer.appendInt(-9223372036854775807LL - 1);
+  buffer.append(' ');
+  buffer.appendUInt(18446744073709551615ULL);
+  QByteArray actual(buffer.data(), static_cast<int>(buffer.size()));
+  DREAM3D_REQUIRE_EQUAL(QString(actual), QString("0 -2147483648 -9223372036854775808 18446744073709551615"))
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//  Writes the nodes of a volume with fprintf and with the FormattedOutputWriter, checks that the files are identical
+//  and prints the throughput of both
+// -----------------------------------------------------------------------------
+int TestWriterMatchesFprintf()
+{
+  size_t dims[3] = { 161, 161, 161 };
+  float origin[3] = { -10.0f, 0.25f, 3.0f };
+  float spacing[3] = { 0.1f, 0.35f, 1.0f / 3.0f };
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+  qint64 start = QDateTime::currentMSecsSinceEpoch();
+  FILE* f = fopen(UnitTest::FormattedOutputWriterTest::ReferenceFile.toLatin1().data(), "wb");
+  DREAM3D_REQUIRE_VALID_POINTER(f)
+  for (size_t z = 0; z < dims[2]; z++)
+  {
+    for (size_t y = 0; y < dims[1]; y++)
+    {
+      for (size_t x = 0; x < dims[0]; x++)
+      {
+        size_t node = (z * dims[1] + y) * dims[0] + x + 1;
+        fprintf(f, "%llu, %f, %f, %f\n", static_cast<unsigned long long int>(node), origin[0] + (x * spacing[0]), origin[1] + (y * spacing[1]), origin[2] + (z * spacing[2]));
+      }
+    }
+  }
+  fclose(f);
+  qint64 fprintfMillis = QDateTime::currentMSecsSinceEpoch() - start;
+
+  start = QDateTime::currentMSecsSinceEpoch();
+  f = fopen(UnitTest::FormattedOutputWriterTest::TestFile.toLatin1().data(), "wb");
+  DREAM3D_REQUIRE_VALID_POINTER(f)
+  NodeLineFormatter formatter(dims, origin, spacing);
+  FormattedOutputWriter<NodeLineFormatter> writer(formatter);
+  // Split the range the way the filters do to check the chunk bookkeeping across calls
+  bool written = writer.write(f, 0, totalPoints / 3);
+  written = written && writer.write(f, totalPoints / 3, totalPoints);
+  fclose(f);
+  qint64 writerMillis = QDateTime::currentMSecsSinceEpoch() - start;
+  DREAM3D_REQUIRE_EQUAL(written, true)
+
+  QByteArray reference = ReadFile(UnitTest::FormattedOutputWriterTest::ReferenceFile);
+  QByteArray test = ReadFile(UnitTest::FormattedOutputWriterTest::TestFile);
+  DREAM3D_REQUIRE_EQUAL(test.size(), reference.size())
+  DREAM3D_REQUIRE(test == reference)
+
+  double megaBytes = reference.size() / (1024.0 * 1024.0);
+  std::cout << "  " << totalPoints << " nodes, " << megaBytes << " MB" << std::endl;
+  std::cout << "  fprintf:               " << fprintfMillis << " ms (" << megaBytes * 1000.0 / (fprintfMillis > 0 ? fprintfMillis : 1) << " MB/s)" << std::endl;
+  std::cout << "  FormattedOutputWriter: " << writerMillis << " ms (" << megaBytes * 1000.0 / (writerMillis > 0 ? writerMillis : 1) << " MB/s)" << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("FormattedOutputWriterTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestFormattedOutputBuffer() )
+  DREAM3D_REGISTER_TEST( TestWriterMatchesFprintf() )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -46,6 +46,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/NeighborMisorientationCache.hpp"
 
 // Include the MOC generated file for this class
 #include "moc_BadDataNeighborOrientationCheck.cpp"
@@ -228,12 +229,20 @@ void BadDataNeighborOrientationCheck::execute()
   neighpoints[4] = static_cast<DimType>(dims[0]);
   neighpoints[5] = static_cast<DimType>(dims[0] * dims[1]);
 
-  float w = 10000.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
+  // (x, y, z) offsets of the 6 neighbors, in the same order as neighpoints
+  int64_t neighoffsets[6][3] = { { 0, 0, -1 }, { 0, -1, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+  // Only pairs that involve a bad voxel are ever looked at, and the orientations do not change,
+  // so the face misorientations are found once up front
+  QVector<bool> badVoxels(totalPoints, false);
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    badVoxels[i] = (m_GoodVoxels[i] == false);
+  }
+  int64_t cacheDims[3] = { dims[0], dims[1], dims[2] };
+  NeighborMisorientationCache misorientations(cacheDims, m_Quats, m_CellPhases, m_CrystalStructures, m_OrientationOps,
+                                              m_MisorientationTolerance, NeighborMisorientationCache::FaceRelations);
+  misorientations.compute(badVoxels.data());
 
   QVector<int32_t> neighborCount(totalPoints, 0);
 
@@ -256,14 +265,7 @@ void BadDataNeighborOrientationCheck::execute()
         if (j == 3 && column == (dims[0] - 1)) { good = 0; }
         if (good == 1 && m_GoodVoxels[neighbor] == true)
         {
-          phase1 = m_CrystalStructures[m_CellPhases[i]];
-          QuaternionMathF::Copy(quats[i], q1);
-
-          phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-          QuaternionMathF::Copy(quats[neighbor], q2);
-
-          if (m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0) { w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3); }
-          if (w < m_MisorientationTolerance)
+          if (misorientations.withinTolerance(column, row, plane, neighoffsets[j][0], neighoffsets[j][1], neighoffsets[j][2]) == true)
           {
             neighborCount[i]++;
           }
@@ -302,14 +304,7 @@ void BadDataNeighborOrientationCheck::execute()
             if (j == 3 && column == (dims[0] - 1)) { good = 0; }
             if (good == 1 && m_GoodVoxels[neighbor] == false)
             {
-              phase1 = m_CrystalStructures[m_CellPhases[i]];
-              QuaternionMathF::Copy(quats[i], q1);
-
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              QuaternionMathF::Copy(quats[neighbor], q2);
-
-              if (m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0) { w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3); }
-              if (w < m_MisorientationTolerance)
+              if (misorientations.withinTolerance(column, row, plane, neighoffsets[j][0], neighoffsets[j][1], neighoffsets[j][2]) == true)
               {
                 neighborCount[neighbor]++;
               }
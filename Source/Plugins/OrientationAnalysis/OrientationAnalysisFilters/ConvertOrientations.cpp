@@ -232,8 +232,9 @@ void generateRepresentation(ConvertOrientations* filter, typename DataArray<T>::
 
   QVector<typename OCType::OrientationType> ocTypes = OCType::GetOrientationTypes();
 
+  // Convert directly into the output array so that no temporary array of the full size is needed
   converters[filter->getInputType()]->setInputData(inputOrientations);
-  converters[filter->getInputType()]->convertRepresentationTo(ocTypes[filter->getOutputType()]);
+  converters[filter->getInputType()]->convertRepresentationTo(ocTypes[filter->getOutputType()], outputOrientations);
 
   ArrayType output = converters[filter->getInputType()]->getOutputData();
   if(NULL == output.get())
@@ -244,7 +245,7 @@ void generateRepresentation(ConvertOrientations* filter, typename DataArray<T>::
     return;
   }
 
-  if(!output->copyIntoArray(outputOrientations) )
+  if(output != outputOrientations && !output->copyIntoArray(outputOrientations) )
   {
     QString ss = QObject::tr("There was an error copying the final results into the output array.");
     filter->setErrorCondition(-1003);
@@ -36,12 +36,21 @@
 
 #include "FindAvgOrientations.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
@@ -51,6 +60,103 @@
 // Include the MOC generated file for this class
 #include "moc_FindAvgOrientations.cpp"
 
+/**
+ * @brief The FindAvgOrientationsImpl class averages the orientations of a range of features. The cells of each
+ * feature are visited in increasing index order, so the running average each cell is brought next to is the same
+ * as in a single sweep over all the cells, no matter how the features are split across threads. If an average
+ * misorientation array is given, the spread of each feature about its new average is found while its cells are
+ * still at hand.
+ */
+class FindAvgOrientationsImpl
+{
+  public:
+    FindAvgOrientationsImpl(const std::vector<int64_t>& featureCellStart, const std::vector<int64_t>& featureCells,
+                            QuatF* quats, int32_t* cellPhases, uint32_t* crystalStructures,
+                            QVector<SpaceGroupOps::Pointer> orientationOps, QuatF* avgQuats, float* featureEulerAngles,
+                            float* featureAvgMisorientations) :
+      m_FeatureCellStart(featureCellStart),
+      m_FeatureCells(featureCells),
+      m_Quats(quats),
+      m_CellPhases(cellPhases),
+      m_CrystalStructures(crystalStructures),
+      m_OrientationOps(orientationOps),
+      m_AvgQuats(avgQuats),
+      m_FeatureEulerAngles(featureEulerAngles),
+      m_FeatureAvgMisorientations(featureAvgMisorientations)
+    {}
+    virtual ~FindAvgOrientationsImpl() {}
+
+    void find(size_t start, size_t end) const
+    {
+      QuatF voxquat = QuaternionMathF::New();
+      QuatF curavgquat = QuaternionMathF::New();
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      for (size_t i = start; i < end; i++)
+      {
+        QuatF& avgQuat = m_AvgQuats[i];
+        QuaternionMathF::ElementWiseAssign(avgQuat, 0.0);
+        float count = 0.0f;
+        for (int64_t c = m_FeatureCellStart[i]; c < m_FeatureCellStart[i + 1]; c++)
+        {
+          int64_t point = m_FeatureCells[c];
+          count += 1;
+          int32_t phase = m_CellPhases[point];
+          QuaternionMathF::Copy(m_Quats[point], voxquat);
+          QuaternionMathF::Copy(avgQuat, curavgquat);
+          QuaternionMathF::ScalarDivide(curavgquat, count);
+
+          if (count == 1)
+          {
+            QuaternionMathF::Identity(curavgquat);
+          }
+          m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
+          QuaternionMathF::Add(avgQuat, voxquat, avgQuat);
+        }
+
+        if (count == 0)
+        {
+          QuaternionMathF::Identity(avgQuat);
+        }
+        QuaternionMathF::ScalarDivide(avgQuat, count);
+        QuaternionMathF::UnitQuaternion(avgQuat);
+
+        FOrientArrayType eu(m_FeatureEulerAngles + (3 * i), 3);
+        FOrientTransformsType::qu2eu(FOrientArrayType(avgQuat), eu);
+
+        if (NULL != m_FeatureAvgMisorientations)
+        {
+          float totalMiso = 0.0f;
+          for (int64_t c = m_FeatureCellStart[i]; c < m_FeatureCellStart[i + 1]; c++)
+          {
+            int64_t point = m_FeatureCells[c];
+            QuaternionMathF::Copy(m_Quats[point], voxquat);
+            QuaternionMathF::Copy(avgQuat, curavgquat);
+            totalMiso += SIMPLib::Constants::k_180OverPi * m_OrientationOps[m_CrystalStructures[m_CellPhases[point]]]->getMisoQuat(voxquat, curavgquat, n1, n2, n3);
+          }
+          m_FeatureAvgMisorientations[i] = (count == 0) ? 0.0f : totalMiso / count;
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      find(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const std::vector<int64_t>& m_FeatureCellStart;
+    const std::vector<int64_t>& m_FeatureCells;
+    QuatF* m_Quats;
+    int32_t* m_CellPhases;
+    uint32_t* m_CrystalStructures;
+    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+    QuatF* m_AvgQuats;
+    float* m_FeatureEulerAngles;
+    float* m_FeatureAvgMisorientations;
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -64,12 +170,15 @@ FindAvgOrientations::FindAvgOrientations() :
   m_CrystalStructuresArrayPath("", "", ""),
   m_AvgQuatsArrayPath("", "", ""),
   m_AvgEulerAnglesArrayPath("", "", ""),
+  m_FindAvgMisorientations(false),
+  m_FeatureAvgMisorientationsArrayName(DREAM3D::FeatureData::FeatureAvgMisorientations),
   m_FeatureIds(NULL),
   m_CellPhases(NULL),
   m_Quats(NULL),
   m_CrystalStructures(NULL),
   m_FeatureEulerAngles(NULL),
-  m_AvgQuats(NULL)
+  m_AvgQuats(NULL),
+  m_FeatureAvgMisorientations(NULL)
 {
   m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
 
@@ -89,6 +198,8 @@ FindAvgOrientations::~FindAvgOrientations()
 void FindAvgOrientations::setupFilterParameters()
 {
   FilterParameterVector parameters;
+  QStringList linkedProps("FeatureAvgMisorientationsArrayName");
+  parameters.push_back(LinkedBooleanFilterParameter::New("Find Average Misorientation Per Feature", "FindAvgMisorientations", getFindAvgMisorientations(), linkedProps, FilterParameter::Parameter));
   parameters.push_back(SeparatorFilterParameter::New("Element Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(DREAM3D::TypeNames::Int32, 1, DREAM3D::AttributeMatrixObjectType::Element);
@@ -117,6 +228,7 @@ void FindAvgOrientations::setupFilterParameters()
     DataArrayCreationFilterParameter::RequirementType req = DataArrayCreationFilterParameter::CreateRequirement(DREAM3D::AttributeMatrixObjectType::Feature);
     parameters.push_back(DataArrayCreationFilterParameter::New("Average Euler Angles", "AvgEulerAnglesArrayPath", getAvgEulerAnglesArrayPath(), FilterParameter::CreatedArray, req));
   }
+  parameters.push_back(StringFilterParameter::New("Average Misorientations", "FeatureAvgMisorientationsArrayName", getFeatureAvgMisorientationsArrayName(), FilterParameter::CreatedArray));
   setFilterParameters(parameters);
 }
 
@@ -132,6 +244,8 @@ void FindAvgOrientations::readFilterParameters(AbstractFilterParametersReader* r
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath() ) );
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath() ) );
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath() ) );
+  setFeatureAvgMisorientationsArrayName(reader->readString("FeatureAvgMisorientationsArrayName", getFeatureAvgMisorientationsArrayName() ) );
+  setFindAvgMisorientations( reader->readValue("FindAvgMisorientations", getFindAvgMisorientations()) );
   reader->closeFilterGroup();
 }
 
@@ -148,6 +262,8 @@ int FindAvgOrientations::writeFilterParameters(AbstractFilterParametersWriter* w
   SIMPL_FILTER_WRITE_PARAMETER(QuatsArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(CellPhasesArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(FeatureIdsArrayPath)
+  SIMPL_FILTER_WRITE_PARAMETER(FeatureAvgMisorientationsArrayName)
+  SIMPL_FILTER_WRITE_PARAMETER(FindAvgMisorientations)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -188,6 +304,15 @@ void FindAvgOrientations::dataCheck()
   { m_FeatureEulerAngles = m_FeatureEulerAnglesPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
 
   cDims[0] = 1;
+  m_FeatureAvgMisorientations = NULL;
+  if(m_FindAvgMisorientations == true)
+  {
+    DataArrayPath tempPath(getAvgQuatsArrayPath().getDataContainerName(), getAvgQuatsArrayPath().getAttributeMatrixName(), getFeatureAvgMisorientationsArrayName());
+    m_FeatureAvgMisorientationsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if( NULL != m_FeatureAvgMisorientationsPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
+    { m_FeatureAvgMisorientations = m_FeatureAvgMisorientationsPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
   m_CrystalStructuresPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter>(this, getCrystalStructuresArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
   if( NULL != m_CrystalStructuresPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
   { m_CrystalStructures = m_CrystalStructuresPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
@@ -220,49 +345,52 @@ void FindAvgOrientations::execute()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
-  std::vector<float> counts(totalFeatures, 0.0f);
-
-  int32_t phase = 0;
-  QuatF voxquat = QuaternionMathF::New();
-  QuatF curavgquat = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
-  for (size_t i = 1; i < totalFeatures; i++)
-  {
-    QuaternionMathF::ElementWiseAssign(avgQuats[i], 0.0);
-  }
-
+  // Gather the cells of each feature, keeping them in increasing order
+  std::vector<int64_t> featureCellStart(totalFeatures + 1, 0);
   for (size_t i = 0; i < totalPoints; i++)
   {
     if (m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
     {
-      counts[m_FeatureIds[i]] += 1;
-      phase = m_CellPhases[i];
-      QuaternionMathF::Copy(quats[i], voxquat);
-      QuaternionMathF::Copy(avgQuats[m_FeatureIds[i]], curavgquat);
-      QuaternionMathF::ScalarDivide(curavgquat, counts[m_FeatureIds[i]]);
-
-      if (counts[m_FeatureIds[i]] == 1)
+      featureCellStart[m_FeatureIds[i] + 1]++;
+    }
+  }
+  for (size_t i = 0; i < totalFeatures; i++)
+  {
+    featureCellStart[i + 1] += featureCellStart[i];
+  }
+  std::vector<int64_t> featureCells(featureCellStart[totalFeatures], 0);
+  {
+    std::vector<int64_t> next(featureCellStart.begin(), featureCellStart.end() - 1);
+    for (size_t i = 0; i < totalPoints; i++)
+    {
+      if (m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
       {
-        QuaternionMathF::Identity(curavgquat);
+        featureCells[next[m_FeatureIds[i]]++] = static_cast<int64_t>(i);
       }
-      m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
-      QuaternionMathF::Add(avgQuats[m_FeatureIds[i]], voxquat, avgQuats[m_FeatureIds[i]]);
     }
   }
 
-  for (size_t i = 1; i < totalFeatures; i++)
+  if (totalFeatures < 2)
   {
-    if (counts[i] == 0)
-    {
-      QuaternionMathF::Identity(avgQuats[i]);
-    }
-    QuaternionMathF::ScalarDivide(avgQuats[i], counts[i]);
-    QuaternionMathF::UnitQuaternion(avgQuats[i]);
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
 
-    FOrientArrayType eu(m_FeatureEulerAngles + (3 * i), 3);
-    FOrientTransformsType::qu2eu(FOrientArrayType(avgQuats[i]), eu);
+  FindAvgOrientationsImpl serial(featureCellStart, featureCells, quats, m_CellPhases, m_CrystalStructures, m_OrientationOps, avgQuats, m_FeatureEulerAngles, m_FeatureAvgMisorientations);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures), serial, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    serial.find(1, totalFeatures);
   }
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
@@ -74,6 +74,12 @@ class FindAvgOrientations : public AbstractFilter
     SIMPL_FILTER_PARAMETER(DataArrayPath, AvgEulerAnglesArrayPath)
     Q_PROPERTY(DataArrayPath AvgEulerAnglesArrayPath READ getAvgEulerAnglesArrayPath WRITE setAvgEulerAnglesArrayPath)
 
+    SIMPL_FILTER_PARAMETER(bool, FindAvgMisorientations)
+    Q_PROPERTY(bool FindAvgMisorientations READ getFindAvgMisorientations WRITE setFindAvgMisorientations)
+
+    SIMPL_FILTER_PARAMETER(QString, FeatureAvgMisorientationsArrayName)
+    Q_PROPERTY(QString FeatureAvgMisorientationsArrayName READ getFeatureAvgMisorientationsArrayName WRITE setFeatureAvgMisorientationsArrayName)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -165,6 +171,7 @@ class FindAvgOrientations : public AbstractFilter
 
     DEFINE_DATAARRAY_VARIABLE(float, FeatureEulerAngles)
     DEFINE_DATAARRAY_VARIABLE(float, AvgQuats)
+    DEFINE_DATAARRAY_VARIABLE(float, FeatureAvgMisorientations)
 
     FindAvgOrientations(const FindAvgOrientations&); // Copy Constructor Not Implemented
     void operator=(const FindAvgOrientations&); // Operator '=' Not Implemented
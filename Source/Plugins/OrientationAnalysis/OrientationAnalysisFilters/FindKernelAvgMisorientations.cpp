@@ -36,6 +36,17 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -52,6 +63,175 @@
 // Include the MOC generated file for this class
 #include "moc_FindKernelAvgMisorientations.cpp"
 
+/**
+ * @brief The FindKernelAvgMisorientationsImpl class implements a threaded algorithm that computes the kernel average
+ * misorientation of every cell. The volume is split into tiles of whole X rows, and each tile is swept in memory order.
+ * A misorientation between two cells of the same tile is computed once and added to the kernel sums of both cells.
+ * Only pairs that cross the tile boundary are computed again by the neighboring tile.
+ */
+class FindKernelAvgMisorientationsImpl
+{
+#if (CMP_SIZEOF_SIZE_T == 4)
+    typedef int32_t DimType;
+#else
+    typedef int64_t DimType;
+#endif
+
+    int32_t* m_FeatureIds;
+    int32_t* m_CellPhases;
+    float* m_Quats;
+    uint32_t* m_CrystalStructures;
+    float* m_KernelAverageMisorientations;
+    DimType m_Dims[3];
+    DimType m_TileRows;
+    DimType m_TilePlanes;
+    IntVec3_t m_KernelSize;
+    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+
+  public:
+    FindKernelAvgMisorientationsImpl(int32_t* featureIds, int32_t* cellPhases, float* quats, uint32_t* crystalStructures, float* kam,
+                                     size_t dims[3], size_t tileRows, size_t tilePlanes, IntVec3_t kernelSize) :
+      m_FeatureIds(featureIds),
+      m_CellPhases(cellPhases),
+      m_Quats(quats),
+      m_CrystalStructures(crystalStructures),
+      m_KernelAverageMisorientations(kam),
+      m_TileRows(static_cast<DimType>(tileRows)),
+      m_TilePlanes(static_cast<DimType>(tilePlanes)),
+      m_KernelSize(kernelSize)
+    {
+      m_Dims[0] = static_cast<DimType>(dims[0]);
+      m_Dims[1] = static_cast<DimType>(dims[1]);
+      m_Dims[2] = static_cast<DimType>(dims[2]);
+      m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
+    }
+
+    virtual ~FindKernelAvgMisorientationsImpl() {}
+
+    size_t getNumberOfTiles() const
+    {
+      return static_cast<size_t>(((m_Dims[1] + m_TileRows - 1) / m_TileRows) * ((m_Dims[2] + m_TilePlanes - 1) / m_TilePlanes));
+    }
+
+    void generate(size_t start, size_t end) const
+    {
+      DimType xPoints = m_Dims[0];
+      DimType yPoints = m_Dims[1];
+      DimType zPoints = m_Dims[2];
+      DimType rowTiles = (yPoints + m_TileRows - 1) / m_TileRows;
+
+      std::vector<float> sums;
+      std::vector<int32_t> counts;
+
+      for (size_t tile = start; tile < end; tile++)
+      {
+        DimType row0 = static_cast<DimType>(tile % rowTiles) * m_TileRows;
+        DimType row1 = std::min(row0 + m_TileRows, yPoints);
+        DimType plane0 = static_cast<DimType>(tile / rowTiles) * m_TilePlanes;
+        DimType plane1 = std::min(plane0 + m_TilePlanes, zPoints);
+        DimType tileRows = row1 - row0;
+
+        sums.assign(static_cast<size_t>(xPoints * tileRows * (plane1 - plane0)), 0.0f);
+        counts.assign(sums.size(), 0);
+
+        for (DimType plane = plane0; plane < plane1; plane++)
+        {
+          for (DimType row = row0; row < row1; row++)
+          {
+            for (DimType col = 0; col < xPoints; col++)
+            {
+              DimType point = (plane * xPoints * yPoints) + (row * xPoints) + col;
+              if (m_FeatureIds[point] <= 0 || m_CellPhases[point] <= 0) { continue; }
+              size_t tilePoint = static_cast<size_t>(((plane - plane0) * tileRows + (row - row0)) * xPoints + col);
+              accumulateKernel(point, col, row, plane, row0, row1, plane0, plane1, tilePoint, sums, counts);
+            }
+          }
+        }
+
+        for (DimType plane = plane0; plane < plane1; plane++)
+        {
+          for (DimType row = row0; row < row1; row++)
+          {
+            for (DimType col = 0; col < xPoints; col++)
+            {
+              DimType point = (plane * xPoints * yPoints) + (row * xPoints) + col;
+              size_t tilePoint = static_cast<size_t>(((plane - plane0) * tileRows + (row - row0)) * xPoints + col);
+              if (m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
+              {
+                m_KernelAverageMisorientations[point] = 0.0f;
+              }
+              else if (m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
+              {
+                // The kernel always holds the cell itself, so the count is never zero here
+                m_KernelAverageMisorientations[point] = sums[tilePoint] / static_cast<float>(counts[tilePoint]);
+              }
+            }
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    /**
+     * @brief accumulateKernel Adds the misorientations between the cell at point and the cells of its kernel that
+     * belong to the same Feature. Pairs inside the tile are only computed from the cell that comes first in memory.
+     */
+    void accumulateKernel(DimType point, DimType col, DimType row, DimType plane, DimType row0, DimType row1, DimType plane0, DimType plane1,
+                          size_t tilePoint, std::vector<float>& sums, std::vector<int32_t>& counts) const
+    {
+      DimType xPoints = m_Dims[0];
+      DimType yPoints = m_Dims[1];
+      DimType zPoints = m_Dims[2];
+      DimType tileRows = row1 - row0;
+      QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+      QuatF q1 = QuaternionMathF::New();
+      QuatF q2 = QuaternionMathF::New();
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      float w = 0.0f;
+
+      QuaternionMathF::Copy(quats[point], q1);
+      uint32_t phase1 = m_CrystalStructures[m_CellPhases[point]];
+
+      for (DimType j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
+      {
+        if (plane + j < 0 || plane + j > zPoints - 1) { continue; }
+        for (DimType k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
+        {
+          if (row + k < 0 || row + k > yPoints - 1) { continue; }
+          for (DimType l = -m_KernelSize.x; l < m_KernelSize.x + 1; l++)
+          {
+            if (col + l < 0 || col + l > xPoints - 1) { continue; }
+            DimType neighbor = point + (j * xPoints * yPoints) + (k * xPoints) + l;
+            if (m_FeatureIds[point] != m_FeatureIds[neighbor]) { continue; }
+
+            bool inTile = (row + k >= row0 && row + k < row1 && plane + j >= plane0 && plane + j < plane1);
+            // A pair with a valid neighbor earlier in the same tile was already added when that neighbor was visited
+            if (inTile == true && neighbor < point && m_CellPhases[neighbor] > 0) { continue; }
+
+            QuaternionMathF::Copy(quats[neighbor], q2);
+            w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+            w = w * (180.0f / SIMPLib::Constants::k_Pi);
+            sums[tilePoint] += w;
+            counts[tilePoint]++;
+            if (inTile == true && neighbor > point)
+            {
+              size_t tileNeighbor = static_cast<size_t>(((plane + j - plane0) * tileRows + (row + k - row0)) * xPoints + col + l);
+              sums[tileNeighbor] += w;
+              counts[tileNeighbor]++;
+            }
+          }
+        }
+      }
+    }
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -212,86 +392,38 @@ void FindKernelAvgMisorientations::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  int32_t numVoxel = 0; // number of voxels in the feature...
-  bool good = false;
-
-  float w = 0.0f, totalmisorientation = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = Ebsd::CrystalStructure::UnknownCrystalStructure;
-  uint32_t phase2 = Ebsd::CrystalStructure::UnknownCrystalStructure;
   size_t udims[3] = { 0, 0, 0 };
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
+
+  if (udims[0] == 0 || udims[1] == 0 || udims[2] == 0) { return; }
+
+  // Each tile keeps a float sum and an int32 count for every one of its cells, so a tile of whole X rows
+  // needs udims[0] * rows * planes * 8 bytes of scratch. Size the square tile cross section so that this
+  // scratch stays around 256KB. Very wide rows still get at least 4 x 4 rows so that the misorientations
+  // computed twice across the tile borders do not dominate, and narrow ones stop at 32 x 32 rows.
+  const size_t k_TileScratchBytes = 256 * 1024;
+  const size_t bytesPerCell = sizeof(float) + sizeof(int32_t);
+  size_t tileCrossSection = std::max<size_t>(k_TileScratchBytes / (bytesPerCell * udims[0]), 1);
+  size_t tileSide = static_cast<size_t>(std::sqrt(static_cast<double>(tileCrossSection)));
+  tileSide = std::min<size_t>(std::max<size_t>(tileSide, 4), 32);
+  size_t tileRows = std::min<size_t>(udims[1], tileSide);
+  size_t tilePlanes = std::min<size_t>(udims[2], tileSide);
+
+  FindKernelAvgMisorientationsImpl serial(m_FeatureIds, m_CellPhases, m_Quats, m_CrystalStructures, m_KernelAverageMisorientations,
+                                          udims, tileRows, tilePlanes, m_KernelSize);
+  size_t numTiles = serial.getNumberOfTiles();
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTiles, 1), serial, tbb::simple_partitioner());
+  }
+  else
 #endif
-  DimType xPoints = static_cast<DimType>(udims[0]);
-  DimType yPoints = static_cast<DimType>(udims[1]);
-  DimType zPoints = static_cast<DimType>(udims[2]);
-  DimType point = 0;
-  size_t neighbor = 0;
-  DimType jStride = 0;
-  DimType kStride = 0;
-
-  for (DimType col = 0; col < xPoints; col++)
   {
-    for (DimType row = 0; row < yPoints; row++)
-    {
-      for (DimType plane = 0; plane < zPoints; plane++)
-      {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if (m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
-        {
-          totalmisorientation = 0.0f;
-          numVoxel = 0;
-          QuaternionMathF::Copy(quats[point], q1);
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for (int32_t j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for (int32_t k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
-            {
-              kStride = k * xPoints;
-              for (int32_t l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
-              {
-                good = true;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if (plane + j < 0) { good = false; }
-                else if (plane + j > zPoints - 1) { good = false; }
-                else if (row + k < 0) { good = false; }
-                else if (row + k > yPoints - 1) { good = false; }
-                else if (col + l < 0) { good = false; }
-                else if (col + l > xPoints - 1) { good = false; }
-                if (good == true && m_FeatureIds[point] == m_FeatureIds[neighbor])
-                {
-                  w = std::numeric_limits<float>::max();
-                  QuaternionMathF::Copy(quats[neighbor], q2);
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                  w = w * (180.0f / SIMPLib::Constants::k_Pi);
-                  totalmisorientation = totalmisorientation + w;
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if (numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0.0f;
-          }
-        }
-        if (m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
-        {
-          m_KernelAverageMisorientations[point] = 0.0f;
-        }
-      }
-    }
+    serial.generate(0, numTiles);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
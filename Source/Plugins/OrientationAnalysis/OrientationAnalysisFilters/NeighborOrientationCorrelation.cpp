@@ -46,6 +46,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/NeighborMisorientationCache.hpp"
 
 // Include the MOC generated file for this class
 #include "moc_NeighborOrientationCorrelation.cpp"
@@ -218,12 +219,10 @@ void NeighborOrientationCorrelation::execute()
     static_cast<int64_t>(udims[2]),
   };
 
-  size_t count = 1;
   int32_t best = 0;
   bool good = true;
   bool good2 = true;
   int64_t neighbor = 0;
-  int64_t neighbor2 = 0;
   int64_t column = 0, row = 0, plane = 0;
 
   int64_t neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
@@ -233,17 +232,18 @@ void NeighborOrientationCorrelation::execute()
   neighpoints[3] = static_cast<int64_t>(1);
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
+  // (x, y, z) offsets of the 6 neighbors, in the same order as neighpoints
+  int64_t neighoffsets[6][3] = { { 0, 0, -1 }, { 0, -1, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
 
-  float w = std::numeric_limits<float>::max();
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
-
-  QVector<int32_t> neighborDiffCount(totalPoints, 0);
   QVector<int32_t> neighborSimCount(6, 0);
   QVector<int64_t> bestNeighbor(totalPoints, -1);
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+
+  // Find which pairs of face neighbors are within the tolerance once; only the cells whose
+  // tuples are copied at the end of a level need to be evaluated again
+  NeighborMisorientationCache misorientations(dims, m_Quats, m_CellPhases, m_CrystalStructures, m_OrientationOps,
+                                              m_MisorientationTolerance, NeighborMisorientationCache::AllRelations);
+  misorientations.compute();
+  std::vector<int64_t> changedCells;
 
   int32_t startLevel = 6;
   for (int32_t currentLevel = startLevel; currentLevel > m_Level; currentLevel--)
@@ -265,14 +265,12 @@ void NeighborOrientationCorrelation::execute()
 
       if (m_ConfidenceIndex[i] < m_MinConfidence)
       {
-        count = 0;
         column = i % dims[0];
         row = (i / dims[0]) % dims[1];
         plane = i / (dims[0] * dims[1]);
         for (int32_t j = 0; j < 6; j++)
         {
           good = true;
-          neighbor = int64_t(i) + neighpoints[j];
           if (j == 0 && plane == 0) { good = false; }
           if (j == 5 && plane == (dims[2] - 1)) { good = false; }
           if (j == 1 && row == 0) { good = false; }
@@ -281,43 +279,22 @@ void NeighborOrientationCorrelation::execute()
           if (j == 3 && column == (dims[0] - 1)) { good = false; }
           if (good == true)
           {
-            phase1 = m_CrystalStructures[m_CellPhases[i]];
-            QuaternionMathF::Copy(quats[i], q1);
-
-            phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-            QuaternionMathF::Copy(quats[neighbor], q2);
-
-            if (m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0) { w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3); }
-            if (w > m_MisorientationTolerance)
-            {
-              neighborDiffCount[i]++;
-            }
             for (int32_t k = j + 1; k < 6; k++)
             {
               good2 = true;
-              neighbor2 = int64_t(i) + neighpoints[k];
               if (k == 0 && plane == 0) { good2 = false; }
               if (k == 5 && plane == (dims[2] - 1)) { good2 = false; }
               if (k == 1 && row == 0) { good2 = false; }
               if (k == 4 && row == (dims[1] - 1)) { good2 = false; }
               if (k == 2 && column == 0) { good2 = false; }
               if (k == 3 && column == (dims[0] - 1)) { good2 = false; }
-              if (good2 == true)
+              if (good2 == true && misorientations.withinTolerance(column + neighoffsets[j][0], row + neighoffsets[j][1], plane + neighoffsets[j][2],
+                                                                    neighoffsets[k][0] - neighoffsets[j][0],
+                                                                    neighoffsets[k][1] - neighoffsets[j][1],
+                                                                    neighoffsets[k][2] - neighoffsets[j][2]) == true)
               {
-                phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
-                QuaternionMathF::Copy(quats[neighbor2], q1);
-
-                phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                QuaternionMathF::Copy(quats[neighbor], q2);
-                if (m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
-                {
-                  w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3);
-                }
-                if (w < m_MisorientationTolerance)
-                {
-                  neighborSimCount[j]++;
-                  neighborSimCount[k]++;
-                }
+                neighborSimCount[j]++;
+                neighborSimCount[k]++;
               }
             }
           }
@@ -353,6 +330,7 @@ void NeighborOrientationCorrelation::execute()
     progIncrement = static_cast<int64_t>(totalPoints / 100);
     prog = 1;
     progressInt = 0;
+    changedCells.clear();
     for (size_t i = 0; i < totalPoints; i++)
     {
       if (int64_t(i) > prog)
@@ -370,8 +348,10 @@ void NeighborOrientationCorrelation::execute()
           IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
           p->copyTuple(neighbor, i);
         }
+        changedCells.push_back(static_cast<int64_t>(i));
       }
     }
+    misorientations.update(changedCells);
     currentLevel = currentLevel - 1;
   }
 
@@ -82,6 +82,10 @@ endforeach()
 
 
 
+#-------------
+# These are files that need to be compiled into DREAM3DLib but are NOT filters
+ADD_DREAM3D_SUPPORT_HEADER_SUBDIR(${OrientationAnalysis_SOURCE_DIR} ${_filterGroupName} NeighborMisorientationCache.hpp util)
+
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
 END_FILTER_GROUP(${OrientationAnalysis_BINARY_DIR} "${_filterGroupName}" "OrientationAnalysis")
@@ -0,0 +1,335 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _NeighborMisorientationCache_hpp_
+#define _NeighborMisorientationCache_hpp_
+
+#include <stdint.h>
+
+#include <vector>
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+/**
+ * @brief The NeighborMisorientationCache class records which nearby cells of an image geometry are within a
+ * misorientation tolerance of each other: both cells belong to the same phase (> 0) and their misorientation is
+ * below the tolerance. Each relation is one bit of a per cell mask, stored on the cell from which the relation's
+ * offset points forward, so every pair is evaluated once. Besides the 3 face relations the cache can hold the
+ * relations between the face neighbors of a cell (2 cells apart along an axis, or diagonal in a plane).
+ */
+class NeighborMisorientationCache
+{
+  public:
+    enum Relation
+    {
+      PlusX = 0,
+      PlusY,
+      PlusZ,
+      PlusTwoX,
+      PlusTwoY,
+      PlusTwoZ,
+      PlusXPlusY,
+      PlusXMinusY,
+      PlusXPlusZ,
+      PlusXMinusZ,
+      PlusYPlusZ,
+      PlusYMinusZ,
+      RelationCount
+    };
+
+    /**
+     * @brief Relations between a cell and its 6 face neighbors
+     */
+    static const uint16_t FaceRelations = 0x0007;
+
+    /**
+     * @brief Relations between a cell and its face neighbors, and between each pair of those face neighbors
+     */
+    static const uint16_t AllRelations = 0x0FFF;
+
+    /**
+     * @brief NeighborMisorientationCache
+     * @param dims Dimensions of the image geometry
+     * @param quats Quaternions of the cells
+     * @param cellPhases Phases of the cells
+     * @param crystalStructures Crystal structures of the phases
+     * @param orientationOps Symmetry operators of each crystal structure
+     * @param tolerance Misorientation tolerance in radians
+     * @param relations Bit mask of the Relations to hold
+     */
+    NeighborMisorientationCache(const int64_t dims[3], float* quats, int32_t* cellPhases, uint32_t* crystalStructures,
+                                const QVector<SpaceGroupOps::Pointer>& orientationOps, float tolerance, uint16_t relations) :
+      m_Quats(reinterpret_cast<QuatF*>(quats)),
+      m_CellPhases(cellPhases),
+      m_CrystalStructures(crystalStructures),
+      m_OrientationOps(orientationOps),
+      m_Tolerance(tolerance),
+      m_Relations(relations),
+      m_Active(NULL)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+      static const int32_t offsets[RelationCount][3] =
+      {
+        { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+        { 2, 0, 0 }, { 0, 2, 0 }, { 0, 0, 2 },
+        { 1, 1, 0 }, { 1, -1, 0 }, { 1, 0, 1 }, { 1, 0, -1 }, { 0, 1, 1 }, { 0, 1, -1 }
+      };
+      for (int32_t r = 0; r < RelationCount; r++)
+      {
+        for (int32_t d = 0; d < 3; d++)
+        {
+          m_Offsets[r][d] = offsets[r][d];
+        }
+      }
+      for (int32_t i = 0; i < 125; i++)
+      {
+        m_RelationLookup[i] = -1;
+      }
+      for (int32_t r = 0; r < RelationCount; r++)
+      {
+        if ((m_Relations & (1 << r)) != 0)
+        {
+          m_RelationLookup[lookupIndex(m_Offsets[r][0], m_Offsets[r][1], m_Offsets[r][2])] = r;
+        }
+      }
+    }
+
+    virtual ~NeighborMisorientationCache() {}
+
+    /**
+     * @brief compute Evaluates every relation of every cell in parallel. If active is not NULL, only the pairs
+     * with at least one active cell are evaluated; the others are recorded as not within tolerance.
+     * @param active Optional per cell flags
+     */
+    void compute(const bool* active = NULL)
+    {
+      m_Active = active;
+      size_t totalPoints = static_cast<size_t>(m_Dims[0] * m_Dims[1] * m_Dims[2]);
+      m_Masks.assign(totalPoints, 0);
+      ComputeMasksImpl serial(this, NULL);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), serial, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        serial.compute(0, totalPoints);
+      }
+    }
+
+    /**
+     * @brief update Re-evaluates every relation that involves one of the given cells, for example after their
+     * tuples were overwritten
+     * @param changedCells Cells whose orientation or phase changed
+     */
+    void update(const std::vector<int64_t>& changedCells)
+    {
+      std::vector<int64_t> cells;
+      cells.reserve(changedCells.size() * (RelationCount + 1));
+      for (size_t c = 0; c < changedCells.size(); c++)
+      {
+        int64_t point = changedCells[c];
+        int64_t x = point % m_Dims[0];
+        int64_t y = (point / m_Dims[0]) % m_Dims[1];
+        int64_t z = point / (m_Dims[0] * m_Dims[1]);
+        cells.push_back(point);
+        for (int32_t r = 0; r < RelationCount; r++)
+        {
+          if ((m_Relations & (1 << r)) == 0) { continue; }
+          int64_t bx = x - m_Offsets[r][0], by = y - m_Offsets[r][1], bz = z - m_Offsets[r][2];
+          if (inside(bx, by, bz) == true)
+          {
+            cells.push_back(bx + m_Dims[0] * (by + m_Dims[1] * bz));
+          }
+        }
+      }
+      std::sort(cells.begin(), cells.end());
+      cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+      if (cells.empty()) { return; }
+
+      ComputeMasksImpl serial(this, &cells);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, cells.size()), serial, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        serial.compute(0, cells.size());
+      }
+    }
+
+    /**
+     * @brief withinTolerance Returns whether the cell at (x, y, z) and the cell at (x + dx, y + dy, z + dz) are within
+     * the misorientation tolerance of each other. The offset (or its opposite) must be one of the held Relations;
+     * cells outside the geometry are never within tolerance.
+     */
+    bool withinTolerance(int64_t x, int64_t y, int64_t z, int64_t dx, int64_t dy, int64_t dz) const
+    {
+      if (dx < 0 || (dx == 0 && (dy < 0 || (dy == 0 && dz < 0))))
+      {
+        x += dx;
+        y += dy;
+        z += dz;
+        dx = -dx;
+        dy = -dy;
+        dz = -dz;
+      }
+      if (inside(x, y, z) == false) { return false; }
+      int32_t r = m_RelationLookup[lookupIndex(dx, dy, dz)];
+      if (r < 0) { return false; }
+      return (m_Masks[x + m_Dims[0] * (y + m_Dims[1] * z)] & (1 << r)) != 0;
+    }
+
+  protected:
+    /**
+     * @brief computeMask Evaluates all the held relations of one cell
+     */
+    uint16_t computeMask(int64_t point) const
+    {
+      uint16_t mask = 0;
+      int64_t x = point % m_Dims[0];
+      int64_t y = (point / m_Dims[0]) % m_Dims[1];
+      int64_t z = point / (m_Dims[0] * m_Dims[1]);
+      int32_t phase = m_CellPhases[point];
+      if (phase <= 0) { return mask; }
+      QuatF q1 = QuaternionMathF::New();
+      QuatF q2 = QuaternionMathF::New();
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      for (int32_t r = 0; r < RelationCount; r++)
+      {
+        if ((m_Relations & (1 << r)) == 0) { continue; }
+        int64_t nx = x + m_Offsets[r][0], ny = y + m_Offsets[r][1], nz = z + m_Offsets[r][2];
+        if (inside(nx, ny, nz) == false) { continue; }
+        int64_t neighbor = nx + m_Dims[0] * (ny + m_Dims[1] * nz);
+        if (m_CellPhases[neighbor] != phase) { continue; }
+        if (NULL != m_Active && m_Active[point] == false && m_Active[neighbor] == false) { continue; }
+        QuaternionMathF::Copy(m_Quats[point], q1);
+        QuaternionMathF::Copy(m_Quats[neighbor], q2);
+        float w = m_OrientationOps[m_CrystalStructures[phase]]->getMisoQuat(q1, q2, n1, n2, n3);
+        if (w < m_Tolerance)
+        {
+          mask |= (1 << r);
+        }
+      }
+      return mask;
+    }
+
+    bool inside(int64_t x, int64_t y, int64_t z) const
+    {
+      return (x >= 0 && y >= 0 && z >= 0 && x < m_Dims[0] && y < m_Dims[1] && z < m_Dims[2]);
+    }
+
+    static int32_t lookupIndex(int64_t dx, int64_t dy, int64_t dz)
+    {
+      if (dx < -2 || dy < -2 || dz < -2 || dx > 2 || dy > 2 || dz > 2) { return 62; } // (0, 0, 0) is never a relation
+      return static_cast<int32_t>(((dx + 2) * 5 + (dy + 2)) * 5 + (dz + 2));
+    }
+
+    /**
+     * @brief The ComputeMasksImpl class evaluates the masks of a range of cells, either all the cells or the
+     * listed ones. Each cell writes only its own mask.
+     */
+    class ComputeMasksImpl
+    {
+      public:
+        ComputeMasksImpl(NeighborMisorientationCache* cache, const std::vector<int64_t>* cells) :
+          m_Cache(cache),
+          m_Cells(cells)
+        {}
+        virtual ~ComputeMasksImpl() {}
+
+        void compute(size_t start, size_t end) const
+        {
+          for (size_t i = start; i < end; i++)
+          {
+            int64_t point = (NULL == m_Cells) ? static_cast<int64_t>(i) : (*m_Cells)[i];
+            m_Cache->m_Masks[point] = m_Cache->computeMask(point);
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          compute(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        NeighborMisorientationCache* m_Cache;
+        const std::vector<int64_t>* m_Cells;
+    };
+
+  private:
+    int64_t m_Dims[3];
+    QuatF* m_Quats;
+    int32_t* m_CellPhases;
+    uint32_t* m_CrystalStructures;
+    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+    float m_Tolerance;
+    uint16_t m_Relations;
+    const bool* m_Active;
+    int32_t m_Offsets[RelationCount][3];
+    int32_t m_RelationLookup[125];
+    std::vector<uint16_t> m_Masks;
+
+    NeighborMisorientationCache(const NeighborMisorientationCache&); // Copy Constructor Not Implemented
+    void operator=(const NeighborMisorientationCache&); // Operator '=' Not Implemented
+};
+
+#endif /* _NeighborMisorientationCache_hpp_ */
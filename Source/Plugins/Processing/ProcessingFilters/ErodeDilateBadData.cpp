@@ -45,6 +45,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/VoxelMorphology.h"
 
 #include "Processing/ProcessingConstants.h"
 
@@ -65,7 +66,6 @@ ErodeDilateBadData::ErodeDilateBadData() :
   m_ZDirOn(true),
   m_ReplaceBadData(true),
   m_FeatureIdsArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds),
-  m_Neighbors(NULL),
   m_FeatureIds(NULL)
 {
   setupFilterParameters();
@@ -189,146 +189,37 @@ void ErodeDilateBadData::execute()
   if(getErrorCondition() < 0) { return; }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
 
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] =
-  {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = 0;
-
-  for (size_t i = 0; i < totalPoints; i++)
+
+  bool dirOn[3] = { getXDirOn(), getYDirOn(), getZDirOn() };
+  VoxelMorphology::Operation operation = (m_Direction == 0) ? VoxelMorphology::GrowRegion : VoxelMorphology::ShrinkRegion;
+
+  QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  QList<IDataArray::Pointer> voxelArrays;
+  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
   {
-    featurename = m_FeatureIds[i];
-    if (featurename > numfeatures) { numfeatures = featurename; }
+    voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter));
   }
 
-  DimType neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  QVector<int32_t> n(numfeatures + 1, 0);
+  // Every iteration moves the boundary of the bad data by one cell; after the first iteration only the
+  // neighbors of the cells changed by the previous iteration are examined
+  VoxelMorphology::Pointer morphology = VoxelMorphology::New();
+  morphology->initialize(udims, m_FeatureIds, operation, dirOn);
 
   for (int32_t iteration = 0; iteration < m_NumIterations; iteration++)
   {
-    for (DimType k = 0; k < dims[2]; k++)
+    if (morphology->nextStep() == 0) { break; }
+
+    if (getReplaceBadData())
     {
-      kstride = dims[0] * dims[1] * k;
-      for (DimType j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for (DimType i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if (featurename == 0)
-          {
-            current = 0;
-            most = 0;
-            for (int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if (l == 0 && (k == 0 || m_ZDirOn == false)) { good = 0; }
-              else if (l == 5 && (k == (dims[2] - 1) || m_ZDirOn == false)) { good = 0; }
-              else if (l == 1 && (j == 0 || m_YDirOn == false)) { good = 0; }
-              else if (l == 4 && (j == (dims[1] - 1) || m_YDirOn == false)) { good = 0; }
-              else if (l == 2 && (i == 0 || m_XDirOn == false)) { good = 0; }
-              else if (l == 3 && (i == (dims[0] - 1) || m_XDirOn == false)) { good = 0; }
-              if (good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if (m_Direction == 0 && feature > 0)
-                {
-                  m_Neighbors[neighpoint] = count;
-                }
-                if (feature > 0 && m_Direction == 1)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if (current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            if (m_Direction == 1)
-            {
-              for (int32_t l = 0; l < 6; l++)
-              {
-                good = 1;
-                neighpoint = count + neighpoints[l];
-                if (l == 0 && k == 0) { good = 0; }
-                if (l == 5 && k == (dims[2] - 1)) { good = 0; }
-                if (l == 1 && j == 0) { good = 0; }
-                if (l == 4 && j == (dims[1] - 1)) { good = 0; }
-                if (l == 2 && i == 0) { good = 0; }
-                if (l == 3 && i == (dims[0] - 1)) { good = 0; }
-                if (good == 1)
-                {
-                  feature = m_FeatureIds[neighpoint];
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
+      morphology->applyStep(voxelArrays);
     }
-
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-
-    for (size_t j = 0; j < totalPoints; j++)
+    else
     {
-      featurename = m_FeatureIds[j];
-      int32_t neighbor = m_Neighbors[j];
-      if (neighbor >= 0)
-      {
-        if ( (featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1)
-             || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
-        {
-          if (getReplaceBadData())
-          {
-            for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-              p->copyTuple(neighbor, j);
-            }
-          }
-          else
-          {
-            m_FeatureIds[j] = m_FeatureIds[neighbor];
-          }
-        }
-      }
+      morphology->applyStep(m_FeatureIds);
     }
   }
 
@@ -159,8 +159,6 @@ class ErodeDilateBadData : public AbstractFilter
     void dataCheck();
 
   private:
-    int32_t* m_Neighbors;
-
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
     ErodeDilateBadData(const ErodeDilateBadData&); // Copy Constructor Not Implemented
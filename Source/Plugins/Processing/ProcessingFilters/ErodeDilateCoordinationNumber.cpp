@@ -36,6 +36,9 @@
 
 #include "ErodeDilateCoordinationNumber.h"
 
+#include <queue>
+#include <functional>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -59,7 +62,6 @@ ErodeDilateCoordinationNumber::ErodeDilateCoordinationNumber() :
   m_Loop(false),
   m_CoordinationNumber(6),
   m_FeatureIdsArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds),
-  m_Neighbors(NULL),
   m_FeatureIds(NULL)
 {
   setupFilterParameters();
@@ -162,10 +164,6 @@ void ErodeDilateCoordinationNumber::execute()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
-
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
 #if (CMP_SIZEOF_SIZE_T == 4)
@@ -180,14 +178,12 @@ void ErodeDilateCoordinationNumber::execute()
     static_cast<DimType>(udims[2]),
   };
 
-  int32_t good = 1;
   int64_t point = 0;
-  int64_t kstride = 0, jstride = 0;
+  int64_t neighpoint = 0;
   int32_t featurename = 0, feature = 0;
   int32_t coordination = 0;
   int32_t current = 0;
   int32_t most = 0;
-  int64_t neighpoint = 0;
   size_t numfeatures = 0;
 
   for(size_t i = 0; i < totalPoints; i++)
@@ -206,97 +202,130 @@ void ErodeDilateCoordinationNumber::execute()
 
   QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
   QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  QList<IDataArray::Pointer> voxelArrays;
+  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  {
+    voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter));
+  }
 
+  // Each pass visits the cells in increasing order and updates them in place, so a cell sees the changes
+  // already made to the cells before it in the same pass. The first pass visits every cell; afterwards a
+  // cell only needs to be visited again if it or one of its neighbors changed since its last visit. A change
+  // at a cell schedules its later neighbors for the current pass and the cell itself and its earlier neighbors
+  // for the next pass, which visits exactly the cells a full sweep could change.
   QVector<int32_t> n(numfeatures + 1, 0);
-  QVector<int32_t> coordinationNumber(totalPoints, 0);
+  QVector<int32_t> scheduledPass(totalPoints, 0);
+  std::priority_queue<int64_t, std::vector<int64_t>, std::greater<int64_t> > currentPass;
+  std::vector<int64_t> nextPass;
+  int64_t neighborList[7] = { 0, 0, 0, 0, 0, 0, 0 };
+  int32_t numNeighbors = 0;
   bool keepgoing = true;
   int32_t counter = 1;
+  int32_t pass = 0;
 
   while (counter > 0 && keepgoing == true)
   {
     counter = 0;
+    pass++;
     if (m_Loop == false) { keepgoing = false; }
 
-    for (DimType k = 0; k < dims[2]; k++)
+    if (pass > 1)
     {
-      kstride = dims[0] * dims[1] * k;
-      for (DimType j = 0; j < dims[1]; j++)
+      currentPass = std::priority_queue<int64_t, std::vector<int64_t>, std::greater<int64_t> >(std::greater<int64_t>(), nextPass);
+      nextPass.clear();
+    }
+
+    int64_t visited = 0;
+    while (true)
+    {
+      if (pass == 1)
+      {
+        if (visited >= static_cast<int64_t>(totalPoints)) { break; }
+        point = visited++;
+      }
+      else
       {
-        jstride = dims[0] * j;
-        for (DimType i = 0; i < dims[0]; i++)
+        if (currentPass.empty()) { break; }
+        point = currentPass.top();
+        currentPass.pop();
+      }
+
+      DimType i = static_cast<DimType>(point % dims[0]);
+      DimType j = static_cast<DimType>((point / dims[0]) % dims[1]);
+      DimType k = static_cast<DimType>(point / (dims[0] * dims[1]));
+
+      numNeighbors = 0;
+      for (int32_t l = 0; l < 6; l++)
+      {
+        if (l == 0 && k == 0) { continue; }
+        if (l == 5 && k == (dims[2] - 1)) { continue; }
+        if (l == 1 && j == 0) { continue; }
+        if (l == 4 && j == (dims[1] - 1)) { continue; }
+        if (l == 2 && i == 0) { continue; }
+        if (l == 3 && i == (dims[0] - 1)) { continue; }
+        neighborList[numNeighbors++] = point + neighpoints[l];
+      }
+
+      // A good cell takes the value of its last bad neighbor; a bad cell takes the value of the good
+      // neighbor whose feature occurs most often among its neighbors
+      featurename = m_FeatureIds[point];
+      coordination = 0;
+      most = 0;
+      int64_t neighbor = -1;
+      for (int32_t l = 0; l < numNeighbors; l++)
+      {
+        neighpoint = neighborList[l];
+        feature = m_FeatureIds[neighpoint];
+        if (featurename > 0 && feature == 0)
         {
-          point = kstride + jstride + i;
-          featurename = m_FeatureIds[point];
-          coordination = 0;
-          current = 0;
-          most = 0;
-          for (int32_t l = 0; l < 6; l++)
-          {
-            good = 1;
-            neighpoint = point + neighpoints[l];
-            if (l == 0 && k == 0) { good = 0; }
-            if (l == 5 && k == (dims[2] - 1)) { good = 0; }
-            if (l == 1 && j == 0) { good = 0; }
-            if (l == 4 && j == (dims[1] - 1)) { good = 0; }
-            if (l == 2 && i == 0) { good = 0; }
-            if (l == 3 && i == (dims[0] - 1)) { good = 0; }
-            if (good == 1)
-            {
-              feature = m_FeatureIds[neighpoint];
-              if ((featurename > 0 && feature == 0) || (featurename == 0 && feature > 0))
-              {
-                coordination = coordination + 1;
-                n[feature]++;
-                current = n[feature];
-                if (current > most)
-                {
-                  most = current;
-                  m_Neighbors[point] = neighpoint;
-                }
-              }
-            }
-          }
-          coordinationNumber[point] = coordination;
-          int32_t neighbor = m_Neighbors[point];
-          if (coordinationNumber[point] >= m_CoordinationNumber && coordinationNumber[point] > 0)
+          coordination = coordination + 1;
+          neighbor = neighpoint;
+        }
+        else if (featurename == 0 && feature > 0)
+        {
+          coordination = coordination + 1;
+          n[feature]++;
+          current = n[feature];
+          if (current > most)
           {
-            for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-              p->copyTuple(neighbor, point);
-            }
-          }
-          for (int32_t l = 0; l < 6; l++)
-          {
-            good = 1;
-            neighpoint = point + neighpoints[l];
-            if (l == 0 && k == 0) { good = 0; }
-            if (l == 5 && k == (dims[2] - 1)) { good = 0; }
-            if (l == 1 && j == 0) { good = 0; }
-            if (l == 4 && j == (dims[1] - 1)) { good = 0; }
-            if (l == 2 && i == 0) { good = 0; }
-            if (l == 3 && i == (dims[0] - 1)) { good = 0; }
-            if (good == 1)
-            {
-              feature = m_FeatureIds[neighpoint];
-              if (feature > 0) { n[feature] = 0; }
-            }
+            most = current;
+            neighbor = neighpoint;
           }
         }
       }
-    }
-    for (DimType k = 0; k < dims[2]; k++)
-    {
-      kstride = static_cast<int64_t>(dims[0] * dims[1] * k);
-      for (DimType j = 0; j < dims[1]; j++)
+      if (featurename == 0)
+      {
+        for (int32_t l = 0; l < numNeighbors; l++)
+        {
+          feature = m_FeatureIds[neighborList[l]];
+          if (feature > 0) { n[feature] = 0; }
+        }
+      }
+
+      if (coordination >= m_CoordinationNumber && coordination > 0)
       {
-        jstride = static_cast<int64_t>(dims[0] * j);
-        for (DimType i = 0; i < dims[0]; i++)
+        for (QList<IDataArray::Pointer>::iterator iter = voxelArrays.begin(); iter != voxelArrays.end(); ++iter)
         {
-          point = kstride + jstride + i;
-          if (coordinationNumber[point] >= m_CoordinationNumber)
+          (*iter)->copyTuple(neighbor, point);
+        }
+        counter++;
+
+        neighborList[numNeighbors++] = point;
+        for (int32_t l = 0; l < numNeighbors; l++)
+        {
+          neighpoint = neighborList[l];
+          if (neighpoint > point)
+          {
+            if (pass > 1 && scheduledPass[neighpoint] != pass)
+            {
+              scheduledPass[neighpoint] = pass;
+              currentPass.push(neighpoint);
+            }
+          }
+          else if (scheduledPass[neighpoint] != pass + 1)
           {
-            counter++;
+            scheduledPass[neighpoint] = pass + 1;
+            nextPass.push_back(neighpoint);
           }
         }
       }
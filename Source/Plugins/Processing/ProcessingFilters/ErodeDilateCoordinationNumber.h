@@ -145,8 +145,6 @@ class ErodeDilateCoordinationNumber : public AbstractFilter
     void dataCheck();
 
   private:
-    int32_t* m_Neighbors;
-
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
     ErodeDilateCoordinationNumber(const ErodeDilateCoordinationNumber&); // Copy Constructor Not Implemented
@@ -45,6 +45,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/VoxelMorphology.h"
 
 #include "Processing/ProcessingConstants.h"
 
@@ -64,7 +65,6 @@ ErodeDilateMask::ErodeDilateMask() :
   m_YDirOn(true),
   m_ZDirOn(true),
   m_MaskArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Mask),
-  m_MaskCopy(NULL),
   m_Mask(NULL)
 {
   setupFilterParameters();
@@ -185,86 +185,22 @@ void ErodeDilateMask::execute()
   if(getErrorCondition() < 0) { return; }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_MaskArrayPath.getDataContainerName());
-  size_t totalPoints = m_MaskPtr.lock()->getNumberOfTuples();
-
-  BoolArrayType::Pointer maskCopyPtr = BoolArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_MaskCopy");
-  m_MaskCopy = maskCopyPtr->getPointer(0);
-  maskCopyPtr->initializeWithValue(false);
 
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] =
-  {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int64_t neighpoint = 0;
-
-  DimType neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
+
+  bool dirOn[3] = { getXDirOn(), getYDirOn(), getZDirOn() };
+  VoxelMorphology::Operation operation = (m_Direction == 0) ? VoxelMorphology::GrowRegion : VoxelMorphology::ShrinkRegion;
+
+  // Every iteration moves the boundary of the mask by one cell; after the first iteration only the
+  // neighbors of the cells changed by the previous iteration are examined
+  VoxelMorphology::Pointer morphology = VoxelMorphology::New();
+  morphology->initialize(udims, m_Mask, operation, dirOn);
 
   for (int32_t iteration = 0; iteration < m_NumIterations; iteration++)
   {
-    for (size_t j = 0; j < totalPoints; j++)
-    {
-      m_MaskCopy[j] = m_Mask[j];
-    }
-    for (DimType k = 0; k < dims[2]; k++)
-    {
-      kstride = dims[0] * dims[1] * k;
-      for (DimType j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for (DimType i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          if (m_Mask[count] == false)
-          {
-            for (int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if (l == 0 && (k == 0 || m_ZDirOn == false)) { good = 0; }
-              else if (l == 5 && (k == (dims[2] - 1) || m_ZDirOn == false)) { good = 0; }
-              else if (l == 1 && (j == 0 || m_YDirOn == false)) { good = 0; }
-              else if (l == 4 && (j == (dims[1] - 1) || m_YDirOn == false)) { good = 0; }
-              else if (l == 2 && (i == 0 || m_XDirOn == false)) { good = 0; }
-              else if (l == 3 && (i == (dims[0] - 1) || m_XDirOn == false)) { good = 0; }
-              if (good == 1)
-              {
-                if (m_Direction == 0 && m_Mask[neighpoint] == true)
-                {
-                  m_MaskCopy[count] = true;
-                }
-                if (m_Direction == 1 && m_Mask[neighpoint] == true)
-                {
-                  m_MaskCopy[neighpoint] = false;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    for (size_t j = 0; j < totalPoints; j++)
-    {
-      m_Mask[j] = m_MaskCopy[j];
-    }
+    if (morphology->nextStep() == 0) { break; }
+    morphology->applyStep(m_Mask);
   }
 
   // If there is an error set this to something negative and also set a message
@@ -154,8 +154,6 @@ class ErodeDilateMask : public AbstractFilter
     void dataCheck();
 
   private:
-    bool* m_MaskCopy;
-
     DEFINE_DATAARRAY_VARIABLE(bool, Mask)
 
     ErodeDilateMask(const ErodeDilateMask&); // Copy Constructor Not Implemented
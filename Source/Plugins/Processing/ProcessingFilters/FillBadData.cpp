@@ -45,6 +45,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/VoxelConnectivity.h"
 
 #include "Processing/ProcessingConstants.h"
 
@@ -63,8 +64,6 @@ FillBadData::FillBadData() :
   m_MinAllowedDefectSize(1),
   m_FeatureIdsArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds),
   m_CellPhasesArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Phases),
-  m_AlreadyChecked(NULL),
-  m_Neighbors(NULL),
   m_FeatureIds(NULL),
   m_CellPhases(NULL)
 {
@@ -185,45 +184,10 @@ void FillBadData::execute()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
-
-  BoolArrayType::Pointer alreadCheckedPtr = BoolArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_AlreadyChecked");
-  m_AlreadyChecked = alreadCheckedPtr->getPointer(0);
-  alreadCheckedPtr->initializeWithZeros();
-
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] =
-  {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-  size_t count = 1;
-  int32_t good = 1;
-  int64_t neighbor;
-  int64_t index = 0;
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  DimType column = 0, row = 0, plane = 0;
-  int64_t neighpoint = 0;
-  int32_t featurename = 0, feature = 0;
-  size_t numfeatures = 0;
-  size_t maxPhase = 0;
-
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    featurename = m_FeatureIds[i];
-    if (featurename > numfeatures) { numfeatures = featurename; }
-  }
 
+  int32_t maxPhase = 0;
   if (m_StoreAsNewPhase == true)
   {
     for(size_t i = 0; i < totalPoints; i++)
@@ -232,154 +196,46 @@ void FillBadData::execute()
     }
   }
 
-  DimType neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-  std::vector<int64_t> currentvlist;
-
-  for (size_t iter = 0; iter < totalPoints; iter++)
-  {
-    m_AlreadyChecked[iter] = false;
-    if (m_FeatureIds[iter] != 0) { m_AlreadyChecked[iter] = true; }
-  }
+  VoxelConnectivity::Pointer connectivity = VoxelConnectivity::New();
 
+  // Find the connected regions of bad voxels. Regions at least as big as the minimum defect size are kept as
+  // defects; the voxels of the smaller ones are marked with a FeatureId of -1 so they get filled in below
+  connectivity->labelComponents(udims, m_FeatureIds, 0);
+  const std::vector<int64_t>& labels = connectivity->getLabels();
+  const std::vector<int64_t>& sizes = connectivity->getComponentSizes();
   for (size_t i = 0; i < totalPoints; i++)
   {
-    if (m_AlreadyChecked[i] == false && m_FeatureIds[i] == 0)
+    int64_t label = labels[i];
+    if (label < 0) { continue; }
+    if (sizes[label] >= m_MinAllowedDefectSize)
+    {
+      if (m_StoreAsNewPhase == true) { m_CellPhases[i] = maxPhase + 1; }
+    }
+    else
     {
-      currentvlist.push_back(static_cast<int64_t>(i));
-      count = 0;
-      while (count < currentvlist.size())
-      {
-        index = currentvlist[count];
-        column = index % dims[0];
-        row = (index / dims[0]) % dims[1];
-        plane = index / (dims[0] * dims[1]);
-        for (int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if (j == 0 && plane == 0) { good = 0; }
-          if (j == 5 && plane == (dims[2] - 1)) { good = 0; }
-          if (j == 1 && row == 0) { good = 0; }
-          if (j == 4 && row == (dims[1] - 1)) { good = 0; }
-          if (j == 2 && column == 0) { good = 0; }
-          if (j == 3 && column == (dims[0] - 1)) { good = 0; }
-          if (good == 1 && m_FeatureIds[neighbor] == 0 && m_AlreadyChecked[neighbor] == false)
-          {
-            currentvlist.push_back(neighbor);
-            m_AlreadyChecked[neighbor] = true;
-          }
-        }
-        count++;
-      }
-      if ((int32_t)currentvlist.size() >= m_MinAllowedDefectSize)
-      {
-        for (size_t k = 0; k < currentvlist.size(); k++)
-        {
-          m_FeatureIds[currentvlist[k]] = 0;
-          if (m_StoreAsNewPhase == true) { m_CellPhases[currentvlist[k]] = maxPhase + 1; }
-        }
-      }
-      if ((int32_t)currentvlist.size() < m_MinAllowedDefectSize)
-      {
-        for (std::vector<int64_t>::size_type k = 0; k < currentvlist.size(); k++)
-        {
-          m_FeatureIds[currentvlist[k]] = -1;
-        }
-      }
-      currentvlist.clear();
+      m_FeatureIds[i] = -1;
     }
   }
 
-  int32_t current = 0;
-  int32_t most = 0;
-  std::vector<int32_t> n(numfeatures + 1, 0);
+  QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  QList<IDataArray::Pointer> voxelArrays;
+  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  {
+    voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter));
+  }
 
-  while (count != 0)
+  // Grow the neighboring Features into the small regions one layer of voxels at a time
+  connectivity->initializeDilation(udims, m_FeatureIds, 1);
+  while (connectivity->nextDilationStep() > 0)
   {
-    count = 0;
-    for (size_t i = 0; i < totalPoints; i++)
+    if (getReplaceBadData())
     {
-      featurename = m_FeatureIds[i];
-      if (featurename < 0)
-      {
-        count++;
-        current = 0;
-        most = 0;
-        x = static_cast<float>(i % dims[0]);
-        y = static_cast<float>((i / dims[0]) % dims[1]);
-        z = static_cast<float>(i / (dims[0] * dims[1]));
-        for (int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighpoint = static_cast<int64_t>(i + neighpoints[j]);
-          if (j == 0 && z == 0) { good = 0; }
-          if (j == 5 && z == (dims[2] - 1)) { good = 0; }
-          if (j == 1 && y == 0) { good = 0; }
-          if (j == 4 && y == (dims[1] - 1)) { good = 0; }
-          if (j == 2 && x == 0) { good = 0; }
-          if (j == 3 && x == (dims[0] - 1)) { good = 0; }
-          if (good == 1)
-          {
-            feature = m_FeatureIds[neighpoint];
-            if (feature > 0)
-            {
-              n[feature]++;
-              current = n[feature];
-              if (current > most)
-              {
-                most = current;
-                m_Neighbors[i] = neighpoint;
-              }
-            }
-          }
-        }
-        for (int32_t l = 0; l < 6; l++)
-        {
-          good = 1;
-          neighpoint = i + neighpoints[l];
-          if (l == 0 && z == 0) { good = 0; }
-          if (l == 5 && z == (dims[2] - 1)) { good = 0; }
-          if (l == 1 && y == 0) { good = 0; }
-          if (l == 4 && y == (dims[1] - 1)) { good = 0; }
-          if (l == 2 && x == 0) { good = 0; }
-          if (l == 3 && x == (dims[0] - 1)) { good = 0; }
-          if (good == 1)
-          {
-            feature = m_FeatureIds[neighpoint];
-            if(feature > 0) { n[feature] = 0; }
-          }
-        }
-      }
+      connectivity->applyDilationStep(voxelArrays);
     }
-
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-
-    for (size_t j = 0; j < totalPoints; j++)
+    else
     {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if (featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
-      {
-        if (getReplaceBadData())
-        {
-          for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-            p->copyTuple(neighbor, j);
-          }
-        }
-        else
-        {
-          m_FeatureIds[j] = m_FeatureIds[neighbor];
-        }
-      }
+      connectivity->applyDilationStep(m_FeatureIds);
     }
   }
 
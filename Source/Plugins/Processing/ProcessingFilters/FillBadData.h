@@ -151,9 +151,6 @@ class FillBadData : public AbstractFilter
     void dataCheck();
 
   private:
-    bool* m_AlreadyChecked;
-    int32_t* m_Neighbors;
-
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
     DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
 
@@ -43,6 +43,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/VoxelConnectivity.h"
 
 #include "Processing/ProcessingConstants.h"
 
@@ -150,140 +151,39 @@ void IdentifySample::execute()
 
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] =
-  {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-  DimType neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
-  DimType xp = dims[0];
-  DimType yp = dims[1];
-  DimType zp = dims[2];
 
-  neighpoints[0] = -(xp * yp);
-  neighpoints[1] = -xp;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xp;
-  neighpoints[5] = (xp * yp);
-  std::vector<int64_t> currentvlist;
-  std::vector<bool> checked(totalPoints, false);
-  std::vector<bool> sample(totalPoints, false);
-  int64_t biggestBlock = 0;
-  size_t count = 0;
-  int32_t good = 0;
-  int64_t neighbor = 0;
-  DimType column = 0, row = 0, plane = 0;
-  int64_t index = 0;
+  VoxelConnectivity::Pointer connectivity = VoxelConnectivity::New();
 
-  // In this loop over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
-  // are flipped to be called 'bad' voxels or 'not sample'
-  for (int64_t i = 0; i < totalPoints; i++)
+  // Here we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'. All GoodVoxels that do not touch the 'sample'
+  // are flipped to be called 'bad' voxels or 'not sample'. When several sets are equally big the last one found wins.
+  int64_t numComponents = connectivity->labelComponents(udims, m_GoodVoxels, true);
+  if (numComponents > 0)
   {
-    if (checked[i] == false && m_GoodVoxels[i] == true)
+    const std::vector<int64_t>& sizes = connectivity->getComponentSizes();
+    int64_t sample = 0;
+    for (int64_t c = 1; c < numComponents; c++)
     {
-      currentvlist.push_back(i);
-      count = 0;
-      while (count < currentvlist.size())
-      {
-        index = currentvlist[count];
-        column = index % xp;
-        row = (index / xp) % yp;
-        plane = index / (xp * yp);
-        for (int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if (j == 0 && plane == 0) { good = 0; }
-          if (j == 5 && plane == (zp - 1)) { good = 0; }
-          if (j == 1 && row == 0) { good = 0; }
-          if (j == 4 && row == (yp - 1)) { good = 0; }
-          if (j == 2 && column == 0) { good = 0; }
-          if (j == 3 && column == (xp - 1)) { good = 0; }
-          if (good == 1 && checked[neighbor] == false && m_GoodVoxels[neighbor] == true)
-          {
-            currentvlist.push_back(neighbor);
-            checked[neighbor] = true;
-          }
-        }
-        count++;
-      }
-      if (static_cast<int64_t>(currentvlist.size()) >= biggestBlock)
-      {
-        biggestBlock = currentvlist.size();
-        sample.assign(totalPoints, false);
-        for (int64_t j = 0; j < biggestBlock; j++)
-        {
-          sample[currentvlist[j]] = true;
-        }
-      }
-      currentvlist.clear();
+      if (sizes[c] >= sizes[sample]) { sample = c; }
+    }
+    const std::vector<int64_t>& labels = connectivity->getLabels();
+    for (int64_t i = 0; i < totalPoints; i++)
+    {
+      if (m_GoodVoxels[i] == true && labels[i] != sample) { m_GoodVoxels[i] = false; }
     }
   }
-  for (int64_t i = 0; i < totalPoints; i++)
-  {
-    if (sample[i] == false && m_GoodVoxels[i] == true) { m_GoodVoxels[i] = false; }
-  }
-  sample.clear();
-  checked.assign(totalPoints, false);
-
 
-  // In this loop we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
+  // Here we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
   // This is done by flipping all 'bad' voxel features that do not touch the outside of the sample (i.e. they are fully contained inside of the 'sample'.
   if (m_FillHoles == true)
   {
-    bool touchesBoundary = false;
+    numComponents = connectivity->labelComponents(udims, m_GoodVoxels, false);
+    std::vector<bool> touchesBoundary = connectivity->findComponentsTouchingBoundary();
+    const std::vector<int64_t>& labels = connectivity->getLabels();
     for (int64_t i = 0; i < totalPoints; i++)
     {
-      if (checked[i] == false && m_GoodVoxels[i] == false)
-      {
-        currentvlist.push_back(i);
-        count = 0;
-        touchesBoundary = false;
-        while (count < currentvlist.size())
-        {
-          index = currentvlist[count];
-          column = index % xp;
-          row = (index / xp) % yp;
-          plane = index / (xp * yp);
-          if (column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1)) { touchesBoundary = true; }
-          for (int32_t j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = index + neighpoints[j];
-            if (j == 0 && plane == 0) { good = 0; }
-            if (j == 5 && plane == (zp - 1)) { good = 0; }
-            if (j == 1 && row == 0) { good = 0; }
-            if (j == 4 && row == (yp - 1)) { good = 0; }
-            if (j == 2 && column == 0) { good = 0; }
-            if (j == 3 && column == (xp - 1)) { good = 0; }
-            if (good == 1 && checked[neighbor] == false && m_GoodVoxels[neighbor] == false)
-            {
-              currentvlist.push_back(neighbor);
-              checked[neighbor] = true;
-            }
-          }
-          count++;
-        }
-        if (touchesBoundary == false)
-        {
-          for (size_t j = 0; j < currentvlist.size(); j++)
-          {
-            m_GoodVoxels[currentvlist[j]] = true;
-          }
-        }
-        currentvlist.clear();
-      }
+      if (labels[i] >= 0 && touchesBoundary[labels[i]] == false) { m_GoodVoxels[i] = true; }
     }
   }
-  checked.clear();
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
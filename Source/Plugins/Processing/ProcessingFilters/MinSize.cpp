@@ -44,6 +44,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/VoxelConnectivity.h"
 
 #include "Processing/ProcessingConstants.h"
 
@@ -63,7 +64,6 @@ MinSize::MinSize() :
   m_FeatureIdsArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds),
   m_FeaturePhasesArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Phases),
   m_NumCellsArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::NumCells),
-  m_Neighbors(NULL),
   m_FeatureIds(NULL),
   m_FeaturePhases(NULL),
   m_NumCells(NULL)
@@ -244,126 +244,23 @@ void MinSize::assign_badpoints()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] =
+
+  QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  QList<IDataArray::Pointer> voxelArrays;
+  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
   {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
-
-  int32_t good = 1;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-
-  DimType neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  size_t counter = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t neighbor = 0;
-  QVector<int32_t> n(m_NumCellsPtr.lock()->getNumberOfTuples(), 0);
-  while (counter != 0)
+    voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter));
+  }
+
+  // Grow the remaining Features into the removed ones one layer of voxels at a time
+  VoxelConnectivity::Pointer connectivity = VoxelConnectivity::New();
+  connectivity->initializeDilation(udims, m_FeatureIds, 0);
+  while (connectivity->nextDilationStep() > 0)
   {
-    counter = 0;
-    for (DimType k = 0; k < dims[2]; k++)
-    {
-      kstride = dims[0] * dims[1] * k;
-      for (DimType j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for (DimType i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if (featurename < 0)
-          {
-            counter++;
-            current = 0;
-            most = 0;
-            for (int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if (l == 0 && k == 0) { good = 0; }
-              if (l == 5 && k == (dims[2] - 1)) { good = 0; }
-              if (l == 1 && j == 0) { good = 0; }
-              if (l == 4 && j == (dims[1] - 1)) { good = 0; }
-              if (l == 2 && i == 0) { good = 0; }
-              if (l == 3 && i == (dims[0] - 1)) { good = 0; }
-              if (good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if (feature >= 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if (current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            for (int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if (l == 0 && k == 0) { good = 0; }
-              if (l == 5 && k == (dims[2] - 1)) { good = 0; }
-              if (l == 1 && j == 0) { good = 0; }
-              if (l == 4 && j == (dims[1] - 1)) { good = 0; }
-              if (l == 2 && i == 0) { good = 0; }
-              if (l == 3 && i == (dims[0] - 1)) { good = 0; }
-              if (good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if (feature >= 0) { n[feature] = 0; }
-              }
-            }
-          }
-        }
-      }
-    }
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-    for (size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if (neighbor >= 0)
-      {
-        if (featurename < 0 && m_FeatureIds[neighbor] >= 0)
-        {
-
-          for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-            p->copyTuple(neighbor, j);
-          }
-        }
-      }
-    }
+    connectivity->applyDilationStep(voxelArrays);
   }
 }
 
@@ -168,8 +168,6 @@ class MinSize : public AbstractFilter
     QVector<bool> remove_smallfeatures();
 
   private:
-    int32_t* m_Neighbors;
-
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeaturePhases)
     DEFINE_DATAARRAY_VARIABLE(int32_t, NumCells)
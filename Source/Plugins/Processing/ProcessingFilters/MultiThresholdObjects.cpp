@@ -37,7 +37,7 @@
 #include "MultiThresholdObjects.h"
 
 #include "SIMPLib/Common/Constants.h"
-#include "SIMPLib/Common/ThresholdFilterHelper.h"
+#include "SIMPLib/Common/ThresholdEvaluator.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
@@ -217,56 +217,38 @@ void MultiThresholdObjects::execute()
   DataContainerArray::Pointer dca = getDataContainerArray();
   DataContainer::Pointer m = dca->getDataContainer(dcName);
 
-  // Prime our output array with the result of the first comparison
+  // All of the comparisons are ANDed together and evaluated in a single pass straight into the output array
+  ThresholdEvaluator::Pointer evaluator = ThresholdEvaluator::New();
+  for (int32_t i = 0; i < m_SelectedThresholds.size(); ++i)
   {
-    ThresholdFilterHelper filter(static_cast<DREAM3D::Comparison::Enumeration>(comp_0.compOperator), comp_0.compValue, m_DestinationPtr.lock().get());
-    // Run the first threshold and store the results in our output array
-    err = filter.execute(m->getAttributeMatrix(amName)->getAttributeArray(comp_0.attributeArrayName).get(), m_DestinationPtr.lock().get());
-    if (err < 0)
+    ComparisonInput_t& compRef = m_SelectedThresholds[i];
+    IDataArray::Pointer inputData = m->getAttributeMatrix(amName)->getAttributeArray(compRef.attributeArrayName);
+    if (evaluator->addComparison(inputData.get(), static_cast<DREAM3D::Comparison::Enumeration>(compRef.compOperator), compRef.compValue) == false)
     {
-      DataArrayPath tempPath(comp_0.dataContainerName, comp_0.attributeMatrixName, comp_0.attributeArrayName);
-      QString ss = QObject::tr("Error Executing threshold filter on first array. The path is %1").arg(tempPath.serialize());
-      setErrorCondition(-13001);
+      DataArrayPath tempPath(compRef.dataContainerName, compRef.attributeMatrixName, compRef.attributeArrayName);
+      QString ss;
+      if (i == 0)
+      {
+        ss = QObject::tr("Error Executing threshold filter on first array. The path is %1").arg(tempPath.serialize());
+        setErrorCondition(-13001);
+      }
+      else
+      {
+        ss = QObject::tr("Error Executing threshold filter on array. The path is %1").arg(tempPath.serialize());
+        setErrorCondition(-13002);
+      }
       notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
       return;
     }
   }
 
-  if (m_SelectedThresholds.size() > 1)
+  err = evaluator->evaluate(m_DestinationPtr.lock().get());
+  if (err < 0)
   {
-    // Get the total number of tuples, create and initialize an array to use for these results
-    int64_t totalTuples = static_cast<int64_t>(m->getAttributeMatrix(amName)->getNumTuples());
-    BoolArrayType::Pointer currentArrayPtr = BoolArrayType::CreateArray(totalTuples, "_INTERNAL_USE_ONLY_TEMP");
-
-    // Loop on the remaining Comparison objects updating our final result array as we go
-    for (int32_t i = 1; i < m_SelectedThresholds.size(); ++i)
-    {
-      // Initialize the array to false
-      currentArrayPtr->initializeWithZeros();
-      // Get the pointer to the front of the array. Raw Pointers = fast access = NO Bounds Checking!!!
-      bool* currentArray = currentArrayPtr->getPointer(0);
-
-      ComparisonInput_t& compRef = m_SelectedThresholds[i];
-
-      ThresholdFilterHelper filter(static_cast<DREAM3D::Comparison::Enumeration>(compRef.compOperator), compRef.compValue, currentArrayPtr.get());
-
-      err = filter.execute(m->getAttributeMatrix(amName)->getAttributeArray(compRef.attributeArrayName).get(), currentArrayPtr.get());
-      if (err < 0)
-      {
-        DataArrayPath tempPath(compRef.dataContainerName, compRef.attributeMatrixName, compRef.attributeArrayName);
-        QString ss = QObject::tr("Error Executing threshold filter on array. The path is %1").arg(tempPath.serialize());
-        setErrorCondition(-13002);
-        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-        return;
-      }
-      for (int64_t p = 0; p < totalTuples; ++p)
-      {
-        if (m_Destination[p] == false || currentArray[p] == false)
-        {
-          m_Destination[p] = false;
-        }
-      }
-    }
+    QString ss = QObject::tr("Error Executing threshold filter. The selected arrays and the output array must have the same number of tuples");
+    setErrorCondition(-13003);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
 
   /* Let the GUI know we are done with this filter */
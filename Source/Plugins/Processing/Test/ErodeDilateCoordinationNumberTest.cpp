@@ -0,0 +1,292 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "ProcessingTestFileLocations.h"
+
+// Number of random images compared against the full sweeps
+static const int32_t k_NumRandomImages = 400;
+
+// Looping cases whose full sweep has not settled after this many passes are run without looping
+static const int32_t k_MaxReferencePasses = 200;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  QString filtName = "ErodeDilateCoordinationNumber";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The ErodeDilateCoordinationNumberTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//  The full volume sweep that ErodeDilateCoordinationNumber used before it only revisited the cells whose
+//  neighborhood changed. Every pass visits all the cells in increasing order and updates them in place. Returns
+//  false if looping was requested and the cells were still changing after maxPasses passes.
+// -----------------------------------------------------------------------------
+bool SweepCoordinationNumber(const int64_t dims[3], int32_t coordinationNumber, bool loop, int32_t maxPasses,
+                             std::vector<int32_t>& featureIds, std::vector<float>& values)
+{
+  int64_t totalPoints = dims[0] * dims[1] * dims[2];
+  int32_t numFeatures = 0;
+  for (int64_t i = 0; i < totalPoints; i++)
+  {
+    if (featureIds[i] > numFeatures) { numFeatures = featureIds[i]; }
+  }
+  std::vector<int32_t> n(numFeatures + 1, 0);
+  int64_t neighbors[6];
+
+  for (int32_t pass = 0; pass < maxPasses; pass++)
+  {
+    int32_t counter = 0;
+    for (int64_t k = 0; k < dims[2]; k++)
+    {
+      for (int64_t j = 0; j < dims[1]; j++)
+      {
+        for (int64_t i = 0; i < dims[0]; i++)
+        {
+          int64_t point = (k * dims[1] + j) * dims[0] + i;
+          int32_t num = 0;
+          if (k > 0) { neighbors[num++] = point - dims[0] * dims[1]; }
+          if (j > 0) { neighbors[num++] = point - dims[0]; }
+          if (i > 0) { neighbors[num++] = point - 1; }
+          if (i < dims[0] - 1) { neighbors[num++] = point + 1; }
+          if (j < dims[1] - 1) { neighbors[num++] = point + dims[0]; }
+          if (k < dims[2] - 1) { neighbors[num++] = point + dims[0] * dims[1]; }
+
+          int32_t featurename = featureIds[point];
+          int32_t coordination = 0;
+          int32_t most = 0;
+          int64_t neighbor = -1;
+          for (int32_t l = 0; l < num; l++)
+          {
+            int32_t feature = featureIds[neighbors[l]];
+            if ((featurename > 0 && feature == 0) || (featurename == 0 && feature > 0))
+            {
+              coordination++;
+              n[feature]++;
+              if (n[feature] > most)
+              {
+                most = n[feature];
+                neighbor = neighbors[l];
+              }
+            }
+          }
+          for (int32_t l = 0; l < num; l++)
+          {
+            n[featureIds[neighbors[l]]] = 0;
+          }
+          if (coordination >= coordinationNumber && coordination > 0)
+          {
+            featureIds[point] = featureIds[neighbor];
+            values[point] = values[neighbor];
+            counter++;
+          }
+        }
+      }
+    }
+    if (loop == false || counter == 0) { return true; }
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//  Runs the filter on a random image and compares the feature ids and a second cell array with the full sweep
+// -----------------------------------------------------------------------------
+void CompareWithSweep(AbstractFilter::Pointer filter, const size_t dims[3], int32_t coordinationNumber, bool loop,
+                      const std::vector<int32_t>& featureIds, const std::vector<float>& values)
+{
+  int64_t idims[3] = { static_cast<int64_t>(dims[0]), static_cast<int64_t>(dims[1]), static_cast<int64_t>(dims[2]) };
+  std::vector<int32_t> expectedIds(featureIds);
+  std::vector<float> expectedValues(values);
+  if (SweepCoordinationNumber(idims, coordinationNumber, loop, k_MaxReferencePasses, expectedIds, expectedValues) == false)
+  {
+    loop = false;
+    expectedIds = featureIds;
+    expectedValues = values;
+    SweepCoordinationNumber(idims, coordinationNumber, loop, k_MaxReferencePasses, expectedIds, expectedValues);
+  }
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DREAM3D::Defaults::ImageDataContainerName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims[0], dims[1], dims[2]);
+  m->setGeometry(image);
+  dca->addDataContainer(m);
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  m->addAttributeMatrix(am->getName(), am);
+
+  Int32ArrayType::Pointer featureIdsPtr = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::FeatureIds);
+  FloatArrayType::Pointer valuesPtr = FloatArrayType::CreateArray(tDims, cDims, "Values");
+  for (size_t i = 0; i < featureIds.size(); i++)
+  {
+    featureIdsPtr->setValue(i, featureIds[i]);
+    valuesPtr->setValue(i, values[i]);
+  }
+  am->addAttributeArray(featureIdsPtr->getName(), featureIdsPtr);
+  am->addAttributeArray(valuesPtr->getName(), valuesPtr);
+
+  filter->setDataContainerArray(dca);
+  QVariant var;
+  var.setValue(DataArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+  var.setValue(coordinationNumber);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CoordinationNumber", var), true)
+  var.setValue(loop);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("Loop", var), true)
+
+  filter->execute();
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  for (size_t i = 0; i < featureIds.size(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(featureIdsPtr->getValue(i), expectedIds[i])
+    DREAM3D_REQUIRE_EQUAL(valuesPtr->getValue(i), expectedValues[i])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Random images with random sizes, coordination numbers, loop settings and amounts of bad data. Every 50th
+//  image is larger than the others.
+// -----------------------------------------------------------------------------
+void TestRandomImages()
+{
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("ErodeDilateCoordinationNumber");
+  DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+  AbstractFilter::Pointer filter = filterFactory->create();
+
+  typedef boost::uniform_int<int32_t> NumberDistribution;
+  typedef boost::mt19937 RandomNumberGenerator;
+  typedef boost::variate_generator<RandomNumberGenerator&, NumberDistribution> Generator;
+  RandomNumberGenerator generator;
+  NumberDistribution distribution(0, 99);
+  Generator numberGenerator(generator, distribution);
+  generator.seed(static_cast<boost::uint32_t>(17));
+
+  for (int32_t i = 0; i < k_NumRandomImages; i++)
+  {
+    size_t dims[3] = { 0, 0, 0 };
+    for (int32_t d = 0; d < 3; d++)
+    {
+      dims[d] = (i % 50 == 0) ? static_cast<size_t>(20 + numberGenerator() % 12) : static_cast<size_t>(1 + numberGenerator() % 10);
+    }
+    int32_t coordinationNumber = numberGenerator() % 7;
+    // A coordination number of 0 changes every cell on every pass, so it is only checked for a single pass
+    bool loop = (coordinationNumber > 0) && (numberGenerator() % 2 == 0);
+    int32_t badPercent = 5 + numberGenerator() % 60;
+    int32_t numFeatures = 1 + numberGenerator() % 8;
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    std::vector<int32_t> featureIds(totalPoints, 0);
+    std::vector<float> values(totalPoints, 0.0f);
+    for (size_t p = 0; p < totalPoints; p++)
+    {
+      if (numberGenerator() >= badPercent) { featureIds[p] = 1 + numberGenerator() % numFeatures; }
+      values[p] = static_cast<float>(p);
+    }
+
+    CompareWithSweep(filter, dims, coordinationNumber, loop, featureIds, values);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("ErodeDilateCoordinationNumberTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+  DREAM3D_REGISTER_TEST( TestRandomImages() )
+  PRINT_TEST_SUMMARY();
+  return err;
+}
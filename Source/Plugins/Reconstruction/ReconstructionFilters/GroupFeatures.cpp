@@ -36,6 +36,15 @@
 
 #include "GroupFeatures.h"
 
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -47,6 +56,57 @@
 // Include the MOC generated file for this class
 #include "moc_GroupFeatures.cpp"
 
+/**
+ * @brief The GroupFeaturesPairImpl class runs GroupFeatures::compareFeatures over a range of neighbor pairs,
+ * writing one flag per pair so the merge that follows sees the same result however the pairs are split.
+ */
+class GroupFeaturesPairImpl
+{
+  public:
+    GroupFeaturesPairImpl(GroupFeatures* filter, const std::vector<int32_t>& pairFeatures,
+                          const std::vector<int32_t>& pairNeighbors, std::vector<uint8_t>& grouped) :
+      m_Filter(filter),
+      m_PairFeatures(pairFeatures),
+      m_PairNeighbors(pairNeighbors),
+      m_Grouped(grouped)
+    {}
+    virtual ~GroupFeaturesPairImpl() {}
+
+    void compare(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        m_Grouped[i] = m_Filter->compareFeatures(m_PairFeatures[i], m_PairNeighbors[i]) ? 1 : 0;
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      compare(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    GroupFeatures* m_Filter;
+    const std::vector<int32_t>& m_PairFeatures;
+    const std::vector<int32_t>& m_PairNeighbors;
+    std::vector<uint8_t>& m_Grouped;
+};
+
+// -----------------------------------------------------------------------------
+// Returns the root of the group holding feature, halving the path on the way up
+// -----------------------------------------------------------------------------
+static int32_t findGroupRoot(std::vector<int32_t>& groups, int32_t feature)
+{
+  while (groups[feature] != feature)
+  {
+    groups[feature] = groups[groups[feature]];
+    feature = groups[feature];
+  }
+  return feature;
+}
+
 
 
 // -----------------------------------------------------------------------------
@@ -179,6 +239,133 @@ bool GroupFeatures::growGrouping(int32_t referenceFeature, int32_t neighborFeatu
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupFeatures::usePairwiseGrouping()
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupFeatures::compareFeatures(int32_t referenceFeature, int32_t neighborFeature)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer GroupFeatures::getFeatureParentIds()
+{
+  return Int32ArrayType::NullPointer();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GroupFeatures::resizeParentFeatures(int32_t numTuples)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GroupFeatures::executePairwiseGrouping()
+{
+  NeighborList<int32_t>& neighborlist = *(m_ContiguousNeighborList.lock());
+  NeighborList<int32_t>* nonContigNeighList = m_NonContiguousNeighborList.lock().get();
+
+  Int32ArrayType::Pointer featureParentIdsPtr = getFeatureParentIds();
+  if (NULL == featureParentIdsPtr.get()) { return; }
+  int32_t* featureParentIds = featureParentIdsPtr->getPointer(0);
+  int32_t numFeatures = static_cast<int32_t>(featureParentIdsPtr->getNumberOfTuples());
+
+  // Gather each unique pair of ungrouped neighbors once, lower Feature Id first
+  std::vector<int32_t> pairFeatures;
+  std::vector<int32_t> pairNeighbors;
+  std::vector<int32_t> candidates;
+  for (int32_t i = 0; i < numFeatures; i++)
+  {
+    if (featureParentIds[i] != -1) { continue; }
+    candidates.clear();
+    int32_t listsize = int32_t(neighborlist[i].size());
+    for (int32_t l = 0; l < listsize; l++)
+    {
+      int32_t neigh = neighborlist[i][l];
+      if (neigh > i && neigh < numFeatures && featureParentIds[neigh] == -1) { candidates.push_back(neigh); }
+    }
+    if (m_UseNonContiguousNeighbors == true)
+    {
+      listsize = nonContigNeighList->getListSize(i);
+      for (int32_t l = 0; l < listsize; l++)
+      {
+        int32_t neigh = nonContigNeighList->getListReference(i)[l];
+        if (neigh > i && neigh < numFeatures && featureParentIds[neigh] == -1) { candidates.push_back(neigh); }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    for (std::vector<int32_t>::size_type j = 0; j < candidates.size(); j++)
+    {
+      pairFeatures.push_back(i);
+      pairNeighbors.push_back(candidates[j]);
+    }
+  }
+
+  notifyStatusMessage(getHumanLabel(), QString("Comparing %1 Neighbor Pairs").arg(pairFeatures.size()));
+
+  std::vector<uint8_t> grouped(pairFeatures.size(), 0);
+  GroupFeaturesPairImpl serial(this, pairFeatures, pairNeighbors, grouped);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pairFeatures.size()), serial, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    serial.compare(0, pairFeatures.size());
+  }
+
+  // Merge the grouped pairs, always hanging the higher root under the lower one so every
+  // group ends up rooted at its lowest Feature Id
+  std::vector<int32_t> groups(numFeatures, 0);
+  for (int32_t i = 0; i < numFeatures; i++) { groups[i] = i; }
+  for (std::vector<int32_t>::size_type p = 0; p < pairFeatures.size(); p++)
+  {
+    if (grouped[p] == 0) { continue; }
+    int32_t root1 = findGroupRoot(groups, pairFeatures[p]);
+    int32_t root2 = findGroupRoot(groups, pairNeighbors[p]);
+    if (root1 < root2) { groups[root2] = root1; }
+    else if (root2 < root1) { groups[root1] = root2; }
+  }
+
+  // Number the groups in the order of their lowest Feature Id
+  int32_t parentcount = 0;
+  for (int32_t i = 0; i < numFeatures; i++)
+  {
+    if (featureParentIds[i] != -1) { continue; }
+    int32_t root = findGroupRoot(groups, i);
+    if (root == i)
+    {
+      parentcount++;
+      featureParentIds[i] = parentcount;
+    }
+    else
+    {
+      featureParentIds[i] = featureParentIds[root];
+    }
+  }
+
+  if (parentcount > 0) { resizeParentFeatures(parentcount + 1); }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -188,6 +375,13 @@ void GroupFeatures::execute()
   dataCheck();
   if(getErrorCondition() < 0) { return; }
 
+  if (m_PatchGrouping == false && usePairwiseGrouping() == true)
+  {
+    executePairwiseGrouping();
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+
   NeighborList<int32_t>& neighborlist = *(m_ContiguousNeighborList.lock());
   NeighborList<int32_t>* nonContigNeighList = m_NonContiguousNeighborList.lock().get();
 
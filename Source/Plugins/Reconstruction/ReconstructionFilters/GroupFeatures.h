@@ -40,6 +40,7 @@
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/AbstractFilter.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
 
 #include "Plugins/Reconstruction/ReconstructionConstants.h"
@@ -183,7 +184,46 @@ class GroupFeatures : public AbstractFilter
      */
     virtual bool growGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+    /**
+     * @brief usePairwiseGrouping Returns whether the grouping can be decided one neighbor pair at a time by
+     * compareFeatures. If so, and patch grouping is off, execute() evaluates every unique neighbor pair once (in
+     * parallel) and merges the passing pairs with a union-find instead of growing each group from a random seed.
+     * @return Boolean check for whether the pairwise engine may be used
+     */
+    virtual bool usePairwiseGrouping();
+
+    /**
+     * @brief compareFeatures Determines if two neighboring Features belong to the same group. This is called
+     * concurrently from several threads, so it must not modify the filter
+     * @param referenceFeature Lower Feature Id of the pair
+     * @param neighborFeature Higher Feature Id of the pair
+     * @return Boolean check for whether the two Features should be grouped
+     */
+    virtual bool compareFeatures(int32_t referenceFeature, int32_t neighborFeature);
+
+    /**
+     * @brief getFeatureParentIds Returns the parent Id array the pairwise engine writes its groups into. Features
+     * that already hold a parent Id (not -1) are left untouched and are never merged
+     * @return Feature parent Ids array
+     */
+    virtual Int32ArrayType::Pointer getFeatureParentIds();
+
+    /**
+     * @brief resizeParentFeatures Resizes the new parent Feature Attribute Matrix to hold the given number of tuples
+     * @param numTuples Number of parent tuples, including parent 0
+     */
+    virtual void resizeParentFeatures(int32_t numTuples);
+
   private:
+    friend class GroupFeaturesPairImpl;
+
+    /**
+     * @brief executePairwiseGrouping Groups the Features with compareFeatures and a union-find; parent Ids are
+     * numbered in order of the lowest Feature Id in each group
+     */
+    void executePairwiseGrouping();
+
+
     NeighborList<int32_t>::WeakPointer m_ContiguousNeighborList;
     NeighborList<int32_t>::WeakPointer m_NonContiguousNeighborList;
 
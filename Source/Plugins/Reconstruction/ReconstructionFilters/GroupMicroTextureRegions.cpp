@@ -358,9 +358,7 @@ int32_t GroupMicroTextureRegions::getSeed(int32_t newFid)
   if (seed >= 0)
   {
     m_FeatureParentIds[seed] = newFid;
-    QVector<size_t> tDims(1, newFid + 1);
-    getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
+    resizeParentFeatures(newFid + 1);
 
     if (m_UseRunningAverage == true)
     {
@@ -388,38 +386,28 @@ int32_t GroupMicroTextureRegions::getSeed(int32_t newFid)
 // -----------------------------------------------------------------------------
 bool GroupMicroTextureRegions::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
 {
-  uint32_t phase1 = 0, phase2 = 0;
+  if (m_UseRunningAverage == false)
+  {
+    if (m_FeatureParentIds[neighborFeature] == -1 && compareFeatures(referenceFeature, neighborFeature) == true)
+    {
+      m_FeatureParentIds[neighborFeature] = newFid;
+      return true;
+    }
+    return false;
+  }
+
   float w = 0.0f;
-  float g1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
   float g2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float g1t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
   float g2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float c1[3] = { 0.0f, 0.0f, 0.0f };
   float c2[3] = { 0.0f, 0.0f, 0.0f };
   float caxis[3] = {0.0f, 0.0f, 1.0f};
-  QuatF q1 = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
   QuatF q2 = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   if (m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
   {
-    if (m_UseRunningAverage == false)
-    {
-      QuaternionMathF::Copy(avgQuats[referenceFeature], q1);
-      phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
-      FOrientArrayType om(9);
-      FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-      om.toGMatrix(g1);
-      // transpose the g matrix so when caxis is multiplied by it
-      // it will give the sample direction that the caxis is along
-      MatrixMath::Transpose3x3(g1, g1t);
-      MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
-      // normalize so that the dot product can be taken below without
-      // dividing by the magnitudes (they would be 1)
-      MatrixMath::Normalize3x1(c1);
-    }
-    phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
-    if (phase1 == phase2 && (phase1 == Ebsd::CrystalStructure::Hexagonal_High) )
+    uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
+    if (phase2 == Ebsd::CrystalStructure::Hexagonal_High)
     {
       QuaternionMathF::Copy(avgQuats[neighborFeature], q2);
       FOrientArrayType om(9);
@@ -433,18 +421,14 @@ bool GroupMicroTextureRegions::determineGrouping(int32_t referenceFeature, int32
       // dividing by the magnitudes (they would be 1)
       MatrixMath::Normalize3x1(c2);
 
-      if (m_UseRunningAverage == true) { w = GeometryMath::CosThetaBetweenVectors(avgCaxes, c2); }
-      else { w = GeometryMath::CosThetaBetweenVectors(c1, c2); }
+      w = GeometryMath::CosThetaBetweenVectors(avgCaxes, c2);
       SIMPLibMath::boundF(w, -1, 1);
       w = acosf(w);
       if (w <= caxisTolerance || (SIMPLib::Constants::k_Pi - w) <= caxisTolerance)
       {
         m_FeatureParentIds[neighborFeature] = newFid;
-        if (m_UseRunningAverage == true)
-        {
-          MatrixMath::Multiply3x1withConstant(c2, m_Volumes[neighborFeature]);
-          MatrixMath::Add3x1s(avgCaxes, c2, avgCaxes);
-        }
+        MatrixMath::Multiply3x1withConstant(c2, m_Volumes[neighborFeature]);
+        MatrixMath::Add3x1s(avgCaxes, c2, avgCaxes);
         return true;
       }
     }
@@ -452,6 +436,73 @@ bool GroupMicroTextureRegions::determineGrouping(int32_t referenceFeature, int32
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupMicroTextureRegions::compareFeatures(int32_t referenceFeature, int32_t neighborFeature)
+{
+  float g1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+  float g2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+  float g1t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+  float g2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+  float c1[3] = { 0.0f, 0.0f, 0.0f };
+  float c2[3] = { 0.0f, 0.0f, 0.0f };
+  float caxis[3] = {0.0f, 0.0f, 1.0f};
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+
+  if (m_FeaturePhases[referenceFeature] <= 0 || m_FeaturePhases[neighborFeature] <= 0) { return false; }
+
+  uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
+  uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
+  if (phase1 != phase2 || phase1 != Ebsd::CrystalStructure::Hexagonal_High) { return false; }
+
+  // transpose the g matrices so when caxis is multiplied by them
+  // they give the sample directions that the caxes are along
+  FOrientArrayType om(9);
+  FOrientTransformsType::qu2om(FOrientArrayType(avgQuats[referenceFeature]), om);
+  om.toGMatrix(g1);
+  MatrixMath::Transpose3x3(g1, g1t);
+  MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
+  MatrixMath::Normalize3x1(c1);
+  FOrientTransformsType::qu2om(FOrientArrayType(avgQuats[neighborFeature]), om);
+  om.toGMatrix(g2);
+  MatrixMath::Transpose3x3(g2, g2t);
+  MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
+  MatrixMath::Normalize3x1(c2);
+
+  float w = GeometryMath::CosThetaBetweenVectors(c1, c2);
+  SIMPLibMath::boundF(w, -1, 1);
+  w = acosf(w);
+  return (w <= caxisTolerance || (SIMPLib::Constants::k_Pi - w) <= caxisTolerance);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupMicroTextureRegions::usePairwiseGrouping()
+{
+  // The running average makes each test depend on the Features already in the group
+  return (m_UseRunningAverage == false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer GroupMicroTextureRegions::getFeatureParentIds()
+{
+  return m_FeatureParentIdsPtr.lock();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GroupMicroTextureRegions::resizeParentFeatures(int32_t numTuples)
+{
+  QVector<size_t> tDims(1, numTuples);
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
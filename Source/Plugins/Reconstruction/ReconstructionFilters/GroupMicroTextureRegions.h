@@ -169,6 +169,26 @@ class GroupMicroTextureRegions : public GroupFeatures
      */
     virtual bool determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+    /**
+     * @brief usePairwiseGrouping Reimplemented from @see GroupFeatures class
+     */
+    virtual bool usePairwiseGrouping();
+
+    /**
+     * @brief compareFeatures Reimplemented from @see GroupFeatures class
+     */
+    virtual bool compareFeatures(int32_t referenceFeature, int32_t neighborFeature);
+
+    /**
+     * @brief getFeatureParentIds Reimplemented from @see GroupFeatures class
+     */
+    virtual Int32ArrayType::Pointer getFeatureParentIds();
+
+    /**
+     * @brief resizeParentFeatures Reimplemented from @see GroupFeatures class
+     */
+    virtual void resizeParentFeatures(int32_t numTuples);
+
     /**
      * @brief randomizeGrainIds Randomizes Feature Ids
      * @param totalPoints Size of Feature Ids array to randomize
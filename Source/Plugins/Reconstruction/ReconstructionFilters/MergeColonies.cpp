@@ -390,9 +390,7 @@ int32_t MergeColonies::getSeed(int32_t newFid)
   if (seed >= 0)
   {
     m_FeatureParentIds[seed] = newFid;
-    QVector<size_t> tDims(1, newFid + 1);
-    getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
+    resizeParentFeatures(newFid + 1);
   }
   return seed;
 }
@@ -401,6 +399,19 @@ int32_t MergeColonies::getSeed(int32_t newFid)
 //
 // -----------------------------------------------------------------------------
 bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
+{
+  if (m_FeatureParentIds[neighborFeature] == -1 && compareFeatures(referenceFeature, neighborFeature) == true)
+  {
+    m_FeatureParentIds[neighborFeature] = newFid;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeColonies::compareFeatures(int32_t referenceFeature, int32_t neighborFeature)
 {
   float w = 0.0f;
   float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
@@ -409,7 +420,7 @@ bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighbor
   QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  if (m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  if (m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
   {
     w = std::numeric_limits<float>::max();
     QuaternionMathF::Copy(avgQuats[referenceFeature], q1);
@@ -443,34 +454,48 @@ bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighbor
       float angdiff5 = fabsf(w - 63.26f);
       float axisdiff5 = acosf(fabsf(n1) * 0.9549f + fabsf(n2) * 0.0000f + fabsf(n3) * 0.2969f);
       if (angdiff5 < m_AngleTolerance && axisdiff5 < axisTolerance) { colony = true; }
-      if (colony == true)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      if (colony == true) { return true; }
     }
     else if (Ebsd::CrystalStructure::Cubic_High == phase2 && Ebsd::CrystalStructure::Hexagonal_High == phase1)
     {
       colony = check_for_burgers(q2, q1);
-      if (colony == true)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      if (colony == true) { return true; }
     }
     else if ( Ebsd::CrystalStructure::Cubic_High == phase1 && Ebsd::CrystalStructure::Hexagonal_High == phase2)
     {
       colony = check_for_burgers(q1, q2);
-      if (colony == true)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      if (colony == true) { return true; }
     }
   }
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeColonies::usePairwiseGrouping()
+{
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer MergeColonies::getFeatureParentIds()
+{
+  return m_FeatureParentIdsPtr.lock();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MergeColonies::resizeParentFeatures(int32_t numTuples)
+{
+  QVector<size_t> tDims(1, numTuples);
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
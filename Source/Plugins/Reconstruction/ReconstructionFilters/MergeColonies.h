@@ -167,6 +167,26 @@ class MergeColonies : public GroupFeatures
      */
     virtual bool determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+    /**
+     * @brief usePairwiseGrouping Reimplemented from @see GroupFeatures class
+     */
+    virtual bool usePairwiseGrouping();
+
+    /**
+     * @brief compareFeatures Reimplemented from @see GroupFeatures class
+     */
+    virtual bool compareFeatures(int32_t referenceFeature, int32_t neighborFeature);
+
+    /**
+     * @brief getFeatureParentIds Reimplemented from @see GroupFeatures class
+     */
+    virtual Int32ArrayType::Pointer getFeatureParentIds();
+
+    /**
+     * @brief resizeParentFeatures Reimplemented from @see GroupFeatures class
+     */
+    virtual void resizeParentFeatures(int32_t numTuples);
+
     /**
      * @brief check_for_burgers Checks the Burgers vector between two quaternions
      * @param betaQuat Beta quaterion
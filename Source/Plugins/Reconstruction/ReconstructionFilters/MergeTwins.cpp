@@ -287,9 +287,7 @@ int32_t MergeTwins::getSeed(int32_t newFid)
   if (seed >= 0)
   {
     m_FeatureParentIds[seed] = newFid;
-    QVector<size_t> tDims(1, newFid + 1);
-    getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
+    resizeParentFeatures(newFid + 1);
   }
   return seed;
 }
@@ -298,15 +296,27 @@ int32_t MergeTwins::getSeed(int32_t newFid)
 //
 // -----------------------------------------------------------------------------
 bool MergeTwins::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
+{
+  if (m_FeatureParentIds[neighborFeature] == -1 && compareFeatures(referenceFeature, neighborFeature) == true)
+  {
+    m_FeatureParentIds[neighborFeature] = newFid;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeTwins::compareFeatures(int32_t referenceFeature, int32_t neighborFeature)
 {
   float w = 0.0f;
   float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  bool twin = false;
   QuatF q1 = QuaternionMathF::New();
   QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  if (m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  if (m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
   {
     QuaternionMathF::Copy(avgQuats[referenceFeature], q1);
     uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
@@ -318,17 +328,38 @@ bool MergeTwins::determineGrouping(int32_t referenceFeature, int32_t neighborFea
       w = w * (180.0f / SIMPLib::Constants::k_Pi);
       float axisdiff111 = acosf(fabsf(n1) * 0.57735f + fabsf(n2) * 0.57735f + fabsf(n3) * 0.57735f);
       float angdiff60 = fabsf(w - 60.0f);
-      if (axisdiff111 < axisTolerance && angdiff60 < m_AngleTolerance) { twin = true; }
-      if (twin == true)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      if (axisdiff111 < axisTolerance && angdiff60 < m_AngleTolerance) { return true; }
     }
   }
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeTwins::usePairwiseGrouping()
+{
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer MergeTwins::getFeatureParentIds()
+{
+  return m_FeatureParentIdsPtr.lock();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MergeTwins::resizeParentFeatures(int32_t numTuples)
+{
+  QVector<size_t> tDims(1, numTuples);
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -158,6 +158,26 @@ class MergeTwins : public GroupFeatures
      */
     virtual bool determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+    /**
+     * @brief usePairwiseGrouping Reimplemented from @see GroupFeatures class
+     */
+    virtual bool usePairwiseGrouping();
+
+    /**
+     * @brief compareFeatures Reimplemented from @see GroupFeatures class
+     */
+    virtual bool compareFeatures(int32_t referenceFeature, int32_t neighborFeature);
+
+    /**
+     * @brief getFeatureParentIds Reimplemented from @see GroupFeatures class
+     */
+    virtual Int32ArrayType::Pointer getFeatureParentIds();
+
+    /**
+     * @brief resizeParentFeatures Reimplemented from @see GroupFeatures class
+     */
+    virtual void resizeParentFeatures(int32_t numTuples);
+
     /**
      * @brief characterize_twins Characterizes twins; CURRENTLY NOT IMPLEMENTED
      */
@@ -36,6 +36,7 @@
 #include "ChangeResolution.h"
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/AttributeMatrixResampler.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 
@@ -326,7 +327,7 @@ void ChangeResolution::execute()
   size_t index = 0;
   size_t index_old = 0 ;
   size_t progressInt = 0;
-  std::vector<size_t> newindicies(totalPoints);
+  std::vector<int64_t> newindicies(totalPoints);
 
   for (size_t i = 0; i < m_ZP; i++)
   {
@@ -345,7 +346,7 @@ void ChangeResolution::execute()
         plane = size_t(z / m->getGeometryAs<ImageGeom>()->getZRes());
         index_old = (plane * m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()) + (row * m->getGeometryAs<ImageGeom>()->getXPoints()) + col;
         index = (i * m_XP * m_YP) + (j * m_XP) + k;
-        newindicies[index] = index_old;
+        newindicies[index] = static_cast<int64_t>(index_old);
       }
     }
   }
@@ -357,30 +358,13 @@ void ChangeResolution::execute()
   tDims[0] = m_XP;
   tDims[1] = m_YP;
   tDims[2] = m_ZP;
-  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
-
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrixResampler::Resample(cellAttrMat, tDims, &(newindicies[0]));
+  if (NULL == newCellAttrMat.get())
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory.
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resize(totalPoints);
-    void* source = NULL;
-    void* destination = NULL;
-    size_t newIndicies_I = 0;
-    int32_t nComp = data->getNumberOfComponents();
-    for (size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-      source = p->getVoidPointer((nComp * newIndicies_I));
-      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->addAttributeArray(*iter, data);
+    QString ss = QObject::tr("The cell arrays could not be resampled to the new resolution");
+    setErrorCondition(-5558);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
   m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x, m_Resolution.y, m_Resolution.z);
   m->getGeometryAs<ImageGeom>()->setDimensions(m_XP, m_YP, m_ZP);
@@ -400,7 +384,7 @@ void ChangeResolution::execute()
       return;
     }
 
-    // We have blown away the old FeatureIds array during the above copy loop, so grab it again here
+    // The FeatureIds array was replaced by the resampled one above, so grab it again here
     IDataArray::Pointer featureIdsPtr = m->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName())->getAttributeArray(getFeatureIdsArrayPath().getDataArrayName());
     Int32ArrayType::Pointer featureIds = boost::dynamic_pointer_cast<Int32ArrayType>(featureIdsPtr);
     int32_t* fIds = featureIds->getPointer(0);
@@ -37,6 +37,7 @@
 #include "CropImageGeometry.h"
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/AttributeMatrixResampler.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 
@@ -357,6 +358,8 @@ void CropImageGeometry::execute()
   DataContainer::Pointer srcCellDataContainer = getDataContainerArray()->getPrereqDataContainer<AbstractFilter>(this, getCellAttributeMatrixPath().getDataContainerName());
   AttributeMatrix::Pointer cellAttrMat = srcCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   DataContainer::Pointer destCellDataContainer = srcCellDataContainer;
+  // The cropped arrays are always gathered from the source Attribute Matrix, even when they are saved into a new DataContainer
+  AttributeMatrix::Pointer srcCellAttrMat = cellAttrMat;
 
   if (m_SaveAsNewDataContainer == true)
   {
@@ -370,10 +373,6 @@ void CropImageGeometry::execute()
 
     destCellDataContainer->getGeometryAs<ImageGeom>()->setOrigin(ox, oy, oz);
     destCellDataContainer->getGeometryAs<ImageGeom>()->setResolution(rx, ry, rz);
-
-    AttributeMatrix::Pointer cellAttrMatCopy = cellAttrMat->deepCopy();
-    destCellDataContainer->addAttributeMatrix(cellAttrMatCopy->getName(), cellAttrMatCopy);
-    cellAttrMat = destCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   }
 
   if(NULL == destCellDataContainer.get() || NULL == cellAttrMat.get() || getErrorCondition() < 0)
@@ -399,6 +398,11 @@ void CropImageGeometry::execute()
   // Check to see if the dims have actually changed.
   if(dims[0] == (m_XMax - m_XMin) && dims[1] == (m_YMax - m_YMin) && dims[2] == (m_ZMax - m_ZMin))
   {
+    if (m_SaveAsNewDataContainer == true)
+    {
+      AttributeMatrix::Pointer cellAttrMatCopy = srcCellAttrMat->deepCopy();
+      destCellDataContainer->addAttributeMatrix(cellAttrMatCopy->getName(), cellAttrMatCopy);
+    }
     return;
   }
 
@@ -442,11 +446,9 @@ void CropImageGeometry::execute()
   int64_t colold = 0, rowold = 0, planeold = 0;
   int64_t index = 0;
   int64_t index_old = 0;
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  std::vector<int64_t> newIndices(XP * YP * ZP);
   for (int64_t i = 0; i < ZP; i++)
   {
-    QString ss = QObject::tr("Cropping Volume - Slice %1 of %2 Complete").arg(i).arg(ZP);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
     planeold = (i + m_ZMin) * (srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints() * srcCellDataContainer->getGeometryAs<ImageGeom>()->getYPoints());
     plane = (i * XP * YP);
     for (int64_t j = 0; j < YP; j++)
@@ -459,21 +461,29 @@ void CropImageGeometry::execute()
         col = k;
         index_old = planeold + rowold + colold;
         index = plane + row + col;
-        for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-        {
-          IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-          p->copyTuple(index_old, index);
-        }
+        newIndices[index] = index_old;
       }
     }
   }
-  destCellDataContainer->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP));
-  totalPoints = destCellDataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Cropping Volume...");
   QVector<size_t> tDims(3, 0);
   tDims[0] = XP;
   tDims[1] = YP;
   tDims[2] = ZP;
-  cellAttrMat->setTupleDimensions(tDims); // THIS WILL CAUSE A RESIZE of all the underlying data arrays.
+  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrixResampler::Resample(srcCellAttrMat, tDims, &(newIndices[0]));
+  if (NULL == newCellAttrMat.get())
+  {
+    QString ss = QObject::tr("The cell arrays could not be cropped");
+    setErrorCondition(-953);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  destCellDataContainer->removeAttributeMatrix(newCellAttrMat->getName());
+  destCellDataContainer->addAttributeMatrix(newCellAttrMat->getName(), newCellAttrMat);
+  cellAttrMat = newCellAttrMat;
+  destCellDataContainer->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP));
+  totalPoints = destCellDataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
 
   if (m_RenumberFeatures == true)
   {
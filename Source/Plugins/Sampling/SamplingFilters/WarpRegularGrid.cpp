@@ -37,6 +37,7 @@
 #include "WarpRegularGrid.h"
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/AttributeMatrixResampler.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 
@@ -245,7 +246,6 @@ void WarpRegularGrid::execute()
   else { m = getDataContainerArray()->getDataContainer(getNewDataContainerName()); }
 
   AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
-  AttributeMatrix::Pointer newCellAttrMat = cellAttrMat->deepCopy();
 
   size_t dims[3] = { 0, 0, 0 };
   m->getGeometryAs<ImageGeom>()->getDimensions(dims);
@@ -258,8 +258,8 @@ void WarpRegularGrid::execute()
   int col = 0.0f, row = 0.0f, plane = 0.0f;
   size_t index;
   size_t index_old;
-  std::vector<size_t> newindicies(totalPoints);
-  std::vector<bool> goodPoint(totalPoints, true);
+  // Cells that warp to a point outside of the grid get an index of -1 and are filled with zeros
+  std::vector<int64_t> newindicies(totalPoints);
 
   for (size_t i = 0; i < dims[2]; i++)
   {
@@ -280,43 +280,23 @@ void WarpRegularGrid::execute()
         plane = i;
 
         index_old = (plane * dims[0] * dims[1]) + (row * dims[0]) + col;
-        newindicies[index] = index_old;
-        if (col > 0 && col < dims[0] && row > 0 && row < dims[1]) { goodPoint[index] = true; }
-        else { goodPoint[index] = false; }
+        if (col > 0 && col < dims[0] && row > 0 && row < dims[1]) { newindicies[index] = static_cast<int64_t>(index_old); }
+        else { newindicies[index] = -1; }
       }
     }
   }
 
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrixResampler::Resample(cellAttrMat, tDims, &(newindicies[0]));
+  if (NULL == newCellAttrMat.get())
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resize(totalPoints);
-    void* source = NULL;
-    void* destination = NULL;
-    size_t newIndicies_I = 0;
-    int nComp = data->getNumberOfComponents();
-    for (size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-
-      if(goodPoint[i] == true)
-      {
-        source = p->getVoidPointer((nComp * newIndicies_I));
-        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-      }
-      else
-      {
-        data->initializeTuple(i, 0);
-      }
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->addAttributeArray(*iter, data);
+    QString ss = QObject::tr("The cell arrays could not be resampled onto the warped grid");
+    setErrorCondition(-5560);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
   m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   m->addAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName(), newCellAttrMat);
@@ -36,6 +36,16 @@
 
 #include "FindNeighborhoods.h"
 
+#include <algorithm>
+#include <limits>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -51,6 +61,101 @@
 // Include the MOC generated file for this class
 #include "moc_FindNeighborhoods.cpp"
 
+/**
+ * @brief The FindNeighborhoodsImpl class implements a threaded algorithm that finds the neighborhood of each
+ * Feature. The Feature centroids are binned on a grid of cells one average diameter wide (the cell list) and
+ * each Feature only visits the cells within its critical distance. Each Feature's neighbors are gathered in a
+ * scratch buffer owned by the calling thread and stored in ascending Feature order.
+ */
+class FindNeighborhoodsImpl
+{
+    int64_t* m_Bins;
+    float* m_CriticalDistance;
+    size_t* m_CellStart;
+    int32_t* m_CellFeatures;
+    int64_t m_GridMin[3];
+    int64_t m_GridDims[3];
+    int32_t* m_Neighborhoods;
+    std::vector<std::vector<int32_t> >* m_NeighborhoodList;
+
+  public:
+    FindNeighborhoodsImpl(int64_t* bins, float* criticalDistance, size_t* cellStart, int32_t* cellFeatures,
+                          int64_t gridMin[3], int64_t gridDims[3], int32_t* neighborhoods, std::vector<std::vector<int32_t> >* neighborhoodList) :
+      m_Bins(bins),
+      m_CriticalDistance(criticalDistance),
+      m_CellStart(cellStart),
+      m_CellFeatures(cellFeatures),
+      m_Neighborhoods(neighborhoods),
+      m_NeighborhoodList(neighborhoodList)
+    {
+      for (int32_t k = 0; k < 3; k++)
+      {
+        m_GridMin[k] = gridMin[k];
+        m_GridDims[k] = gridDims[k];
+      }
+    }
+
+    virtual ~FindNeighborhoodsImpl() {}
+
+    void find(size_t start, size_t end) const
+    {
+      std::vector<int32_t> buffer;
+      int64_t cellLow[3] = { 0, 0, 0 };
+      int64_t cellHigh[3] = { 0, 0, 0 };
+      for (size_t i = start; i < end; i++)
+      {
+        buffer.clear();
+        float criticalDistance = m_CriticalDistance[i];
+        // A Feature j is in the neighborhood of Feature i when the bins of the two differ by less than the
+        // critical distance of i along all three axes, so no cell further away than that can hold a neighbor
+        if (criticalDistance > 0.0f)
+        {
+          for (int32_t k = 0; k < 3; k++)
+          {
+            int64_t cell = m_Bins[3 * i + k] - m_GridMin[k];
+            int64_t reach = (criticalDistance >= static_cast<float>(m_GridDims[k])) ? m_GridDims[k] : static_cast<int64_t>(criticalDistance);
+            cellLow[k] = (cell - reach < 0) ? 0 : cell - reach;
+            cellHigh[k] = (cell + reach >= m_GridDims[k]) ? m_GridDims[k] - 1 : cell + reach;
+          }
+          for (int64_t zc = cellLow[2]; zc <= cellHigh[2]; zc++)
+          {
+            for (int64_t yc = cellLow[1]; yc <= cellHigh[1]; yc++)
+            {
+              for (int64_t xc = cellLow[0]; xc <= cellHigh[0]; xc++)
+              {
+                size_t cell = static_cast<size_t>((zc * m_GridDims[1] + yc) * m_GridDims[0] + xc);
+                for (size_t c = m_CellStart[cell]; c < m_CellStart[cell + 1]; c++)
+                {
+                  size_t j = static_cast<size_t>(m_CellFeatures[c]);
+                  if (j == i) { continue; }
+                  // Use the llabs version of the "C" abs function because we are using int64_t
+                  // do NOT try to use the std::abs() function as this is C++11 ONLY
+                  float dBinX = llabs(m_Bins[3 * j] - m_Bins[3 * i]);
+                  float dBinY = llabs(m_Bins[3 * j + 1] - m_Bins[3 * i + 1]);
+                  float dBinZ = llabs(m_Bins[3 * j + 2] - m_Bins[3 * i + 2]);
+                  if (dBinX < criticalDistance && dBinY < criticalDistance && dBinZ < criticalDistance)
+                  {
+                    buffer.push_back(static_cast<int32_t>(j));
+                  }
+                }
+              }
+            }
+          }
+          std::sort(buffer.begin(), buffer.end());
+        }
+        m_Neighborhoods[i] = static_cast<int32_t>(buffer.size());
+        (*m_NeighborhoodList)[i].assign(buffer.begin(), buffer.end());
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      find(r.begin(), r.end());
+    }
+#endif
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -197,8 +302,6 @@ void FindNeighborhoods::preflight()
 // -----------------------------------------------------------------------------
 void FindNeighborhoods::find_neighborhoods()
 {
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-
   std::vector<std::vector<int32_t> > neighborhoodlist;
   std::vector<float> criticalDistance;
 
@@ -216,81 +319,121 @@ void FindNeighborhoods::find_neighborhoods()
     criticalDistance[i] = m_EquivalentDiameters[i] * m_MultiplesOfAverage;
   }
   aveDiam /= totalFeatures;
-  for (size_t i = 1; i < totalFeatures; i++)
+
+  // Without a positive average diameter there is no bin size, so every Feature gets an empty neighborhood
+  if (aveDiam > 0.0f)
   {
-    criticalDistance[i] /= aveDiam;
+    for (size_t i = 1; i < totalFeatures; i++)
+    {
+      criticalDistance[i] /= aveDiam;
+    }
   }
 
   float m_OriginX = 0.0f, m_OriginY = 0.0f, m_OriginZ = 0.0f;
   m->getGeometryAs<ImageGeom>()->getOrigin(m_OriginX, m_OriginY, m_OriginZ);
   size_t udims[3] = { 0, 0, 0 };
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
+  float res[3] = { 0.0f, 0.0f, 0.0f };
+  m->getGeometryAs<ImageGeom>()->getResolution(res);
+  float origin[3] = { m_OriginX, m_OriginY, m_OriginZ };
 
-  size_t xbin = 0, ybin = 0, zbin = 0;
+  // Features whose centroid is not a finite number (an empty Feature has a centroid of 0/0) keep an empty
+  // neighborhood and stay out of the cell list. All other bins are clamped to the extent of the image.
   std::vector<int64_t> bins(3 * totalFeatures, 0);
-  for (size_t i = 1; i < totalFeatures; i++)
+  std::vector<bool> binned(totalFeatures, false);
+  int64_t imageMaxBin[3] = { 0, 0, 0 };
+  if (aveDiam > 0.0f)
   {
-    x = m_Centroids[3 * i];
-    y = m_Centroids[3 * i + 1];
-    z = m_Centroids[3 * i + 2];
-    xbin = int32_t((x - m_OriginX) / aveDiam);
-    ybin = int32_t((y - m_OriginY) / aveDiam);
-    zbin = int32_t((z - m_OriginZ) / aveDiam);
-    bins[3 * i] = xbin;
-    bins[3 * i + 1] = ybin;
-    bins[3 * i + 2] = zbin;
+    for (int32_t k = 0; k < 3; k++)
+    {
+      float maxBin = (static_cast<float>(udims[k]) * res[k]) / aveDiam;
+      imageMaxBin[k] = (maxBin >= 0.0f && maxBin < static_cast<float>(std::numeric_limits<int32_t>::max())) ? static_cast<int64_t>(maxBin) : 0;
+    }
+    for (size_t i = 1; i < totalFeatures; i++)
+    {
+      binned[i] = true;
+      for (int32_t k = 0; k < 3; k++)
+      {
+        float bin = (m_Centroids[3 * i + k] - origin[k]) / aveDiam;
+        if (bin != bin || fabsf(bin) > std::numeric_limits<float>::max())
+        {
+          binned[i] = false;
+          break;
+        }
+        if (bin < 0.0f) { bin = 0.0f; }
+        if (bin > static_cast<float>(imageMaxBin[k])) { bin = static_cast<float>(imageMaxBin[k]); }
+        bins[3 * i + k] = int32_t(bin);
+      }
+      if (binned[i] == false) { criticalDistance[i] = 0.0f; }
+    }
   }
 
-  int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
-  float dBinX = 0, dBinY = 0, dBinZ = 0;
-  float criticalDistance1 = 0, criticalDistance2 = 0;
-
+  // Build the cell list: the Features sorted by the cell their centroid falls in, which a counting sort over the
+  // cells gives in ascending Feature order within each cell
+  int64_t gridMin[3] = { 0, 0, 0 };
+  int64_t gridMax[3] = { 0, 0, 0 };
+  bool first = true;
   for (size_t i = 1; i < totalFeatures; i++)
   {
-    if (i % 1000 == 0)
+    if (binned[i] == false) { continue; }
+    for (int32_t k = 0; k < 3; k++)
     {
+      if (first == true || bins[3 * i + k] < gridMin[k]) { gridMin[k] = bins[3 * i + k]; }
+      if (first == true || bins[3 * i + k] > gridMax[k]) { gridMax[k] = bins[3 * i + k]; }
+    }
+    first = false;
+  }
+  int64_t gridDims[3] = { gridMax[0] - gridMin[0] + 1, gridMax[1] - gridMin[1] + 1, gridMax[2] - gridMin[2] + 1 };
+  size_t totalCells = static_cast<size_t>(gridDims[0] * gridDims[1] * gridDims[2]);
 
-      QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalFeatures);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+  std::vector<size_t> featureCell(totalFeatures, 0);
+  std::vector<size_t> cellStart(totalCells + 1, 0);
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    if (binned[i] == false) { continue; }
+    featureCell[i] = static_cast<size_t>(((bins[3 * i + 2] - gridMin[2]) * gridDims[1] + (bins[3 * i + 1] - gridMin[1])) * gridDims[0] + (bins[3 * i] - gridMin[0]));
+    cellStart[featureCell[i] + 1]++;
+  }
+  for (size_t c = 0; c < totalCells; c++)
+  {
+    cellStart[c + 1] += cellStart[c];
+  }
+  std::vector<int32_t> cellFeatures(totalFeatures, 0);
+  std::vector<size_t> cellFill(cellStart.begin(), cellStart.end() - 1);
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    if (binned[i] == false) { continue; }
+    cellFeatures[cellFill[featureCell[i]]++] = static_cast<int32_t>(i);
+  }
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Feature Neighborhoods");
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  if (totalFeatures > 1 && aveDiam > 0.0f)
+  {
+    FindNeighborhoodsImpl impl(&(bins.front()), &(criticalDistance.front()), &(cellStart.front()), &(cellFeatures.front()),
+                               gridMin, gridDims, m_Neighborhoods, &neighborhoodlist);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures), impl, tbb::auto_partitioner());
     }
-    x = m_Centroids[3 * i];
-    y = m_Centroids[3 * i + 1];
-    z = m_Centroids[3 * i + 2];
-    bin1x = bins[3 * i];
-    bin1y = bins[3 * i + 1];
-    bin1z = bins[3 * i + 2];
-    criticalDistance1 = criticalDistance[i];
-
-    for (size_t j = i + 1; j < totalFeatures; j++)
+    else
+#endif
     {
-      bin2x = bins[3 * j];
-      bin2y = bins[3 * j + 1];
-      bin2z = bins[3 * j + 2];
-      criticalDistance2 = criticalDistance[j];
-      // Use the llabs version of the "C" abs function because we are using int64_t
-      // do NOT try to use the std::abs() function as this is C++11 ONLY
-      dBinX = llabs(bin2x - bin1x);
-      dBinY = llabs(bin2y - bin1y);
-      dBinZ = llabs(bin2z - bin1z);
-
-      if (dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
-      {
-        m_Neighborhoods[i]++;
-        neighborhoodlist[i].push_back(j);
-      }
-
-      if (dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
-      {
-        m_Neighborhoods[j]++;
-        neighborhoodlist[j].push_back(i);
-      }
+      impl.find(1, totalFeatures);
     }
   }
+
   for (size_t i = 1; i < totalFeatures; i++)
   {
     // Set the vector for each list into the NeighborhoodList Object
     NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborhoodlist[i].begin(), neighborhoodlist[i].end());
+    sharedNeiLst->swap(neighborhoodlist[i]);
     m_NeighborhoodList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
   }
 }
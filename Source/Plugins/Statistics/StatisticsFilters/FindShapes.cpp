@@ -41,6 +41,7 @@
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/FeatureVoxelStatistics.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
@@ -229,7 +230,6 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   m_FeatureMoments->resize(numfeatures * 6);
   featuremoments = m_FeatureMoments->getPointer(0);
@@ -257,79 +257,32 @@ void FindShapes::find_moments()
     featuremoments[6 * i + 5] = 0.0f;
   }
 
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for (size_t i = 0; i < zPoints; i++)
+  // Each voxel is broken into 8 sub-voxels offset by a quarter of the resolution from its center.
+  // Summed over the 8 sub-voxels the offsets cancel in the cross terms and add a constant to the
+  // squared terms, so the moments follow from the second moments of the voxel centers which are
+  // gathered for all features in a single parallel pass.
+  size_t dims[3] = { xPoints, yPoints, zPoints };
+  FeatureVoxelStatistics::Pointer stats = FeatureVoxelStatistics::New();
+  stats->compute(dims, m_FeatureIds, numfeatures, FeatureVoxelStatistics::SecondMoments);
+
+  float res[3] = { xRes, yRes, zRes };
+  double sf2 = scaleFactor * scaleFactor;
+  double xOffsetSqrd = static_cast<double>(modXRes / 4.0f) * static_cast<double>(modXRes / 4.0f);
+  double yOffsetSqrd = static_cast<double>(modYRes / 4.0f) * static_cast<double>(modYRes / 4.0f);
+  double zOffsetSqrd = static_cast<double>(modZRes / 4.0f) * static_cast<double>(modZRes / 4.0f);
+  double moments[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  for (size_t i = 0; i < numfeatures; i++)
   {
-    zStride = i * xPoints * yPoints;
-    for (size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for (size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        x = float(k * modXRes);
-        y = float(j * modYRes);
-        z = float(i * modZRes);
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist1 = (z1 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist2 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist2 = (z2 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist3 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist3 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist3 = (z1 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist4 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist4 = (z2 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist5 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist5 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist5 = (z1 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist6 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist6 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist6 = (z2 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist7 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist7 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist7 = (z1 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist8 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist8 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist8 = (z2 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3))
-             + ((ydist4) * (ydist4)) + ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6))
-             + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) + ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3))
-             + ((xdist4) * (xdist4)) + ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6))
-             + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) + ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3))
-             + ((xdist4) * (xdist4)) + ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6))
-             + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) + ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6))
-             + ((xdist7) * (ydist7)) + ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6))
-             + ((ydist7) * (zdist7)) + ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6))
-             + ((xdist7) * (zdist7)) + ((xdist8) * (zdist8));
-
-        featuremoments[gnum * 6 + 0] = featuremoments[gnum * 6 + 0] + xx;
-        featuremoments[gnum * 6 + 1] = featuremoments[gnum * 6 + 1] + yy;
-        featuremoments[gnum * 6 + 2] = featuremoments[gnum * 6 + 2] + zz;
-        featuremoments[gnum * 6 + 3] = featuremoments[gnum * 6 + 3] + xy;
-        featuremoments[gnum * 6 + 4] = featuremoments[gnum * 6 + 4] + yz;
-        featuremoments[gnum * 6 + 5] = featuremoments[gnum * 6 + 5] + xz;
-        m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-      }
-    }
+    double count = static_cast<double>(stats->getNumberOfVoxels(i));
+    if (count == 0.0) { continue; }
+    stats->getSecondMoments(i, res, m_Centroids + 3 * i, moments);
+    featuremoments[i * 6 + 0] = 8.0 * (sf2 * (moments[1] + moments[2]) + count * (yOffsetSqrd + zOffsetSqrd));
+    featuremoments[i * 6 + 1] = 8.0 * (sf2 * (moments[0] + moments[2]) + count * (xOffsetSqrd + zOffsetSqrd));
+    featuremoments[i * 6 + 2] = 8.0 * (sf2 * (moments[0] + moments[1]) + count * (xOffsetSqrd + yOffsetSqrd));
+    featuremoments[i * 6 + 3] = 8.0 * sf2 * moments[3];
+    featuremoments[i * 6 + 4] = 8.0 * sf2 * moments[4];
+    featuremoments[i * 6 + 5] = 8.0 * sf2 * moments[5];
+    m_Volumes[i] = m_Volumes[i] + static_cast<float>(count);
   }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
@@ -44,6 +44,7 @@
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/FeatureVoxelStatistics.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "Statistics/StatisticsConstants.h"
@@ -184,24 +185,19 @@ void FindSizes::find_sizes()
   float diameter = 0.0f;
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<float>::Pointer m_FeatureCounts = DataArray<float>::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts");
-  m_FeatureCounts->initializeWithZeros();
-  float* featurecounts = m_FeatureCounts->getPointer(0);
-
-  for (size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
+  size_t dims[3] = { 0, 0, 0 };
+  m->getGeometryAs<ImageGeom>()->getDimensions(dims);
+  FeatureVoxelStatistics::Pointer stats = FeatureVoxelStatistics::New();
+  stats->compute(dims, m_FeatureIds, numfeatures, FeatureVoxelStatistics::Counts);
   float res_scalar = m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getYRes() * m->getGeometryAs<ImageGeom>()->getZRes();
   float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_Pi;
   for (size_t i = 1; i < numfeatures; i++)
   {
-    m_NumCells[i] = static_cast<int32_t>( featurecounts[i] );
-    m_Volumes[i] = (featurecounts[i] * res_scalar);
+    float featurecount = static_cast<float>(stats->getNumberOfVoxels(i));
+    m_NumCells[i] = static_cast<int32_t>( stats->getNumberOfVoxels(i) );
+    m_Volumes[i] = (featurecount * res_scalar);
     radcubed = m_Volumes[i] / vol_term;
     diameter = 2.0f * powf(radcubed, 0.3333333333f);
     m_EquivalentDiameters[i] = diameter;
@@ -217,26 +213,21 @@ void FindSizes::find_sizes2D()
   float diameter = 0.0f;
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<float>::Pointer m_FeatureCounts = DataArray<float>::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts");
-  m_FeatureCounts->initializeWithZeros();
-  float* featurecounts = m_FeatureCounts->getPointer(0);
-
-  for (size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
+  size_t dims[3] = { 0, 0, 0 };
+  m->getGeometryAs<ImageGeom>()->getDimensions(dims);
+  FeatureVoxelStatistics::Pointer stats = FeatureVoxelStatistics::New();
+  stats->compute(dims, m_FeatureIds, numfeatures, FeatureVoxelStatistics::Counts);
   float res_scalar = 0.0f;
   if (m->getGeometryAs<ImageGeom>()->getXPoints() == 1) { res_scalar = m->getGeometryAs<ImageGeom>()->getYRes() * m->getGeometryAs<ImageGeom>()->getZRes(); }
   else if (m->getGeometryAs<ImageGeom>()->getYPoints() == 1) { res_scalar = m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getZRes(); }
   else if (m->getGeometryAs<ImageGeom>()->getZPoints() == 1) { res_scalar = m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getYRes(); }
   for (size_t i = 1; i < numfeatures; i++)
   {
-    m_NumCells[i] = static_cast<int32_t>( featurecounts[i] );
-    m_Volumes[i] = (featurecounts[i] * res_scalar);
+    float featurecount = static_cast<float>(stats->getNumberOfVoxels(i));
+    m_NumCells[i] = static_cast<int32_t>( stats->getNumberOfVoxels(i) );
+    m_Volumes[i] = (featurecount * res_scalar);
     radsquared = m_Volumes[i] / SIMPLib::Constants::k_Pi;
     diameter = (2 * sqrtf(radsquared));
     m_EquivalentDiameters[i] = diameter;
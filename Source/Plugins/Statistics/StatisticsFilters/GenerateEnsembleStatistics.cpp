@@ -36,6 +36,14 @@
 
 #include "GenerateEnsembleStatistics.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#include <tbb/task_group.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/PhaseType.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -70,6 +78,168 @@
 // Include the MOC generated file for this class
 #include "moc_GenerateEnsembleStatistics.cpp"
 
+/**
+ * @brief The CalculateOdfBinsImpl class implements a threaded algorithm that finds the ODF bin of the orientation of
+ * each Feature. The bins are accumulated afterwards in Feature order so the histograms do not depend on the threading.
+ * Excluded Features get a bin of -1.
+ */
+class CalculateOdfBinsImpl
+{
+    float* m_Eulers;
+    int32_t* m_FeaturePhases;
+    unsigned int* m_CrystalStructures;
+    bool* m_Excluded;
+    int32_t* m_Bins;
+    bool m_AxisOdf;
+    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+
+  public:
+    CalculateOdfBinsImpl(float* eulers, int32_t* featurePhases, unsigned int* crystalStructures, bool* excluded, int32_t* bins, bool axisOdf) :
+      m_Eulers(eulers),
+      m_FeaturePhases(featurePhases),
+      m_CrystalStructures(crystalStructures),
+      m_Excluded(excluded),
+      m_Bins(bins),
+      m_AxisOdf(axisOdf)
+    {
+      m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
+    }
+
+    virtual ~CalculateOdfBinsImpl() {}
+
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        m_Bins[i] = -1;
+        if (m_Excluded[i] == true) { continue; }
+
+        FOrientArrayType rod(4);
+        FOrientTransformsType::eu2ro(FOrientArrayType( &(m_Eulers[3 * i]), 3), rod);
+        if (m_AxisOdf == true)
+        {
+          // The axis ODF is always binned with orthorhombic symmetry
+          m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]->getODFFZRod(rod);
+          m_Bins[i] = m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]->getOdfBin(rod);
+        }
+        else
+        {
+          m_Bins[i] = m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getOdfBin(rod);
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The CalculateMisorientationBinsImpl class implements a threaded algorithm that finds the MDF bin of the
+ * misorientation across every Feature-neighbor pair of a batch of Features. The bins of the pairs of Feature i are
+ * stored starting at offsets[i] - offsets[first Feature of the batch]. Pairs that do not contribute to the MDF
+ * get a bin of -1.
+ */
+class CalculateMisorientationBinsImpl
+{
+    float* m_AvgQuats;
+    int32_t* m_FeaturePhases;
+    unsigned int* m_CrystalStructures;
+    bool* m_SurfaceFeatures;
+    NeighborList<int32_t>* m_NeighborList;
+    size_t* m_Offsets;
+    size_t m_BatchStart;
+    int32_t* m_Bins;
+    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+
+  public:
+    CalculateMisorientationBinsImpl(float* avgQuats, int32_t* featurePhases, unsigned int* crystalStructures, bool* surfaceFeatures,
+                                    NeighborList<int32_t>* neighborList, size_t* offsets, size_t batchStart, int32_t* bins) :
+      m_AvgQuats(avgQuats),
+      m_FeaturePhases(featurePhases),
+      m_CrystalStructures(crystalStructures),
+      m_SurfaceFeatures(surfaceFeatures),
+      m_NeighborList(neighborList),
+      m_Offsets(offsets),
+      m_BatchStart(batchStart),
+      m_Bins(bins)
+    {
+      m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
+    }
+
+    virtual ~CalculateMisorientationBinsImpl() {}
+
+    void generate(size_t start, size_t end) const
+    {
+      NeighborList<int32_t>& neighborlist = *m_NeighborList;
+      QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+      QuatF q1 = QuaternionMathF::New();
+      QuatF q2 = QuaternionMathF::New();
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      float w = 0.0f;
+      uint32_t phase1 = 0, phase2 = 0;
+      int32_t nname = 0;
+
+      for (size_t i = start; i < end; i++)
+      {
+        int32_t* bins = m_Bins + (m_Offsets[i] - m_Offsets[m_BatchStart]);
+        QuaternionMathF::Copy(avgQuats[i], q1);
+        phase1 = m_CrystalStructures[m_FeaturePhases[i]];
+        for (size_t j = 0; j < neighborlist[i].size(); j++)
+        {
+          bins[j] = -1;
+          nname = neighborlist[i][j];
+          phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
+          if (phase1 != phase2) { continue; }
+          if (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname] == true)
+          {
+            QuaternionMathF::Copy(avgQuats[nname], q2);
+            w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3);
+            FOrientArrayType rod(4);
+            FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
+            bins[j] = m_OrientationOps[phase1]->getMisoBin(rod);
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The GatherEnsembleStatsImpl class runs one of the gather methods of the filter so that independent
+ * statistics can be gathered concurrently
+ */
+class GatherEnsembleStatsImpl
+{
+  public:
+    typedef void (GenerateEnsembleStatistics::*GatherFunction)();
+
+    GatherEnsembleStatsImpl(GenerateEnsembleStatistics* filter, GatherFunction function) :
+      m_Filter(filter),
+      m_Function(function)
+    {}
+
+    virtual ~GatherEnsembleStatsImpl() {}
+
+    void operator()() const
+    {
+      (m_Filter->*m_Function)();
+    }
+
+  private:
+    GenerateEnsembleStatistics* m_Filter;
+    GatherFunction m_Function;
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -926,7 +1096,6 @@ void GenerateEnsembleStatistics::gatherODFStats()
   size_t bin = 0;
   size_t numfeatures = m_FeatureEulerAnglesPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  int32_t phase = 0;
   std::vector<float> totalvol;
   std::vector<FloatArrayType::Pointer> eulerodf;
 
@@ -962,15 +1131,25 @@ void GenerateEnsembleStatistics::gatherODFStats()
       totalvol[m_FeaturePhases[i]] = totalvol[m_FeaturePhases[i]] + m_Volumes[i];
     }
   }
+
+  // Find the ODF bin of every Feature in parallel, then accumulate them in Feature order
+  std::vector<int32_t> bins(numfeatures, -1);
+  if (numfeatures > 1)
+  {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures),
+                      CalculateOdfBinsImpl(m_FeatureEulerAngles, m_FeaturePhases, m_CrystalStructures, m_SurfaceFeatures, &(bins.front()), false), tbb::auto_partitioner());
+#else
+    CalculateOdfBinsImpl serial(m_FeatureEulerAngles, m_FeaturePhases, m_CrystalStructures, m_SurfaceFeatures, &(bins.front()), false);
+    serial.generate(1, numfeatures);
+#endif
+  }
+
   for (size_t i = 1; i < numfeatures; i++)
   {
-    if (m_SurfaceFeatures[i] == false)
+    if (bins[i] >= 0)
     {
-      phase = m_CrystalStructures[m_FeaturePhases[i]];
-      FOrientArrayType eu( &(m_FeatureEulerAngles[3 * i]), 3); // Wrap the pointer
-      FOrientArrayType rod(4);
-      OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
-      bin = m_OrientationOps[phase]->getOdfBin(rod);
+      bin = bins[i];
       eulerodf[m_FeaturePhases[i]]->setValue(bin, (eulerodf[m_FeaturePhases[i]]->getValue(bin) + (m_Volumes[i] / totalvol[m_FeaturePhases[i]])));
     }
   }
@@ -1008,16 +1187,10 @@ void GenerateEnsembleStatistics::gatherMDFStats()
   // And we do the same for the SharedSurfaceArea list
   NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
 
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
   int32_t mbin = 0;
-  float w = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   size_t numfeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  uint32_t phase1 = 0, phase2 = 0;
   QVector<float> totalSurfaceArea;
   QVector<FloatArrayType::Pointer> misobin;
   int32_t numbins = 0;
@@ -1043,33 +1216,52 @@ void GenerateEnsembleStatistics::gatherMDFStats()
       misobin[i]->setValue(j, 0.0);
     }
   }
-  int32_t nname = 0;
-  float nsa = 0.0f;
+  // Offsets of the first Feature-neighbor pair of each Feature into one flat list of pairs
+  std::vector<size_t> offsets(numfeatures + 1, 0);
   for (size_t i = 1; i < numfeatures; i++)
   {
-    QuaternionMathF::Copy(avgQuats[i], q1);
-    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
-    for (size_t j = 0; j < neighborlist[i].size(); j++)
+    offsets[i + 1] = offsets[i] + neighborlist[i].size();
+  }
+
+  // Misorientations are computed in parallel a batch of Features at a time, which keeps the bin buffer bounded
+  // no matter how many Features there are. The bins are then accumulated in Feature order.
+  const size_t k_MaxPairsPerBatch = 1 << 22;
+  std::vector<int32_t> bins;
+  float nsa = 0.0f;
+  size_t batchStart = 1;
+  while (batchStart < numfeatures)
+  {
+    size_t batchEnd = batchStart + 1;
+    while (batchEnd < numfeatures && offsets[batchEnd + 1] - offsets[batchStart] <= k_MaxPairsPerBatch)
+    {
+      batchEnd++;
+    }
+    bins.resize(offsets[batchEnd] - offsets[batchStart] + 1);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(batchStart, batchEnd),
+                      CalculateMisorientationBinsImpl(m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceFeatures, &neighborlist, &(offsets.front()), batchStart, &(bins.front())),
+                      tbb::auto_partitioner());
+#else
+    CalculateMisorientationBinsImpl serial(m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceFeatures, &neighborlist, &(offsets.front()), batchStart, &(bins.front()));
+    serial.generate(batchStart, batchEnd);
+#endif
+
+    for (size_t i = batchStart; i < batchEnd; i++)
     {
-      w = 10000.0f;
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
-      phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      if (phase1 == phase2) { w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3); }
-      if (phase1 == phase2)
+      int32_t* featureBins = &(bins.front()) + (offsets[i] - offsets[batchStart]);
+      for (size_t j = 0; j < neighborlist[i].size(); j++)
       {
-        FOrientArrayType rod(4);
-        FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-
-        if ((nname > i || m_SurfaceFeatures[nname] == true))
+        mbin = featureBins[j];
+        if (mbin >= 0)
         {
-          mbin = m_OrientationOps[phase1]->getMisoBin(rod);
           nsa = neighborsurfacearealist[i][j];
           misobin[m_FeaturePhases[i]]->setValue(mbin, (misobin[m_FeaturePhases[i]]->getValue(mbin) + nsa));
           totalSurfaceArea[m_FeaturePhases[i]] = totalSurfaceArea[m_FeaturePhases[i]] + nsa;
         }
       }
     }
+    batchStart = batchEnd;
   }
 
   for (size_t i = 1; i < numensembles; i++)
@@ -1129,14 +1321,25 @@ void GenerateEnsembleStatistics::gatherAxisODFStats()
       totalaxes[m_FeaturePhases[i]]++;
     }
   }
+
+  // Find the axis ODF bin of every Feature in parallel, then accumulate them in Feature order
+  std::vector<int32_t> bins(numfeatures, -1);
+  if (numfeatures > 1)
+  {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures),
+                      CalculateOdfBinsImpl(m_AxisEulerAngles, m_FeaturePhases, m_CrystalStructures, m_BiasedFeatures, &(bins.front()), true), tbb::auto_partitioner());
+#else
+    CalculateOdfBinsImpl serial(m_AxisEulerAngles, m_FeaturePhases, m_CrystalStructures, m_BiasedFeatures, &(bins.front()), true);
+    serial.generate(1, numfeatures);
+#endif
+  }
+
   for (size_t i = 1; i < numfeatures; i++)
   {
-    if (m_BiasedFeatures[i] == false)
+    if (bins[i] >= 0)
     {
-      FOrientArrayType rod(4);
-      FOrientTransformsType::eu2ro( FOrientArrayType( &(m_AxisEulerAngles[3 * i]), 3), rod);
-      m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]->getODFFZRod(rod);
-      bin = m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]->getOdfBin(rod);
+      bin = bins[i];
       axisodf[m_FeaturePhases[i]]->setValue(bin, (axisodf[m_FeaturePhases[i]]->getValue(bin) + static_cast<float>((1.0 / totalaxes[m_FeaturePhases[i]]))));
     }
   }
@@ -1322,40 +1525,68 @@ void GenerateEnsembleStatistics::execute()
     m_StatsDataArray->fillArrayWithNewStatsData(m_PhaseTypesPtr.lock()->getNumberOfTuples(), m_PhaseTypes);
   }
 
+  // The correlated distributions are binned by the Feature sizes, so the size statistics have to be gathered first
   if(m_ComputeSizeDistribution == true)
   {
     gatherSizeStats();
   }
+
+  // The remaining statistics only read the Feature data and each writes its own entries of the StatsData objects,
+  // so they can all be gathered at the same time
+  QVector<GatherEnsembleStatsImpl::GatherFunction> gatherFunctions;
   if(m_ComputeAspectRatioDistribution == true)
   {
-    gatherAspectRatioStats();
+    gatherFunctions.push_back(&GenerateEnsembleStatistics::gatherAspectRatioStats);
   }
   if(m_ComputeOmega3Distribution == true)
   {
-    gatherOmega3Stats();
+    gatherFunctions.push_back(&GenerateEnsembleStatistics::gatherOmega3Stats);
   }
   if(m_ComputeNeighborhoodDistribution == true)
   {
-    gatherNeighborhoodStats();
+    gatherFunctions.push_back(&GenerateEnsembleStatistics::gatherNeighborhoodStats);
   }
   if(m_CalculateODF == true)
   {
-    gatherODFStats();
+    gatherFunctions.push_back(&GenerateEnsembleStatistics::gatherODFStats);
   }
   if(m_CalculateMDF == true)
   {
-    gatherMDFStats();
+    gatherFunctions.push_back(&GenerateEnsembleStatistics::gatherMDFStats);
   }
   if(m_CalculateAxisODF == true)
   {
-    gatherAxisODFStats();
+    gatherFunctions.push_back(&GenerateEnsembleStatistics::gatherAxisODFStats);
   }
   if(m_IncludeRadialDistFunc == true)
   {
-    gatherRadialDistFunc();
+    gatherFunctions.push_back(&GenerateEnsembleStatistics::gatherRadialDistFunc);
   }
+  gatherFunctions.push_back(&GenerateEnsembleStatistics::calculatePPTBoundaryFrac);
 
-  calculatePPTBoundaryFrac();
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::task_group* g = new tbb::task_group;
+    for (int32_t i = 0; i < gatherFunctions.size(); i++)
+    {
+      g->run(GatherEnsembleStatsImpl(this, gatherFunctions[i]));
+    }
+    g->wait(); // Wait for all the threads to complete before moving on.
+    delete g;
+    g = NULL;
+  }
+  else
+#endif
+  {
+    for (int32_t i = 0; i < gatherFunctions.size(); i++)
+    {
+      GatherEnsembleStatsImpl gather(this, gatherFunctions[i]);
+      gather();
+    }
+  }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
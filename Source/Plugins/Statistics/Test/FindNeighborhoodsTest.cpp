@@ -0,0 +1,283 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <limits>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "StatisticsTestFileLocations.h"
+
+// Number of random Feature sets compared against the pairwise search
+static const int32_t k_NumRandomFeatureSets = 300;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  QString filtName = "FindNeighborhoods";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The FindNeighborhoodsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//  The pairwise search that FindNeighborhoods used before the cell list. Every pair of Features is compared
+//  once. A centroid of NaN turns into a bin of INT32_MIN, which is too far away to match anything.
+// -----------------------------------------------------------------------------
+void PairwiseNeighborhoods(const float origin[3], float multiplesOfAverage, const std::vector<float>& diameters,
+                           const std::vector<float>& centroids, std::vector<int32_t>& counts, std::vector<std::vector<int32_t> >& lists)
+{
+  size_t totalFeatures = diameters.size();
+  counts.assign(totalFeatures, 0);
+  lists.assign(totalFeatures, std::vector<int32_t>());
+
+  std::vector<float> criticalDistance(totalFeatures, 0.0f);
+  float aveDiam = 0.0f;
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    aveDiam += diameters[i];
+    criticalDistance[i] = diameters[i] * multiplesOfAverage;
+  }
+  aveDiam /= totalFeatures;
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    criticalDistance[i] /= aveDiam;
+  }
+
+  std::vector<int64_t> bins(3 * totalFeatures, 0);
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    for (int32_t k = 0; k < 3; k++)
+    {
+      float bin = (centroids[3 * i + k] - origin[k]) / aveDiam;
+      bins[3 * i + k] = (bin != bin) ? static_cast<int64_t>(std::numeric_limits<int32_t>::min()) : static_cast<int64_t>(int32_t(bin));
+    }
+  }
+
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    for (size_t j = i + 1; j < totalFeatures; j++)
+    {
+      float dBinX = llabs(bins[3 * j] - bins[3 * i]);
+      float dBinY = llabs(bins[3 * j + 1] - bins[3 * i + 1]);
+      float dBinZ = llabs(bins[3 * j + 2] - bins[3 * i + 2]);
+      if (dBinX < criticalDistance[i] && dBinY < criticalDistance[i] && dBinZ < criticalDistance[i])
+      {
+        counts[i]++;
+        lists[i].push_back(static_cast<int32_t>(j));
+      }
+      if (dBinX < criticalDistance[j] && dBinY < criticalDistance[j] && dBinZ < criticalDistance[j])
+      {
+        counts[j]++;
+        lists[j].push_back(static_cast<int32_t>(i));
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Runs the filter on one set of Features and compares the counts and lists with the pairwise search
+// -----------------------------------------------------------------------------
+void CompareWithPairwise(AbstractFilter::Pointer filter, const size_t dims[3], const float res[3], const float origin[3], float multiplesOfAverage,
+                         const std::vector<float>& diameters, const std::vector<float>& centroids)
+{
+  std::vector<int32_t> expectedCounts;
+  std::vector<std::vector<int32_t> > expectedLists;
+  PairwiseNeighborhoods(origin, multiplesOfAverage, diameters, centroids, expectedCounts, expectedLists);
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DREAM3D::Defaults::ImageDataContainerName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims[0], dims[1], dims[2]);
+  image->setResolution(res[0], res[1], res[2]);
+  image->setOrigin(origin[0], origin[1], origin[2]);
+  m->setGeometry(image);
+  dca->addDataContainer(m);
+
+  size_t totalFeatures = diameters.size();
+  QVector<size_t> tDims(1, totalFeatures);
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+  m->addAttributeMatrix(am->getName(), am);
+
+  FloatArrayType::Pointer diametersPtr = FloatArrayType::CreateArray(tDims, cDims, DREAM3D::FeatureData::EquivalentDiameters);
+  Int32ArrayType::Pointer phasesPtr = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::FeatureData::Phases);
+  cDims[0] = 3;
+  FloatArrayType::Pointer centroidsPtr = FloatArrayType::CreateArray(tDims, cDims, DREAM3D::FeatureData::Centroids);
+  for (size_t i = 0; i < totalFeatures; i++)
+  {
+    diametersPtr->setValue(i, diameters[i]);
+    phasesPtr->setValue(i, 1);
+    for (int32_t k = 0; k < 3; k++)
+    {
+      centroidsPtr->setValue(3 * i + k, centroids[3 * i + k]);
+    }
+  }
+  am->addAttributeArray(diametersPtr->getName(), diametersPtr);
+  am->addAttributeArray(phasesPtr->getName(), phasesPtr);
+  am->addAttributeArray(centroidsPtr->getName(), centroidsPtr);
+
+  filter->setDataContainerArray(dca);
+  QVariant var;
+  var.setValue(multiplesOfAverage);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("MultiplesOfAverage", var), true)
+
+  filter->execute();
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  Int32ArrayType::Pointer counts = boost::dynamic_pointer_cast<Int32ArrayType>(am->getAttributeArray(DREAM3D::FeatureData::Neighborhoods));
+  NeighborList<int32_t>::Pointer lists = boost::dynamic_pointer_cast<NeighborList<int32_t> >(am->getAttributeArray(DREAM3D::FeatureData::NeighborhoodList));
+  DREAM3D_REQUIRE_VALID_POINTER(counts.get())
+  DREAM3D_REQUIRE_VALID_POINTER(lists.get())
+
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(counts->getValue(i), expectedCounts[i])
+    NeighborList<int32_t>::VectorType& list = lists->getListReference(static_cast<int32_t>(i));
+    DREAM3D_REQUIRE_EQUAL(list.size(), expectedLists[i].size())
+    for (size_t n = 0; n < list.size(); n++)
+    {
+      DREAM3D_REQUIRE_EQUAL(list[n], expectedLists[i][n])
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Random Features inside random images. About one Feature in eight is empty, with no diameter and a centroid of
+//  NaN as FindFeatureCentroids leaves it, and a few sets have no diameters at all.
+// -----------------------------------------------------------------------------
+void TestRandomFeatures()
+{
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("FindNeighborhoods");
+  DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+  AbstractFilter::Pointer filter = filterFactory->create();
+
+  typedef boost::uniform_int<int32_t> NumberDistribution;
+  typedef boost::mt19937 RandomNumberGenerator;
+  typedef boost::variate_generator<RandomNumberGenerator&, NumberDistribution> Generator;
+  RandomNumberGenerator generator;
+  NumberDistribution distribution(0, 999);
+  Generator numberGenerator(generator, distribution);
+  generator.seed(static_cast<boost::uint32_t>(29));
+
+  for (int32_t s = 0; s < k_NumRandomFeatureSets; s++)
+  {
+    size_t dims[3] = { static_cast<size_t>(1 + numberGenerator() % 50), static_cast<size_t>(1 + numberGenerator() % 50), static_cast<size_t>(1 + numberGenerator() % 20) };
+    float res[3] = { 0.0f, 0.0f, 0.0f };
+    float origin[3] = { 0.0f, 0.0f, 0.0f };
+    for (int32_t k = 0; k < 3; k++)
+    {
+      res[k] = 0.5f + 0.25f * (numberGenerator() % 4);
+      origin[k] = static_cast<float>(numberGenerator() % 5) - 2.0f;
+    }
+    float multiplesOfAverage = 1.0f + (numberGenerator() % 4);
+    size_t totalFeatures = 2 + numberGenerator() % 80;
+
+    std::vector<float> diameters(totalFeatures, 0.0f);
+    std::vector<float> centroids(3 * totalFeatures, 0.0f);
+    for (size_t i = 1; i < totalFeatures; i++)
+    {
+      bool empty = (numberGenerator() % 8 == 0) || (s % 50 == 0);
+      diameters[i] = empty ? 0.0f : 1.0f + (numberGenerator() % 80) / 10.0f;
+      for (int32_t k = 0; k < 3; k++)
+      {
+        centroids[3 * i + k] = empty ? std::numeric_limits<float>::quiet_NaN() : origin[k] + (numberGenerator() / 1000.0f) * dims[k] * res[k];
+      }
+    }
+
+    CompareWithPairwise(filter, dims, res, origin, multiplesOfAverage, diameters, centroids);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("FindNeighborhoodsTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+  DREAM3D_REGISTER_TEST( TestRandomFeatures() )
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -59,6 +59,7 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
     DoubleArrayType::Pointer gaussianCurvature,
     DoubleArrayType::Pointer meanCurvature,
     TriangleGeom::Pointer trianglesGeom,
+    TriangleLabelAdjacency::Pointer adjacency,
     DataArray<int32_t>::Pointer surfaceMeshFaceLabels,
     DataArray<double>::Pointer surfaceMeshFaceNormals,
     DataArray<double>::Pointer surfaceMeshTriangleCentroids,
@@ -73,6 +74,7 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
   m_GaussianCurvature(gaussianCurvature),
   m_MeanCurvature(meanCurvature),
   m_TrianglesPtr(trianglesGeom),
+  m_Adjacency(adjacency),
   m_SurfaceMeshFaceLabels(surfaceMeshFaceLabels),
   m_SurfaceMeshFaceNormals(surfaceMeshFaceNormals),
   m_SurfaceMeshTriangleCentroids(surfaceMeshTriangleCentroids),
@@ -147,10 +149,10 @@ void CalculateTriangleGroupCurvatures::operator()() const
     nRingNeighborAlg->setRegionId0(feature0);
     nRingNeighborAlg->setRegionId1(feature1);
     nRingNeighborAlg->setRing(m_NRing);
-    err = nRingNeighborAlg->generate(m_TrianglesPtr, faceLabels);
+    err = nRingNeighborAlg->generate(m_Adjacency.get(), faceLabels);
     BOOST_ASSERT(err >= 0);
 
-    UniqueFaceIds_t triPatch = nRingNeighborAlg->getNRingTriangles();
+    const std::vector<int64_t>& triPatch = nRingNeighborAlg->getNRingTriangles();
     BOOST_ASSERT(triPatch.size() > 1);
 
     DataArray<double>::Pointer patchCentroids = extractPatchData(triId, triPatch, m_SurfaceMeshTriangleCentroids->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Centroids"));
@@ -290,30 +292,24 @@ void CalculateTriangleGroupCurvatures::operator()() const
 //
 // -----------------------------------------------------------------------------
 DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId,
-    UniqueFaceIds_t& triPatch,
+    const std::vector<int64_t>& triPatch,
     double* data,
     const QString& name) const
 {
   QVector<size_t> cDims(1, 3);
   DataArray<double>::Pointer extractedData = DataArray<double>::CreateArray(triPatch.size(), cDims, name);
-  // This little chunk makes sure the current seed triangles centroid and normal data appear
+  // The patch always holds the current seed triangle first so its centroid and normal data appear
   // first in the returned arrays which makes the next steps a tad easier.
-  int32_t i = 0;
-  extractedData->setComponent(i, 0, data[triId * 3]);
-  extractedData->setComponent(i, 1, data[triId * 3 + 1]);
-  extractedData->setComponent(i, 2, data[triId * 3 + 2]);
-  ++i;
-  triPatch.erase(triId);
-
-  for (UniqueFaceIds_t::iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
+  BOOST_ASSERT(triPatch.empty() == false && triPatch[0] == triId);
+  (void)triId;
+  double* ptr = extractedData->getPointer(0);
+  for (std::vector<int64_t>::size_type i = 0; i < triPatch.size(); ++i)
   {
-    int64_t t = *iter;
-    extractedData->setComponent(i, 0, data[t * 3]);
-    extractedData->setComponent(i, 1, data[t * 3 + 1]);
-    extractedData->setComponent(i, 2, data[t * 3 + 2]);
-    ++i;
+    int64_t t = triPatch[i];
+    ptr[i * 3] = data[t * 3];
+    ptr[i * 3 + 1] = data[t * 3 + 1];
+    ptr[i * 3 + 2] = data[t * 3 + 2];
   }
-  triPatch.insert(triId);
 
   return extractedData;
 }
@@ -41,6 +41,8 @@
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Common/AbstractFilter.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/TriangleLabelAdjacency.h"
+
 /**
  * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for a group of triangles
  * where each triangle in the group will have the 2 Principal Curvature values computed and optionally
@@ -58,6 +60,7 @@ class CalculateTriangleGroupCurvatures
                                      DoubleArrayType::Pointer gaussianCurvature,
                                      DoubleArrayType::Pointer meanCurvature,
                                      TriangleGeom::Pointer trianglesGeom,
+                                     TriangleLabelAdjacency::Pointer adjacency,
                                      DataArray<int32_t>::Pointer surfaceMeshFaceLabels,
                                      DataArray<double>::Pointer surfaceMeshFaceNormals,
                                      DataArray<double>::Pointer surfaceMeshTriangleCentroids,
@@ -67,20 +70,18 @@ class CalculateTriangleGroupCurvatures
 
     void operator()() const;
 
-    typedef std::set<int64_t> UniqueFaceIds_t;
-
   protected:
     CalculateTriangleGroupCurvatures();
 
     /**
      * @brief extractPatchData Extracts out the needed data values from the global arrays
      * @param triId The seed triangle Id
-     * @param triPatch The group of triangles being used
+     * @param triPatch The group of triangles being used, with the seed triangle first
      * @param data The data to extract from
      * @param name The name of the data array being used
      * @return Shared pointer to the extracted data
      */
-    DataArray<double>::Pointer extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch,
+    DataArray<double>::Pointer extractPatchData(int64_t triId, const std::vector<int64_t>& triPatch,
                                                 double* data,
                                                 const QString& name) const;
 
@@ -95,6 +96,7 @@ class CalculateTriangleGroupCurvatures
     DoubleArrayType::Pointer m_GaussianCurvature;
     DoubleArrayType::Pointer m_MeanCurvature;
     TriangleGeom::Pointer m_TrianglesPtr;
+    TriangleLabelAdjacency::Pointer m_Adjacency;
     DataArray<int32_t>::Pointer m_SurfaceMeshFaceLabels;
     DataArray<double>::Pointer m_SurfaceMeshFaceNormals;
     DataArray<double>::Pointer m_SurfaceMeshTriangleCentroids;
@@ -38,6 +38,7 @@
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
 #endif
@@ -61,61 +62,89 @@
 
 /**
  * @brief The CalculateGBCDImpl class implements a threaded algorithm that calculates the
- * grain boundary character distribution (GBCD) for a surface mesh
+ * grain boundary character distribution (GBCD) for a surface mesh. Each symmetric equivalent of
+ * a triangle adds the triangle's area straight into a GBCD histogram. The serial path bins into the
+ * output array itself; in parallel each thread bins into its own histogram and face area totals,
+ * which are summed into the output once every triangle has been visited.
  */
 class CalculateGBCDImpl
 {
-    size_t startOffset;
-    size_t numEntriesPerTri;
     Int32ArrayType::Pointer m_LabelsArray;
     DoubleArrayType::Pointer m_NormalsArray;
+    DoubleArrayType::Pointer m_AreasArray;
     Int32ArrayType::Pointer m_PhasesArray;
     FloatArrayType::Pointer m_EulersArray;
 
     FloatArrayType::Pointer m_GbcdDeltasArray;
     FloatArrayType::Pointer m_GbcdLimitsArray;
     Int32ArrayType::Pointer m_GbcdSizesArray;
-    Int32ArrayType::Pointer m_GbcdBinsArray;
-    BoolArrayType::Pointer  m_GbcdHemiCheckArray;
 
     UInt32ArrayType::Pointer m_CrystalStructuresArray;
     QVector<SpaceGroupOps::Pointer> m_OrientationOps;
 
+    size_t m_TotalGBCDBins;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::enumerable_thread_specific<std::vector<double> >* m_ThreadGbcd;
+    tbb::enumerable_thread_specific<std::vector<double> >* m_ThreadFaceArea;
+#endif
+
   public:
-    CalculateGBCDImpl(size_t i, size_t numMisoReps, Int32ArrayType::Pointer Labels, DoubleArrayType::Pointer Normals, FloatArrayType::Pointer Eulers,
-                      Int32ArrayType::Pointer Phases, UInt32ArrayType::Pointer CrystalStructures,
-                      Int32ArrayType::Pointer Bins, BoolArrayType::Pointer HemiCheck,
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    typedef tbb::enumerable_thread_specific<std::vector<double> > ThreadHistograms;
+#endif
+
+    CalculateGBCDImpl(size_t totalGBCDBins, Int32ArrayType::Pointer Labels, DoubleArrayType::Pointer Normals, DoubleArrayType::Pointer Areas,
+                      FloatArrayType::Pointer Eulers, Int32ArrayType::Pointer Phases, UInt32ArrayType::Pointer CrystalStructures,
                       FloatArrayType::Pointer GBCDdeltas, Int32ArrayType::Pointer  GBCDsizes,
                       FloatArrayType::Pointer GBCDlimits) :
-      startOffset(i),
-      numEntriesPerTri(numMisoReps),
       m_LabelsArray(Labels),
       m_NormalsArray(Normals),
+      m_AreasArray(Areas),
       m_PhasesArray(Phases),
       m_EulersArray(Eulers),
       m_GbcdDeltasArray(GBCDdeltas),
       m_GbcdLimitsArray(GBCDlimits),
       m_GbcdSizesArray(GBCDsizes),
-      m_GbcdBinsArray(Bins),
-      m_GbcdHemiCheckArray(HemiCheck),
-      m_CrystalStructuresArray(CrystalStructures)
+      m_CrystalStructuresArray(CrystalStructures),
+      m_TotalGBCDBins(totalGBCDBins)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      , m_ThreadGbcd(NULL),
+      m_ThreadFaceArea(NULL)
+#endif
     {
       m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
     }
+
     virtual ~CalculateGBCDImpl() {}
 
-    void generate(size_t start, size_t end) const
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    /**
+     * @brief setThreadHistograms Sets the per thread histograms that operator() bins into
+     */
+    void setThreadHistograms(ThreadHistograms* gbcd, ThreadHistograms* totalFaceArea)
+    {
+      m_ThreadGbcd = gbcd;
+      m_ThreadFaceArea = totalFaceArea;
+    }
+#endif
+
+    /**
+     * @brief generate Bins the triangles in [start, end) into the given histograms
+     * @param gbcd numPhases * totalGBCDBins histogram values
+     * @param totalFaceArea Binned area for each phase
+     */
+    void generate(size_t start, size_t end, double* gbcd, double* totalFaceArea) const
     {
 
       // We want to work with the raw pointers for speed so get those pointers.
       float* m_GBCDdeltas = m_GbcdDeltasArray->getPointer(0);
       float* m_GBCDlimits = m_GbcdLimitsArray->getPointer(0);
       int* m_GBCDsizes = m_GbcdSizesArray->getPointer(0);
-      int32_t* m_Bins = m_GbcdBinsArray->getPointer(0);
-      bool* m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
       int32_t* m_Labels = m_LabelsArray->getPointer(0);
       double* m_Normals = m_NormalsArray->getPointer(0);
+      double* m_Areas = m_AreasArray->getPointer(0);
       int32_t* m_Phases = m_PhasesArray->getPointer(0);
       float* m_Eulers = m_EulersArray->getPointer(0);
       uint32_t* m_CrystalStructures = m_CrystalStructuresArray->getPointer(0);
@@ -139,13 +168,11 @@ class CalculateGBCDImpl
       int32_t gbcd_index = 0;
       float sqCoord[2] = { 0.0f, 0.0f }, sqCoordInv[2] = { 0.0f, 0.0f };
       bool nhCheck = false, nhCheckInv = true;
-      int32_t SYMcounter = 0;
-      int64_t TRIcounter = static_cast<int64_t>(start - startOffset);
-      int64_t TRIcounterShift = 0;
+      double area = 0.0;
+      double* phaseGbcd = NULL;
 
       for (size_t i = start; i < end; i++)
       {
-        SYMcounter = 0;
         feature1 = m_Labels[2 * i];
         feature2 = m_Labels[2 * i + 1];
         normal[0] = m_Normals[3 * i];
@@ -156,8 +183,10 @@ class CalculateGBCDImpl
 
         if (m_Phases[feature1] == m_Phases[feature2] && m_Phases[feature1] > 0)
         {
-          TRIcounterShift = (TRIcounter * numEntriesPerTri);
           uint32_t cryst = m_CrystalStructures[m_Phases[feature1]];
+          area = m_Areas[i];
+          phaseGbcd = gbcd + m_Phases[feature1] * m_TotalGBCDBins;
+          double& phaseFaceArea = totalFaceArea[m_Phases[feature1]];
           for (int32_t q = 0; q < 2; q++)
           {
             if (q == 1)
@@ -224,34 +253,31 @@ class CalculateGBCDImpl
                   gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoord);
                   if (gbcd_index != -1)
                   {
-                    m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheck;
-                    m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                    // the southern hemisphere is stored in the odd bins
+                    phaseGbcd[2 * gbcd_index + (nhCheck == false ? 1 : 0)] += area;
+                    phaseFaceArea += area;
                   }
-                  SYMcounter++;
                   if (inversion == 1)
                   {
                     gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoordInv);
                     if (gbcd_index != -1)
                     {
-                      m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheckInv;
-                      m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                      phaseGbcd[2 * gbcd_index + (nhCheckInv == false ? 1 : 0)] += area;
+                      phaseFaceArea += area;
                     }
-                    SYMcounter++;
                   }
                 }
-                else { SYMcounter += 2; }
               }
             }
           }
         }
-        TRIcounter++;
       }
     }
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
     void operator()(const tbb::blocked_range<size_t>& r) const
     {
-      generate(r.begin(), r.end());
+      generate(r.begin(), r.end(), &(m_ThreadGbcd->local().front()), &(m_ThreadFaceArea->local().front()));
     }
 #endif
 
@@ -349,15 +375,11 @@ FindGBCD::FindGBCD() :
   m_GBCD(NULL),
   m_GbcdDeltas(NULL),
   m_GbcdSizes(NULL),
-  m_GbcdLimits(NULL),
-  m_GbcdBins(NULL),
-  m_HemiCheck(NULL)
+  m_GbcdLimits(NULL)
 {
   m_GbcdDeltasArray = FloatArrayType::NullPointer();
   m_GbcdSizesArray = Int32ArrayType::NullPointer();
   m_GbcdLimitsArray = FloatArrayType::NullPointer();
-  m_GbcdBinsArray = Int32ArrayType::NullPointer();
-  m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
 
   setupFilterParameters();
 }
@@ -482,8 +504,8 @@ void FindGBCD::dataCheckSurfaceMesh()
   if( NULL != m_SurfaceMeshFaceAreasPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
   { m_SurfaceMeshFaceAreas = m_SurfaceMeshFaceAreasPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
 
-  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.  Note that the input parameters do not affect the size and can be dummy values here;
-  sizeGBCD(0, 0);
+  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.
+  sizeGBCD();
   cDims.resize(6);
   cDims[0] = m_GbcdSizes[0];
   cDims[1] = m_GbcdSizes[1];
@@ -557,10 +579,8 @@ void FindGBCD::execute()
   size_t totalPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
   size_t totalFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
   size_t faceChunkSize = 50000;
-  size_t numMisoReps = 576 * 4;
   if (totalFaces < faceChunkSize) { faceChunkSize = totalFaces; }
-  // call the sizeGBCD function with proper chunkSize and numMisoReps to get Bins array set up properly
-  sizeGBCD(faceChunkSize, numMisoReps);
+  sizeGBCD();
   int32_t totalGBCDBins = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3] * m_GbcdSizes[4] * 2;
 
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
@@ -569,12 +589,19 @@ void FindGBCD::execute()
   uint64_t estimatedTime = 0;
   float timeDiff = 0.0f;
   startMillis =  QDateTime::currentMSecsSinceEpoch();
-  int32_t hemisphere = 0;
 
-  //create an array to hold the total face area for each phase and initialize the array to 0.0
-  DoubleArrayType::Pointer totalFaceAreaPtr = DoubleArrayType::CreateArray(totalPhases, "totalFaceArea");
-  totalFaceAreaPtr->initializeWithValue(0.0);
-  double* totalFaceArea = totalFaceAreaPtr->getPointer(0);
+  // The triangle areas are accumulated straight into the GBCD histograms; the faces are still handed out a chunk
+  // at a time so progress can be reported and the filter can be canceled
+  CalculateGBCDImpl accumulator(totalGBCDBins, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_SurfaceMeshFaceAreasPtr.lock(),
+                                m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
+  std::vector<double> totalFaceArea(totalPhases, 0.0);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  // Each thread gets one histogram the first time it bins a triangle and keeps it across all of the chunks
+  CalculateGBCDImpl::ThreadHistograms threadGbcd(std::vector<double>(totalPhases * totalGBCDBins, 0.0));
+  CalculateGBCDImpl::ThreadHistograms threadFaceArea(std::vector<double>(totalPhases, 0.0));
+  accumulator.setThreadHistograms(&threadGbcd, &threadFaceArea);
+#endif
 
   QString ss = QObject::tr("Calculating GBCD || 0/%1 Completed").arg(totalFaces);
   for (size_t i = 0; i < totalFaces; i = i + faceChunkSize)
@@ -584,19 +611,15 @@ void FindGBCD::execute()
     {
       faceChunkSize = totalFaces - i;
     }
-    m_GbcdBinsArray->initializeWithValue(-1);
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
     if (doParallel == true)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize),
-                        CalculateGBCDImpl(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray), tbb::auto_partitioner());
-
+      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize), accumulator, tbb::auto_partitioner());
     }
     else
 #endif
     {
-      CalculateGBCDImpl serial(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
-      serial.generate(i, i + faceChunkSize);
+      accumulator.generate(i, i + faceChunkSize, m_GBCD, &(totalFaceArea.front()));
     }
 
     currentMillis = QDateTime::currentMSecsSinceEpoch();
@@ -609,29 +632,27 @@ void FindGBCD::execute()
       millis = QDateTime::currentMSecsSinceEpoch();
       notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
     }
+  }
 
-    if(getCancel() == true) { return; }
+  if(getCancel() == true) { return; }
 
-    int32_t phase = 0;
-    int32_t feature = 0;
-    double area = 0.0;
-    for (size_t j = 0; j < faceChunkSize; j++)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  for (CalculateGBCDImpl::ThreadHistograms::const_iterator iter = threadGbcd.begin(); iter != threadGbcd.end(); ++iter)
+  {
+    const std::vector<double>& gbcd = *iter;
+    for (size_t i = 0; i < gbcd.size(); i++)
     {
-      area = m_SurfaceMeshFaceAreas[i + j];
-      feature = m_SurfaceMeshFaceLabels[2 * (i + j)];
-      phase = m_FeaturePhases[feature];
-      for (size_t k = 0; k < numMisoReps; k++)
-      {
-        if (m_GbcdBins[(j * numMisoReps) + (k)] >= 0)
-        {
-          hemisphere = 0;
-          if (m_HemiCheck[(j * numMisoReps) + k] == false) { hemisphere = 1; }
-          m_GBCD[(phase * totalGBCDBins) + (2 * m_GbcdBins[(j * numMisoReps) + (k)] + hemisphere)] += area;
-          totalFaceArea[phase] += area;
-        }
-      }
+      m_GBCD[i] += gbcd[i];
+    }
+  }
+  for (CalculateGBCDImpl::ThreadHistograms::const_iterator iter = threadFaceArea.begin(); iter != threadFaceArea.end(); ++iter)
+  {
+    for (size_t i = 0; i < totalPhases; i++)
+    {
+      totalFaceArea[i] += (*iter)[i];
     }
   }
+#endif
 
   ss = QObject::tr("Starting GBCD Normalization");
   notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
@@ -653,7 +674,7 @@ void FindGBCD::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
+void FindGBCD::sizeGBCD()
 {
   m_GbcdDeltasArray = FloatArrayType::CreateArray(5, "GBCDDeltas");
   m_GbcdDeltasArray->initializeWithZeros();
@@ -661,17 +682,10 @@ void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
   m_GbcdLimitsArray->initializeWithZeros();
   m_GbcdSizesArray = Int32ArrayType::CreateArray(5, "GBCDSizes");
   m_GbcdSizesArray->initializeWithZeros();
-  QVector<size_t> cDims(1, numMisoReps);
-  m_GbcdBinsArray = Int32ArrayType::CreateArray(faceChunkSize, cDims, "GBCDBins");
-  m_GbcdBinsArray->initializeWithZeros();
-  m_GbcdHemiCheckArray = BoolArrayType::CreateArray(faceChunkSize, cDims, "GBCDHemiCheck");
-  m_GbcdHemiCheckArray->initializeWithValue(false);
 
   m_GbcdDeltas = m_GbcdDeltasArray->getPointer(0);
   m_GbcdSizes = m_GbcdSizesArray->getPointer(0);
   m_GbcdLimits = m_GbcdLimitsArray->getPointer(0);
-  m_GbcdBins = m_GbcdBinsArray->getPointer(0);
-  m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
   //Original Ranges from Dave R.
   //m_GBCDlimits[0] = 0.0f;
@@ -151,10 +151,8 @@ class FindGBCD : public SurfaceMeshFilter
 
     /**
      * @brief sizeGBCD Determines the sizing for the GBCD arrays
-     * @param faceChunkSize Number of triangles per chunk
-     * @param numMisoReps Dimensionality for bins
      */
-    void sizeGBCD(size_t faceChunkSize, size_t numMisoReps);
+    void sizeGBCD();
 
   private:
     DEFINE_DATAARRAY_VARIABLE(double, SurfaceMeshFaceAreas)
@@ -168,14 +166,10 @@ class FindGBCD : public SurfaceMeshFilter
     FloatArrayType::Pointer m_GbcdDeltasArray;
     Int32ArrayType::Pointer m_GbcdSizesArray;
     FloatArrayType::Pointer m_GbcdLimitsArray;
-    Int32ArrayType::Pointer m_GbcdBinsArray;
-    BoolArrayType::Pointer m_GbcdHemiCheckArray;
 
     float* m_GbcdDeltas;
     int32_t* m_GbcdSizes;
     float* m_GbcdLimits;
-    int32_t* m_GbcdBins;
-    bool* m_HemiCheck;
 
     FindGBCD(const FindGBCD&); // Copy Constructor Not Implemented
     void operator=(const FindGBCD&); // Operator '=' Not Implemented
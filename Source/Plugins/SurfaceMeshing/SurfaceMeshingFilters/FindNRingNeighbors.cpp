@@ -36,6 +36,9 @@
 
 #include "FindNRingNeighbors.h"
 
+#include <algorithm>
+#include <iterator>
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -68,11 +71,29 @@ void FindNRingNeighbors::setRegionIds(int32_t g, int32_t r)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FindNRingNeighbors::UniqueFaceIds_t& FindNRingNeighbors::getNRingTriangles()
+const FindNRingNeighbors::FaceIds_t& FindNRingNeighbors::getNRingTriangles() const
 {
   return m_NRingTriangles;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FindNRingNeighbors::checkSeedRegionIds(int32_t* faceLabels) const
+{
+  // Figure out these boolean values for a sanity check
+  bool check0 = faceLabels[m_TriangleId * 2] == m_RegionId0 && faceLabels[m_TriangleId * 2 + 1] == m_RegionId1;
+  bool check1 = faceLabels[m_TriangleId * 2 + 1] == m_RegionId0 && faceLabels[m_TriangleId * 2] == m_RegionId1;
+
+  if ( check0 == false && check1 == false)
+  {
+    qDebug() << "FindNRingNeighbors Seed triangle ID does not have a matching Region ID for " << m_RegionId0 << " & " << m_RegionId1 << "\n";
+    qDebug() << "Region Ids are: " << faceLabels[m_TriangleId * 2] << " & " << faceLabels[m_TriangleId * 2 + 1] << "\n";
+    return false;
+  }
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -96,27 +117,23 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
     node2TrianglePtr = triangleGeom->getElementsContainingVert();
   }
 
-  // Figure out these boolean values for a sanity check
-  bool check0 = faceLabels[m_TriangleId * 2] == m_RegionId0 && faceLabels[m_TriangleId * 2 + 1] == m_RegionId1;
-  bool check1 = faceLabels[m_TriangleId * 2 + 1] == m_RegionId0 && faceLabels[m_TriangleId * 2] == m_RegionId1;
-
-#if 1
-  if ( check0 == false && check1 == false)
+  if (checkSeedRegionIds(faceLabels) == false)
   {
-    qDebug() << "FindNRingNeighbors Seed triangle ID does not have a matching Region ID for " << m_RegionId0 << " & " << m_RegionId1 << "\n";
-    qDebug() << "Region Ids are: " << faceLabels[m_TriangleId * 2] << " & " << faceLabels[m_TriangleId * 2 + 1] << "\n";
     return err;
   }
-#endif
+
+  bool check0 = false;
+  bool check1 = false;
+  UniqueFaceIds_t nRingTriangles;
 
   // Add our seed triangle
-  m_NRingTriangles.insert(m_TriangleId);
+  nRingTriangles.insert(m_TriangleId);
 
   for (int64_t ring = 0; ring < m_Ring; ++ring)
   {
     // Make a copy of the 1 Ring Triangles that we just found so that we can use those triangles as the
     // seed triangles for the 2 Ring triangles
-    UniqueFaceIds_t lcvTriangles(m_NRingTriangles);
+    UniqueFaceIds_t lcvTriangles(nRingTriangles);
 
     // Now that we have the 1 ring triangles, get the 2 Ring neighbors from that list
     for (UniqueFaceIds_t::iterator triIter = lcvTriangles.begin(); triIter != lcvTriangles.end(); ++triIter)
@@ -137,11 +154,69 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
           check1 = faceLabels[tid * 2 + 1] == m_RegionId0 && faceLabels[tid * 2] == m_RegionId1;
           if (check0 == true || check1 == true)
           {
-            m_NRingTriangles.insert(tid);
+            nRingTriangles.insert(tid);
           }
         }
       }
     }
   }
+
+  // Seed triangle first, then the rest in ascending order
+  m_NRingTriangles.push_back(m_TriangleId);
+  for (UniqueFaceIds_t::iterator triIter = nRingTriangles.begin(); triIter != nRingTriangles.end(); ++triIter)
+  {
+    if (*triIter != m_TriangleId) { m_NRingTriangles.push_back(*triIter); }
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t FindNRingNeighbors::generate(const TriangleLabelAdjacency* adjacency, int32_t* faceLabels)
+{
+  int32_t err = 0;
+
+  //Clear out all the previous triangles.
+  m_NRingTriangles.clear();
+
+  if (checkSeedRegionIds(faceLabels) == false)
+  {
+    return err;
+  }
+
+  // Every triangle reachable through the adjacency carries the same pair of labels as the seed, so the
+  // region check above is all that is needed. m_Found is kept sorted so that each ring can be merged in.
+  m_Found.assign(1, m_TriangleId);
+  m_Frontier.assign(1, m_TriangleId);
+
+  for (int64_t ring = 0; ring < m_Ring && m_Frontier.empty() == false; ++ring)
+  {
+    m_Candidates.clear();
+    for (FaceIds_t::iterator triIter = m_Frontier.begin(); triIter != m_Frontier.end(); ++triIter)
+    {
+      const int64_t* neighbors = adjacency->getNeighbors(*triIter);
+      int64_t nCount = adjacency->getNumberOfNeighbors(*triIter);
+      m_Candidates.insert(m_Candidates.end(), neighbors, neighbors + nCount);
+    }
+    std::sort(m_Candidates.begin(), m_Candidates.end());
+    m_Candidates.erase(std::unique(m_Candidates.begin(), m_Candidates.end()), m_Candidates.end());
+
+    // The next frontier is whatever this ring added to the patch
+    m_Frontier.clear();
+    std::set_difference(m_Candidates.begin(), m_Candidates.end(), m_Found.begin(), m_Found.end(), std::back_inserter(m_Frontier));
+
+    m_Merged.clear();
+    std::merge(m_Found.begin(), m_Found.end(), m_Frontier.begin(), m_Frontier.end(), std::back_inserter(m_Merged));
+    m_Found.swap(m_Merged);
+  }
+
+  // Seed triangle first, then the rest in ascending order
+  m_NRingTriangles.reserve(m_Found.size());
+  m_NRingTriangles.push_back(m_TriangleId);
+  for (FaceIds_t::iterator triIter = m_Found.begin(); triIter != m_Found.end(); ++triIter)
+  {
+    if (*triIter != m_TriangleId) { m_NRingTriangles.push_back(*triIter); }
+  }
   return err;
 }
@@ -37,10 +37,15 @@
 #ifndef _FindNRingNeighbors_H_
 #define _FindNRingNeighbors_H_
 
+#include <set>
+#include <vector>
+
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/TriangleLabelAdjacency.h"
+
 /**
  * @brief The FindNRingNeighbors class calculates the set of triangles that are "N" rings (based on vertex) from a seed triangle
  */
@@ -54,6 +59,7 @@ class FindNRingNeighbors
     virtual ~FindNRingNeighbors();
 
     typedef std::set<int64_t> UniqueFaceIds_t;
+    typedef std::vector<int64_t> FaceIds_t;
 
     SIMPL_INSTANCE_PROPERTY(int64_t, TriangleId)
 
@@ -80,10 +86,11 @@ class FindNRingNeighbors
     SIMPL_INSTANCE_PROPERTY(int64_t, Ring)
 
     /**
-     * @brief getNRingTriangles Returns the N ring set
-     * @return Set of N ring Ids
+     * @brief getNRingTriangles Returns the N ring triangles. The seed triangle is always the first entry and
+     * the remaining triangles follow in ascending order.
+     * @return Vector of N ring Ids
      */
-    UniqueFaceIds_t& getNRingTriangles();
+    const FaceIds_t& getNRingTriangles() const;
 
     /**
      * @brief generate Generates the N rings based on the supplied TriangleGeom
@@ -93,6 +100,15 @@ class FindNRingNeighbors
      */
     int32_t generate(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels);
 
+    /**
+     * @brief generate Generates the N rings by walking a precomputed triangle adjacency. Only the triangles that
+     * were added in the previous ring are expanded, so each triangle of the patch is visited once.
+     * @param adjacency Adjacency built from the same TriangleGeom and face labels
+     * @param faceLabels Feature Id labels for the TriangleGeom
+     * @return Integer error value
+     */
+    int32_t generate(const TriangleLabelAdjacency* adjacency, int32_t* faceLabels);
+
     SIMPL_INSTANCE_PROPERTY(bool, WriteBinaryFile)
     SIMPL_INSTANCE_PROPERTY(bool, WriteConformalMesh)
 
@@ -100,7 +116,16 @@ class FindNRingNeighbors
     FindNRingNeighbors();
 
   private:
-    UniqueFaceIds_t  m_NRingTriangles;
+    FaceIds_t  m_NRingTriangles;
+    FaceIds_t  m_Frontier;
+    FaceIds_t  m_Candidates;
+    FaceIds_t  m_Found;
+    FaceIds_t  m_Merged;
+
+    /**
+     * @brief checkSeedRegionIds Returns true if the seed triangle lies between the two region ids
+     */
+    bool checkSeedRegionIds(int32_t* faceLabels) const;
 
     FindNRingNeighbors(const FindNRingNeighbors&); // Copy Constructor Not Implemented
     void operator=(const FindNRingNeighbors&); // Operator '=' Not Implemented
@@ -42,6 +42,7 @@
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/IGeometry2D.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 
@@ -56,7 +57,8 @@ GenerateGeometryConnectivity::GenerateGeometryConnectivity() :
   SurfaceMeshFilter(),
   m_SurfaceDataContainerName(""),
   m_GenerateVertexTriangleLists(true),
-  m_GenerateTriangleNeighbors(true)
+  m_GenerateTriangleNeighbors(true),
+  m_GenerateEdgeLists(false)
 {
   setupFilterParameters();
 }
@@ -76,6 +78,7 @@ void GenerateGeometryConnectivity::setupFilterParameters()
   FilterParameterVector parameters;
   parameters.push_back(BooleanFilterParameter::New("Generate Per Vertex Element List", "GenerateVertexTriangleLists", getGenerateVertexTriangleLists(), FilterParameter::Parameter));
   parameters.push_back(BooleanFilterParameter::New("Generate Element Neighbors List", "GenerateTriangleNeighbors", getGenerateTriangleNeighbors(), FilterParameter::Parameter));
+  parameters.push_back(BooleanFilterParameter::New("Generate Edge Lists", "GenerateEdgeLists", getGenerateEdgeLists(), FilterParameter::Parameter));
   {
     DataContainerSelectionFilterParameter::RequirementType req;
     parameters.push_back(DataContainerSelectionFilterParameter::New("Data Container", "SurfaceDataContainerName", getSurfaceDataContainerName(), FilterParameter::RequiredArray, req));
@@ -92,6 +95,7 @@ void GenerateGeometryConnectivity::readFilterParameters(AbstractFilterParameters
   setSurfaceDataContainerName(reader->readString("SurfaceDataContainerName", getSurfaceDataContainerName() ) );
   setGenerateVertexTriangleLists( reader->readValue("GenerateVertexTriangleLists", getGenerateVertexTriangleLists()) );
   setGenerateTriangleNeighbors( reader->readValue("GenerateTriangleNeighbors", getGenerateTriangleNeighbors()) );
+  setGenerateEdgeLists( reader->readValue("GenerateEdgeLists", getGenerateEdgeLists()) );
   reader->closeFilterGroup();
 }
 
@@ -105,6 +109,7 @@ int GenerateGeometryConnectivity::writeFilterParameters(AbstractFilterParameters
   SIMPL_FILTER_WRITE_PARAMETER(SurfaceDataContainerName)
   SIMPL_FILTER_WRITE_PARAMETER(GenerateVertexTriangleLists)
   SIMPL_FILTER_WRITE_PARAMETER(GenerateTriangleNeighbors)
+  SIMPL_FILTER_WRITE_PARAMETER(GenerateEdgeLists)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -114,7 +119,15 @@ int GenerateGeometryConnectivity::writeFilterParameters(AbstractFilterParameters
 // -----------------------------------------------------------------------------
 void GenerateGeometryConnectivity::dataCheck()
 {
-  getDataContainerArray()->getPrereqGeometryFromDataContainer<IGeometry, AbstractFilter>(this, getSurfaceDataContainerName());
+  IGeometry::Pointer geom = getDataContainerArray()->getPrereqGeometryFromDataContainer<IGeometry, AbstractFilter>(this, getSurfaceDataContainerName());
+  if(getErrorCondition() < 0 || NULL == geom.get()) { return; }
+
+  if (m_GenerateEdgeLists == true && NULL == boost::dynamic_pointer_cast<IGeometry2D>(geom).get())
+  {
+    setErrorCondition(-402);
+    QString ss = QObject::tr("Edge lists can only be generated for Triangle and Quadrilateral Geometries, but the Geometry type is %1").arg(geom->getGeometryTypeAsString());
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -166,6 +179,23 @@ void GenerateGeometryConnectivity::execute()
     }
   }
 
+  if (m_GenerateEdgeLists == true)
+  {
+    IGeometry2D::Pointer geom2D = sm->getGeometryAs<IGeometry2D>();
+    notifyStatusMessage(getHumanLabel(), "Generating Edge Lists");
+    err = geom2D->findEdges();
+    if (err >= 0)
+    {
+      err = geom2D->findUnsharedEdges();
+    }
+    if (err < 0)
+    {
+      setErrorCondition(-403);
+      QString ss = QObject::tr("Error generating edge lists for Geometry type %1").arg(geom->getGeometryTypeAsString());
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+  }
+
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
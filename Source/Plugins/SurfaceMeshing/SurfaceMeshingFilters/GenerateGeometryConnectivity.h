@@ -65,6 +65,9 @@ class GenerateGeometryConnectivity : public SurfaceMeshFilter
     SIMPL_FILTER_PARAMETER(bool, GenerateTriangleNeighbors)
     Q_PROPERTY(bool GenerateTriangleNeighbors READ getGenerateTriangleNeighbors WRITE setGenerateTriangleNeighbors)
 
+    SIMPL_FILTER_PARAMETER(bool, GenerateEdgeLists)
+    Q_PROPERTY(bool GenerateEdgeLists READ getGenerateEdgeLists WRITE setGenerateEdgeLists)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -77,6 +77,9 @@ ADD_DREAM3D_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} Mesh
 ADD_DREAM3D_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} FindNRingNeighbors.h)
 ADD_DREAM3D_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} FindNRingNeighbors.cpp)
 
+ADD_DREAM3D_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} TriangleLabelAdjacency.h)
+ADD_DREAM3D_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} TriangleLabelAdjacency.cpp)
+
 ADD_DREAM3D_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/Vector3.h)
 ADD_DREAM3D_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/Vector3.cpp)
 
@@ -0,0 +1,210 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "TriangleLabelAdjacency.h"
+
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace Detail
+{
+  /**
+   * @brief The FindLabelNeighborsImpl class collects the neighbors of a range of triangles. Without an output
+   * array it only stores the number of neighbors of each triangle; with one it writes the neighbors at the offsets
+   * computed from those counts.
+   */
+  class FindLabelNeighborsImpl
+  {
+    public:
+      FindLabelNeighborsImpl(const int64_t* triangles, const int32_t* faceLabels, ElementDynamicList* trianglesContainingVert,
+                             int64_t* counts, const int64_t* offsets, int64_t* neighbors) :
+        m_Triangles(triangles),
+        m_FaceLabels(faceLabels),
+        m_TrianglesContainingVert(trianglesContainingVert),
+        m_Counts(counts),
+        m_Offsets(offsets),
+        m_Neighbors(neighbors)
+      {}
+      virtual ~FindLabelNeighborsImpl() {}
+
+      void generate(size_t start, size_t end) const
+      {
+        std::vector<int64_t> candidates;
+        for (size_t t = start; t < end; t++)
+        {
+          int32_t label0 = m_FaceLabels[t * 2];
+          int32_t label1 = m_FaceLabels[t * 2 + 1];
+          candidates.clear();
+          for (int32_t v = 0; v < 3; v++)
+          {
+            int64_t vert = m_Triangles[t * 3 + v];
+            uint16_t tCount = m_TrianglesContainingVert->getNumberOfElements(vert);
+            int64_t* data = m_TrianglesContainingVert->getElementListPointer(vert);
+            for (uint16_t i = 0; i < tCount; i++)
+            {
+              int64_t tid = data[i];
+              if (tid == static_cast<int64_t>(t)) { continue; }
+              bool check0 = m_FaceLabels[tid * 2] == label0 && m_FaceLabels[tid * 2 + 1] == label1;
+              bool check1 = m_FaceLabels[tid * 2 + 1] == label0 && m_FaceLabels[tid * 2] == label1;
+              if (check0 == true || check1 == true) { candidates.push_back(tid); }
+            }
+          }
+          std::sort(candidates.begin(), candidates.end());
+          candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+          if (NULL == m_Neighbors)
+          {
+            m_Counts[t] = static_cast<int64_t>(candidates.size());
+          }
+          else if (candidates.empty() == false)
+          {
+            std::copy(candidates.begin(), candidates.end(), m_Neighbors + m_Offsets[t]);
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        generate(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      const int64_t* m_Triangles;
+      const int32_t* m_FaceLabels;
+      ElementDynamicList* m_TrianglesContainingVert;
+      int64_t* m_Counts;
+      const int64_t* m_Offsets;
+      int64_t* m_Neighbors;
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleLabelAdjacency::TriangleLabelAdjacency() :
+  m_Offsets(1, 0)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleLabelAdjacency::~TriangleLabelAdjacency()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriangleLabelAdjacency::getNumberOfTriangles() const
+{
+  return static_cast<int64_t>(m_Offsets.size()) - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t TriangleLabelAdjacency::build(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels)
+{
+  m_Offsets.assign(1, 0);
+  m_Neighbors.clear();
+
+  // Make sure we have the proper connectivity built
+  ElementDynamicList::Pointer node2TrianglePtr = triangleGeom->getElementsContainingVert();
+  if (node2TrianglePtr.get() == NULL)
+  {
+    int32_t err = triangleGeom->findElementsContainingVert();
+    if (err < 0)
+    {
+      return err;
+    }
+    node2TrianglePtr = triangleGeom->getElementsContainingVert();
+  }
+
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+  size_t numTriangles = static_cast<size_t>(triangleGeom->getNumberOfTris());
+  m_Offsets.assign(numTriangles + 1, 0);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // First count the neighbors of every triangle, then fill them in at the prefix sum of the counts
+  Detail::FindLabelNeighborsImpl countImpl(triangles, faceLabels, node2TrianglePtr.get(), &(m_Offsets.front()) + 1, NULL, NULL);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles), countImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    countImpl.generate(0, numTriangles);
+  }
+
+  for (size_t t = 0; t < numTriangles; t++)
+  {
+    m_Offsets[t + 1] += m_Offsets[t];
+  }
+  m_Neighbors.resize(static_cast<size_t>(m_Offsets.back()));
+  if (m_Neighbors.empty() == true)
+  {
+    return 0;
+  }
+
+  Detail::FindLabelNeighborsImpl fillImpl(triangles, faceLabels, node2TrianglePtr.get(), NULL, &(m_Offsets.front()), &(m_Neighbors.front()));
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles), fillImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    fillImpl.generate(0, numTriangles);
+  }
+
+  return 0;
+}
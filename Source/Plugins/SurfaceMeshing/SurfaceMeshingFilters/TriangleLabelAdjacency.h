@@ -0,0 +1,101 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _TriangleLabelAdjacency_H_
+#define _TriangleLabelAdjacency_H_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+/**
+ * @brief The TriangleLabelAdjacency class holds, in compressed row form, the triangles that share at least one vertex
+ * with each triangle of a mesh and carry the same pair of face labels (in either order). N ring neighborhoods only
+ * ever grow through such triangles, so the adjacency is built once per mesh and shared by every N ring search.
+ */
+class TriangleLabelAdjacency
+{
+  public:
+    SIMPL_SHARED_POINTERS(TriangleLabelAdjacency)
+    SIMPL_STATIC_NEW_MACRO(TriangleLabelAdjacency)
+    SIMPL_TYPE_MACRO(TriangleLabelAdjacency)
+
+    virtual ~TriangleLabelAdjacency();
+
+    /**
+     * @brief build Computes the adjacency of every triangle of the geometry. The vertex to triangle links of the
+     * geometry are created first if they do not exist yet.
+     * @param triangleGeom Incoming TriangleGeom object
+     * @param faceLabels Feature Id labels for the TriangleGeom (2 per triangle)
+     * @return Integer error value
+     */
+    int32_t build(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels);
+
+    /**
+     * @brief getNumberOfTriangles Returns the number of triangles of the last build
+     */
+    int64_t getNumberOfTriangles() const;
+
+    /**
+     * @brief getNumberOfNeighbors Returns the number of neighbors of a triangle
+     */
+    int64_t getNumberOfNeighbors(int64_t triangle) const
+    {
+      return m_Offsets[triangle + 1] - m_Offsets[triangle];
+    }
+
+    /**
+     * @brief getNeighbors Returns the neighbors of a triangle in ascending order
+     */
+    const int64_t* getNeighbors(int64_t triangle) const
+    {
+      return m_Neighbors.empty() ? NULL : &(m_Neighbors.front()) + m_Offsets[triangle];
+    }
+
+  protected:
+    TriangleLabelAdjacency();
+
+  private:
+    std::vector<int64_t> m_Offsets;
+    std::vector<int64_t> m_Neighbors;
+
+    TriangleLabelAdjacency(const TriangleLabelAdjacency&); // Copy Constructor Not Implemented
+    void operator=(const TriangleLabelAdjacency&); // Operator '=' Not Implemented
+};
+
+#endif /* _TriangleLabelAdjacency_H_ */
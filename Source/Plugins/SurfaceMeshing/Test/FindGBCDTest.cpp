@@ -0,0 +1,513 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+// Number of random meshes compared against the staged serial GBCD
+static const int32_t k_NumRandomMeshes = 6;
+
+// Number of symmetric misorientation entries staged for each triangle by the old serial GBCD
+static const size_t k_NumMisoReps = 576 * 4;
+
+/**
+ * @brief The ReferenceMesh struct holds the inputs of a random surface mesh
+ */
+struct ReferenceMesh
+{
+  std::vector<int32_t> labels;
+  std::vector<double> normals;
+  std::vector<double> areas;
+  std::vector<float> eulers;
+  std::vector<int32_t> phases;
+  std::vector<uint32_t> crystalStructures;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  QString filtName = "FindGBCD";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The FindGBCDTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//  The GBCD ranges, bin sizes and bin counts for a resolution in degrees, as FindGBCD::sizeGBCD() sets them up
+// -----------------------------------------------------------------------------
+void SizeGBCD(float gbcdRes, float deltas[5], float limits[10], int32_t sizes[5])
+{
+  limits[0] = 0.0f;
+  limits[1] = 0.0f;
+  limits[2] = 0.0f;
+  limits[3] = 0.0f;
+  limits[4] = 0.0f;
+  limits[5] = SIMPLib::Constants::k_PiOver2;
+  limits[6] = 1.0f;
+  limits[7] = SIMPLib::Constants::k_PiOver2;
+  limits[8] = 1.0f;
+  limits[9] = SIMPLib::Constants::k_2Pi;
+
+  float binsize = gbcdRes * SIMPLib::Constants::k_PiOver180;
+  float binsize2 = binsize * (2.0 / SIMPLib::Constants::k_Pi);
+  deltas[0] = binsize;
+  deltas[1] = binsize2;
+  deltas[2] = binsize;
+  deltas[3] = binsize2;
+  deltas[4] = binsize;
+
+  for (int32_t i = 0; i < 5; i++)
+  {
+    sizes[i] = int32_t(0.5 + (limits[i + 5] - limits[i]) / deltas[i]);
+  }
+
+  float totalNormalBins = sizes[3] * sizes[4];
+  sizes[3] = int32_t(sqrtf(totalNormalBins) + 0.5f);
+  sizes[4] = int32_t(sqrtf(totalNormalBins) + 0.5f);
+  limits[3] = -sqrtf(SIMPLib::Constants::k_PiOver2);
+  limits[4] = -sqrtf(SIMPLib::Constants::k_PiOver2);
+  limits[8] = sqrtf(SIMPLib::Constants::k_PiOver2);
+  limits[9] = sqrtf(SIMPLib::Constants::k_PiOver2);
+  deltas[3] = (limits[8] - limits[3]) / float(sizes[3]);
+  deltas[4] = (limits[9] - limits[4]) / float(sizes[4]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t GBCDIndex(const float deltas[5], const int32_t sizes[5], const float limits[10], const float eulerN[3], const float sqCoord[2])
+{
+  float mis_eulerNorm[5] = { eulerN[0], eulerN[1], eulerN[2], sqCoord[0], sqCoord[1] };
+  for (int32_t i = 0; i < 5; i++)
+  {
+    if (mis_eulerNorm[i] < limits[i] || mis_eulerNorm[i] > limits[i + 5]) { return -1; }
+  }
+
+  int32_t index[5] = { 0, 0, 0, 0, 0 };
+  for (int32_t i = 0; i < 5; i++)
+  {
+    index[i] = (int32_t)((mis_eulerNorm[i] - limits[i]) / deltas[i]);
+    if (index[i] > (sizes[i] - 1)) { index[i] = (sizes[i] - 1); }
+    if (index[i] < 0) { index[i] = 0; }
+  }
+
+  int32_t n1 = sizes[0];
+  int32_t n1n2 = n1 * sizes[1];
+  int32_t n1n2n3 = n1n2 * sizes[2];
+  int32_t n1n2n3n4 = n1n2n3 * sizes[3];
+  return index[0] + n1 * index[1] + n1n2 * index[2] + n1n2n3 * index[3] + n1n2n3n4 * index[4];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GetSquareCoord(const float xstl1_norm1[3], float sqCoord[2])
+{
+  bool nhCheck = false;
+  float adjust = 1.0;
+  if (xstl1_norm1[2] >= 0.0)
+  {
+    adjust = -1.0;
+    nhCheck = true;
+  }
+  if (fabsf(xstl1_norm1[0]) >= fabsf(xstl1_norm1[1]))
+  {
+    sqCoord[0] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
+    sqCoord[1] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[1] / xstl1_norm1[0]));
+  }
+  else
+  {
+    sqCoord[0] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0 * 1.0 * (1.0 + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[0] / xstl1_norm1[1]));
+    sqCoord[1] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0 * 1.0 * (1.0 + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
+  }
+  return nhCheck;
+}
+
+// -----------------------------------------------------------------------------
+//  The serial GBCD that FindGBCD computed before the triangle areas were binned directly. Every triangle first
+//  stages the bin and hemisphere of each of its symmetric equivalents, then the areas are added to the histogram
+//  one triangle at a time and each phase is normalized to multiples of random distribution. The mesh must not
+//  have negative labels; the staging indexed those triangles inconsistently.
+// -----------------------------------------------------------------------------
+void ReferenceGBCD(const ReferenceMesh& mesh, float gbcdRes, std::vector<double>& gbcd)
+{
+  float deltas[5], limits[10];
+  int32_t sizes[5];
+  SizeGBCD(gbcdRes, deltas, limits, sizes);
+  size_t totalGBCDBins = size_t(sizes[0]) * sizes[1] * sizes[2] * sizes[3] * sizes[4] * 2;
+  size_t totalPhases = mesh.crystalStructures.size();
+  size_t totalFaces = mesh.areas.size();
+
+  QVector<SpaceGroupOps::Pointer> orientationOps = SpaceGroupOps::getOrientationOpsQVector();
+  std::vector<int32_t> bins(totalFaces * k_NumMisoReps, -1);
+  std::vector<bool> hemiCheck(totalFaces * k_NumMisoReps, false);
+
+  float g1ea[3], g2ea[3];
+  float g1[3][3], g2[3][3], g1s[3][3], g2s[3][3], sym1[3][3], sym2[3][3], g2t[3][3], dg[3][3];
+  float euler_mis[3] = { 0.0f, 0.0f, 0.0f };
+  float normal[3];
+  float xstl1_norm1[3];
+  float sqCoord[2] = { 0.0f, 0.0f }, sqCoordInv[2] = { 0.0f, 0.0f };
+  bool nhCheck = false, nhCheckInv = true;
+
+  for (size_t i = 0; i < totalFaces; i++)
+  {
+    int32_t feature1 = mesh.labels[2 * i];
+    int32_t feature2 = mesh.labels[2 * i + 1];
+    for (int32_t m = 0; m < 3; m++) { normal[m] = mesh.normals[3 * i + m]; }
+    if (mesh.phases[feature1] != mesh.phases[feature2] || mesh.phases[feature1] <= 0) { continue; }
+
+    uint32_t cryst = mesh.crystalStructures[mesh.phases[feature1]];
+    size_t symCounter = i * k_NumMisoReps;
+    for (int32_t q = 0; q < 2; q++)
+    {
+      if (q == 1)
+      {
+        std::swap(feature1, feature2);
+        for (int32_t m = 0; m < 3; m++) { normal[m] = -normal[m]; }
+      }
+      for (int32_t m = 0; m < 3; m++)
+      {
+        g1ea[m] = mesh.eulers[3 * feature1 + m];
+        g2ea[m] = mesh.eulers[3 * feature2 + m];
+      }
+
+      FOrientArrayType om(9, 0.0f);
+      FOrientTransformsType::eu2om(FOrientArrayType(g1ea, 3), om);
+      om.toGMatrix(g1);
+      FOrientTransformsType::eu2om(FOrientArrayType(g2ea, 3), om);
+      om.toGMatrix(g2);
+
+      int32_t nsym = orientationOps[cryst]->getNumSymOps();
+      for (int32_t j = 0; j < nsym; j++)
+      {
+        orientationOps[cryst]->getMatSymOp(j, sym1);
+        MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
+        MatrixMath::Multiply3x3with3x1(g1s, normal, xstl1_norm1);
+        nhCheck = GetSquareCoord(xstl1_norm1, sqCoord);
+        sqCoordInv[0] = -sqCoord[0];
+        sqCoordInv[1] = -sqCoord[1];
+        nhCheckInv = !nhCheck;
+
+        for (int32_t k = 0; k < nsym; k++)
+        {
+          orientationOps[cryst]->getMatSymOp(k, sym2);
+          MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
+          MatrixMath::Transpose3x3(g2s, g2t);
+          MatrixMath::Multiply3x3with3x3(g1s, g2t, dg);
+          FOrientArrayType omMis(dg);
+          FOrientArrayType eu(euler_mis, 3);
+          FOrientTransformsType::om2eu(omMis, eu);
+
+          if (euler_mis[0] < SIMPLib::Constants::k_PiOver2 && euler_mis[1] < SIMPLib::Constants::k_PiOver2 && euler_mis[2] < SIMPLib::Constants::k_PiOver2)
+          {
+            euler_mis[1] = cosf(euler_mis[1]);
+            int32_t gbcd_index = GBCDIndex(deltas, sizes, limits, euler_mis, sqCoord);
+            if (gbcd_index != -1)
+            {
+              hemiCheck[symCounter] = nhCheck;
+              bins[symCounter] = gbcd_index;
+            }
+            symCounter++;
+            gbcd_index = GBCDIndex(deltas, sizes, limits, euler_mis, sqCoordInv);
+            if (gbcd_index != -1)
+            {
+              hemiCheck[symCounter] = nhCheckInv;
+              bins[symCounter] = gbcd_index;
+            }
+            symCounter++;
+          }
+          else { symCounter += 2; }
+        }
+      }
+    }
+  }
+
+  gbcd.assign(totalPhases * totalGBCDBins, 0.0);
+  std::vector<double> totalFaceArea(totalPhases, 0.0);
+  for (size_t i = 0; i < totalFaces; i++)
+  {
+    int32_t phase = mesh.phases[mesh.labels[2 * i]];
+    for (size_t k = 0; k < k_NumMisoReps; k++)
+    {
+      size_t entry = i * k_NumMisoReps + k;
+      if (bins[entry] >= 0)
+      {
+        int32_t hemisphere = (hemiCheck[entry] == false) ? 1 : 0;
+        gbcd[phase * totalGBCDBins + 2 * bins[entry] + hemisphere] += mesh.areas[i];
+        totalFaceArea[phase] += mesh.areas[i];
+      }
+    }
+  }
+
+  for (size_t i = 0; i < totalPhases; i++)
+  {
+    double MRDfactor = double(totalGBCDBins) / totalFaceArea[i];
+    for (size_t j = 0; j < totalGBCDBins; j++)
+    {
+      gbcd[i * totalGBCDBins + j] *= MRDfactor;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Builds the image and triangle data containers that FindGBCD reads with its default paths
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer CreateDataContainerArray(const ReferenceMesh& mesh)
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+
+  DataContainer::Pointer image = DataContainer::New(DREAM3D::Defaults::ImageDataContainerName);
+  ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  imageGeom->setDimensions(1, 1, 1);
+  image->setGeometry(imageGeom);
+  dca->addDataContainer(image);
+
+  QVector<size_t> tDims(1, mesh.phases.size());
+  QVector<size_t> cDims(1, 3);
+  AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+  image->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+  FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(tDims, cDims, DREAM3D::FeatureData::EulerAngles);
+  std::copy(mesh.eulers.begin(), mesh.eulers.end(), eulers->getPointer(0));
+  featureAttrMat->addAttributeArray(eulers->getName(), eulers);
+  cDims[0] = 1;
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::FeatureData::Phases);
+  std::copy(mesh.phases.begin(), mesh.phases.end(), phases->getPointer(0));
+  featureAttrMat->addAttributeArray(phases->getName(), phases);
+
+  tDims[0] = mesh.crystalStructures.size();
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+  image->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+  UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(tDims, cDims, DREAM3D::EnsembleData::CrystalStructures);
+  std::copy(mesh.crystalStructures.begin(), mesh.crystalStructures.end(), crystalStructures->getPointer(0));
+  ensembleAttrMat->addAttributeArray(crystalStructures->getName(), crystalStructures);
+
+  // The triangles themselves are never read; every face reuses the same three vertices
+  size_t numFaces = mesh.areas.size();
+  DataContainer::Pointer surface = DataContainer::New(DREAM3D::Defaults::TriangleDataContainerName);
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(3);
+  float* verts = vertices->getPointer(0);
+  std::fill(verts, verts + 9, 0.0f);
+  verts[3] = 1.0f;
+  verts[7] = 1.0f;
+  TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numFaces, vertices, DREAM3D::Geometry::TriangleGeometry);
+  int64_t* tris = triangleGeom->getTriPointer(0);
+  for (size_t i = 0; i < numFaces; i++)
+  {
+    tris[3 * i] = 0;
+    tris[3 * i + 1] = 1;
+    tris[3 * i + 2] = 2;
+  }
+  surface->setGeometry(triangleGeom);
+  dca->addDataContainer(surface);
+
+  tDims[0] = numFaces;
+  AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::FaceAttributeMatrixName, DREAM3D::AttributeMatrixType::Face);
+  surface->addAttributeMatrix(faceAttrMat->getName(), faceAttrMat);
+  cDims[0] = 2;
+  Int32ArrayType::Pointer labels = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::FaceData::SurfaceMeshFaceLabels);
+  std::copy(mesh.labels.begin(), mesh.labels.end(), labels->getPointer(0));
+  faceAttrMat->addAttributeArray(labels->getName(), labels);
+  cDims[0] = 3;
+  DoubleArrayType::Pointer normals = DoubleArrayType::CreateArray(tDims, cDims, DREAM3D::FaceData::SurfaceMeshFaceNormals);
+  std::copy(mesh.normals.begin(), mesh.normals.end(), normals->getPointer(0));
+  faceAttrMat->addAttributeArray(normals->getName(), normals);
+  cDims[0] = 1;
+  DoubleArrayType::Pointer areas = DoubleArrayType::CreateArray(tDims, cDims, DREAM3D::FaceData::SurfaceMeshFaceAreas);
+  std::copy(mesh.areas.begin(), mesh.areas.end(), areas->getPointer(0));
+  faceAttrMat->addAttributeArray(areas->getName(), areas);
+
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//  Random meshes with a cubic and a hexagonal phase. Some faces sit between features of different phases or touch
+//  feature 0, which has no phase, so they are not binned. The filter may sum the areas in a different order than
+//  the serial reference, so the bins are compared with a relative tolerance.
+// -----------------------------------------------------------------------------
+void TestRandomMeshes()
+{
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("FindGBCD");
+  DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+
+  typedef boost::uniform_int<int32_t> NumberDistribution;
+  typedef boost::mt19937 RandomNumberGenerator;
+  typedef boost::variate_generator<RandomNumberGenerator&, NumberDistribution> Generator;
+  RandomNumberGenerator generator;
+  NumberDistribution distribution(0, 9999);
+  Generator numberGenerator(generator, distribution);
+  generator.seed(static_cast<boost::uint32_t>(23));
+
+  for (int32_t n = 0; n < k_NumRandomMeshes; n++)
+  {
+    float gbcdRes = (n % 2 == 0) ? 9.0f : 15.0f;
+    int32_t numFeatures = 4 + numberGenerator() % 12;
+    size_t numFaces = 200 + numberGenerator() % 800;
+
+    ReferenceMesh mesh;
+    mesh.crystalStructures.push_back(Ebsd::CrystalStructure::UnknownCrystalStructure);
+    mesh.crystalStructures.push_back(Ebsd::CrystalStructure::Cubic_High);
+    mesh.crystalStructures.push_back(Ebsd::CrystalStructure::Hexagonal_High);
+    mesh.phases.assign(numFeatures + 1, 0);
+    mesh.eulers.assign(3 * (numFeatures + 1), 0.0f);
+    for (int32_t i = 1; i <= numFeatures; i++)
+    {
+      mesh.phases[i] = (numberGenerator() % 4 == 0) ? 2 : 1;
+      mesh.eulers[3 * i] = SIMPLib::Constants::k_2Pi * numberGenerator() / 10000.0f;
+      mesh.eulers[3 * i + 1] = SIMPLib::Constants::k_Pi * numberGenerator() / 10000.0f;
+      mesh.eulers[3 * i + 2] = SIMPLib::Constants::k_2Pi * numberGenerator() / 10000.0f;
+    }
+    for (size_t i = 0; i < numFaces; i++)
+    {
+      int32_t feature1 = numberGenerator() % (numFeatures + 1);
+      int32_t feature2 = numberGenerator() % (numFeatures + 1);
+      if (feature1 == feature2) { feature2 = (feature2 % numFeatures) + 1; }
+      mesh.labels.push_back(feature1);
+      mesh.labels.push_back(feature2);
+      double normal[3] = { 0.0, 0.0, 0.0 };
+      double length = 0.0;
+      while (length < 0.01)
+      {
+        for (int32_t m = 0; m < 3; m++) { normal[m] = (numberGenerator() - 5000) / 5000.0; }
+        length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      }
+      for (int32_t m = 0; m < 3; m++) { mesh.normals.push_back(normal[m] / length); }
+      mesh.areas.push_back(0.01 + numberGenerator() / 1000.0);
+    }
+
+    std::vector<double> expected;
+    ReferenceGBCD(mesh, gbcdRes, expected);
+
+    AbstractFilter::Pointer filter = filterFactory->create();
+    DataContainerArray::Pointer dca = CreateDataContainerArray(mesh);
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(gbcdRes);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("GBCDRes", var), true)
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+    DataArrayPath gbcdPath(DREAM3D::Defaults::TriangleDataContainerName, DREAM3D::Defaults::FaceEnsembleAttributeMatrixName, DREAM3D::EnsembleData::GBCD);
+    DoubleArrayType::Pointer gbcd = boost::dynamic_pointer_cast<DoubleArrayType>(dca->getAttributeMatrix(gbcdPath)->getAttributeArray(gbcdPath.getDataArrayName()));
+    DREAM3D_REQUIRE_VALID_POINTER(gbcd.get())
+    DREAM3D_REQUIRE_EQUAL(gbcd->getSize(), expected.size())
+
+    double* actual = gbcd->getPointer(0);
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+      // Phase 0 never bins any area, so both normalize its bins to NaN
+      if (expected[i] != expected[i])
+      {
+        DREAM3D_REQUIRE(actual[i] != actual[i])
+        continue;
+      }
+      double tolerance = 1.0e-9 * std::max(fabs(expected[i]), 1.0);
+      DREAM3D_REQUIRED(fabs(actual[i] - expected[i]), <=, tolerance)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("FindGBCDTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+  DREAM3D_REGISTER_TEST( TestRandomMeshes() )
+  PRINT_TEST_SUMMARY();
+  return err;
+}
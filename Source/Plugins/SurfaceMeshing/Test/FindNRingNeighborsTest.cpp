@@ -0,0 +1,281 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <set>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/TriangleLabelAdjacency.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+// -----------------------------------------------------------------------------
+//  Builds a flat strip of numX x numY quads with two triangles per quad. Quad (x, y) holds the triangles
+//  2 * (y * numX + x) and 2 * (y * numX + x) + 1.
+// -----------------------------------------------------------------------------
+TriangleGeom::Pointer CreateGrid(int64_t numX, int64_t numY)
+{
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList((numX + 1) * (numY + 1));
+  float* verts = vertices->getPointer(0);
+  for (int64_t y = 0; y <= numY; y++)
+  {
+    for (int64_t x = 0; x <= numX; x++)
+    {
+      int64_t v = y * (numX + 1) + x;
+      verts[v * 3] = static_cast<float>(x);
+      verts[v * 3 + 1] = static_cast<float>(y);
+      verts[v * 3 + 2] = 0.0f;
+    }
+  }
+
+  TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numX * numY * 2, vertices, "Triangles");
+  int64_t* tris = triangleGeom->getTriPointer(0);
+  for (int64_t y = 0; y < numY; y++)
+  {
+    for (int64_t x = 0; x < numX; x++)
+    {
+      int64_t a = y * (numX + 1) + x;
+      int64_t b = a + 1;
+      int64_t c = a + numX + 1;
+      int64_t d = c + 1;
+      int64_t* t = tris + (y * numX + x) * 6;
+      t[0] = a;
+      t[1] = b;
+      t[2] = d;
+      t[3] = a;
+      t[4] = d;
+      t[5] = c;
+    }
+  }
+  return triangleGeom;
+}
+
+// -----------------------------------------------------------------------------
+//  The N-ring search as it was written before the adjacency was introduced: every ring re-expands every triangle
+//  found so far through the vertex-to-triangle lists. The result is returned with the seed first and the remaining
+//  triangles in ascending order.
+// -----------------------------------------------------------------------------
+std::vector<int64_t> ReferenceNRing(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels, int64_t seed, int64_t ring)
+{
+  std::vector<int64_t> result;
+  int32_t region0 = faceLabels[seed * 2];
+  int32_t region1 = faceLabels[seed * 2 + 1];
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+  ElementDynamicList::Pointer node2TrianglePtr = triangleGeom->getElementsContainingVert();
+
+  std::set<int64_t> nRingTriangles;
+  nRingTriangles.insert(seed);
+  for (int64_t r = 0; r < ring; r++)
+  {
+    std::set<int64_t> lcvSet(nRingTriangles);
+    for (std::set<int64_t>::iterator iter = lcvSet.begin(); iter != lcvSet.end(); ++iter)
+    {
+      int64_t triangleIdx = *iter;
+      for (int32_t i = 0; i < 3; i++)
+      {
+        int64_t vert = triangles[triangleIdx * 3 + i];
+        uint16_t tCount = node2TrianglePtr->getNumberOfElements(vert);
+        int64_t* data = node2TrianglePtr->getElementListPointer(vert);
+        for (uint16_t t = 0; t < tCount; t++)
+        {
+          int64_t tid = data[t];
+          bool check0 = faceLabels[tid * 2] == region0 && faceLabels[tid * 2 + 1] == region1;
+          bool check1 = faceLabels[tid * 2 + 1] == region0 && faceLabels[tid * 2] == region1;
+          if (check0 == true || check1 == true)
+          {
+            nRingTriangles.insert(tid);
+          }
+        }
+      }
+    }
+  }
+
+  result.push_back(seed);
+  for (std::set<int64_t>::iterator iter = nRingTriangles.begin(); iter != nRingTriangles.end(); ++iter)
+  {
+    if (*iter != seed)
+    {
+      result.push_back(*iter);
+    }
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RequireNRing(const std::vector<int64_t>& found, const int64_t* expected, size_t numExpected)
+{
+  DREAM3D_REQUIRE_EQUAL(found.size(), numExpected)
+  for (size_t i = 0; i < numExpected; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(found[i], expected[i])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  A 4 x 1 strip where the triangles of the third quad lie between a different pair of features. The rings can
+//  not grow across that quad, so the fourth quad is never reached.
+// -----------------------------------------------------------------------------
+void TestStrip()
+{
+  TriangleGeom::Pointer triangleGeom = CreateGrid(4, 1);
+  int32_t labels[16] = { 1, 2, 2, 1, 1, 2, 2, 1, 1, 3, 3, 1, 1, 2, 1, 2 };
+  int32_t err = triangleGeom->findElementsContainingVert();
+  DREAM3D_REQUIRED(err, >=, 0)
+
+  TriangleLabelAdjacency::Pointer adjacency = TriangleLabelAdjacency::New();
+  err = adjacency->build(triangleGeom, labels);
+  DREAM3D_REQUIRED(err, >=, 0)
+
+  FindNRingNeighbors::Pointer nRing = FindNRingNeighbors::New();
+  nRing->setRegionIds(1, 2);
+
+  // Triangle 0 touches the first two quads; the second ring stops at the third quad
+  const int64_t ring1[4] = { 0, 1, 2, 3 };
+  nRing->setTriangleId(0);
+  nRing->setRing(1);
+  err = nRing->generate(triangleGeom, labels);
+  DREAM3D_REQUIRED(err, >=, 0)
+  RequireNRing(nRing->getNRingTriangles(), ring1, 4);
+  err = nRing->generate(adjacency.get(), labels);
+  DREAM3D_REQUIRED(err, >=, 0)
+  RequireNRing(nRing->getNRingTriangles(), ring1, 4);
+
+  nRing->setRing(3);
+  nRing->generate(triangleGeom, labels);
+  RequireNRing(nRing->getNRingTriangles(), ring1, 4);
+  nRing->generate(adjacency.get(), labels);
+  RequireNRing(nRing->getNRingTriangles(), ring1, 4);
+
+  // The seed is always listed first, even when it is not the smallest id
+  const int64_t seedFirst[4] = { 3, 0, 1, 2 };
+  nRing->setTriangleId(3);
+  nRing->setRing(2);
+  nRing->generate(triangleGeom, labels);
+  RequireNRing(nRing->getNRingTriangles(), seedFirst, 4);
+  nRing->generate(adjacency.get(), labels);
+  RequireNRing(nRing->getNRingTriangles(), seedFirst, 4);
+
+  // The last quad only has itself
+  const int64_t isolated[2] = { 6, 7 };
+  nRing->setTriangleId(6);
+  nRing->setRing(2);
+  nRing->generate(adjacency.get(), labels);
+  RequireNRing(nRing->getNRingTriangles(), isolated, 2);
+
+  // A seed that does not lie between the requested features yields nothing
+  nRing->setTriangleId(4);
+  nRing->setRegionIds(1, 2);
+  nRing->generate(triangleGeom, labels);
+  DREAM3D_REQUIRE_EQUAL(nRing->getNRingTriangles().size(), 0)
+  nRing->generate(adjacency.get(), labels);
+  DREAM3D_REQUIRE_EQUAL(nRing->getNRingTriangles().size(), 0)
+}
+
+// -----------------------------------------------------------------------------
+//  A grid with random feature patches, where some triangles are assigned a third feature. Both generate() overloads
+//  must find the same N-ring as the original search for every seed and ring.
+// -----------------------------------------------------------------------------
+void TestRandomPatches()
+{
+  const int64_t numX = 40;
+  const int64_t numY = 30;
+  TriangleGeom::Pointer triangleGeom = CreateGrid(numX, numY);
+  int64_t numTris = triangleGeom->getNumberOfTris();
+
+  srand(3);
+  std::vector<int32_t> labels(static_cast<size_t>(numTris * 2));
+  for (int64_t y = 0; y < numY; y++)
+  {
+    for (int64_t x = 0; x < numX; x++)
+    {
+      int32_t label0 = static_cast<int32_t>((x / 7) + (y / 9) * 10);
+      for (int64_t k = 0; k < 2; k++)
+      {
+        int32_t label1 = label0 + 1 + (rand() % 15 == 0 ? 1 : 0);
+        int64_t t = (y * numX + x) * 2 + k;
+        bool flip = (rand() % 2 == 0);
+        labels[t * 2] = flip ? label1 : label0;
+        labels[t * 2 + 1] = flip ? label0 : label1;
+      }
+    }
+  }
+
+  int32_t err = triangleGeom->findElementsContainingVert();
+  DREAM3D_REQUIRED(err, >=, 0)
+  TriangleLabelAdjacency::Pointer adjacency = TriangleLabelAdjacency::New();
+  err = adjacency->build(triangleGeom, &(labels.front()));
+  DREAM3D_REQUIRED(err, >=, 0)
+  DREAM3D_REQUIRE_EQUAL(adjacency->getNumberOfTriangles(), numTris)
+
+  FindNRingNeighbors::Pointer nRing = FindNRingNeighbors::New();
+  for (int64_t ring = 1; ring <= 4; ring++)
+  {
+    nRing->setRing(ring);
+    for (int64_t t = 0; t < numTris; t++)
+    {
+      std::vector<int64_t> reference = ReferenceNRing(triangleGeom, &(labels.front()), t, ring);
+      nRing->setTriangleId(t);
+      nRing->setRegionIds(labels[t * 2], labels[t * 2 + 1]);
+
+      nRing->generate(triangleGeom, &(labels.front()));
+      DREAM3D_REQUIRE(nRing->getNRingTriangles() == reference)
+      nRing->generate(adjacency.get(), &(labels.front()));
+      DREAM3D_REQUIRE(nRing->getNRingTriangles() == reference)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestStrip() )
+  DREAM3D_REGISTER_TEST( TestRandomPatches() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
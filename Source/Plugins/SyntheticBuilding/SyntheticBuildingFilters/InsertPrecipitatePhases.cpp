@@ -125,6 +125,9 @@ InsertPrecipitatePhases::InsertPrecipitatePhases() :
   m_CurrentSizeDistError = m_OldSizeDistError = 0.0f;
   m_rdfMax = m_rdfMin = m_StepSize = 0.0f;
   m_numRDFbins = 0;
+  m_rdfComparedBins = 0;
+  m_rdfCellDims[0] = m_rdfCellDims[1] = m_rdfCellDims[2] = 1;
+  m_rdfCellSize[0] = m_rdfCellSize[1] = m_rdfCellSize[2] = 0.0f;
 
   setupFilterParameters();
 }
@@ -678,8 +681,8 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   if (getCancel() == true) { return; }
 
   //This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  std::vector<size_t> availablePoints;
+  std::vector<size_t> availablePointsInv;
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* exclusionZones = exclusionZonesPtr->getPointer(0);
@@ -801,6 +804,8 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   }
 
   // determine initial set of available points
+  availablePoints.assign(m_TotalPoints, 0);
+  availablePointsInv.assign(m_TotalPoints, 0);
   availablePointsCount = 0;
   for (int64_t i = 0; i < m_TotalPoints; i++)
   {
@@ -1010,6 +1015,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   if (m_MatchRDF == true)
   {
     // calculate the initial current RDF - this will change as we move particles around
+    initialize_rdfCellList(numfeatures);
     for (size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
     {
       m_oldRDFerror = check_RDFerror(int32_t(i), -1000, false);
@@ -1133,6 +1139,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
         m_currentRDFerror = check_RDFerror(-1000, randomfeature, true);
         update_exclusionZones(-1000, randomfeature, exclusionZonesPtr);
         move_precipitate(randomfeature, xc, yc, zc);
+        update_rdfCellList(randomfeature);
         m_currentRDFerror = check_RDFerror(randomfeature, -1000, true);
         update_exclusionZones(randomfeature, -1000, exclusionZonesPtr);
         if(m_currentRDFerror >= m_oldRDFerror)
@@ -1146,6 +1153,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
           m_currentRDFerror = check_RDFerror(-1000, randomfeature, true);
           update_exclusionZones(-1000, randomfeature, exclusionZonesPtr);
           move_precipitate(randomfeature, oldxc, oldyc, oldzc);
+          update_rdfCellList(randomfeature);
           m_currentRDFerror = check_RDFerror(randomfeature, -1000, true);
           update_exclusionZones(randomfeature, -1000, exclusionZonesPtr);
           m_oldRDFerror = m_currentRDFerror;
@@ -1484,7 +1492,7 @@ bool InsertPrecipitatePhases::check_for_overlap(size_t gNum, Int32ArrayType::Poi
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void InsertPrecipitatePhases::update_availablepoints(std::vector<size_t>& availablePoints, std::vector<size_t>& availablePointsInv)
 {
   size_t removeSize = pointsToRemove.size();
   size_t addSize = pointsToAdd.size();
@@ -1501,9 +1509,7 @@ void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& a
   {
     featureOwnersIdx = pointsToRemove[i];
     key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
     val = availablePointsInv[availablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
     if (key < availablePointsCount - 1)
     {
       availablePointsInv[key] = val;
@@ -1515,6 +1521,95 @@ void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& a
   pointsToAdd.clear();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::initialize_rdfCellList(size_t numFeatures)
+{
+  // Only the bins both distributions have are compared, so a pair of precipitates further apart than the
+  // last compared bin does not change the RDF error and never needs to be visited
+  m_rdfComparedBins = std::min(m_rdfTargetDist.size(), m_rdfCurrentDist.size());
+  float cutoff = m_rdfMin + m_StepSize * static_cast<float>(m_rdfComparedBins);
+
+  // The cells are at least as wide as the cutoff, so all the pairs that matter lie in adjacent cells. The
+  // grid is coarsened if needed to keep the number of cells in proportion to the number of precipitates
+  float size[3] = { m_SizeX, m_SizeY, m_SizeZ };
+  size_t maxCells = 8 * numFeatures + 64;
+  for (int32_t k = 0; k < 3; k++)
+  {
+    m_rdfCellDims[k] = 1;
+    if (cutoff > 0.0f && cutoff < size[k])
+    {
+      m_rdfCellDims[k] = static_cast<int64_t>(size[k] / cutoff);
+    }
+  }
+  while (static_cast<size_t>(m_rdfCellDims[0] * m_rdfCellDims[1] * m_rdfCellDims[2]) > maxCells)
+  {
+    int32_t largest = 0;
+    if (m_rdfCellDims[1] > m_rdfCellDims[largest]) { largest = 1; }
+    if (m_rdfCellDims[2] > m_rdfCellDims[largest]) { largest = 2; }
+    m_rdfCellDims[largest] = (m_rdfCellDims[largest] + 1) / 2;
+  }
+  for (int32_t k = 0; k < 3; k++)
+  {
+    m_rdfCellSize[k] = size[k] / static_cast<float>(m_rdfCellDims[k]);
+  }
+
+  m_rdfCellFeatures.clear();
+  m_rdfCellFeatures.resize(static_cast<size_t>(m_rdfCellDims[0] * m_rdfCellDims[1] * m_rdfCellDims[2]));
+  m_rdfFeatureCell.assign(numFeatures, 0);
+  m_rdfFeatureSlot.assign(numFeatures, 0);
+  for (size_t i = size_t(m_FirstPrecipitateFeature); i < numFeatures; i++)
+  {
+    size_t cell = find_rdfCell(static_cast<int32_t>(i));
+    m_rdfFeatureCell[i] = cell;
+    m_rdfFeatureSlot[i] = m_rdfCellFeatures[cell].size();
+    m_rdfCellFeatures[cell].push_back(static_cast<int32_t>(i));
+  }
+
+  // Normalize the current RDF by the random RDF; from here on only the bins that change are renormalized
+  m_rdfCurrentDistNorm.resize(m_rdfCurrentDist.size());
+  for (size_t i = 0; i < m_rdfComparedBins; i++)
+  {
+    m_rdfCurrentDistNorm[i] = m_rdfCurrentDist[i] / m_rdfRandom[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::update_rdfCellList(int32_t gnum)
+{
+  size_t oldCell = m_rdfFeatureCell[gnum];
+  size_t newCell = find_rdfCell(gnum);
+  if (newCell == oldCell) { return; }
+
+  std::vector<int32_t>& oldFeatures = m_rdfCellFeatures[oldCell];
+  int32_t last = oldFeatures.back();
+  oldFeatures[m_rdfFeatureSlot[gnum]] = last;
+  m_rdfFeatureSlot[last] = m_rdfFeatureSlot[gnum];
+  oldFeatures.pop_back();
+
+  m_rdfFeatureCell[gnum] = newCell;
+  m_rdfFeatureSlot[gnum] = m_rdfCellFeatures[newCell].size();
+  m_rdfCellFeatures[newCell].push_back(gnum);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t InsertPrecipitatePhases::find_rdfCell(int32_t gnum)
+{
+  int64_t cell[3] = { 0, 0, 0 };
+  for (int32_t k = 0; k < 3; k++)
+  {
+    cell[k] = static_cast<int64_t>(m_Centroids[3 * gnum + k] / m_rdfCellSize[k]);
+    if (cell[k] < 0) { cell[k] = 0; }
+    if (cell[k] >= m_rdfCellDims[k]) { cell[k] = m_rdfCellDims[k] - 1; }
+  }
+  return static_cast<size_t>((cell[2] * m_rdfCellDims[1] + cell[1]) * m_rdfCellDims[0] + cell[0]);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1524,50 +1619,61 @@ void InsertPrecipitatePhases::determine_currentRDF(int32_t gnum, int32_t add, bo
   float xn = 0.0f, yn = 0.0f, zn = 0.0f;
   float r = 0.0f;
 
-  size_t iter = 0;
-  int32_t numPPTfeatures = 1;
   int32_t rdfBin = 0;
+  size_t bin = 0;
 
   int32_t phase = m_FeaturePhases[gnum];
-  while (phase != precipitatephases[iter]) { iter++; }
 
   x = m_Centroids[3 * gnum];
   y = m_Centroids[3 * gnum + 1];
   z = m_Centroids[3 * gnum + 2];
-  size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  for (size_t n = size_t(m_FirstPrecipitateFeature); n < numFeatures; n++)
+  size_t cell = m_rdfFeatureCell[gnum];
+  int64_t cellX = static_cast<int64_t>(cell % m_rdfCellDims[0]);
+  int64_t cellY = static_cast<int64_t>((cell / m_rdfCellDims[0]) % m_rdfCellDims[1]);
+  int64_t cellZ = static_cast<int64_t>(cell / (m_rdfCellDims[0] * m_rdfCellDims[1]));
+
+  for (int64_t zc = cellZ - 1; zc <= cellZ + 1; zc++)
   {
-    if (m_FeaturePhases[n] == phase && n != gnum)
+    if (zc < 0 || zc >= m_rdfCellDims[2]) { continue; }
+    for (int64_t yc = cellY - 1; yc <= cellY + 1; yc++)
     {
-      xn = m_Centroids[3 * n];
-      yn = m_Centroids[3 * n + 1];
-      zn = m_Centroids[3 * n + 2];
-      r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+      if (yc < 0 || yc >= m_rdfCellDims[1]) { continue; }
+      for (int64_t xc = cellX - 1; xc <= cellX + 1; xc++)
+      {
+        if (xc < 0 || xc >= m_rdfCellDims[0]) { continue; }
+        const std::vector<int32_t>& cellFeatures = m_rdfCellFeatures[(zc * m_rdfCellDims[1] + yc) * m_rdfCellDims[0] + xc];
+        for (size_t c = 0; c < cellFeatures.size(); c++)
+        {
+          int32_t n = cellFeatures[c];
+          if (m_FeaturePhases[n] == phase && n != gnum)
+          {
+            xn = m_Centroids[3 * n];
+            yn = m_Centroids[3 * n + 1];
+            zn = m_Centroids[3 * n + 2];
+            r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
 
-      rdfBin = (r - m_rdfMin) / m_StepSize;
+            rdfBin = (r - m_rdfMin) / m_StepSize;
 
-      if (r < m_rdfMin)
-      { rdfBin = -1;}
-      //if (r < 6.0)
-      //{
-      //  int stop = 0;
-      //}
-      //if (rdfBin >= m_numRDFbins) {rdfBin = m_numRDFbins;}
-      if (double_count == true)
-      {
-        m_rdfCurrentDist[rdfBin + 1] += 2 * add;
-      }
-      else if (double_count == false)
-      {
-        m_rdfCurrentDist[rdfBin + 1] += add;
-      }
+            if (r < m_rdfMin)
+            { rdfBin = -1;}
 
-      numPPTfeatures += 1;
+            bin = static_cast<size_t>(rdfBin + 1);
+            if (bin >= m_rdfComparedBins) { continue; }
+            if (double_count == true)
+            {
+              m_rdfCurrentDist[bin] += 2 * add;
+            }
+            else if (double_count == false)
+            {
+              m_rdfCurrentDist[bin] += add;
+            }
+            m_rdfCurrentDistNorm[bin] = m_rdfCurrentDist[bin] / m_rdfRandom[bin];
+          }
+        }
+      }
     }
   }
-
-  m_rdfCurrentDistNorm = normalizeRDF(m_rdfCurrentDist, m_numRDFbins, m_StepSize, m_rdfMin, numPPTfeatures);
 }
 
 // -----------------------------------------------------------------------------
@@ -1617,41 +1723,6 @@ void InsertPrecipitatePhases::determine_randomRDF(size_t gnum, int32_t add, bool
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-std::vector<float> InsertPrecipitatePhases::normalizeRDF(std::vector<float> rdf, int32_t num_bins, float m_StepSize, float rdfmin, int32_t numPPTfeatures)
-{
-  //  //Normalizing the RDF by number density of particles (4/3*pi*(r2^3-r1^3)*numPPTfeatures/volume)
-  //  float normfactor;
-  //  float r1;
-  //  float r2;
-  //  float oneovervolume = 1.0f/volume;
-  //  float finiteAdjFactor = .5;
-
-  //  r1 = 0*finiteAdjFactor;
-  //  r2 = rdfmin*finiteAdjFactor;
-  //  normfactor = 4.0f/3.0f*SIMPLib::Constants::k_Pi*((r2*r2*r2) - (r1*r1*r1))*numPPTfeatures*oneovervolume;
-  //  rdf[0] = rdf[0];
-
-  //  for (size_t i = 1; i < num_bins+2; i++)
-  //  {
-  //    r1 = (rdfmin + (i-1)*m_StepSize);
-  //    r2 = (r1 + m_StepSize);
-  //    r1 = r1*finiteAdjFactor;
-  //    r2 = r2*finiteAdjFactor;
-  //    normfactor = 4.0f/3.0f*SIMPLib::Constants::k_Pi*((r2*r2*r2) - (r1*r1*r1))*numPPTfeatures*oneovervolume;
-  //    rdf[i] = rdf[i]/normfactor;
-  //  }
-
-  for (size_t i = 0; i < rdf.size(); i++)
-  {
-    rdf[i] = rdf[i] / m_rdfRandom[i];
-  }
-
-  return rdf;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1684,18 +1755,12 @@ float InsertPrecipitatePhases::check_RDFerror(int32_t gadd, int32_t gremove, boo
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1, std::vector<float> array2, float& bhattdist)
+void InsertPrecipitatePhases::compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& bhattdist)
 {
   bhattdist = 0;
   float sum_array1 = 0.0f;
   float sum_array2 = 0.0f;
 
-  //  for (std::vector<float>::iterator j=array1.begin(); j!=array1.end(); j++)
-  //  {sum_array1 += *j;}
-
-  //  for (std::vector<float>::iterator j=array2.begin(); j!=array2.end(); j++)
-  //  {sum_array2 += *j;}
-
   size_t array1Size = array1.size();
   for (size_t i = 0; i < array1Size; i++)
   {
@@ -1705,9 +1770,7 @@ void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1,
 
   for (size_t i = 0; i < array1Size; i++)
   {
-    array1[i] = array1[i] / sum_array1;
-    array2[i] = array2[i] / sum_array2;
-    bhattdist = bhattdist + sqrtf((array1[i] * array2[i]));
+    bhattdist = bhattdist + sqrtf(((array1[i] / sum_array1) * (array2[i] / sum_array2)));
   }
 }
 
@@ -293,11 +293,31 @@ class InsertPrecipitatePhases : public AbstractFilter
     bool check_for_overlap(size_t gNum, Int32ArrayType::Pointer exlusionZonesPtr);
 
     /**
-     * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-     * @param availablePoints Map between precipitate owners and number of available points
-     * @param availablePointsInv Inverse associations for the availablePoints map
+     * @brief update_availablepoints Updates the arrays used to associate packing points with an "available" state
+     * @param availablePoints Position of each packing point in the list of available points
+     * @param availablePointsInv List of available points (the inverse of availablePoints)
      */
-    void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+    void update_availablepoints(std::vector<size_t>& availablePoints, std::vector<size_t>& availablePointsInv);
+
+    /**
+     * @brief initialize_rdfCellList Bins the precipitate centroids on a grid of cells at least as wide as the
+     * largest distance that lands in a compared RDF bin and normalizes the current RDF
+     * @param numFeatures Number of Features
+     */
+    void initialize_rdfCellList(size_t numFeatures);
+
+    /**
+     * @brief update_rdfCellList Moves a precipitate to the cell of its current centroid
+     * @param featureNum Index for the precipitate that moved
+     */
+    void update_rdfCellList(int32_t featureNum);
+
+    /**
+     * @brief find_rdfCell Returns the cell of the RDF cell list holding the centroid of a precipitate
+     * @param featureNum Index for the precipitate
+     * @return Cell index
+     */
+    size_t find_rdfCell(int32_t featureNum);
 
     /**
      * @brief determine_currentRDF Determines the radial distribution function about a given precipitate
@@ -316,18 +336,6 @@ class InsertPrecipitatePhases : public AbstractFilter
      */
     void determine_randomRDF(size_t gnum, int32_t add, bool double_count, int32_t largeNumber);
 
-    /**
-     * @brief normalizeRDF Normalizes a radial distribution function
-     * @param rdf RDF to normalize
-     * @param num_bins Number of bins in the discretized RDF
-     * @param stepsize Bin sted size for discretized RDF
-     * @param rdfmin Minimum value for RDF
-     * @param numPPTfeatures Number of precipiate Features
-     * @param volume Volume for a given precipitate
-     * @return Normalized RDF
-     */
-    std::vector<float> normalizeRDF(std::vector<float> rdf, int num_bins, float stepsize, float rdfmin, int32_t numPPTfeatures);
-
     /**
      * @brief check_RDFerror Computes the error between the current radial distribution function
      * and the goal radial distribution function
@@ -375,10 +383,10 @@ class InsertPrecipitatePhases : public AbstractFilter
     float find_zcoord(int64_t index);
 
     /**
-     * @brief compare_1Ddistributions Computes the 1D Bhattacharyya distance
+     * @brief compare_1Ddistributions Computes the 1D Bhattacharyya distance over the bins of array1
      * @param sqrerror Float 1D Bhattacharyya distance
      */
-    void compare_1Ddistributions(std::vector<float>, std::vector<float>, float& sqrerror);
+    void compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& sqrerror);
 
     /**
      * @brief compare_2Ddistributions Computes the 2D Bhattacharyya distance
@@ -458,6 +466,13 @@ class InsertPrecipitatePhases : public AbstractFilter
     std::vector<float> m_rdfTargetDist;
     std::vector<float> m_rdfCurrentDist;
     std::vector<float> m_rdfCurrentDistNorm;
+    size_t m_rdfComparedBins;
+
+    std::vector<std::vector<int32_t> > m_rdfCellFeatures;
+    std::vector<size_t> m_rdfFeatureCell;
+    std::vector<size_t> m_rdfFeatureSlot;
+    int64_t m_rdfCellDims[3];
+    float m_rdfCellSize[3];
 
     std::vector<float> m_RandomCentroids;
     std::vector<float> m_rdfRandom;
@@ -283,15 +283,44 @@ void FilterPipeline::disconnectFilterNotifications(QObject* filter)
 //
 // -----------------------------------------------------------------------------
 int FilterPipeline::preflightPipeline()
+{
+  return preflightPipeline(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FilterPipeline::preflightPipeline(int startIndex)
 {
   // Create the DataContainer object
   DataContainerArray::Pointer dca = DataContainerArray::New();
 
+  if (startIndex < 0 || startIndex > m_Pipeline.size()) { startIndex = 0; }
+  if (startIndex > 0)
+  {
+    // Resume from the structure the previous filter ended its last preflight with. That filter keeps a copy of its
+    // own, so copy it again so the filters preflighted below can not modify it.
+    DataContainerArray::Pointer cached = m_Pipeline.at(startIndex - 1)->getDataContainerArray();
+    if (NULL == cached.get())
+    {
+      startIndex = 0;
+    }
+    else
+    {
+      dca = DeepCopyDataContainerArray(cached);
+    }
+  }
+
   setErrorCondition(0);
   int preflightError = 0;
 
+  for (int i = 0; i < startIndex; i++)
+  {
+    preflightError |= m_Pipeline.at(i)->getErrorCondition();
+  }
+
   // Start looping through each filter in the Pipeline and preflight everything
-  for (FilterContainerType::iterator filter = m_Pipeline.begin(); filter != m_Pipeline.end(); ++filter)
+  for (FilterContainerType::iterator filter = m_Pipeline.begin() + startIndex; filter != m_Pipeline.end(); ++filter)
   {
     (*filter)->setDataContainerArray(dca);
     setCurrentFilter(*filter);
@@ -300,20 +329,28 @@ int FilterPipeline::preflightPipeline()
     disconnectFilterNotifications( (*filter).get() );
 
 //    (*filter)->setDataContainerArray(DataContainerArray::NullPointer());
-    DataContainerArray::Pointer dcaCopy = DataContainerArray::New();
-    QList<DataContainer::Pointer> dcs = dca->getDataContainers();
-    for (int i=0; i<dcs.size(); i++)
-    {
-      DataContainer::Pointer dcCopy = dcs[i]->deepCopy();
-      dcaCopy->addDataContainer(dcCopy);
-    }
-    (*filter)->setDataContainerArray(dcaCopy);
+    (*filter)->setDataContainerArray(DeepCopyDataContainerArray(dca));
     preflightError |= (*filter)->getErrorCondition();
   }
   setCurrentFilter(AbstractFilter::NullPointer());
   return preflightError;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer FilterPipeline::DeepCopyDataContainerArray(DataContainerArray::Pointer dca)
+{
+  DataContainerArray::Pointer dcaCopy = DataContainerArray::New();
+  QList<DataContainer::Pointer> dcs = dca->getDataContainers();
+  for (int i=0; i<dcs.size(); i++)
+  {
+    DataContainer::Pointer dcCopy = dcs[i]->deepCopy();
+    dcaCopy->addDataContainer(dcCopy);
+  }
+  return dcaCopy;
+}
+
 
 // -----------------------------------------------------------------------------
 //
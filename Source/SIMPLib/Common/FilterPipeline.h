@@ -92,6 +92,16 @@ class SIMPLib_EXPORT FilterPipeline : public QObject
      */
     virtual int preflightPipeline();
 
+    /**
+     * @brief This will preflight the pipeline starting at the filter at index startIndex. The filters before
+     * startIndex are not preflighted again; instead the DataContainerArray that the filter at startIndex - 1
+     * kept from its last preflight is copied and used as the starting point. If that filter has never been
+     * preflighted the whole pipeline is preflighted.
+     * @param startIndex Index of the first filter to preflight
+     * @return The combined error condition of all the filters in the pipeline
+     */
+    virtual int preflightPipeline(int startIndex);
+
 
     /**
      * @brief
@@ -145,6 +155,11 @@ class SIMPLib_EXPORT FilterPipeline : public QObject
 
     void updatePrevNextFilters();
 
+    /**
+     * @brief Creates a new DataContainerArray holding deep copies of all the DataContainers in dca
+     */
+    static DataContainerArray::Pointer DeepCopyDataContainerArray(DataContainerArray::Pointer dca);
+
   signals:
     void pipelineGeneratedMessage(const PipelineMessage& message);
 
@@ -0,0 +1,312 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "ThresholdEvaluator.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace Detail
+{
+  // Number of tuples evaluated at once. The per chunk masks live on the stack and stay in cache.
+  static const size_t k_ThresholdChunkSize = 8192;
+
+  template<typename T>
+  void CompareLessThan(const void* data, double value, uint8_t* mask, size_t start, size_t end)
+  {
+    const T* values = reinterpret_cast<const T*>(data) + start;
+    T v = static_cast<T>(value);
+    size_t count = end - start;
+    for (size_t i = 0; i < count; i++)
+    {
+      mask[i] &= static_cast<uint8_t>(values[i] < v);
+    }
+  }
+
+  template<typename T>
+  void CompareGreaterThan(const void* data, double value, uint8_t* mask, size_t start, size_t end)
+  {
+    const T* values = reinterpret_cast<const T*>(data) + start;
+    T v = static_cast<T>(value);
+    size_t count = end - start;
+    for (size_t i = 0; i < count; i++)
+    {
+      mask[i] &= static_cast<uint8_t>(values[i] > v);
+    }
+  }
+
+  template<typename T>
+  void CompareEqualTo(const void* data, double value, uint8_t* mask, size_t start, size_t end)
+  {
+    const T* values = reinterpret_cast<const T*>(data) + start;
+    T v = static_cast<T>(value);
+    size_t count = end - start;
+    for (size_t i = 0; i < count; i++)
+    {
+      mask[i] &= static_cast<uint8_t>(values[i] == v);
+    }
+  }
+
+  /**
+   * @brief SelectComparison Returns the comparison function for the array type T and the operator
+   */
+  template<typename T>
+  ThresholdEvaluator::ComparisonFunction SelectComparison(DREAM3D::Comparison::Enumeration compOperator)
+  {
+    switch(compOperator)
+    {
+      case DREAM3D::Comparison::Operator_LessThan:
+        return CompareLessThan<T>;
+      case DREAM3D::Comparison::Operator_GreaterThan:
+        return CompareGreaterThan<T>;
+      case DREAM3D::Comparison::Operator_Equal:
+        return CompareEqualTo<T>;
+      default:
+        break;
+    }
+    return NULL;
+  }
+
+  /**
+   * @brief The EvaluateChunksImpl class evaluates all of the comparison groups for a range of chunks
+   */
+  class EvaluateChunksImpl
+  {
+    public:
+      EvaluateChunksImpl(const std::vector<std::vector<ThresholdEvaluator::Comparison> >& groups, bool* output, size_t numTuples) :
+        m_Groups(groups),
+        m_Output(output),
+        m_NumTuples(numTuples)
+      {}
+      virtual ~EvaluateChunksImpl() {}
+
+      void evaluate(size_t start, size_t end) const
+      {
+        uint8_t groupMask[k_ThresholdChunkSize];
+        uint8_t result[k_ThresholdChunkSize];
+        for (size_t c = start; c < end; c++)
+        {
+          size_t first = c * k_ThresholdChunkSize;
+          size_t last = std::min(first + k_ThresholdChunkSize, m_NumTuples);
+          size_t count = last - first;
+          ::memset(result, 0, count);
+          for (size_t g = 0; g < m_Groups.size(); g++)
+          {
+            const std::vector<ThresholdEvaluator::Comparison>& group = m_Groups[g];
+            ::memset(groupMask, 1, count);
+            for (size_t i = 0; i < group.size(); i++)
+            {
+              group[i].function(group[i].data, group[i].value, groupMask, first, last);
+            }
+            for (size_t i = 0; i < count; i++)
+            {
+              result[i] |= groupMask[i];
+            }
+          }
+          bool* output = m_Output + first;
+          for (size_t i = 0; i < count; i++)
+          {
+            output[i] = (result[i] != 0);
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        evaluate(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      const std::vector<std::vector<ThresholdEvaluator::Comparison> >& m_Groups;
+      bool* m_Output;
+      size_t m_NumTuples;
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThresholdEvaluator::ThresholdEvaluator()
+{
+  m_Groups.resize(1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThresholdEvaluator::~ThresholdEvaluator()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ThresholdEvaluator::addComparison(IDataArray* input, DREAM3D::Comparison::Enumeration compOperator, double value)
+{
+  if (NULL == input || input->getNumberOfComponents() != 1)
+  {
+    return false;
+  }
+
+  ComparisonFunction function = NULL;
+  if (NULL != dynamic_cast<FloatArrayType*>(input)) { function = Detail::SelectComparison<float>(compOperator); }
+  else if (NULL != dynamic_cast<DoubleArrayType*>(input)) { function = Detail::SelectComparison<double>(compOperator); }
+  else if (NULL != dynamic_cast<Int8ArrayType*>(input)) { function = Detail::SelectComparison<int8_t>(compOperator); }
+  else if (NULL != dynamic_cast<UInt8ArrayType*>(input)) { function = Detail::SelectComparison<uint8_t>(compOperator); }
+  else if (NULL != dynamic_cast<Int16ArrayType*>(input)) { function = Detail::SelectComparison<int16_t>(compOperator); }
+  else if (NULL != dynamic_cast<UInt16ArrayType*>(input)) { function = Detail::SelectComparison<uint16_t>(compOperator); }
+  else if (NULL != dynamic_cast<Int32ArrayType*>(input)) { function = Detail::SelectComparison<int32_t>(compOperator); }
+  else if (NULL != dynamic_cast<UInt32ArrayType*>(input)) { function = Detail::SelectComparison<uint32_t>(compOperator); }
+  else if (NULL != dynamic_cast<Int64ArrayType*>(input)) { function = Detail::SelectComparison<int64_t>(compOperator); }
+  else if (NULL != dynamic_cast<UInt64ArrayType*>(input)) { function = Detail::SelectComparison<uint64_t>(compOperator); }
+  else if (NULL != dynamic_cast<BoolArrayType*>(input)) { function = Detail::SelectComparison<bool>(compOperator); }
+
+  if (NULL == function)
+  {
+    return false;
+  }
+
+  Comparison comparison;
+  comparison.input = input;
+  comparison.data = input->getVoidPointer(0);
+  comparison.value = value;
+  comparison.function = function;
+  m_Groups.back().push_back(comparison);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThresholdEvaluator::addGroup()
+{
+  if (m_Groups.back().empty() == false)
+  {
+    m_Groups.push_back(std::vector<Comparison>());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ThresholdEvaluator::getNumberOfComparisons() const
+{
+  size_t count = 0;
+  for (size_t g = 0; g < m_Groups.size(); g++)
+  {
+    count += m_Groups[g].size();
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThresholdEvaluator::clear()
+{
+  m_Groups.clear();
+  m_Groups.resize(1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ThresholdEvaluator::evaluate(BoolArrayType* output)
+{
+  if (NULL == output || getNumberOfComparisons() == 0)
+  {
+    return -1;
+  }
+
+  // Drop a trailing empty group so it does not turn every tuple on
+  std::vector<std::vector<Comparison> > groups;
+  for (size_t g = 0; g < m_Groups.size(); g++)
+  {
+    if (m_Groups[g].empty() == false) { groups.push_back(m_Groups[g]); }
+  }
+
+  size_t numTuples = groups[0][0].input->getNumberOfTuples();
+  for (size_t g = 0; g < groups.size(); g++)
+  {
+    for (size_t i = 0; i < groups[g].size(); i++)
+    {
+      if (groups[g][i].input->getNumberOfTuples() != numTuples)
+      {
+        return -1;
+      }
+    }
+  }
+  if (output->getNumberOfTuples() < numTuples)
+  {
+    return -1;
+  }
+  if (numTuples == 0)
+  {
+    return 0;
+  }
+
+  size_t numChunks = (numTuples + Detail::k_ThresholdChunkSize - 1) / Detail::k_ThresholdChunkSize;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks),
+                      Detail::EvaluateChunksImpl(groups, output->getPointer(0), numTuples), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    Detail::EvaluateChunksImpl serial(groups, output->getPointer(0), numTuples);
+    serial.evaluate(0, numChunks);
+  }
+
+  return 0;
+}
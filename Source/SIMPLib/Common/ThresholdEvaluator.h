@@ -0,0 +1,141 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _ThresholdEvaluator_H_
+#define _ThresholdEvaluator_H_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+/**
+ * @brief The ThresholdEvaluator class evaluates a set of scalar comparisons of the form
+ * "array op value" into a boolean mask in a single pass over the arrays. The comparisons are
+ * organized in groups: the comparisons inside a group are ANDed together and the groups are
+ * ORed together, which is enough to express any mix of AND and OR.
+ *
+ * The tuples are split into chunks that are evaluated in parallel. Each chunk is evaluated
+ * into a small buffer that stays in cache, one comparison at a time, with loops that have no
+ * branches so the compiler can vectorize them. Only the final mask is written to memory, so no
+ * temporary array the size of the input is ever allocated.
+ *
+ * Typical usage is:
+ * @code
+ * ThresholdEvaluator::Pointer evaluator = ThresholdEvaluator::New();
+ * evaluator->addComparison(phases.get(), DREAM3D::Comparison::Operator_Equal, 1.0);
+ * evaluator->addComparison(confidence.get(), DREAM3D::Comparison::Operator_GreaterThan, 0.1);
+ * evaluator->addGroup();
+ * evaluator->addComparison(imageQuality.get(), DREAM3D::Comparison::Operator_GreaterThan, 120.0);
+ * evaluator->evaluate(mask.get()); // (phase == 1 AND ci > 0.1) OR iq > 120
+ * @endcode
+ */
+class SIMPLib_EXPORT ThresholdEvaluator
+{
+  public:
+    SIMPL_SHARED_POINTERS(ThresholdEvaluator)
+    SIMPL_STATIC_NEW_MACRO(ThresholdEvaluator)
+    SIMPL_TYPE_MACRO(ThresholdEvaluator)
+
+    virtual ~ThresholdEvaluator();
+
+    /**
+     * @brief The signature of the function that evaluates one comparison over a range of tuples
+     * and ANDs the result into a mask
+     */
+    typedef void (*ComparisonFunction)(const void* data, double value, uint8_t* mask, size_t start, size_t end);
+
+    /**
+     * @brief addComparison Adds a comparison to the current group. The comparison value is cast to the
+     * type of the array before comparing, like ThresholdFilterHelper does.
+     * @param input The scalar array to compare. Must stay alive until evaluate() returns
+     * @param compOperator The comparison operator
+     * @param value The value to compare against
+     * @return false if the array is not a scalar array of a supported type or the operator is unknown
+     */
+    bool addComparison(IDataArray* input, DREAM3D::Comparison::Enumeration compOperator, double value);
+
+    /**
+     * @brief addGroup Starts a new group that is ORed with the previous groups. Does nothing if
+     * the current group is still empty.
+     */
+    void addGroup();
+
+    /**
+     * @brief getNumberOfComparisons Returns the total number of comparisons in all of the groups
+     * @return
+     */
+    size_t getNumberOfComparisons() const;
+
+    /**
+     * @brief clear Removes all of the comparisons and groups
+     */
+    void clear();
+
+    /**
+     * @brief evaluate Evaluates the comparisons and writes the result into output, which must have
+     * at least as many tuples as the compared arrays.
+     * @param output The mask to write. Tuples are true when any of the groups is true
+     * @return -1 if there are no comparisons or the arrays do not have the same number of tuples, 0 otherwise
+     */
+    int evaluate(BoolArrayType* output);
+
+    /**
+     * @brief The Comparison class holds one compiled comparison
+     */
+    class Comparison
+    {
+      public:
+        IDataArray* input;
+        const void* data;
+        double value;
+        ComparisonFunction function;
+    };
+
+  protected:
+    ThresholdEvaluator();
+
+  private:
+    std::vector<std::vector<Comparison> > m_Groups;
+
+    ThresholdEvaluator(const ThresholdEvaluator&); // Copy Constructor Not Implemented
+    void operator=(const ThresholdEvaluator&); // Operator '=' Not Implemented
+};
+
+#endif /* _ThresholdEvaluator_H_ */
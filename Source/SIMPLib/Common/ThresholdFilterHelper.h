@@ -56,55 +56,6 @@ class SIMPLib_EXPORT ThresholdFilterHelper : public IDataArrayFilter
 
     virtual ~ThresholdFilterHelper();
 
-    /**
-     *
-     */
-    template<typename T>
-    void filterDataLessThan(IDataArray* m_Input)
-    {
-      size_t m_NumValues = m_Input->getNumberOfTuples();
-      T v = static_cast<T>(comparisonValue);
-      T* data = IDataArray::SafeReinterpretCast<IDataArray*, DataArray<T>*, T*>(m_Input);
-      for (size_t i = 0; i < m_NumValues; ++i)
-      {
-        bool b = (data[i] < v);
-        m_Output->setValue(i, b);
-      }
-    }
-
-    /**
-     *
-     */
-    template<typename T>
-    void filterDataGreaterThan(IDataArray* m_Input)
-    {
-      size_t m_NumValues = m_Input->getNumberOfTuples();
-      T v = static_cast<T>(comparisonValue);
-      T* data = IDataArray::SafeReinterpretCast<IDataArray*, DataArray<T>*, T*>(m_Input);
-      for (size_t i = 0; i < m_NumValues; ++i)
-      {
-        bool b = (data[i] > v);
-        m_Output->setValue(i, b);
-      }
-    }
-
-    /**
-     *
-     */
-    template<typename T>
-    void filterDataEqualTo(IDataArray* m_Input)
-    {
-      size_t m_NumValues = m_Input->getNumberOfTuples();
-      T v = static_cast<T>(comparisonValue);
-      T* data = IDataArray::SafeReinterpretCast<IDataArray*, DataArray<T>*, T*>(m_Input);
-      for (size_t i = 0; i < m_NumValues; ++i)
-      {
-        bool b = (data[i] == v);
-        m_Output->setValue(i, b);
-      }
-    }
-
-
     /**
     * @brief execute
     * @param input
@@ -45,6 +45,7 @@
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerReaderFilterParameter.h"
 #include "SIMPLib/FilterParameters/H5FilterParametersReader.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 
 
 // Include the MOC generated file for this class
@@ -61,8 +62,16 @@ DataContainerReader::DataContainerReader() :
   m_OverwriteExistingDataContainers(false),
   m_LastFileRead(""),
   m_LastRead(QDateTime::currentDateTime()),
-  m_InputFileDataContainerArrayProxy()
+  m_InputFileDataContainerArrayProxy(),
+  m_ReadSubVolume(false)
 {
+  m_SubVolumeMin.x = 0;
+  m_SubVolumeMin.y = 0;
+  m_SubVolumeMin.z = 0;
+  m_SubVolumeMax.x = 0;
+  m_SubVolumeMax.y = 0;
+  m_SubVolumeMax.z = 0;
+
   m_PipelineFromFile = FilterPipeline::New();
 
   setupFilterParameters();
@@ -92,6 +101,11 @@ void DataContainerReader::setupFilterParameters()
     parameter->setCategory(FilterParameter::Parameter);
     parameters.push_back(parameter);
   }
+  QStringList linkedProps;
+  linkedProps << "SubVolumeMin" << "SubVolumeMax";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Read Sub Volume", "ReadSubVolume", getReadSubVolume(), linkedProps, FilterParameter::Parameter));
+  parameters.push_back(IntVec3FilterParameter::New("Sub Volume Min (Column, Row, Plane)", "SubVolumeMin", getSubVolumeMin(), FilterParameter::Parameter));
+  parameters.push_back(IntVec3FilterParameter::New("Sub Volume Max (Column, Row, Plane) [Inclusive]", "SubVolumeMax", getSubVolumeMax(), FilterParameter::Parameter));
 
   setFilterParameters(parameters);
 }
@@ -106,6 +120,9 @@ void DataContainerReader::readFilterParameters(AbstractFilterParametersReader* r
   setInputFileDataContainerArrayProxy(reader->readDataContainerArrayProxy("InputFileDataContainerArrayProxy", getInputFileDataContainerArrayProxy() ) );
   syncProxies();  // Sync the file proxy and currently cached proxy together into one proxy
   setOverwriteExistingDataContainers(reader->readValue("OverwriteExistingDataContainers", getOverwriteExistingDataContainers() ) );
+  setReadSubVolume(reader->readValue("ReadSubVolume", getReadSubVolume() ) );
+  setSubVolumeMin(reader->readIntVec3("SubVolumeMin", getSubVolumeMin() ) );
+  setSubVolumeMax(reader->readIntVec3("SubVolumeMax", getSubVolumeMax() ) );
   reader->closeFilterGroup();
 }
 
@@ -118,6 +135,9 @@ int DataContainerReader::writeFilterParameters(AbstractFilterParametersWriter* w
   writer->openFilterGroup(this, index);
   SIMPL_FILTER_WRITE_PARAMETER(InputFile)
   SIMPL_FILTER_WRITE_PARAMETER(OverwriteExistingDataContainers)
+  SIMPL_FILTER_WRITE_PARAMETER(ReadSubVolume)
+  SIMPL_FILTER_WRITE_PARAMETER(SubVolumeMin)
+  SIMPL_FILTER_WRITE_PARAMETER(SubVolumeMax)
   DataContainerArrayProxy dcaProxy = getInputFileDataContainerArrayProxy(); // This line makes a COPY of the DataContainerArrayProxy that is stored in the current instance
   writer->writeValue("InputFileDataContainerArrayProxy", dcaProxy );
   writer->closeFilterGroup();
@@ -150,6 +170,24 @@ void DataContainerReader::dataCheck()
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
   }
 
+  if (getReadSubVolume() == true)
+  {
+    if (getSubVolumeMin().x < 0 || getSubVolumeMin().y < 0 || getSubVolumeMin().z < 0)
+    {
+      ss = QObject::tr("The sub volume minimum (%1, %2, %3) must not be negative").arg(getSubVolumeMin().x).arg(getSubVolumeMin().y).arg(getSubVolumeMin().z);
+      setErrorCondition(-391);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+    if (getSubVolumeMax().x < getSubVolumeMin().x || getSubVolumeMax().y < getSubVolumeMin().y || getSubVolumeMax().z < getSubVolumeMin().z)
+    {
+      ss = QObject::tr("The sub volume maximum (%1, %2, %3) is less than the sub volume minimum (%4, %5, %6)")
+           .arg(getSubVolumeMax().x).arg(getSubVolumeMax().y).arg(getSubVolumeMax().z)
+           .arg(getSubVolumeMin().x).arg(getSubVolumeMin().y).arg(getSubVolumeMin().z);
+      setErrorCondition(-392);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+  }
+
   if(getErrorCondition())
   {
     // something has gone wrong and errors were logged alread so just return
@@ -286,7 +324,18 @@ void DataContainerReader::readData(bool preflight, DataContainerArrayProxy& prox
 
   scopedFileSentinel.addGroupId(&dcaGid);
 
-  err = dca->readDataContainersFromHDF5(preflight, dcaGid, proxy, this);
+  // Only the selected block of the Cell data of Image Geometries is read from the file when reading a sub volume
+  QVector<size_t> subVolumeStart;
+  QVector<size_t> subVolumeCount;
+  if (getReadSubVolume() == true)
+  {
+    subVolumeStart << static_cast<size_t>(m_SubVolumeMin.x) << static_cast<size_t>(m_SubVolumeMin.y) << static_cast<size_t>(m_SubVolumeMin.z);
+    subVolumeCount << static_cast<size_t>(m_SubVolumeMax.x - m_SubVolumeMin.x + 1)
+                   << static_cast<size_t>(m_SubVolumeMax.y - m_SubVolumeMin.y + 1)
+                   << static_cast<size_t>(m_SubVolumeMax.z - m_SubVolumeMin.z + 1);
+  }
+
+  err = dca->readDataContainersFromHDF5(preflight, dcaGid, proxy, this, subVolumeStart, subVolumeCount);
   if (err < 0)
   {
     setErrorCondition(err);
@@ -44,6 +44,7 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Common/FilterPipeline.h"
 #include "SIMPLib/DataContainers/DataContainerArrayProxy.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 
 /**
  * @brief The DataContainerReader class. See [Filter documentation](@ref datacontainerreader) for details.
@@ -73,6 +74,15 @@ class SIMPLib_EXPORT DataContainerReader : public AbstractFilter
     SIMPL_FILTER_PARAMETER(DataContainerArrayProxy, InputFileDataContainerArrayProxy)
     Q_PROPERTY(DataContainerArrayProxy InputFileDataContainerArrayProxy READ getInputFileDataContainerArrayProxy WRITE setInputFileDataContainerArrayProxy)
 
+    SIMPL_FILTER_PARAMETER(bool, ReadSubVolume)
+    Q_PROPERTY(bool ReadSubVolume READ getReadSubVolume WRITE setReadSubVolume)
+
+    SIMPL_FILTER_PARAMETER(IntVec3_t, SubVolumeMin)
+    Q_PROPERTY(IntVec3_t SubVolumeMin READ getSubVolumeMin WRITE setSubVolumeMin)
+
+    SIMPL_FILTER_PARAMETER(IntVec3_t, SubVolumeMax)
+    Q_PROPERTY(IntVec3_t SubVolumeMax READ getSubVolumeMax WRITE setSubVolumeMax)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -108,8 +108,9 @@ class DynamicListArray
     bool setElementList(size_t ptId, T nCells, K* data)
     {
       if(ptId >= m_Size) { return false; }
-      if(NULL != m_Array[ptId].cells && m_Array[ptId].ncells > 0)
+      if(NULL != m_Array[ptId].cells)
       {
+        delete [] m_Array[ptId].cells;
         m_Array[ptId].cells = NULL;
         m_Array[ptId].ncells = 0;
       }
@@ -173,6 +174,16 @@ class DynamicListArray
       }
     }
 
+    /**
+     * @brief initializeLists Allocates numLists empty lists. Each list can then be filled with setElementList(),
+     * which is safe to call concurrently for different list indices.
+     * @param numLists
+     */
+    void initializeLists(size_t numLists)
+    {
+      allocate(numLists);
+    }
+
     /**
      * @brief allocateLists
      * @param linkCounts
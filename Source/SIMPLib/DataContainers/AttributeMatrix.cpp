@@ -493,7 +493,8 @@ int AttributeMatrix::addAttributeArrayFromHDF5Path(hid_t gid, QString name, bool
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int AttributeMatrix::readAttributeArraysFromHDF5(hid_t amGid, bool preflight, AttributeMatrixProxy& attrMatProxy)
+int AttributeMatrix::readAttributeArraysFromHDF5(hid_t amGid, bool preflight, AttributeMatrixProxy& attrMatProxy, Observable* obs,
+                                                 const QVector<size_t>& tupleStart, const QVector<size_t>& tupleCount)
 {
   int err = 0;
   QMap<QString, DataArrayProxy> dasToRead = attrMatProxy.dataArrays;
@@ -511,7 +512,31 @@ int AttributeMatrix::readAttributeArraysFromHDF5(hid_t amGid, bool preflight, At
 
     if(classType.startsWith("DataArray") == true)
     {
-      dPtr = H5DataArrayReader::ReadIDataArray(amGid, iter->name, preflight);
+      if (tupleStart.isEmpty() == true)
+      {
+        dPtr = H5DataArrayReader::ReadIDataArray(amGid, iter->name, preflight);
+      }
+      else
+      {
+        dPtr = H5DataArrayReader::ReadIDataArraySubset(amGid, iter->name, tupleStart, tupleCount, preflight);
+        if (NULL == dPtr.get())
+        {
+          err = -1;
+          break;
+        }
+      }
+    }
+    else if(tupleStart.isEmpty() == false)
+    {
+      // Only DataArrays keep their tuples in a single dataset that can be read in part
+      if(NULL != obs)
+      {
+        QString ss = QObject::tr("Reading a sub volume (hyperslab) is not supported for the %1 array '%2' in Attribute Matrix '%3'. "
+                                 "Deselect the array or read the whole volume").arg(classType).arg(iter->name).arg(getName());
+        obs->notifyErrorMessage(getNameOfClass(), ss, -198745606);
+      }
+      err = -198745606;
+      break;
     }
     else if(classType.compare("StringDataArray") == 0)
     {
@@ -545,9 +545,15 @@ class SIMPLib_EXPORT AttributeMatrix : public Observable
      * @param amGid
      * @param preflight
      * @param attrMatProxy
+     * @param obs Receives the error messages, if not NULL
+     * @param tupleStart The first tuple along each tuple dimension of the block of tuples to read. Empty to read all the tuples
+     * @param tupleCount The number of tuples along each tuple dimension of the block of tuples to read
      * @return
      */
-    virtual int readAttributeArraysFromHDF5(hid_t amGid, bool preflight, AttributeMatrixProxy& attrMatProxy);
+    virtual int readAttributeArraysFromHDF5(hid_t amGid, bool preflight, AttributeMatrixProxy& attrMatProxy,
+                                            Observable* obs = NULL,
+                                            const QVector<size_t>& tupleStart = QVector<size_t>(),
+                                            const QVector<size_t>& tupleCount = QVector<size_t>());
 
     /**
      * @brief generateXdmfText
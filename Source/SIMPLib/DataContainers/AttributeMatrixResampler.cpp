@@ -0,0 +1,338 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "AttributeMatrixResampler.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Common/TemplateHelpers.hpp"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+namespace Detail
+{
+  // Number of destination tuples that are gathered for all of the arrays before moving to the next block
+  static const size_t k_BlockSize = 4096;
+
+  /**
+   * @brief The GatherEntry struct describes one array that takes part in the gather
+   */
+  struct GatherEntry
+  {
+    const char* source;
+    char* destination;
+    size_t numComp;
+    size_t typeSize;
+  };
+
+  /**
+   * @brief GatherTuples Copies tuples [start, end) of the destination from the source through the index map
+   */
+  template<typename T>
+  void GatherTuples(const T* source, T* destination, size_t numComp, const int64_t* newIndices, size_t start, size_t end)
+  {
+    if (numComp == 1)
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        int64_t index = newIndices[i];
+        destination[i] = (index >= 0) ? source[index] : static_cast<T>(0);
+      }
+      return;
+    }
+    for (size_t i = start; i < end; i++)
+    {
+      int64_t index = newIndices[i];
+      T* dest = destination + i * numComp;
+      if (index >= 0)
+      {
+        const T* src = source + static_cast<size_t>(index) * numComp;
+        for (size_t c = 0; c < numComp; c++)
+        {
+          dest[c] = src[c];
+        }
+      }
+      else
+      {
+        for (size_t c = 0; c < numComp; c++)
+        {
+          dest[c] = static_cast<T>(0);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief The GatherArraysImpl class gathers a range of blocks of destination tuples for all of the arrays
+   */
+  class GatherArraysImpl
+  {
+    public:
+      GatherArraysImpl(const std::vector<GatherEntry>& entries, const int64_t* newIndices, size_t numNewTuples) :
+        m_Entries(entries),
+        m_NewIndices(newIndices),
+        m_NumNewTuples(numNewTuples)
+      {}
+      virtual ~GatherArraysImpl() {}
+
+      void generate(size_t start, size_t end) const
+      {
+        for (size_t b = start; b < end; b++)
+        {
+          size_t first = b * k_BlockSize;
+          size_t last = std::min(first + k_BlockSize, m_NumNewTuples);
+          for (size_t a = 0; a < m_Entries.size(); a++)
+          {
+            const GatherEntry& e = m_Entries[a];
+            // Every DataArray type has a power of two element size, so the copy is done with
+            // the unsigned integer type of that size
+            switch(e.typeSize)
+            {
+              case 1:
+                GatherTuples<uint8_t>(reinterpret_cast<const uint8_t*>(e.source), reinterpret_cast<uint8_t*>(e.destination), e.numComp, m_NewIndices, first, last);
+                break;
+              case 2:
+                GatherTuples<uint16_t>(reinterpret_cast<const uint16_t*>(e.source), reinterpret_cast<uint16_t*>(e.destination), e.numComp, m_NewIndices, first, last);
+                break;
+              case 4:
+                GatherTuples<uint32_t>(reinterpret_cast<const uint32_t*>(e.source), reinterpret_cast<uint32_t*>(e.destination), e.numComp, m_NewIndices, first, last);
+                break;
+              case 8:
+                GatherTuples<uint64_t>(reinterpret_cast<const uint64_t*>(e.source), reinterpret_cast<uint64_t*>(e.destination), e.numComp, m_NewIndices, first, last);
+                break;
+              default:
+                GatherTuples<char>(e.source, e.destination, e.numComp * e.typeSize, m_NewIndices, first, last);
+                break;
+            }
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        generate(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      const std::vector<GatherEntry>& m_Entries;
+      const int64_t* m_NewIndices;
+      size_t m_NumNewTuples;
+  };
+
+  /**
+   * @brief IsPlainDataArray Returns true if the array is one of the DataArray types whose values
+   * are stored contiguously and can be copied byte for byte
+   */
+  inline bool IsPlainDataArray(IDataArray::Pointer p)
+  {
+    return TemplateHelpers::CanDynamicCast<FloatArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<DoubleArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<Int8ArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<Int16ArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<Int32ArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<Int64ArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(p)
+           || TemplateHelpers::CanDynamicCast<BoolArrayType>()(p);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AttributeMatrixResampler::AttributeMatrixResampler()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AttributeMatrixResampler::~AttributeMatrixResampler()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AttributeMatrix::Pointer AttributeMatrixResampler::Resample(AttributeMatrix::Pointer source, QVector<size_t> tDims, const int64_t* newIndices)
+{
+  AttributeMatrix::Pointer newAttrMat = AttributeMatrix::New(tDims, source->getName(), source->getType());
+  size_t numNewTuples = newAttrMat->getNumTuples();
+
+  QVector<IDataArray::Pointer> sources;
+  QVector<IDataArray::Pointer> destinations;
+  QList<QString> arrayNames = source->getAttributeArrayNames();
+  for (QList<QString>::iterator iter = arrayNames.begin(); iter != arrayNames.end(); ++iter)
+  {
+    IDataArray::Pointer p = source->getAttributeArray(*iter);
+    IDataArray::Pointer data = p->createNewArray(numNewTuples, p->getComponentDimensions(), p->getName());
+    if (NULL == data.get() || (numNewTuples > 0 && data->isAllocated() == false))
+    {
+      return AttributeMatrix::NullPointer();
+    }
+    sources.push_back(p);
+    destinations.push_back(data);
+  }
+
+  if (GatherArrays(sources, destinations, newIndices, numNewTuples) == false)
+  {
+    return AttributeMatrix::NullPointer();
+  }
+
+  for (int32_t i = 0; i < destinations.size(); i++)
+  {
+    newAttrMat->addAttributeArray(destinations[i]->getName(), destinations[i]);
+  }
+  return newAttrMat;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AttributeMatrixResampler::GatherArrays(const QVector<IDataArray::Pointer>& sources, const QVector<IDataArray::Pointer>& destinations,
+                                            const int64_t* newIndices, size_t numNewTuples)
+{
+  if (sources.size() != destinations.size())
+  {
+    return false;
+  }
+
+  int64_t maxIndex = -1;
+  for (size_t i = 0; i < numNewTuples; i++)
+  {
+    if (newIndices[i] > maxIndex) { maxIndex = newIndices[i]; }
+  }
+
+  std::vector<Detail::GatherEntry> entries;
+  QVector<int32_t> fallbackArrays;
+  for (int32_t a = 0; a < sources.size(); a++)
+  {
+    IDataArray::Pointer src = sources[a];
+    IDataArray::Pointer dest = destinations[a];
+    if (dest->getNumberOfTuples() != numNewTuples || dest->getNumberOfComponents() != src->getNumberOfComponents()
+        || dest->getTypeSize() != src->getTypeSize())
+    {
+      return false;
+    }
+    if (maxIndex >= static_cast<int64_t>(src->getNumberOfTuples()))
+    {
+      return false;
+    }
+    if (numNewTuples == 0 || src->getNumberOfTuples() == 0)
+    {
+      // Nothing to read from, so every index is negative and the destination only needs zeroing
+      dest->initializeWithZeros();
+      continue;
+    }
+    if (Detail::IsPlainDataArray(src) == false || Detail::IsPlainDataArray(dest) == false)
+    {
+      fallbackArrays.push_back(a);
+      continue;
+    }
+    Detail::GatherEntry e;
+    e.source = reinterpret_cast<const char*>(src->getVoidPointer(0));
+    e.destination = reinterpret_cast<char*>(dest->getVoidPointer(0));
+    e.numComp = static_cast<size_t>(src->getNumberOfComponents());
+    e.typeSize = src->getTypeSize();
+    entries.push_back(e);
+  }
+
+  // Arrays that are not plain DataArrays are copied one tuple at a time
+  for (int32_t f = 0; f < fallbackArrays.size(); f++)
+  {
+    IDataArray::Pointer src = sources[fallbackArrays[f]];
+    IDataArray::Pointer dest = destinations[fallbackArrays[f]];
+    size_t numComp = static_cast<size_t>(src->getNumberOfComponents());
+    size_t tupleBytes = numComp * src->getTypeSize();
+    for (size_t i = 0; i < numNewTuples; i++)
+    {
+      if (newIndices[i] >= 0)
+      {
+        void* source = src->getVoidPointer(numComp * static_cast<size_t>(newIndices[i]));
+        void* destination = dest->getVoidPointer(numComp * i);
+        if (NULL == source || NULL == destination)
+        {
+          return false;
+        }
+        ::memcpy(destination, source, tupleBytes);
+      }
+      else
+      {
+        dest->initializeTuple(i, 0);
+      }
+    }
+  }
+
+  if (entries.empty())
+  {
+    return true;
+  }
+
+  size_t numBlocks = (numNewTuples + Detail::k_BlockSize - 1) / Detail::k_BlockSize;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks),
+                      Detail::GatherArraysImpl(entries, newIndices, numNewTuples), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    Detail::GatherArraysImpl serial(entries, newIndices, numNewTuples);
+    serial.generate(0, numBlocks);
+  }
+
+  return true;
+}
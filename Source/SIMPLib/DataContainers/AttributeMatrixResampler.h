@@ -0,0 +1,95 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _AttributeMatrixResampler_H_
+#define _AttributeMatrixResampler_H_
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+/**
+ * @brief The AttributeMatrixResampler class gathers the tuples of a set of arrays into new arrays
+ * through an index map, which is the final step shared by the filters that resample, crop or rotate
+ * an image geometry. Entry i of the index map is the source tuple that is copied into destination
+ * tuple i; a negative entry fills the destination tuple with zeros.
+ *
+ * The destination tuples are split into blocks that are processed in parallel. Each block is
+ * gathered for every array before moving on to the next block, so the part of the index map a
+ * block uses is read from memory once instead of once per array. Arrays of the plain numeric
+ * DataArray types are copied with typed loads and stores; any other array type falls back to a
+ * serial byte copy of each tuple.
+ */
+class SIMPLib_EXPORT AttributeMatrixResampler
+{
+  public:
+    virtual ~AttributeMatrixResampler();
+
+    /**
+     * @brief Resample Creates a new AttributeMatrix with the name and type of source and the tuple
+     * dimensions tDims, holding a gathered copy of every array of source.
+     * @param source The AttributeMatrix to resample
+     * @param tDims The tuple dimensions of the new AttributeMatrix
+     * @param newIndices The index map, which must have as many entries as tDims has tuples
+     * @return The new AttributeMatrix or a NullPointer if an index is outside of the source arrays
+     * or an array could not be gathered
+     */
+    static AttributeMatrix::Pointer Resample(AttributeMatrix::Pointer source, QVector<size_t> tDims, const int64_t* newIndices);
+
+    /**
+     * @brief GatherArrays Gathers the tuples of each source array into the destination array at
+     * the same position. The destination arrays must be allocated with numNewTuples tuples and the
+     * same type and number of components as their source array.
+     * @param sources The arrays to read from
+     * @param destinations The arrays to write to
+     * @param newIndices The index map with numNewTuples entries
+     * @param numNewTuples The number of tuples of the destination arrays
+     * @return false if an index is outside of a source array or an array could not be gathered
+     */
+    static bool GatherArrays(const QVector<IDataArray::Pointer>& sources, const QVector<IDataArray::Pointer>& destinations,
+                             const int64_t* newIndices, size_t numNewTuples);
+
+  protected:
+    AttributeMatrixResampler();
+
+  private:
+    AttributeMatrixResampler(const AttributeMatrixResampler&); // Copy Constructor Not Implemented
+    void operator=(const AttributeMatrixResampler&); // Operator '=' Not Implemented
+};
+
+#endif /* _AttributeMatrixResampler_H_ */
@@ -321,7 +321,8 @@ int DataContainer::writeAttributeMatricesToHDF5(hid_t parentId)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int DataContainer::readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, const DataContainerProxy& dcProxy)
+int DataContainer::readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, const DataContainerProxy& dcProxy, Observable* obs,
+                                                 const QVector<size_t>& cellTupleStart, const QVector<size_t>& cellTupleCount)
 {
   int err = 0;
   QVector<size_t> tDims;
@@ -344,6 +345,20 @@ int DataContainer::readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, co
       return -1;
     }
 
+    // Only a block of the Cell tuples is read if one was requested
+    QVector<size_t> tupleStart;
+    QVector<size_t> tupleCount;
+    if (amType == DREAM3D::AttributeMatrixType::Cell && cellTupleStart.isEmpty() == false)
+    {
+      if (tDims.size() != cellTupleStart.size())
+      {
+        return -1;
+      }
+      tupleStart = cellTupleStart;
+      tupleCount = cellTupleCount;
+      tDims = cellTupleCount;
+    }
+
     hid_t amGid = H5Gopen(dcGid, amName.toLatin1().data(), H5P_DEFAULT );
     if (amGid < 0)
     {
@@ -356,7 +371,7 @@ int DataContainer::readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, co
       addAttributeMatrix(amName, am);
     }
 
-    err = getAttributeMatrix(amName)->readAttributeArraysFromHDF5(amGid, preflight, iter.value());
+    err = getAttributeMatrix(amName)->readAttributeArraysFromHDF5(amGid, preflight, iter.value(), obs, tupleStart, tupleCount);
     if(err < 0)
     {
       err |= H5Gclose(dcGid);
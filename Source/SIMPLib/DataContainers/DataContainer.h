@@ -378,9 +378,16 @@ class SIMPLib_EXPORT DataContainer : public Observable
 
     /**
     * @brief Reads desired Attribute Matrices from HDF5 file
+    * @param obs Receives the error messages, if not NULL
+    * @param cellTupleStart The first tuple along each tuple dimension of the block of tuples to read from the Cell
+    * Attribute Matrices. Empty to read all the tuples
+    * @param cellTupleCount The number of tuples along each tuple dimension of the block of Cell tuples to read
     * @return
     */
-    virtual int readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, const DataContainerProxy& dcProxy);
+    virtual int readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, const DataContainerProxy& dcProxy,
+                                              Observable* obs = NULL,
+                                              const QVector<size_t>& cellTupleStart = QVector<size_t>(),
+                                              const QVector<size_t>& cellTupleCount = QVector<size_t>());
 
     /**
      * @brief creates copy of dataContainer
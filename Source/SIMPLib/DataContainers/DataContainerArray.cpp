@@ -34,6 +34,8 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "DataContainerArray.h"
 
+#include "SIMPLib/Geometry/ImageGeom.h"
+
 #include "moc_DataContainerArray.cpp"
 
 
@@ -295,7 +297,9 @@ void DataContainerArray::printDataContainerNames(QTextStream& out)
 int DataContainerArray::readDataContainersFromHDF5(bool preflight,
                                                    hid_t dcaGid,
                                                    DataContainerArrayProxy& dcaProxy,
-                                                   Observable* obs)
+                                                   Observable* obs,
+                                                   const QVector<size_t>& subVolumeStart,
+                                                   const QVector<size_t>& subVolumeCount)
 {
   int err = 0;
   QList<DataContainerProxy> dcsToRead = dcaProxy.dataContainers.values();
@@ -342,7 +346,45 @@ int DataContainerArray::readDataContainersFromHDF5(bool preflight,
       }
       return -198745603;
     }
-    err = this->getDataContainer(dcProxy.name)->readAttributeMatricesFromHDF5(preflight, dcGid, dcProxy);
+
+    // The sub volume only applies to Image Geometries. The geometry is cropped to the sub volume and only
+    // the matching block of the Cell data is read from the file.
+    QVector<size_t> cellTupleStart;
+    QVector<size_t> cellTupleCount;
+    ImageGeom::Pointer image = this->getDataContainer(dcProxy.name)->getGeometryAs<ImageGeom>();
+    if (subVolumeStart.isEmpty() == false && NULL != image.get())
+    {
+      size_t dims[3] = { 0, 0, 0 };
+      float origin[3] = { 0.0f, 0.0f, 0.0f };
+      float res[3] = { 0.0f, 0.0f, 0.0f };
+      image->getDimensions(dims);
+      image->getOrigin(origin);
+      image->getResolution(res);
+      if (subVolumeStart.size() != 3 || subVolumeCount.size() != 3
+          || subVolumeStart[0] + subVolumeCount[0] > dims[0]
+          || subVolumeStart[1] + subVolumeCount[1] > dims[1]
+          || subVolumeStart[2] + subVolumeCount[2] > dims[2])
+      {
+        if(NULL != obs)
+        {
+          QString ss = QObject::tr("The sub volume to read lies outside of the dimensions (%1, %2, %3) of '%4'").arg(dims[0]).arg(dims[1]).arg(dims[2]).arg(dcProxy.name);
+          obs->notifyErrorMessage(getNameOfClass(), ss, -198745605);
+        }
+        H5Gclose(dcGid);
+        return -198745605;
+      }
+      for (int32_t i = 0; i < 3; i++)
+      {
+        origin[i] = origin[i] + subVolumeStart[i] * res[i];
+        dims[i] = subVolumeCount[i];
+      }
+      image->setDimensions(dims);
+      image->setOrigin(origin);
+      cellTupleStart = subVolumeStart;
+      cellTupleCount = subVolumeCount;
+    }
+
+    err = this->getDataContainer(dcProxy.name)->readAttributeMatricesFromHDF5(preflight, dcGid, dcProxy, obs, cellTupleStart, cellTupleCount);
     if (err < 0)
     {
       if(NULL != obs)
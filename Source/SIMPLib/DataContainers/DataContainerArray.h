@@ -176,12 +176,17 @@ class SIMPLib_EXPORT DataContainerArray : public QObject
      * @param dcaGid
      * @param dcaProxy
      * @param obs
+     * @param subVolumeStart The first cell (x, y, z) of the sub volume to read from DataContainers with an Image
+     * Geometry. Empty to read the whole volume
+     * @param subVolumeCount The number of cells (x, y, z) of the sub volume
      * @return
      */
     virtual int readDataContainersFromHDF5(bool preflight,
                                            hid_t dcaGid,
                                            DataContainerArrayProxy& dcaProxy,
-                                           Observable* obs = NULL);
+                                           Observable* obs = NULL,
+                                           const QVector<size_t>& subVolumeStart = QVector<size_t>(),
+                                           const QVector<size_t>& subVolumeCount = QVector<size_t>());
 
 
     /**
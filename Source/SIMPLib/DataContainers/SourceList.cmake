@@ -52,6 +52,7 @@ set_source_files_properties( ${SIMPLib_${SUBDIR_NAME}_Generated_MOC_SRCS} PROPER
 set(SIMPLib_${SUBDIR_NAME}_HDRS
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataContainer.h
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/AttributeMatrix.h
+  ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/AttributeMatrixResampler.h
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataContainerArrayProxy.h
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataContainerProxy.h
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/AttributeMatrixProxy.h
@@ -64,6 +65,7 @@ set(SIMPLib_${SUBDIR_NAME}_SRCS
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataContainer.cpp
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataContainerArray.cpp
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/AttributeMatrix.cpp
+  ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/AttributeMatrixResampler.cpp
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataContainerArrayProxy.cpp
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataArrayPath.cpp
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataContainerBundle.cpp
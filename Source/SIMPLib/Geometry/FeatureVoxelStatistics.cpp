@@ -0,0 +1,359 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "FeatureVoxelStatistics.h"
+
+#include <limits>
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace Detail
+{
+  // Upper limit on the memory used by the partial accumulators of all the chunks
+  static const size_t k_MaxPartialBytes = 512 * 1024 * 1024;
+  // Do not bother splitting the cells into chunks smaller than this
+  static const size_t k_MinChunkSize = 65536;
+
+  /**
+   * @brief The AccumulateChunksImpl class fills the partial accumulators of a range of chunks
+   */
+  class AccumulateChunksImpl
+  {
+    public:
+      AccumulateChunksImpl(const size_t dims[3], const int32_t* featureIds, size_t chunkSize, size_t totalPoints,
+                           std::vector<FeatureVoxelStatistics::Accumulators>& partials) :
+        m_FeatureIds(featureIds),
+        m_ChunkSize(chunkSize),
+        m_TotalPoints(totalPoints),
+        m_Partials(partials)
+      {
+        m_Dims[0] = dims[0];
+        m_Dims[1] = dims[1];
+        m_Dims[2] = dims[2];
+      }
+      virtual ~AccumulateChunksImpl() {}
+
+      void accumulate(size_t start, size_t end) const
+      {
+        for (size_t c = start; c < end; c++)
+        {
+          size_t first = c * m_ChunkSize;
+          size_t last = std::min(first + m_ChunkSize, m_TotalPoints);
+          m_Partials[c].accumulate(m_Dims, m_FeatureIds, first, last);
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        accumulate(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      size_t m_Dims[3];
+      const int32_t* m_FeatureIds;
+      size_t m_ChunkSize;
+      size_t m_TotalPoints;
+      std::vector<FeatureVoxelStatistics::Accumulators>& m_Partials;
+  };
+
+  /**
+   * @brief CrossSum Returns the sum of (a * u - p) * (b * v - q) over the voxels of a feature
+   * given the sums of u, v and u * v.
+   */
+  inline double CrossSum(double n, double sumU, double sumV, double sumUV, double a, double b, double p, double q)
+  {
+    return (a * b * sumUV) - (a * q * sumU) - (b * p * sumV) + (n * p * q);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureVoxelStatistics::Accumulators::Accumulators() :
+  m_NumFeatures(0),
+  m_Quantities(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureVoxelStatistics::Accumulators::~Accumulators()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureVoxelStatistics::Accumulators::allocate(size_t numFeatures, unsigned int quantities)
+{
+  m_NumFeatures = numFeatures;
+  m_Quantities = quantities;
+  m_Counts.assign((quantities & Counts) ? numFeatures : 0, 0);
+  m_Sums.assign((quantities & Sums) ? numFeatures * 3 : 0, 0);
+  m_SquareSums.assign((quantities & SecondMoments) ? numFeatures * 6 : 0, 0);
+  m_Min.assign((quantities & Bounds) ? numFeatures * 3 : 0, std::numeric_limits<int64_t>::max());
+  m_Max.assign((quantities & Bounds) ? numFeatures * 3 : 0, std::numeric_limits<int64_t>::min());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureVoxelStatistics::Accumulators::accumulate(const size_t dims[3], const int32_t* featureIds, size_t start, size_t end)
+{
+  if (start >= end) { return; }
+
+  const bool doCounts = (m_Quantities & Counts) != 0;
+  const bool doSums = (m_Quantities & Sums) != 0;
+  const bool doSquares = (m_Quantities & SecondMoments) != 0;
+  const bool doBounds = (m_Quantities & Bounds) != 0;
+  const int64_t numFeatures = static_cast<int64_t>(m_NumFeatures);
+
+  int64_t x = static_cast<int64_t>(start % dims[0]);
+  int64_t y = static_cast<int64_t>((start / dims[0]) % dims[1]);
+  int64_t z = static_cast<int64_t>(start / (dims[0] * dims[1]));
+  const int64_t xDim = static_cast<int64_t>(dims[0]);
+  const int64_t yDim = static_cast<int64_t>(dims[1]);
+
+  for (size_t i = start; i < end; i++)
+  {
+    int64_t gnum = featureIds[i];
+    if (gnum >= 0 && gnum < numFeatures)
+    {
+      if (doCounts) { m_Counts[gnum]++; }
+      if (doSums)
+      {
+        int64_t* sums = &(m_Sums[gnum * 3]);
+        sums[0] += x;
+        sums[1] += y;
+        sums[2] += z;
+      }
+      if (doSquares)
+      {
+        int64_t* squares = &(m_SquareSums[gnum * 6]);
+        squares[0] += x * x;
+        squares[1] += y * y;
+        squares[2] += z * z;
+        squares[3] += x * y;
+        squares[4] += y * z;
+        squares[5] += x * z;
+      }
+      if (doBounds)
+      {
+        int64_t* minIdx = &(m_Min[gnum * 3]);
+        int64_t* maxIdx = &(m_Max[gnum * 3]);
+        if (x < minIdx[0]) { minIdx[0] = x; }
+        if (y < minIdx[1]) { minIdx[1] = y; }
+        if (z < minIdx[2]) { minIdx[2] = z; }
+        if (x > maxIdx[0]) { maxIdx[0] = x; }
+        if (y > maxIdx[1]) { maxIdx[1] = y; }
+        if (z > maxIdx[2]) { maxIdx[2] = z; }
+      }
+    }
+
+    x++;
+    if (x == xDim)
+    {
+      x = 0;
+      y++;
+      if (y == yDim)
+      {
+        y = 0;
+        z++;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureVoxelStatistics::Accumulators::merge(const Accumulators& rhs)
+{
+  for (size_t i = 0; i < m_Counts.size(); i++) { m_Counts[i] += rhs.m_Counts[i]; }
+  for (size_t i = 0; i < m_Sums.size(); i++) { m_Sums[i] += rhs.m_Sums[i]; }
+  for (size_t i = 0; i < m_SquareSums.size(); i++) { m_SquareSums[i] += rhs.m_SquareSums[i]; }
+  for (size_t i = 0; i < m_Min.size(); i++)
+  {
+    if (rhs.m_Min[i] < m_Min[i]) { m_Min[i] = rhs.m_Min[i]; }
+    if (rhs.m_Max[i] > m_Max[i]) { m_Max[i] = rhs.m_Max[i]; }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureVoxelStatistics::FeatureVoxelStatistics()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureVoxelStatistics::~FeatureVoxelStatistics()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureVoxelStatistics::compute(const size_t dims[3], const int32_t* featureIds, size_t numFeatures, unsigned int quantities)
+{
+  // Centroids and moments can not be computed without the counts
+  if (quantities & (Sums | SecondMoments)) { quantities |= Counts; }
+  if (quantities & SecondMoments) { quantities |= Sums; }
+
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  m_Result.allocate(numFeatures, quantities);
+  if (totalPoints == 0) { return; }
+
+  size_t bytesPerFeature = 0;
+  if (quantities & Counts) { bytesPerFeature += sizeof(int64_t); }
+  if (quantities & Sums) { bytesPerFeature += 3 * sizeof(int64_t); }
+  if (quantities & SecondMoments) { bytesPerFeature += 6 * sizeof(int64_t); }
+  if (quantities & Bounds) { bytesPerFeature += 6 * sizeof(int64_t); }
+
+  size_t numChunks = 1;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  numChunks = static_cast<size_t>(init.default_num_threads());
+  size_t partialBytes = std::max(bytesPerFeature * numFeatures, static_cast<size_t>(1));
+  numChunks = std::min(numChunks, std::max(Detail::k_MaxPartialBytes / partialBytes, static_cast<size_t>(1)));
+  numChunks = std::min(numChunks, std::max(totalPoints / Detail::k_MinChunkSize, static_cast<size_t>(1)));
+#endif
+  if (numChunks == 1)
+  {
+    m_Result.accumulate(dims, featureIds, 0, totalPoints);
+    return;
+  }
+
+  size_t chunkSize = (totalPoints + numChunks - 1) / numChunks;
+  std::vector<Accumulators> partials(numChunks);
+  for (size_t c = 0; c < numChunks; c++)
+  {
+    partials[c].allocate(numFeatures, quantities);
+  }
+
+  Detail::AccumulateChunksImpl impl(dims, featureIds, chunkSize, totalPoints, partials);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), impl, tbb::simple_partitioner());
+#else
+  impl.accumulate(0, numChunks);
+#endif
+
+  // Merge the partial results in chunk order
+  for (size_t c = 0; c < numChunks; c++)
+  {
+    m_Result.merge(partials[c]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureVoxelStatistics::getNumberOfFeatures() const
+{
+  return m_Result.m_NumFeatures;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+unsigned int FeatureVoxelStatistics::getQuantities() const
+{
+  return m_Result.m_Quantities;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t FeatureVoxelStatistics::getNumberOfVoxels(size_t featureId) const
+{
+  return m_Result.m_Counts[featureId];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureVoxelStatistics::getCentroid(size_t featureId, const float res[3], float centroid[3]) const
+{
+  double n = static_cast<double>(m_Result.m_Counts[featureId]);
+  const int64_t* sums = &(m_Result.m_Sums[featureId * 3]);
+  for (int d = 0; d < 3; d++)
+  {
+    centroid[d] = static_cast<float>((static_cast<double>(sums[d]) / n) * res[d]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureVoxelStatistics::getSecondMoments(size_t featureId, const float res[3], const float center[3], double moments[6]) const
+{
+  double n = static_cast<double>(m_Result.m_Counts[featureId]);
+  const int64_t* sums = &(m_Result.m_Sums[featureId * 3]);
+  const int64_t* squares = &(m_Result.m_SquareSums[featureId * 6]);
+  double s[3] = { static_cast<double>(sums[0]), static_cast<double>(sums[1]), static_cast<double>(sums[2]) };
+  double r[3] = { res[0], res[1], res[2] };
+  double c[3] = { center[0], center[1], center[2] };
+
+  moments[0] = Detail::CrossSum(n, s[0], s[0], static_cast<double>(squares[0]), r[0], r[0], c[0], c[0]);
+  moments[1] = Detail::CrossSum(n, s[1], s[1], static_cast<double>(squares[1]), r[1], r[1], c[1], c[1]);
+  moments[2] = Detail::CrossSum(n, s[2], s[2], static_cast<double>(squares[2]), r[2], r[2], c[2], c[2]);
+  moments[3] = Detail::CrossSum(n, s[0], s[1], static_cast<double>(squares[3]), r[0], r[1], c[0], c[1]);
+  moments[4] = Detail::CrossSum(n, s[1], s[2], static_cast<double>(squares[4]), r[1], r[2], c[1], c[2]);
+  moments[5] = Detail::CrossSum(n, s[0], s[2], static_cast<double>(squares[5]), r[0], r[2], c[0], c[2]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureVoxelStatistics::getBounds(size_t featureId, int64_t minIndex[3], int64_t maxIndex[3]) const
+{
+  for (int d = 0; d < 3; d++)
+  {
+    minIndex[d] = m_Result.m_Min[featureId * 3 + d];
+    maxIndex[d] = m_Result.m_Max[featureId * 3 + d];
+  }
+}
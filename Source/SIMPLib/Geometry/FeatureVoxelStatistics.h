@@ -0,0 +1,174 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _FeatureVoxelStatistics_H_
+#define _FeatureVoxelStatistics_H_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+/**
+ * @brief The FeatureVoxelStatistics class computes the per-feature voxel counts, coordinate
+ * sums, second order coordinate sums and bounding boxes of a feature ids array that lives
+ * on an image geometry. All of the quantities are gathered in a single pass over the cells.
+ * The cells are split into contiguous chunks that are processed in parallel, each into its own
+ * set of partial accumulators, which are then merged in chunk order. All sums are kept in voxel
+ * index units as 64 bit integers so the result does not depend on the number of threads.
+ *
+ * Typical usage is:
+ * @code
+ * FeatureVoxelStatistics::Pointer stats = FeatureVoxelStatistics::New();
+ * stats->compute(dims, featureIds, numFeatures, FeatureVoxelStatistics::Counts | FeatureVoxelStatistics::Sums);
+ * stats->getCentroid(featureId, res, centroid);
+ * @endcode
+ */
+class SIMPLib_EXPORT FeatureVoxelStatistics
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureVoxelStatistics)
+    SIMPL_STATIC_NEW_MACRO(FeatureVoxelStatistics)
+    SIMPL_TYPE_MACRO(FeatureVoxelStatistics)
+
+    virtual ~FeatureVoxelStatistics();
+
+    /**
+     * @brief The quantities that can be gathered. Only the requested ones are allocated
+     * and accumulated.
+     */
+    enum Quantity
+    {
+      Counts = 0x1,
+      Sums = 0x2,
+      SecondMoments = 0x4,
+      Bounds = 0x8,
+      AllQuantities = 0xF
+    };
+
+    /**
+     * @brief compute Sweeps the feature ids once and gathers the requested quantities for
+     * every feature. Cells whose feature id is negative or not less than numFeatures are skipped.
+     * @param dims The dimensions of the image geometry
+     * @param featureIds The feature id of each cell
+     * @param numFeatures The number of features (including feature 0)
+     * @param quantities A bitwise OR of the Quantity values to gather
+     */
+    void compute(const size_t dims[3], const int32_t* featureIds, size_t numFeatures, unsigned int quantities = AllQuantities);
+
+    /**
+     * @brief getNumberOfFeatures Returns the number of features from the last call to compute()
+     * @return
+     */
+    size_t getNumberOfFeatures() const;
+
+    /**
+     * @brief getQuantities Returns the quantities that were gathered by the last call to compute()
+     * @return
+     */
+    unsigned int getQuantities() const;
+
+    /**
+     * @brief getNumberOfVoxels Returns the number of cells that belong to the feature
+     * @param featureId
+     * @return
+     */
+    int64_t getNumberOfVoxels(size_t featureId) const;
+
+    /**
+     * @brief getCentroid Returns the centroid of the feature as x = i * res[0] etc. The centroid
+     * of a feature without voxels is NaN. Requires Counts and Sums.
+     * @param featureId
+     * @param res The resolution of the image geometry
+     * @param centroid (OUT) The centroid
+     */
+    void getCentroid(size_t featureId, const float res[3], float centroid[3]) const;
+
+    /**
+     * @brief getSecondMoments Returns the sums over the cells of the feature of (x-cx)^2, (y-cy)^2,
+     * (z-cz)^2, (x-cx)(y-cy), (y-cy)(z-cz) and (x-cx)(z-cz) in that order, where x = i * res[0] etc.
+     * Requires Counts, Sums and SecondMoments.
+     * @param featureId
+     * @param res The resolution of the image geometry
+     * @param center The point the moments are taken about, usually the centroid
+     * @param moments (OUT) The 6 second moments
+     */
+    void getSecondMoments(size_t featureId, const float res[3], const float center[3], double moments[6]) const;
+
+    /**
+     * @brief getBounds Returns the smallest and largest cell index along each axis of the
+     * feature. A feature without voxels returns a minimum that is larger than its maximum.
+     * Requires Bounds.
+     * @param featureId
+     * @param minIndex (OUT) The minimum index
+     * @param maxIndex (OUT) The maximum index
+     */
+    void getBounds(size_t featureId, int64_t minIndex[3], int64_t maxIndex[3]) const;
+
+    /**
+     * @brief The Accumulators class holds one set of per-feature sums. Each parallel chunk
+     * fills its own instance.
+     */
+    class Accumulators
+    {
+      public:
+        Accumulators();
+        virtual ~Accumulators();
+
+        void allocate(size_t numFeatures, unsigned int quantities);
+        void accumulate(const size_t dims[3], const int32_t* featureIds, size_t start, size_t end);
+        void merge(const Accumulators& rhs);
+
+        size_t m_NumFeatures;
+        unsigned int m_Quantities;
+        std::vector<int64_t> m_Counts;
+        std::vector<int64_t> m_Sums;        // N x 3 (i, j, k)
+        std::vector<int64_t> m_SquareSums;  // N x 6 (ii, jj, kk, ij, jk, ik)
+        std::vector<int64_t> m_Min;         // N x 3
+        std::vector<int64_t> m_Max;         // N x 3
+    };
+
+  protected:
+    FeatureVoxelStatistics();
+
+  private:
+    Accumulators m_Result;
+
+    FeatureVoxelStatistics(const FeatureVoxelStatistics&); // Copy Constructor Not Implemented
+    void operator=(const FeatureVoxelStatistics&); // Operator '=' Not Implemented
+};
+
+#endif /* _FeatureVoxelStatistics_H_ */
@@ -3,6 +3,21 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "H5Support/QH5Utilities.h"
 #include "H5Support/HDF5ScopedFileSentinel.h"
 #include "H5Support/QH5Lite.h"
@@ -183,6 +198,295 @@ namespace GeometryHelpers
       }
   };
 
+  namespace Detail
+  {
+    /**
+     * @brief The BucketVertexReferencesImpl class sorts the vertex references of a list of elements into buckets of
+     * consecutive vertex ids. The elements are processed in fixed size blocks; without output arrays each block only
+     * counts its references per bucket, with them each block scatters its (vertex, element) pairs starting at its own
+     * per bucket offsets. Because blocks are laid out in element order inside every bucket the scatter is stable.
+     */
+    template<typename K>
+    class BucketVertexReferencesImpl
+    {
+      public:
+        BucketVertexReferencesImpl(const K* elems, size_t numElems, size_t numVertsPerElem, size_t blockSize,
+                                   size_t bucketWidth, size_t numBuckets, size_t* blockBuckets, K* vertIds, K* elemIds) :
+          m_Elems(elems),
+          m_NumElems(numElems),
+          m_NumVertsPerElem(numVertsPerElem),
+          m_BlockSize(blockSize),
+          m_BucketWidth(bucketWidth),
+          m_NumBuckets(numBuckets),
+          m_BlockBuckets(blockBuckets),
+          m_VertIds(vertIds),
+          m_ElemIds(elemIds)
+        {}
+        virtual ~BucketVertexReferencesImpl() {}
+
+        void generate(size_t start, size_t end) const
+        {
+          for (size_t b = start; b < end; b++)
+          {
+            size_t* buckets = m_BlockBuckets + b * m_NumBuckets;
+            size_t elemStart = b * m_BlockSize;
+            size_t elemEnd = elemStart + m_BlockSize;
+            if (elemEnd > m_NumElems) { elemEnd = m_NumElems; }
+            for (size_t elemId = elemStart; elemId < elemEnd; elemId++)
+            {
+              const K* verts = m_Elems + elemId * m_NumVertsPerElem;
+              for (size_t j = 0; j < m_NumVertsPerElem; j++)
+              {
+                size_t bucket = static_cast<size_t>(verts[j]) / m_BucketWidth;
+                if (NULL == m_VertIds)
+                {
+                  buckets[bucket]++;
+                }
+                else
+                {
+                  size_t pos = buckets[bucket]++;
+                  m_VertIds[pos] = verts[j];
+                  m_ElemIds[pos] = static_cast<K>(elemId);
+                }
+              }
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          generate(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        const K* m_Elems;
+        size_t m_NumElems;
+        size_t m_NumVertsPerElem;
+        size_t m_BlockSize;
+        size_t m_BucketWidth;
+        size_t m_NumBuckets;
+        size_t* m_BlockBuckets;
+        K* m_VertIds;
+        K* m_ElemIds;
+    };
+
+    /**
+     * @brief The FillVertexListsImpl class counting sorts the (vertex, element) pairs of each bucket by vertex and
+     * stores the resulting element list of every vertex in the bucket.
+     */
+    template<typename T, typename K>
+    class FillVertexListsImpl
+    {
+      public:
+        FillVertexListsImpl(const K* vertIds, const K* elemIds, const size_t* bucketStarts, size_t bucketWidth, size_t numVerts,
+                            DynamicListArray<T, K>* dynamicList) :
+          m_VertIds(vertIds),
+          m_ElemIds(elemIds),
+          m_BucketStarts(bucketStarts),
+          m_BucketWidth(bucketWidth),
+          m_NumVerts(numVerts),
+          m_DynamicList(dynamicList)
+        {}
+        virtual ~FillVertexListsImpl() {}
+
+        void generate(size_t start, size_t end) const
+        {
+          std::vector<size_t> offsets;
+          std::vector<K> sorted;
+          for (size_t bucket = start; bucket < end; bucket++)
+          {
+            size_t firstVert = bucket * m_BucketWidth;
+            size_t lastVert = firstVert + m_BucketWidth;
+            if (lastVert > m_NumVerts) { lastVert = m_NumVerts; }
+            size_t first = m_BucketStarts[bucket];
+            size_t last = m_BucketStarts[bucket + 1];
+
+            offsets.assign(lastVert - firstVert + 1, 0);
+            for (size_t i = first; i < last; i++)
+            {
+              offsets[static_cast<size_t>(m_VertIds[i]) - firstVert + 1]++;
+            }
+            for (size_t v = 1; v < offsets.size(); v++)
+            {
+              offsets[v] += offsets[v - 1];
+            }
+            sorted.resize(last - first + 1);
+            for (size_t i = first; i < last; i++)
+            {
+              sorted[offsets[static_cast<size_t>(m_VertIds[i]) - firstVert]++] = m_ElemIds[i];
+            }
+            // offsets[v] now holds the end of the list of vertex v
+            size_t listStart = 0;
+            for (size_t v = firstVert; v < lastVert; v++)
+            {
+              size_t listEnd = offsets[v - firstVert];
+              m_DynamicList->setElementList(v, static_cast<T>(listEnd - listStart), &(sorted[listStart]));
+              listStart = listEnd;
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          generate(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        const K* m_VertIds;
+        const K* m_ElemIds;
+        const size_t* m_BucketStarts;
+        size_t m_BucketWidth;
+        size_t m_NumVerts;
+        DynamicListArray<T, K>* m_DynamicList;
+    };
+
+    /**
+     * @brief The FindElementNeighborsImpl class finds the elements that share numSharedVerts vertices with each
+     * element of a range. Neighbors are stored in the order they are first encountered while walking the vertices
+     * of the element. Any pair of elements that share all of their vertices is flagged as an error.
+     */
+    template<typename T, typename K>
+    class FindElementNeighborsImpl
+    {
+      public:
+        FindElementNeighborsImpl(const K* elems, size_t numVertsPerElem, size_t numSharedVerts,
+                                 DynamicListArray<T, K>* elemsContainingVert, DynamicListArray<T, K>* dynamicList) :
+          m_Elems(elems),
+          m_NumVertsPerElem(numVertsPerElem),
+          m_NumSharedVerts(numSharedVerts),
+          m_ElemsContainingVert(elemsContainingVert),
+          m_DynamicList(dynamicList),
+          m_Error(0)
+        {}
+        virtual ~FindElementNeighborsImpl() {}
+
+        int getError() const { return m_Error; }
+
+        void generate(size_t start, size_t end)
+        {
+          for (size_t t = start; t < end; ++t)
+          {
+            const K* seedElem = m_Elems + t * m_NumVertsPerElem;
+            m_LoopNeighbors.clear();
+            for (size_t v = 0; v < m_NumVertsPerElem; ++v)
+            {
+              T nEs = m_ElemsContainingVert->getNumberOfElements(seedElem[v]);
+              K* vertIdxs = m_ElemsContainingVert->getElementListPointer(seedElem[v]);
+
+              for (T vt = 0; vt < nEs; ++vt)
+              {
+                if (vertIdxs[vt] == static_cast<K>(t) ) { continue; } // This is the same element as our "source"
+                if (std::find(m_LoopNeighbors.begin(), m_LoopNeighbors.end(), vertIdxs[vt]) != m_LoopNeighbors.end()) { continue; }
+                const K* vertCell = m_Elems + vertIdxs[vt] * m_NumVertsPerElem;
+                size_t vCount = 0;
+                for (size_t i = 0; i < m_NumVertsPerElem; i++)
+                {
+                  for (size_t j = 0; j < m_NumVertsPerElem; j++)
+                  {
+                    if (seedElem[i] == vertCell[j])
+                    {
+                      vCount++;
+                    }
+                  }
+                }
+
+                if (vCount >= m_NumVertsPerElem) // No way 2 elements can share all vertices. Something is VERY wrong at this point
+                {
+                  m_Error = -1;
+                  return;
+                }
+
+                if (vCount == m_NumSharedVerts)
+                {
+                  m_LoopNeighbors.push_back(vertIdxs[vt]);
+                }
+              }
+            }
+            m_DynamicList->setElementList(t, static_cast<T>(m_LoopNeighbors.size()), m_LoopNeighbors.empty() ? NULL : &(m_LoopNeighbors.front()));
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        FindElementNeighborsImpl(FindElementNeighborsImpl& other, tbb::split) :
+          m_Elems(other.m_Elems),
+          m_NumVertsPerElem(other.m_NumVertsPerElem),
+          m_NumSharedVerts(other.m_NumSharedVerts),
+          m_ElemsContainingVert(other.m_ElemsContainingVert),
+          m_DynamicList(other.m_DynamicList),
+          m_Error(0)
+        {}
+
+        void operator()(const tbb::blocked_range<size_t>& r)
+        {
+          if (m_Error < 0) { return; }
+          generate(r.begin(), r.end());
+        }
+
+        void join(const FindElementNeighborsImpl& rhs)
+        {
+          if (rhs.m_Error < m_Error) { m_Error = rhs.m_Error; }
+        }
+#endif
+
+      private:
+        const K* m_Elems;
+        size_t m_NumVertsPerElem;
+        size_t m_NumSharedVerts;
+        DynamicListArray<T, K>* m_ElemsContainingVert;
+        DynamicListArray<T, K>* m_DynamicList;
+        int m_Error;
+        std::vector<K> m_LoopNeighbors;
+    };
+
+    /**
+     * @brief The ExtractElementEdgesImpl class writes the edges of a range of 2D elements, each with its smaller
+     * vertex id first, into a flat array that holds numVertsPerElem edges per element.
+     */
+    template<typename T>
+    class ExtractElementEdgesImpl
+    {
+      public:
+        ExtractElementEdgesImpl(const T* elems, size_t numVertsPerElem, std::pair<T, T>* edges) :
+          m_Elems(elems),
+          m_NumVertsPerElem(numVertsPerElem),
+          m_Edges(edges)
+        {}
+        virtual ~ExtractElementEdgesImpl() {}
+
+        void generate(size_t start, size_t end) const
+        {
+          for (size_t i = start; i < end; i++)
+          {
+            const T* verts = m_Elems + i * m_NumVertsPerElem;
+            std::pair<T, T>* edges = m_Edges + i * m_NumVertsPerElem;
+            for (size_t j = 0; j < m_NumVertsPerElem; j++)
+            {
+              T a = verts[j];
+              T b = (j == (m_NumVertsPerElem - 1)) ? verts[0] : verts[j + 1];
+              if (a > b) { edges[j] = std::make_pair(b, a); }
+              else { edges[j] = std::make_pair(a, b); }
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          generate(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        const T* m_Elems;
+        size_t m_NumVertsPerElem;
+        std::pair<T, T>* m_Edges;
+    };
+  }
+
   /**
    * @brief The Connectivity class
    */
@@ -204,42 +508,72 @@ namespace GeometryHelpers
       {
         size_t numElems = elemList->getNumberOfTuples();
         size_t numVertsPerElem = elemList->getNumberOfComponents();
+        size_t numRefs = numElems * numVertsPerElem;
+
+        dynamicList->initializeLists(numVerts);
+        if (numVerts == 0) { return; }
+
+        // The links are built with a two level counting sort. The vertex references are first bucketed by ranges
+        // of vertex ids, block by block over the elements, and then each bucket is sorted by vertex on its own. Both
+        // steps are stable, so every list holds its elements in ascending order just like a serial walk would.
+        size_t numBlocks = numElems / 16384 + 1;
+        if (numBlocks > 256) { numBlocks = 256; }
+        size_t blockSize = numElems / numBlocks + 1;
+        size_t numBuckets = numVerts / 4096 + 1;
+        if (numBuckets > 1024) { numBuckets = 1024; }
+        size_t bucketWidth = (numVerts + numBuckets - 1) / numBuckets;
+        numBuckets = (numVerts + bucketWidth - 1) / bucketWidth;
+
+        std::vector<size_t> blockBuckets(numBlocks * numBuckets, 0);
+        std::vector<size_t> bucketStarts(numBuckets + 1, 0);
+        std::vector<K> vertIds(numRefs + 1);
+        std::vector<K> elemIds(numRefs + 1);
+        K* elems = elemList->getPointer(0);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        tbb::task_scheduler_init init;
+        bool doParallel = true;
+#endif
+
+        Detail::BucketVertexReferencesImpl<K> countImpl(elems, numElems, numVertsPerElem, blockSize, bucketWidth, numBuckets, &(blockBuckets.front()), NULL, NULL);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        if (doParallel == true)
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), countImpl, tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          countImpl.generate(0, numBlocks);
+        }
 
-        // Allocate the basic structures
-        QVector<T> linkCount(numVerts, 0);
-        size_t elemId = 0;
-        int64_t* linkLoc;
-
-        // Fill out lists with number of references to cells
-        typedef boost::shared_array<K> SharedArray_t;
-        SharedArray_t linkLocPtr(new K[numVerts]);
-        linkLoc = linkLocPtr.get();
-
-        ::memset(linkLoc, 0, numVerts * sizeof(K));
-
-        K* verts;
-
-        //vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
-        // Traverse data to determine number of uses of each point
-        for (elemId = 0; elemId < numElems; elemId++)
+        // Turn the counts into the offset each block starts writing at inside each bucket
+        size_t total = 0;
+        for (size_t bucket = 0; bucket < numBuckets; bucket++)
         {
-          verts = elemList->getTuplePointer(elemId);
-          for (size_t j = 0; j < numVertsPerElem; j++)
+          bucketStarts[bucket] = total;
+          for (size_t b = 0; b < numBlocks; b++)
           {
-            linkCount[verts[j]]++;
+            size_t count = blockBuckets[b * numBuckets + bucket];
+            blockBuckets[b * numBuckets + bucket] = total;
+            total += count;
           }
         }
+        bucketStarts[numBuckets] = total;
 
-        // Now allocate storage for the links
-        dynamicList->allocateLists(linkCount);
-
-        for (elemId = 0; elemId < numElems; elemId++)
+        Detail::BucketVertexReferencesImpl<K> scatterImpl(elems, numElems, numVertsPerElem, blockSize, bucketWidth, numBuckets, &(blockBuckets.front()), &(vertIds.front()), &(elemIds.front()));
+        Detail::FillVertexListsImpl<T, K> fillImpl(&(vertIds.front()), &(elemIds.front()), &(bucketStarts.front()), bucketWidth, numVerts, dynamicList.get());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        if (doParallel == true)
         {
-          verts = elemList->getTuplePointer(elemId);
-          for (size_t j = 0; j < numVertsPerElem; j++)
-          {
-            dynamicList->insertCellReference(verts[j], (linkLoc[verts[j]])++, elemId);
-          }
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), scatterImpl, tbb::auto_partitioner());
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numBuckets), fillImpl, tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          scatterImpl.generate(0, numBlocks);
+          fillImpl.generate(0, numBuckets);
         }
       }
 
@@ -258,7 +592,6 @@ namespace GeometryHelpers
         size_t numElems = elemList->getNumberOfTuples();
         size_t numVertsPerElem = elemList->getNumberOfComponents();
         size_t numSharedVerts = 0;
-        QVector<T> linkCount(numElems, 0);
         int err = 0;
 
         switch(numVertsPerElem)
@@ -283,78 +616,27 @@ namespace GeometryHelpers
             break;
         }
 
-        dynamicList->allocateLists(linkCount);
+        dynamicList->initializeLists(numElems);
 
-        // Allocate an array of bools that we use each iteration so that we don't put duplicates into the array
-        boost::shared_array<bool> visitedPtr(new bool[numElems]);
-        bool* visited = visitedPtr.get();
-        ::memset(visitedPtr.get(), 0, numElems);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        tbb::task_scheduler_init init;
+        bool doParallel = true;
+#endif
 
-        // Reuse this vector for each loop. Avoids re-allocating the memory each time through the loop
-        QVector<K> loop_neighbors(32, 0);
-
-        // Build up the element adjacency list now that we have the element links
-        for (size_t t = 0; t < numElems; ++t)
+        // Build up the element adjacency list now that we have the element links. Each element writes only its
+        // own list so the elements can be processed concurrently.
+        Detail::FindElementNeighborsImpl<T, K> neighborsImpl(elemList->getPointer(0), numVertsPerElem, numSharedVerts, elemsContainingVert.get(), dynamicList.get());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        if (doParallel == true)
         {
-          //   qDebug() << "Analyzing Cell " << t << "\n";
-          K* seedElem = elemList->getTuplePointer(t);
-          for (size_t v = 0; v < numVertsPerElem; ++v)
-          {
-            //   qDebug() << " vert " << v << "\n";
-            T nEs = elemsContainingVert->getNumberOfElements(seedElem[v]);
-            K* vertIdxs = elemsContainingVert->getElementListPointer(seedElem[v]);
-
-            for (T vt = 0; vt < nEs; ++vt)
-            {
-              if (vertIdxs[vt] == static_cast<K>(t) ) { continue; } // This is the same element as our "source"
-              if (visited[vertIdxs[vt]] == true) { continue; } // We already added this element so loop again
-              //      qDebug() << "   Comparing Element " << vertIdxs[vt] << "\n";
-              K* vertCell = elemList->getTuplePointer(vertIdxs[vt]);
-              size_t vCount = 0;
-              // Loop over all the vertex indices of this element and try to match numSharedVerts of them to the current loop element
-              // If there is numSharedVerts match then that element is a neighbor of the source. If there are more than numVertsPerElem
-              // matches then there is a real problem with the mesh and the program is going to return an error.
-              for (size_t i = 0; i < numVertsPerElem; i++)
-              {
-                for (size_t j = 0; j < numVertsPerElem; j++)
-                {
-                  if (seedElem[i] == vertCell[j])
-                  {
-                    vCount++;
-                  }
-                }
-              }
-
-              if (vCount >= numVertsPerElem) // No way 2 elements can share all vertices. Something is VERY wrong at this point
-              {
-                return -1;
-              }
-
-              // So if our vertex match count is numSharedVerts and we have not visited the element in question then add this element index
-              // into the list of vertex indices as neighbors for the source element.
-              if (vCount == numSharedVerts)
-              {
-                //qDebug() << "       Neighbor: " << vertIdxs[vt] << "\n";
-                // Use the current count of neighbors as the index
-                // into the loop_neighbors vector and place the value of the vertex element at that index
-                loop_neighbors[linkCount[t]] = vertIdxs[vt];
-                linkCount[t]++; // Increment the count for the next time through
-                if (linkCount[t] >= loop_neighbors.size())
-                {
-                  loop_neighbors.resize(loop_neighbors.size() + 10);
-                }
-                visited[vertIdxs[vt]] = true; // Set this element as visited so we do NOT add it again
-              }
-            }
-          }
-          // Reset all the visited cell indexs back to false (zero)
-          for(int64_t k = 0; k < linkCount[t]; ++k)
-          {
-            visited[loop_neighbors[k]] = false;
-          }
-          // Allocate the array storage for the current edge to hold its vertex list
-          dynamicList->setElementList(t, linkCount[t], &(loop_neighbors[0]));
+          tbb::parallel_reduce(tbb::blocked_range<size_t>(0, numElems), neighborsImpl, tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          neighborsImpl.generate(0, numElems);
         }
+        err = neighborsImpl.getError();
 
         return err;
       }
@@ -367,45 +649,19 @@ namespace GeometryHelpers
       template<typename T>
       static void Find2DElementEdges(typename DataArray<T>::Pointer elemList, typename DataArray<T>::Pointer edgeList)
       {
-        size_t numElems = elemList->getNumberOfTuples();
-        size_t numVertsPerElem = elemList->getNumberOfComponents();
-        T v0 = 0;
-        T v1 = 0;
+        std::vector<std::pair<T, T> > edges;
+        ExtractSorted2DEdges<T>(elemList, edges);
 
-        std::pair<T, T> edge;
-        std::set<std::pair<T, T> > edgeSet;
+        typename std::vector<std::pair<T, T> >::iterator last = std::unique(edges.begin(), edges.end());
+        edges.erase(last, edges.end());
 
-        for (size_t i = 0; i < numElems; i++)
-        {
-          T* verts = elemList->getTuplePointer(i);
-
-          for (size_t j = 0; j < numVertsPerElem; j++)
-          {
-            if (j == (numVertsPerElem - 1))
-            {
-              if (verts[j] > verts[0]) { v0 = verts[0]; v1 = verts[j]; }
-              else { v0 = verts[j]; v1 = verts[0]; }
-            }
-            else
-            {
-              if (verts[j] > verts[j + 1]) { v0 = verts[j + 1]; v1 = verts[j]; }
-              else { v0 = verts[j]; v1 = verts[j + 1]; }
-            }
-            edge = std::make_pair(v0, v1);
-            edgeSet.insert(edge);
-          }
-        }
-
-        typename std::set<std::pair<T, T> >::iterator setIter;
-        edgeList->resize(edgeSet.size());
+        edgeList->resize(edges.size());
         T* uEdges = edgeList->getPointer(0);
-        T index = 0;
 
-        for (setIter = edgeSet.begin(); setIter != edgeSet.end(); ++setIter)
+        for (size_t index = 0; index < edges.size(); ++index)
         {
-          uEdges[2 * index] = (*setIter).first;
-          uEdges[2 * index + 1] = (*setIter).second;
-          ++index;
+          uEdges[2 * index] = edges[index].first;
+          uEdges[2 * index + 1] = edges[index].second;
         }
       }
 
@@ -417,52 +673,65 @@ namespace GeometryHelpers
       template<typename T>
       static void Find2DUnsharedEdges(typename DataArray<T>::Pointer elemList, typename DataArray<T>::Pointer edgeList)
       {
-        size_t numElems = elemList->getNumberOfTuples();
-        size_t numVertsPerElem = elemList->getNumberOfComponents();
-        T v0 = 0;
-        T v1 = 0;
-
-        std::pair<T, T> edge;
-        std::map<std::pair<T, T>, T> edgeMap;
-
-        for (size_t i = 0; i < numElems; i++)
+        std::vector<std::pair<T, T> > edges;
+        ExtractSorted2DEdges<T>(elemList, edges);
+
+        // Equal edges are adjacent after the sort, so an edge is unshared when its run has a length of one
+        size_t numUnshared = 0;
+        size_t numEdges = edges.size();
+        size_t i = 0;
+        while (i < numEdges)
         {
-          T* verts = elemList->getTuplePointer(i);
-
-          for (size_t j = 0; j < numVertsPerElem; j++)
-          {
-            if (j == (numVertsPerElem - 1))
-            {
-              if (verts[j] > verts[0]) { v0 = verts[0]; v1 = verts[j]; }
-              else { v0 = verts[j]; v1 = verts[0]; }
-            }
-            else
-            {
-              if (verts[j] > verts[j + 1]) { v0 = verts[j + 1]; v1 = verts[j]; }
-              else { v0 = verts[j]; v1 = verts[j + 1]; }
-            }
-            edge = std::make_pair(v0, v1);
-            edgeMap[edge]++;
-          }
+          size_t j = i + 1;
+          while (j < numEdges && edges[j] == edges[i]) { ++j; }
+          if (j - i == 1) { edges[numUnshared++] = edges[i]; }
+          i = j;
         }
+        edges.resize(numUnshared);
 
-        typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
+        edgeList->resize(edges.size());
+        T* bEdges = edgeList->getPointer(0);
 
-        while (mapIter != edgeMap.end())
+        for (size_t index = 0; index < edges.size(); ++index)
         {
-          if ((*mapIter).second > 1) { edgeMap.erase(mapIter++); }
-          else { ++mapIter; }
+          bEdges[2 * index] = edges[index].first;
+          bEdges[2 * index + 1] = edges[index].second;
         }
+      }
 
-        edgeList->resize(edgeMap.size());
-        T* bEdges = edgeList->getPointer(0);
-        T index = 0;
+    protected:
+      /**
+       * @brief ExtractSorted2DEdges Collects every edge of every element, with the smaller vertex id first, and
+       * sorts them. Shared edges appear once per element that uses them.
+       * @param elemList
+       * @param edges
+       */
+      template<typename T>
+      static void ExtractSorted2DEdges(typename DataArray<T>::Pointer elemList, std::vector<std::pair<T, T> >& edges)
+      {
+        size_t numElems = elemList->getNumberOfTuples();
+        size_t numVertsPerElem = elemList->getNumberOfComponents();
+
+        edges.resize(numElems * numVertsPerElem);
+        if (edges.empty() == true) { return; }
 
-        for (mapIter = edgeMap.begin(); mapIter != edgeMap.end(); ++mapIter)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        tbb::task_scheduler_init init;
+        bool doParallel = true;
+#endif
+
+        Detail::ExtractElementEdgesImpl<T> edgesImpl(elemList->getPointer(0), numVertsPerElem, &(edges.front()));
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        if (doParallel == true)
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numElems), edgesImpl, tbb::auto_partitioner());
+          tbb::parallel_sort(edges.begin(), edges.end());
+        }
+        else
+#endif
         {
-          bEdges[2 * index] = (*mapIter).first.first;
-          bEdges[2 * index + 1] = (*mapIter).first.second;
-          ++index;
+          edgesImpl.generate(0, numElems);
+          std::sort(edges.begin(), edges.end());
         }
       }
   };
@@ -46,6 +46,10 @@ set(SIMPLib_Geometry_HDRS
   ${SIMPLib_SOURCE_DIR}/Geometry/MeshStructs.h
   ${SIMPLib_SOURCE_DIR}/Geometry/DerivativeHelpers.h
   ${SIMPLib_SOURCE_DIR}/Geometry/GeometryHelpers.hpp
+  ${SIMPLib_SOURCE_DIR}/Geometry/FeatureVoxelStatistics.h
+  ${SIMPLib_SOURCE_DIR}/Geometry/VoxelConnectivity.h
+  ${SIMPLib_SOURCE_DIR}/Geometry/VoxelMorphology.h
+  ${SIMPLib_SOURCE_DIR}/Geometry/VoxelFrontier.hpp
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/ShapeOps.h
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/CubeOctohedronOps.h
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/CylinderAOps.h
@@ -66,6 +70,9 @@ set(SIMPLib_Geometry_SRCS
   ${SIMPLib_SOURCE_DIR}/Geometry/TriangleGeom.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/QuadGeom.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/DerivativeHelpers.cpp
+  ${SIMPLib_SOURCE_DIR}/Geometry/FeatureVoxelStatistics.cpp
+  ${SIMPLib_SOURCE_DIR}/Geometry/VoxelConnectivity.cpp
+  ${SIMPLib_SOURCE_DIR}/Geometry/VoxelMorphology.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/ShapeOps.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/CubeOctohedronOps.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/CylinderAOps.cpp
@@ -0,0 +1,430 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "VoxelConnectivity.h"
+
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Geometry/VoxelFrontier.hpp"
+
+namespace Detail
+{
+  /**
+   * @brief The BoolMaskPredicate class selects the cells whose mask has a given value
+   */
+  class BoolMaskPredicate
+  {
+    public:
+      BoolMaskPredicate(const bool* mask, bool value) : m_Mask(mask), m_Value(value) {}
+      bool operator()(int64_t i) const { return m_Mask[i] == m_Value; }
+    private:
+      const bool* m_Mask;
+      bool m_Value;
+  };
+
+  /**
+   * @brief The FeatureIdPredicate class selects the cells that have a given feature id
+   */
+  class FeatureIdPredicate
+  {
+    public:
+      FeatureIdPredicate(const int32_t* featureIds, int32_t value) : m_FeatureIds(featureIds), m_Value(value) {}
+      bool operator()(int64_t i) const { return m_FeatureIds[i] == m_Value; }
+    private:
+      const int32_t* m_FeatureIds;
+      int32_t m_Value;
+  };
+
+  /**
+   * @brief FindRoot Returns the root of cell i, halving the path on the way. Every cell points
+   * to a cell with a lower or equal index, so the root is the lowest cell of the component.
+   */
+  inline int64_t FindRoot(int64_t* parent, int64_t i)
+  {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  }
+
+  /**
+   * @brief Unite Merges the components of cells a and b, keeping the lower root
+   */
+  inline void Unite(int64_t* parent, int64_t a, int64_t b)
+  {
+    a = FindRoot(parent, a);
+    b = FindRoot(parent, b);
+    if (a < b) { parent[b] = a; }
+    else if (b < a) { parent[a] = b; }
+  }
+
+  /**
+   * @brief The LabelSlabsImpl class runs the union-find over a range of slabs. Only links between
+   * cells of the same slab are followed, so the slabs can be processed concurrently.
+   */
+  template<typename Predicate>
+  class LabelSlabsImpl
+  {
+    public:
+      LabelSlabsImpl(const Predicate& predicate, int64_t* parent, const int64_t dims[3], int64_t cellsPerUnit, int64_t unitsPerSlab, int64_t numUnits) :
+        m_Predicate(predicate),
+        m_Parent(parent),
+        m_CellsPerUnit(cellsPerUnit),
+        m_UnitsPerSlab(unitsPerSlab),
+        m_NumUnits(numUnits)
+      {
+        m_Dims[0] = dims[0];
+        m_Dims[1] = dims[1];
+        m_Dims[2] = dims[2];
+      }
+      virtual ~LabelSlabsImpl() {}
+
+      void label(size_t start, size_t end) const
+      {
+        int64_t plane = m_Dims[0] * m_Dims[1];
+        for (size_t s = start; s < end; s++)
+        {
+          int64_t first = static_cast<int64_t>(s) * m_UnitsPerSlab * m_CellsPerUnit;
+          int64_t last = std::min(static_cast<int64_t>(s + 1) * m_UnitsPerSlab, m_NumUnits) * m_CellsPerUnit;
+          for (int64_t i = first; i < last; i++)
+          {
+            if (m_Predicate(i) == false)
+            {
+              m_Parent[i] = -1;
+              continue;
+            }
+            m_Parent[i] = i;
+            int64_t column = i % m_Dims[0];
+            int64_t row = (i / m_Dims[0]) % m_Dims[1];
+            // Slabs start on a row boundary, so the -x neighbor is always inside the slab
+            if (column > 0 && m_Parent[i - 1] >= 0) { Unite(m_Parent, i, i - 1); }
+            if (row > 0 && i - m_Dims[0] >= first && m_Parent[i - m_Dims[0]] >= 0) { Unite(m_Parent, i, i - m_Dims[0]); }
+            if (i - plane >= first && m_Parent[i - plane] >= 0) { Unite(m_Parent, i, i - plane); }
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        label(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      const Predicate& m_Predicate;
+      int64_t* m_Parent;
+      int64_t m_Dims[3];
+      int64_t m_CellsPerUnit;
+      int64_t m_UnitsPerSlab;
+      int64_t m_NumUnits;
+  };
+
+  /**
+   * @brief The DilationCells class supplies the rules of a dilation step to VoxelFrontier: the negative cells
+   * change and copy from the neighbor whose feature occurs most often among their neighbors
+   */
+  class DilationCells
+  {
+    public:
+      DilationCells(const int64_t dims[3], const int32_t* featureIds, int32_t minSourceId) :
+        m_FeatureIds(featureIds),
+        m_MinSourceId(minSourceId)
+      {
+        for (int32_t d = 0; d < 3; d++)
+        {
+          m_Dims[d] = dims[d];
+          m_DirOn[d] = true;
+        }
+      }
+      virtual ~DilationCells() {}
+
+      inline bool isCandidate(int64_t index) const
+      {
+        return m_FeatureIds[index] < 0;
+      }
+
+      inline int32_t getNeighbors(int64_t index, int64_t neighbors[6]) const
+      {
+        return VoxelFrontier::GetNeighbors(m_Dims, m_DirOn, index, neighbors);
+      }
+
+      inline int64_t findSource(int64_t index) const
+      {
+        int64_t neighbors[6];
+        int32_t num = getNeighbors(index, neighbors);
+        return VoxelFrontier::FindMajorityNeighbor(m_FeatureIds, m_MinSourceId, neighbors, num);
+      }
+
+    private:
+      int64_t m_Dims[3];
+      bool m_DirOn[3];
+      const int32_t* m_FeatureIds;
+      int32_t m_MinSourceId;
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VoxelConnectivity::VoxelConnectivity() :
+  m_NumComponents(0),
+  m_FeatureIds(NULL),
+  m_MinSourceId(0),
+  m_DilationStarted(false)
+{
+  m_Dims[0] = 0;
+  m_Dims[1] = 0;
+  m_Dims[2] = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VoxelConnectivity::~VoxelConnectivity()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename Predicate>
+int64_t VoxelConnectivity::label(const size_t dims[3], const Predicate& predicate)
+{
+  m_Dims[0] = static_cast<int64_t>(dims[0]);
+  m_Dims[1] = static_cast<int64_t>(dims[1]);
+  m_Dims[2] = static_cast<int64_t>(dims[2]);
+  int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+
+  m_Labels.resize(totalPoints);
+  m_ComponentSizes.clear();
+  m_NumComponents = 0;
+  if (totalPoints == 0) { return 0; }
+  int64_t* parent = &(m_Labels.front());
+
+  // Slabs are made of whole planes, or of whole rows when there is only one plane
+  int64_t cellsPerUnit = (m_Dims[2] > 1) ? m_Dims[0] * m_Dims[1] : m_Dims[0];
+  int64_t numUnits = totalPoints / cellsPerUnit;
+  int64_t numSlabs = 1;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  numSlabs = std::min(numUnits, static_cast<int64_t>(4 * tbb::task_scheduler_init::default_num_threads()));
+#endif
+  int64_t unitsPerSlab = (numUnits + numSlabs - 1) / numSlabs;
+  numSlabs = (numUnits + unitsPerSlab - 1) / unitsPerSlab;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                      Detail::LabelSlabsImpl<Predicate>(predicate, parent, m_Dims, cellsPerUnit, unitsPerSlab, numUnits), tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    Detail::LabelSlabsImpl<Predicate> serial(predicate, parent, m_Dims, cellsPerUnit, unitsPerSlab, numUnits);
+    serial.label(0, numSlabs);
+  }
+
+  // Merge the links that cross from the first unit of each slab into the last unit of the previous slab
+  for (int64_t s = 1; s < numSlabs; s++)
+  {
+    int64_t first = s * unitsPerSlab * cellsPerUnit;
+    for (int64_t i = first; i < first + cellsPerUnit; i++)
+    {
+      if (parent[i] >= 0 && parent[i - cellsPerUnit] >= 0) { Detail::Unite(parent, i, i - cellsPerUnit); }
+    }
+  }
+
+  // Every cell points at a lower cell, so a single pass in increasing order replaces the parent of each
+  // cell with the number of its component, numbering the components in the order of their lowest cell
+  for (int64_t i = 0; i < totalPoints; i++)
+  {
+    int64_t p = parent[i];
+    if (p < 0) { continue; }
+    if (p == i)
+    {
+      parent[i] = m_NumComponents;
+      m_ComponentSizes.push_back(1);
+      m_NumComponents++;
+    }
+    else
+    {
+      parent[i] = parent[p];
+      m_ComponentSizes[parent[i]]++;
+    }
+  }
+
+  return m_NumComponents;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t VoxelConnectivity::labelComponents(const size_t dims[3], const bool* mask, bool value)
+{
+  Detail::BoolMaskPredicate predicate(mask, value);
+  return label(dims, predicate);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t VoxelConnectivity::labelComponents(const size_t dims[3], const int32_t* featureIds, int32_t value)
+{
+  Detail::FeatureIdPredicate predicate(featureIds, value);
+  return label(dims, predicate);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t VoxelConnectivity::getNumberOfComponents() const
+{
+  return m_NumComponents;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int64_t>& VoxelConnectivity::getLabels() const
+{
+  return m_Labels;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int64_t>& VoxelConnectivity::getComponentSizes() const
+{
+  return m_ComponentSizes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<bool> VoxelConnectivity::findComponentsTouchingBoundary() const
+{
+  std::vector<bool> touches(m_NumComponents, false);
+  if (m_Labels.empty()) { return touches; }
+
+  for (int64_t k = 0; k < m_Dims[2]; k++)
+  {
+    for (int64_t j = 0; j < m_Dims[1]; j++)
+    {
+      int64_t rowStart = (k * m_Dims[1] + j) * m_Dims[0];
+      // Interior rows only have their two end cells on the surface
+      int64_t step = (k == 0 || k == m_Dims[2] - 1 || j == 0 || j == m_Dims[1] - 1) ? 1 : std::max(m_Dims[0] - 1, static_cast<int64_t>(1));
+      for (int64_t i = 0; i < m_Dims[0]; i += step)
+      {
+        int64_t label = m_Labels[rowStart + i];
+        if (label >= 0) { touches[label] = true; }
+      }
+    }
+  }
+  return touches;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelConnectivity::initializeDilation(const size_t dims[3], const int32_t* featureIds, int32_t minSourceId)
+{
+  m_Dims[0] = static_cast<int64_t>(dims[0]);
+  m_Dims[1] = static_cast<int64_t>(dims[1]);
+  m_Dims[2] = static_cast<int64_t>(dims[2]);
+  m_FeatureIds = featureIds;
+  m_MinSourceId = minSourceId;
+  m_DilationStarted = false;
+  m_Targets.clear();
+  m_Sources.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VoxelConnectivity::nextDilationStep()
+{
+  // Only the negative neighbors of the cells filled by the previous step can have gained a feature neighbor
+  Detail::DilationCells cells(m_Dims, m_FeatureIds, m_MinSourceId);
+  return VoxelFrontier::NextStep(cells, m_Dims[0] * m_Dims[1] * m_Dims[2], m_DilationStarted, m_Targets, m_Sources);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int64_t>& VoxelConnectivity::getDilationTargets() const
+{
+  return m_Targets;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int64_t>& VoxelConnectivity::getDilationSources() const
+{
+  return m_Sources;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelConnectivity::applyDilationStep(int32_t* featureIds) const
+{
+  for (size_t i = 0; i < m_Targets.size(); i++)
+  {
+    featureIds[m_Targets[i]] = featureIds[m_Sources[i]];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelConnectivity::applyDilationStep(const QList<IDataArray::Pointer>& arrays) const
+{
+  VoxelFrontier::CopyTuples(arrays, m_Targets, m_Sources);
+}
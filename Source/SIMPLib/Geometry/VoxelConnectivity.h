@@ -0,0 +1,177 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _VoxelConnectivity_H_
+#define _VoxelConnectivity_H_
+
+#include <vector>
+
+#include <QtCore/QList>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+/**
+ * @brief The VoxelConnectivity class implements the region operations that the cleanup filters
+ * perform on the 6-connected cells of an image geometry:
+ *
+ * @li Labeling the connected components of the cells that have a given mask or feature id value.
+ * The image is split into slabs of whole planes (or whole rows for a single plane image) that are
+ * labeled in parallel with a union-find, after which the links across the slab boundaries are merged.
+ * Components are numbered in the order of their lowest cell index, which is the order in which a
+ * raster scan would find them, so the labels do not depend on the number of threads.
+ *
+ * @li Dilating features into the cells that have a negative feature id. Each step assigns every
+ * negative cell that touches a valid feature to the neighbor whose feature occurs most often among
+ * its 6 neighbors (the first such neighbor in -z, -y, -x, +x, +y, +z order wins ties). Only the
+ * cells next to the cells filled in the previous step are examined, so the cost of a step scales
+ * with the size of the front instead of the size of the image.
+ */
+class SIMPLib_EXPORT VoxelConnectivity
+{
+  public:
+    SIMPL_SHARED_POINTERS(VoxelConnectivity)
+    SIMPL_STATIC_NEW_MACRO(VoxelConnectivity)
+    SIMPL_TYPE_MACRO(VoxelConnectivity)
+
+    virtual ~VoxelConnectivity();
+
+    /**
+     * @brief labelComponents Labels the connected components of the cells where mask equals value
+     * @param dims The dimensions of the image geometry
+     * @param mask The mask of each cell
+     * @param value The mask value of the cells to label
+     * @return The number of components
+     */
+    int64_t labelComponents(const size_t dims[3], const bool* mask, bool value);
+
+    /**
+     * @brief labelComponents Labels the connected components of the cells where featureIds equals value
+     * @param dims The dimensions of the image geometry
+     * @param featureIds The feature id of each cell
+     * @param value The feature id of the cells to label
+     * @return The number of components
+     */
+    int64_t labelComponents(const size_t dims[3], const int32_t* featureIds, int32_t value);
+
+    /**
+     * @brief getNumberOfComponents Returns the number of components found by the last call to labelComponents()
+     * @return
+     */
+    int64_t getNumberOfComponents() const;
+
+    /**
+     * @brief getLabels Returns the component of each cell, or -1 for the cells that were not labeled
+     * @return
+     */
+    const std::vector<int64_t>& getLabels() const;
+
+    /**
+     * @brief getComponentSizes Returns the number of cells in each component
+     * @return
+     */
+    const std::vector<int64_t>& getComponentSizes() const;
+
+    /**
+     * @brief findComponentsTouchingBoundary Returns for each component whether any of its cells
+     * lies on the outer surface of the image
+     * @return
+     */
+    std::vector<bool> findComponentsTouchingBoundary() const;
+
+    /**
+     * @brief initializeDilation Prepares a dilation of the features into the cells with a negative feature id
+     * @param dims The dimensions of the image geometry
+     * @param featureIds The feature id of each cell. The caller updates these between the steps
+     * @param minSourceId Cells with a feature id of at least this value are grown into the negative cells
+     */
+    void initializeDilation(const size_t dims[3], const int32_t* featureIds, int32_t minSourceId);
+
+    /**
+     * @brief nextDilationStep Finds the negative cells that are filled in the next step and the cell each
+     * one copies from. The caller must apply the step (see applyDilationStep()) before asking for the next one.
+     * @return The number of cells filled by the step. 0 means the dilation is finished.
+     */
+    size_t nextDilationStep();
+
+    /**
+     * @brief getDilationTargets Returns the cells filled by the current step in increasing order
+     * @return
+     */
+    const std::vector<int64_t>& getDilationTargets() const;
+
+    /**
+     * @brief getDilationSources Returns the cell each target of the current step copies from
+     * @return
+     */
+    const std::vector<int64_t>& getDilationSources() const;
+
+    /**
+     * @brief applyDilationStep Copies the feature id of each source of the current step onto its target
+     * @param featureIds
+     */
+    void applyDilationStep(int32_t* featureIds) const;
+
+    /**
+     * @brief applyDilationStep Copies the tuple of each source of the current step onto its target for every array
+     * @param arrays
+     */
+    void applyDilationStep(const QList<IDataArray::Pointer>& arrays) const;
+
+  protected:
+    VoxelConnectivity();
+
+    template<typename Predicate>
+    int64_t label(const size_t dims[3], const Predicate& predicate);
+
+  private:
+    int64_t m_Dims[3];
+    int64_t m_NumComponents;
+    std::vector<int64_t> m_Labels;
+    std::vector<int64_t> m_ComponentSizes;
+
+    const int32_t* m_FeatureIds;
+    int32_t m_MinSourceId;
+    bool m_DilationStarted;
+    std::vector<int64_t> m_Targets;
+    std::vector<int64_t> m_Sources;
+
+    VoxelConnectivity(const VoxelConnectivity&); // Copy Constructor Not Implemented
+    void operator=(const VoxelConnectivity&); // Operator '=' Not Implemented
+};
+
+#endif /* _VoxelConnectivity_H_ */
@@ -0,0 +1,420 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _VoxelFrontier_H_
+#define _VoxelFrontier_H_
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QList>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief This file contains a namespace with the frontier stepping shared by VoxelConnectivity and VoxelMorphology.
+ * A step finds the cells of an image geometry that change and the neighbor each one copies from (its source).
+ * The first step scans the whole image in parallel chunks; every later step only examines the neighbors of the
+ * cells changed by the previous step.
+ *
+ * The rules of a step are supplied by a Cells class with the following members:
+ * @li bool isCandidate(int64_t index) const - Returns true for the cells that may change
+ * @li int32_t getNeighbors(int64_t index, int64_t neighbors[6]) const - Fills the neighbors of a cell
+ * @li int64_t findSource(int64_t index) const - Returns the source of a candidate cell, or -1 if it does not change
+ */
+namespace VoxelFrontier
+{
+  // Number of cells (or front entries) handled by one parallel chunk of a step
+  static const int64_t k_ChunkSize = 16384;
+
+  /**
+   * @brief GetNeighbors Fills the 6-connected neighbors of cell index along the enabled directions in
+   * -z, -y, -x, +x, +y, +z order and returns how many there are
+   */
+  inline int32_t GetNeighbors(const int64_t dims[3], const bool dirOn[3], int64_t index, int64_t neighbors[6])
+  {
+    int64_t plane = dims[0] * dims[1];
+    int64_t column = index % dims[0];
+    int64_t row = (index / dims[0]) % dims[1];
+    int64_t slice = index / plane;
+    int32_t num = 0;
+    if (dirOn[2] && slice > 0) { neighbors[num++] = index - plane; }
+    if (dirOn[1] && row > 0) { neighbors[num++] = index - dims[0]; }
+    if (dirOn[0] && column > 0) { neighbors[num++] = index - 1; }
+    if (dirOn[0] && column < dims[0] - 1) { neighbors[num++] = index + 1; }
+    if (dirOn[1] && row < dims[1] - 1) { neighbors[num++] = index + dims[0]; }
+    if (dirOn[2] && slice < dims[2] - 1) { neighbors[num++] = index + plane; }
+    return num;
+  }
+
+  /**
+   * @brief FindMajorityNeighbor Returns the neighbor whose feature occurs most often among the neighbors with
+   * a feature id of at least minFeatureId, or -1 if there is no such neighbor. Among features that occur equally
+   * often, the one whose count reaches that number first in the neighbor order wins.
+   */
+  inline int64_t FindMajorityNeighbor(const int32_t* featureIds, int32_t minFeatureId, const int64_t neighbors[6], int32_t num)
+  {
+    int32_t features[6];
+    int32_t most = 0;
+    int64_t source = -1;
+    for (int32_t l = 0; l < num; l++)
+    {
+      features[l] = featureIds[neighbors[l]];
+      if (features[l] < minFeatureId) { continue; }
+      int32_t current = 0;
+      for (int32_t m = 0; m <= l; m++)
+      {
+        if (features[m] == features[l]) { current++; }
+      }
+      if (current > most)
+      {
+        most = current;
+        source = neighbors[l];
+      }
+    }
+    return source;
+  }
+
+  /**
+   * @brief The InitialFrontImpl class scans a range of cell chunks for the candidate cells that have a source
+   */
+  template<typename Cells>
+  class InitialFrontImpl
+  {
+    public:
+      InitialFrontImpl(const Cells& cells, int64_t totalPoints,
+                       std::vector<std::vector<int64_t> >& targets, std::vector<std::vector<int64_t> >& sources) :
+        m_Cells(cells),
+        m_TotalPoints(totalPoints),
+        m_Targets(targets),
+        m_Sources(sources)
+      {}
+      virtual ~InitialFrontImpl() {}
+
+      void find(size_t start, size_t end) const
+      {
+        for (size_t c = start; c < end; c++)
+        {
+          int64_t first = static_cast<int64_t>(c) * k_ChunkSize;
+          int64_t last = std::min(first + k_ChunkSize, m_TotalPoints);
+          for (int64_t i = first; i < last; i++)
+          {
+            if (m_Cells.isCandidate(i) == false) { continue; }
+            int64_t source = m_Cells.findSource(i);
+            if (source >= 0)
+            {
+              m_Targets[c].push_back(i);
+              m_Sources[c].push_back(source);
+            }
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        find(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      const Cells& m_Cells;
+      int64_t m_TotalPoints;
+      std::vector<std::vector<int64_t> >& m_Targets;
+      std::vector<std::vector<int64_t> >& m_Sources;
+  };
+
+  /**
+   * @brief The ExpandFrontImpl class collects the candidate neighbors of a range of chunks of the cells changed
+   * by the previous step
+   */
+  template<typename Cells>
+  class ExpandFrontImpl
+  {
+    public:
+      ExpandFrontImpl(const Cells& cells, const std::vector<int64_t>& previous, std::vector<std::vector<int64_t> >& candidates) :
+        m_Cells(cells),
+        m_Previous(previous),
+        m_Candidates(candidates)
+      {}
+      virtual ~ExpandFrontImpl() {}
+
+      void expand(size_t start, size_t end) const
+      {
+        int64_t neighbors[6];
+        int64_t numPrevious = static_cast<int64_t>(m_Previous.size());
+        for (size_t c = start; c < end; c++)
+        {
+          int64_t first = static_cast<int64_t>(c) * k_ChunkSize;
+          int64_t last = std::min(first + k_ChunkSize, numPrevious);
+          for (int64_t p = first; p < last; p++)
+          {
+            int32_t num = m_Cells.getNeighbors(m_Previous[p], neighbors);
+            for (int32_t l = 0; l < num; l++)
+            {
+              if (m_Cells.isCandidate(neighbors[l])) { m_Candidates[c].push_back(neighbors[l]); }
+            }
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        expand(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      const Cells& m_Cells;
+      const std::vector<int64_t>& m_Previous;
+      std::vector<std::vector<int64_t> >& m_Candidates;
+  };
+
+  /**
+   * @brief The FindSourcesImpl class finds the source of a range of candidate cells
+   */
+  template<typename Cells>
+  class FindSourcesImpl
+  {
+    public:
+      FindSourcesImpl(const Cells& cells, const std::vector<int64_t>& candidates, std::vector<int64_t>& sources) :
+        m_Cells(cells),
+        m_Candidates(candidates),
+        m_Sources(sources)
+      {}
+      virtual ~FindSourcesImpl() {}
+
+      void find(size_t start, size_t end) const
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          m_Sources[i] = m_Cells.findSource(m_Candidates[i]);
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        find(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      const Cells& m_Cells;
+      const std::vector<int64_t>& m_Candidates;
+      std::vector<int64_t>& m_Sources;
+  };
+
+  /**
+   * @brief The CopyTuplesImpl class copies the source tuple onto the target tuple of a range of assignments of
+   * one array. The targets are distinct and never used as sources in the same step, so the assignments are
+   * independent.
+   */
+  class CopyTuplesImpl
+  {
+    public:
+      CopyTuplesImpl(IDataArray* array, const std::vector<int64_t>& targets, const std::vector<int64_t>& sources) :
+        m_Array(array),
+        m_Targets(targets),
+        m_Sources(sources)
+      {}
+      virtual ~CopyTuplesImpl() {}
+
+      void copy(size_t start, size_t end) const
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          m_Array->copyTuple(static_cast<size_t>(m_Sources[i]), static_cast<size_t>(m_Targets[i]));
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        copy(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      IDataArray* m_Array;
+      const std::vector<int64_t>& m_Targets;
+      const std::vector<int64_t>& m_Sources;
+  };
+
+  /**
+   * @brief NextStep Replaces targets and sources with the cells changed by the next step and the cell each one
+   * copies from. Targets are returned in increasing order.
+   * @param cells The rules of the step
+   * @param totalPoints The number of cells in the image
+   * @param started False before the first step; set to true by the first step
+   * @param targets On input the targets of the previous step
+   * @param sources On input the sources of the previous step
+   * @return The number of cells changed by the step
+   */
+  template<typename Cells>
+  size_t NextStep(const Cells& cells, int64_t totalPoints, bool& started, std::vector<int64_t>& targets, std::vector<int64_t>& sources)
+  {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+#endif
+
+    if (started == false)
+    {
+      // The first front is every candidate cell that already has a source
+      started = true;
+      size_t numChunks = static_cast<size_t>((totalPoints + k_ChunkSize - 1) / k_ChunkSize);
+      std::vector<std::vector<int64_t> > chunkTargets(numChunks);
+      std::vector<std::vector<int64_t> > chunkSources(numChunks);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks),
+                          InitialFrontImpl<Cells>(cells, totalPoints, chunkTargets, chunkSources), tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        InitialFrontImpl<Cells> serial(cells, totalPoints, chunkTargets, chunkSources);
+        serial.find(0, numChunks);
+      }
+
+      targets.clear();
+      sources.clear();
+      for (size_t c = 0; c < numChunks; c++)
+      {
+        targets.insert(targets.end(), chunkTargets[c].begin(), chunkTargets[c].end());
+        sources.insert(sources.end(), chunkSources[c].begin(), chunkSources[c].end());
+      }
+      return targets.size();
+    }
+
+    if (targets.empty()) { return 0; }
+
+    // A cell can only gain a source if one of its neighbors changed in the previous step
+    size_t numChunks = static_cast<size_t>((static_cast<int64_t>(targets.size()) + k_ChunkSize - 1) / k_ChunkSize);
+    std::vector<std::vector<int64_t> > chunkCandidates(numChunks);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks),
+                        ExpandFrontImpl<Cells>(cells, targets, chunkCandidates), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      ExpandFrontImpl<Cells> serial(cells, targets, chunkCandidates);
+      serial.expand(0, numChunks);
+    }
+
+    std::vector<int64_t> candidates;
+    for (size_t c = 0; c < numChunks; c++)
+    {
+      candidates.insert(candidates.end(), chunkCandidates[c].begin(), chunkCandidates[c].end());
+    }
+    chunkCandidates.clear();
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<int64_t> candidateSources(candidates.size(), -1);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, candidates.size()),
+                        FindSourcesImpl<Cells>(cells, candidates, candidateSources), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      FindSourcesImpl<Cells> serial(cells, candidates, candidateSources);
+      serial.find(0, candidates.size());
+    }
+
+    targets.clear();
+    sources.clear();
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+      if (candidateSources[i] >= 0)
+      {
+        targets.push_back(candidates[i]);
+        sources.push_back(candidateSources[i]);
+      }
+    }
+    return targets.size();
+  }
+
+  /**
+   * @brief CopyTuples Copies the source tuple onto the target tuple of every assignment of a step for every
+   * array. Each array is updated for all the targets before moving on to the next array.
+   */
+  inline void CopyTuples(const QList<IDataArray::Pointer>& arrays, const std::vector<int64_t>& targets, const std::vector<int64_t>& sources)
+  {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+#endif
+
+    for (int32_t a = 0; a < arrays.size(); a++)
+    {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, targets.size()),
+                          CopyTuplesImpl(arrays[a].get(), targets, sources), tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        CopyTuplesImpl serial(arrays[a].get(), targets, sources);
+        serial.copy(0, targets.size());
+      }
+    }
+  }
+}
+
+#endif /* _VoxelFrontier_H_ */
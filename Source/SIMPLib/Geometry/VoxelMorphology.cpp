@@ -0,0 +1,225 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "VoxelMorphology.h"
+
+#include "SIMPLib/Geometry/VoxelFrontier.hpp"
+
+namespace Detail
+{
+  /**
+   * @brief The MorphologyCells class supplies the rules of a morphology step to VoxelFrontier: which cells may
+   * change, which neighbors are considered and which neighbor a changing cell copies from.
+   */
+  class MorphologyCells
+  {
+    public:
+      MorphologyCells(const int64_t dims[3], const bool dirOn[3], VoxelMorphology::Operation operation, const int32_t* featureIds, const bool* mask) :
+        m_Operation(operation),
+        m_FeatureIds(featureIds),
+        m_Mask(mask)
+      {
+        for (int32_t d = 0; d < 3; d++)
+        {
+          m_Dims[d] = dims[d];
+          m_DirOn[d] = dirOn[d];
+        }
+      }
+      virtual ~MorphologyCells() {}
+
+      inline bool inRegion(int64_t index) const
+      {
+        return (NULL != m_FeatureIds) ? (m_FeatureIds[index] == 0) : m_Mask[index];
+      }
+
+      /**
+       * @brief isCandidate Returns true for the cells on the side of the boundary that changes
+       */
+      inline bool isCandidate(int64_t index) const
+      {
+        if (m_Operation == VoxelMorphology::ShrinkRegion) { return inRegion(index); }
+        return (NULL != m_FeatureIds) ? (m_FeatureIds[index] > 0) : (m_Mask[index] == false);
+      }
+
+      inline int32_t getNeighbors(int64_t index, int64_t neighbors[6]) const
+      {
+        return VoxelFrontier::GetNeighbors(m_Dims, m_DirOn, index, neighbors);
+      }
+
+      /**
+       * @brief findSource Returns the neighbor that candidate cell index copies from, or -1 if the cell does
+       * not touch the other side of the boundary
+       */
+      inline int64_t findSource(int64_t index) const
+      {
+        int64_t neighbors[6];
+        int32_t num = getNeighbors(index, neighbors);
+        if (m_Operation == VoxelMorphology::ShrinkRegion && NULL != m_FeatureIds)
+        {
+          return VoxelFrontier::FindMajorityNeighbor(m_FeatureIds, 1, neighbors, num);
+        }
+        bool side = inRegion(index);
+        int64_t source = -1;
+        for (int32_t l = 0; l < num; l++)
+        {
+          if (inRegion(neighbors[l]) != side) { source = neighbors[l]; }
+        }
+        return source;
+      }
+
+    private:
+      int64_t m_Dims[3];
+      bool m_DirOn[3];
+      VoxelMorphology::Operation m_Operation;
+      const int32_t* m_FeatureIds;
+      const bool* m_Mask;
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VoxelMorphology::VoxelMorphology() :
+  m_Operation(GrowRegion),
+  m_FeatureIds(NULL),
+  m_Mask(NULL),
+  m_Started(false)
+{
+  for (int32_t d = 0; d < 3; d++)
+  {
+    m_Dims[d] = 0;
+    m_DirOn[d] = true;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VoxelMorphology::~VoxelMorphology()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelMorphology::initialize(const size_t dims[3], Operation operation, const bool dirOn[3])
+{
+  for (int32_t d = 0; d < 3; d++)
+  {
+    m_Dims[d] = static_cast<int64_t>(dims[d]);
+    m_DirOn[d] = dirOn[d];
+  }
+  m_Operation = operation;
+  m_Started = false;
+  m_Targets.clear();
+  m_Sources.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelMorphology::initialize(const size_t dims[3], const int32_t* featureIds, Operation operation, const bool dirOn[3])
+{
+  initialize(dims, operation, dirOn);
+  m_FeatureIds = featureIds;
+  m_Mask = NULL;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelMorphology::initialize(const size_t dims[3], const bool* mask, Operation operation, const bool dirOn[3])
+{
+  initialize(dims, operation, dirOn);
+  m_FeatureIds = NULL;
+  m_Mask = mask;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VoxelMorphology::nextStep()
+{
+  // A cell can only start touching the other side of the boundary if one of its neighbors changed in the previous step
+  Detail::MorphologyCells cells(m_Dims, m_DirOn, m_Operation, m_FeatureIds, m_Mask);
+  return VoxelFrontier::NextStep(cells, m_Dims[0] * m_Dims[1] * m_Dims[2], m_Started, m_Targets, m_Sources);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int64_t>& VoxelMorphology::getTargets() const
+{
+  return m_Targets;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int64_t>& VoxelMorphology::getSources() const
+{
+  return m_Sources;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelMorphology::applyStep(int32_t* featureIds) const
+{
+  for (size_t i = 0; i < m_Targets.size(); i++)
+  {
+    featureIds[m_Targets[i]] = featureIds[m_Sources[i]];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelMorphology::applyStep(bool* mask) const
+{
+  for (size_t i = 0; i < m_Targets.size(); i++)
+  {
+    mask[m_Targets[i]] = mask[m_Sources[i]];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelMorphology::applyStep(const QList<IDataArray::Pointer>& arrays) const
+{
+  VoxelFrontier::CopyTuples(arrays, m_Targets, m_Sources);
+}
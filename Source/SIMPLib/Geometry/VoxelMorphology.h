@@ -0,0 +1,156 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _VoxelMorphology_H_
+#define _VoxelMorphology_H_
+
+#include <vector>
+
+#include <QtCore/QList>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+/**
+ * @brief The VoxelMorphology class grows or shrinks a region of the 6-connected cells of an image geometry one
+ * layer per step, as done by the erode/dilate filters. The region is either the cells with a feature id of 0
+ * or the cells whose mask is true. Growing assigns every cell outside the region (for feature ids, every cell
+ * with a positive feature id) that touches the region to it; shrinking removes every region cell that touches
+ * a cell outside of it. Only the neighbors along the enabled directions are considered.
+ *
+ * Every changed cell (target) copies from one of its neighbors on the other side of the region boundary (source):
+ * @li When the region grows, the source is the last region neighbor in -z, -y, -x, +x, +y, +z order.
+ * @li When a feature id region shrinks, the source is the neighbor whose feature occurs most often among the
+ * neighbors (the first such neighbor in -z, -y, -x, +x, +y, +z order wins ties). When a mask region shrinks,
+ * the source is the last neighbor outside of the region.
+ *
+ * All targets of a step are found from the cells as they were before the step, and targets and sources are
+ * always on opposite sides of the boundary, so applying a step never reads a value written by the same step.
+ * The first step scans the whole image in parallel chunks; every later step only examines the neighbors of
+ * the cells changed by the previous step, so the cost of a step scales with the size of the front.
+ */
+class SIMPLib_EXPORT VoxelMorphology
+{
+  public:
+    SIMPL_SHARED_POINTERS(VoxelMorphology)
+    SIMPL_STATIC_NEW_MACRO(VoxelMorphology)
+    SIMPL_TYPE_MACRO(VoxelMorphology)
+
+    virtual ~VoxelMorphology();
+
+    enum Operation
+    {
+      GrowRegion = 0,
+      ShrinkRegion = 1
+    };
+
+    /**
+     * @brief initialize Prepares a morphology operation on the cells with a feature id of 0
+     * @param dims The dimensions of the image geometry
+     * @param featureIds The feature id of each cell. The caller updates these between the steps
+     * @param operation Whether the region grows or shrinks
+     * @param dirOn Whether the neighbors along x, y and z are considered
+     */
+    void initialize(const size_t dims[3], const int32_t* featureIds, Operation operation, const bool dirOn[3]);
+
+    /**
+     * @brief initialize Prepares a morphology operation on the cells whose mask is true
+     * @param dims The dimensions of the image geometry
+     * @param mask The mask of each cell. The caller updates these between the steps
+     * @param operation Whether the region grows or shrinks
+     * @param dirOn Whether the neighbors along x, y and z are considered
+     */
+    void initialize(const size_t dims[3], const bool* mask, Operation operation, const bool dirOn[3]);
+
+    /**
+     * @brief nextStep Finds the cells that change in the next step and the cell each one copies from. The
+     * caller must apply the step (see applyStep()) before asking for the next one.
+     * @return The number of cells changed by the step. 0 means the region cannot change any further.
+     */
+    size_t nextStep();
+
+    /**
+     * @brief getTargets Returns the cells changed by the current step in increasing order
+     * @return
+     */
+    const std::vector<int64_t>& getTargets() const;
+
+    /**
+     * @brief getSources Returns the cell each target of the current step copies from
+     * @return
+     */
+    const std::vector<int64_t>& getSources() const;
+
+    /**
+     * @brief applyStep Copies the feature id of each source of the current step onto its target
+     * @param featureIds
+     */
+    void applyStep(int32_t* featureIds) const;
+
+    /**
+     * @brief applyStep Copies the mask value of each source of the current step onto its target
+     * @param mask
+     */
+    void applyStep(bool* mask) const;
+
+    /**
+     * @brief applyStep Copies the tuple of each source of the current step onto its target for every array.
+     * Each array is updated for all the targets before moving on to the next array.
+     * @param arrays
+     */
+    void applyStep(const QList<IDataArray::Pointer>& arrays) const;
+
+  protected:
+    VoxelMorphology();
+
+    void initialize(const size_t dims[3], Operation operation, const bool dirOn[3]);
+
+  private:
+    int64_t m_Dims[3];
+    bool m_DirOn[3];
+    Operation m_Operation;
+    const int32_t* m_FeatureIds;
+    const bool* m_Mask;
+    bool m_Started;
+    std::vector<int64_t> m_Targets;
+    std::vector<int64_t> m_Sources;
+
+    VoxelMorphology(const VoxelMorphology&); // Copy Constructor Not Implemented
+    void operator=(const VoxelMorphology&); // Operator '=' Not Implemented
+};
+
+#endif /* _VoxelMorphology_H_ */
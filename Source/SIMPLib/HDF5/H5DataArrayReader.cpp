@@ -72,7 +72,9 @@ namespace Detail
   IDataArray::Pointer readH5Dataset(hid_t locId,
                                     const QString& datasetPath,
                                     const QVector<size_t>& tDims,
-                                    const QVector<size_t>& cDims)
+                                    const QVector<size_t>& cDims,
+                                    const QVector<hsize_t>& h5Start,
+                                    const QVector<hsize_t>& h5Count)
   {
     herr_t err = -1;
     IDataArray::Pointer ptr;
@@ -80,7 +82,14 @@ namespace Detail
     ptr = DataArray<T>::CreateArray(tDims, cDims, datasetPath);
 
     T* data = (T*)(ptr->getVoidPointer(0));
-    err = QH5Lite::readPointerDataset(locId, datasetPath, data);
+    if (h5Start.isEmpty() == true)
+    {
+      err = QH5Lite::readPointerDataset(locId, datasetPath, data);
+    }
+    else
+    {
+      err = QH5Lite::readPointerDatasetHyperslab(locId, datasetPath, h5Start, h5Count, data);
+    }
     if(err < 0)
     {
       qDebug() << "readH5Data read error: " << __FILE__ << "(" << __LINE__ << ")" ;
@@ -211,6 +220,15 @@ IDataArray::Pointer H5DataArrayReader::ReadStringDataArray(hid_t gid, const QStr
 //
 // -----------------------------------------------------------------------------
 IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString& name, bool metaDataOnly)
+{
+  return ReadIDataArraySubset(gid, name, QVector<size_t>(), QVector<size_t>(), metaDataOnly);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer H5DataArrayReader::ReadIDataArraySubset(hid_t gid, const QString& name, const QVector<size_t>& tupleStart,
+                                                            const QVector<size_t>& tupleCount, bool metaDataOnly)
 {
 
   herr_t err = -1;
@@ -248,13 +266,43 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
       return ptr;
     }
 
+    // A subset of the tuples is read as a hyperslab of the dataset. HDF5 keeps the tuple and component
+    // dimensions from slowest to fastest, which is the reverse of the order of tDims and cDims.
+    QVector<hsize_t> h5Start;
+    QVector<hsize_t> h5Count;
+    if (tupleStart.isEmpty() == false)
+    {
+      if (tupleStart.size() != tDims.size() || tupleCount.size() != tDims.size())
+      {
+        qDebug() << "The tuple subset does not match the Tuple Dimensions of Array with Name: " << name;
+        err = H5Tclose(typeId);
+        return ptr;
+      }
+      for (qint32 i = tDims.size() - 1; i >= 0; i--)
+      {
+        if (tupleCount[i] == 0 || tupleStart[i] + tupleCount[i] > tDims[i])
+        {
+          qDebug() << "The tuple subset lies outside of the Tuple Dimensions of Array with Name: " << name;
+          err = H5Tclose(typeId);
+          return ptr;
+        }
+        h5Start.push_back(tupleStart[i]);
+        h5Count.push_back(tupleCount[i]);
+      }
+      for (qint32 i = cDims.size() - 1; i >= 0; i--)
+      {
+        h5Start.push_back(0);
+        h5Count.push_back(cDims[i]);
+      }
+      tDims = tupleCount;
+    }
 
     // Check to see if we are reading a bool array and if so read it and return
     if (classType.compare("DataArray<bool>") == 0)
     {
       if (metaDataOnly == false)
       {
-        ptr = Detail::readH5Dataset<bool>(gid, name, tDims, cDims);
+        ptr = Detail::readH5Dataset<bool>(gid, name, tDims, cDims, h5Start, h5Count);
       }
       else
       {
@@ -281,7 +329,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<uint8_t>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<uint8_t>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -292,7 +340,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<uint16_t>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<uint16_t>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -303,7 +351,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<uint32_t>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<uint32_t>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -314,7 +362,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<uint64_t>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<uint64_t>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -325,7 +373,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<int8_t>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<int8_t>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -336,7 +384,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<int16_t>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<int16_t>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -347,7 +395,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<int32_t>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<int32_t>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -358,7 +406,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<int64_t>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<int64_t>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -376,7 +424,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<float>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<float>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -387,7 +435,7 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
         {
           if (metaDataOnly == false)
           {
-            ptr = Detail::readH5Dataset<double>(gid, name, tDims, cDims);
+            ptr = Detail::readH5Dataset<double>(gid, name, tDims, cDims, h5Start, h5Count);
           }
           else
           {
@@ -77,6 +77,20 @@ class SIMPLib_EXPORT H5DataArrayReader
      */
     static IDataArray::Pointer ReadIDataArray(hid_t gid, const QString& name, bool metaDataOnly = false);
 
+    /**
+     * @brief ReadIDataArraySubset Reads a block of the tuples of an IDataArray subclass from the HDF5 file. Only the
+     * selected block is read from the file (as an HDF5 hyperslab) and the returned array has the tuple dimensions of
+     * the block.
+     * @param gid The HDF5 Group to read the data array from
+     * @param name The name of the data set
+     * @param tupleStart The first tuple of the block along each tuple dimension
+     * @param tupleCount The number of tuples of the block along each tuple dimension
+     * @param metaDataOnly Read just the meta data about the DataArray or actually read all the data
+     * @return The array or a NULL pointer if the block does not fit inside the tuple dimensions of the data set
+     */
+    static IDataArray::Pointer ReadIDataArraySubset(hid_t gid, const QString& name, const QVector<size_t>& tupleStart,
+                                                    const QVector<size_t>& tupleCount, bool metaDataOnly = false);
+
     /**
      * @brief ReadNeighborListData
      * @param gid The HDF5 Group to read the data array from
@@ -0,0 +1,234 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/AttributeMatrixResampler.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "DREAM3DTestFileLocations.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+void AddRandomArray(AttributeMatrix::Pointer attrMat, const QString& name, size_t numComp)
+{
+  QVector<size_t> cDims(1, numComp);
+  typename DataArray<T>::Pointer data = DataArray<T>::CreateArray(attrMat->getNumTuples(), cDims, name);
+  T* ptr = data->getPointer(0);
+  for (size_t i = 0; i < data->getSize(); i++)
+  {
+    ptr[i] = static_cast<T>(rand() % 251 - 20);
+  }
+  attrMat->addAttributeArray(name, data);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AttributeMatrix::Pointer CreateSourceMatrix()
+{
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = 40;
+  tDims[1] = 30;
+  tDims[2] = 20;
+  AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, "CellData", DREAM3D::AttributeMatrixType::Cell);
+
+  srand(1234);
+  AddRandomArray<int8_t>(attrMat, "Int8", 1);
+  AddRandomArray<uint8_t>(attrMat, "RGBA", 4);
+  AddRandomArray<int16_t>(attrMat, "Int16", 1);
+  AddRandomArray<uint16_t>(attrMat, "UInt16", 2);
+  AddRandomArray<int32_t>(attrMat, "FeatureIds", 1);
+  AddRandomArray<uint32_t>(attrMat, "UInt32", 1);
+  AddRandomArray<int64_t>(attrMat, "Int64", 1);
+  AddRandomArray<uint64_t>(attrMat, "UInt64", 3);
+  AddRandomArray<float>(attrMat, "Quats", 4);
+  AddRandomArray<double>(attrMat, "Double", 1);
+
+  BoolArrayType::Pointer mask = BoolArrayType::CreateArray(attrMat->getNumTuples(), "Mask");
+  for (size_t i = 0; i < mask->getNumberOfTuples(); i++)
+  {
+    mask->setValue(i, (rand() % 3) == 0);
+  }
+  attrMat->addAttributeArray(mask->getName(), mask);
+  return attrMat;
+}
+
+// -----------------------------------------------------------------------------
+//  This is the copy loop that ChangeResolution, WarpRegularGrid, RotateSampleRefFrame
+//  and CropImageGeometry each used to run on every array of the cell AttributeMatrix
+// -----------------------------------------------------------------------------
+IDataArray::Pointer CopyTuples(IDataArray::Pointer p, const std::vector<int64_t>& newindicies)
+{
+  size_t newNumCellTuples = newindicies.size();
+  IDataArray::Pointer data = p->createNewArray(newNumCellTuples, p->getComponentDimensions(), p->getName());
+  void* source = NULL;
+  void* destination = NULL;
+  int64_t newIndicies_I = 0;
+  int32_t nComp = data->getNumberOfComponents();
+  for (size_t i = 0; i < newNumCellTuples; i++)
+  {
+    newIndicies_I = newindicies[i];
+    if(newIndicies_I >= 0)
+    {
+      source = p->getVoidPointer((nComp * newIndicies_I));
+      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
+      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
+    }
+    else
+    {
+      data->initializeTuple(i, 0);
+    }
+  }
+  return data;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CompareWithCopyLoop(AttributeMatrix::Pointer source, QVector<size_t> tDims, const std::vector<int64_t>& newIndices)
+{
+  AttributeMatrix::Pointer resampled = AttributeMatrixResampler::Resample(source, tDims, &(newIndices.front()));
+  DREAM3D_REQUIRE_VALID_POINTER(resampled.get())
+  DREAM3D_REQUIRE_EQUAL(resampled->getNumTuples(), newIndices.size())
+  DREAM3D_REQUIRE(resampled->getName() == source->getName())
+  DREAM3D_REQUIRE_EQUAL(resampled->getType(), source->getType())
+
+  QList<QString> arrayNames = source->getAttributeArrayNames();
+  DREAM3D_REQUIRE_EQUAL(resampled->getAttributeArrayNames().size(), arrayNames.size())
+  for (QList<QString>::iterator iter = arrayNames.begin(); iter != arrayNames.end(); ++iter)
+  {
+    IDataArray::Pointer expected = CopyTuples(source->getAttributeArray(*iter), newIndices);
+    IDataArray::Pointer data = resampled->getAttributeArray(*iter);
+    DREAM3D_REQUIRE_VALID_POINTER(data.get())
+    DREAM3D_REQUIRE(data->getTypeAsString() == expected->getTypeAsString())
+    DREAM3D_REQUIRE_EQUAL(data->getNumberOfTuples(), expected->getNumberOfTuples())
+    DREAM3D_REQUIRE_EQUAL(data->getNumberOfComponents(), expected->getNumberOfComponents())
+    size_t numBytes = expected->getSize() * expected->getTypeSize();
+    DREAM3D_REQUIRE_EQUAL(::memcmp(data->getVoidPointer(0), expected->getVoidPointer(0), numBytes), 0)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Coarsens the volume by a factor of two, like ChangeResolution does
+// -----------------------------------------------------------------------------
+void TestChangeResolutionMap()
+{
+  AttributeMatrix::Pointer source = CreateSourceMatrix();
+  QVector<size_t> srcDims = source->getTupleDimensions();
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = srcDims[0] / 2;
+  tDims[1] = srcDims[1] / 2;
+  tDims[2] = srcDims[2] / 2;
+
+  std::vector<int64_t> newIndices(tDims[0] * tDims[1] * tDims[2]);
+  for (size_t z = 0; z < tDims[2]; z++)
+  {
+    for (size_t y = 0; y < tDims[1]; y++)
+    {
+      for (size_t x = 0; x < tDims[0]; x++)
+      {
+        newIndices[(z * tDims[1] + y) * tDims[0] + x] = static_cast<int64_t>((2 * z * srcDims[1] + 2 * y) * srcDims[0] + 2 * x);
+      }
+    }
+  }
+  CompareWithCopyLoop(source, tDims, newIndices);
+}
+
+// -----------------------------------------------------------------------------
+//  Random map with cells outside of the source volume, like RotateSampleRefFrame
+//  and WarpRegularGrid produce. The destination spans several gather blocks.
+// -----------------------------------------------------------------------------
+void TestRandomMap()
+{
+  AttributeMatrix::Pointer source = CreateSourceMatrix();
+  int64_t numSourceTuples = static_cast<int64_t>(source->getNumTuples());
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = 50;
+  tDims[1] = 20;
+  tDims[2] = 30;
+
+  std::vector<int64_t> newIndices(tDims[0] * tDims[1] * tDims[2]);
+  srand(42);
+  for (size_t i = 0; i < newIndices.size(); i++)
+  {
+    newIndices[i] = (rand() % 5 == 0) ? -1 : static_cast<int64_t>(rand()) % numSourceTuples;
+  }
+  CompareWithCopyLoop(source, tDims, newIndices);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestInvalidMaps()
+{
+  AttributeMatrix::Pointer source = CreateSourceMatrix();
+  QVector<size_t> tDims(1, 10);
+  std::vector<int64_t> newIndices(10, 0);
+  newIndices[7] = static_cast<int64_t>(source->getNumTuples());
+  AttributeMatrix::Pointer resampled = AttributeMatrixResampler::Resample(source, tDims, &(newIndices.front()));
+  DREAM3D_REQUIRE_NULL_POINTER(resampled.get())
+
+  // The destination arrays must match their source arrays
+  QVector<IDataArray::Pointer> sources(1, source->getAttributeArray("Quats"));
+  QVector<IDataArray::Pointer> destinations(1, FloatArrayType::CreateArray(10, QVector<size_t>(1, 3), "Quats"));
+  newIndices[7] = 0;
+  DREAM3D_REQUIRE_EQUAL(AttributeMatrixResampler::GatherArrays(sources, destinations, &(newIndices.front()), 10), false)
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestChangeResolutionMap() )
+  DREAM3D_REGISTER_TEST( TestRandomMap() )
+  DREAM3D_REGISTER_TEST( TestInvalidMaps() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -117,6 +117,11 @@ namespace DataContainerIOTest
     return TestDir() + QString::fromLatin1("/DataContainerIOTest_Subset.h5");
   }
 
+  QString TestFile4()
+  {
+    return TestDir() + QString::fromLatin1("/DataContainerIOTest_SubVolume.h5");
+  }
+
   QString IniFile()
   {
     return TestDir() + QString::fromLatin1("/DataContainerProxyTest.ini");
@@ -137,6 +142,7 @@ void RemoveTestFiles()
   QFile::remove(DataContainerIOTest::TestFile());
   QFile::remove(DataContainerIOTest::TestFile2());
   QFile::remove(DataContainerIOTest::TestFile3());
+  QFile::remove(DataContainerIOTest::TestFile4());
   QFile::remove(DataContainerIOTest::IniFile());
   QFile::remove(DataContainerIOTest::H5File());
 
@@ -468,6 +474,134 @@ void TestDataContainerReader()
   DREAM3D_REQUIRE_EQUAL(err, 0);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestDataContainerReaderSubVolume()
+{
+  size_t dims[3] = { 7, 6, 5 };
+  float origin[3] = { 1.0f, 2.0f, 3.0f };
+  float res[3] = { 0.5f, 0.25f, 2.0f };
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DREAM3D::Defaults::ImageDataContainerName);
+  dca->addDataContainer(m);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setOrigin(origin);
+  image->setResolution(res);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, getCellAttributeMatrixName(), DREAM3D::AttributeMatrixType::Cell);
+  m->addAttributeMatrix(getCellAttributeMatrixName(), cellAttrMat);
+
+  QVector<size_t> cDims(1, 3);
+  Int32ArrayType::Pointer indices = Int32ArrayType::CreateArray(totalPoints, cDims, "Indices");
+  BoolArrayType::Pointer odd = BoolArrayType::CreateArray(totalPoints, DREAM3D::CellData::BoundaryCells);
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    for (int32_t c = 0; c < 3; c++)
+    {
+      indices->setComponent(i, c, static_cast<int32_t>(i * 3 + c));
+    }
+    odd->setValue(i, (i % 2) == 1);
+  }
+  cellAttrMat->addAttributeArray(indices->getName(), indices);
+  cellAttrMat->addAttributeArray(odd->getName(), odd);
+
+  tDims.resize(1);
+  tDims[0] = 4;
+  AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, getCellFeatureAttributeMatrixName(), DREAM3D::AttributeMatrixType::CellFeature);
+  m->addAttributeMatrix(getCellFeatureAttributeMatrixName(), featureAttrMat);
+  FloatArrayType::Pointer volumes = FloatArrayType::CreateArray(4, DREAM3D::FeatureData::Volumes);
+  for (int32_t i = 0; i < 4; i++)
+  {
+    volumes->setValue(i, i + 0.5f);
+  }
+  featureAttrMat->addAttributeArray(volumes->getName(), volumes);
+
+  DataContainerWriter::Pointer writer = DataContainerWriter::New();
+  writer->setDataContainerArray(dca);
+  writer->setOutputFile(DataContainerIOTest::TestFile4());
+  writer->execute();
+  DREAM3D_REQUIRE_EQUAL(writer->getErrorCondition(), 0);
+
+  IntVec3_t subMin = { 1, 2, 1 };
+  IntVec3_t subMax = { 4, 4, 3 };
+
+  DataContainerArray::Pointer dca2 = DataContainerArray::New();
+  DataContainerReader::Pointer reader = DataContainerReader::New();
+  reader->setInputFile(DataContainerIOTest::TestFile4());
+  reader->setDataContainerArray(dca2);
+  reader->setInputFileDataContainerArrayProxy(reader->readDataContainerArrayStructure(DataContainerIOTest::TestFile4()));
+  reader->setReadSubVolume(true);
+  reader->setSubVolumeMin(subMin);
+  reader->setSubVolumeMax(subMax);
+  reader->execute();
+  DREAM3D_REQUIRE(reader->getErrorCondition() >= 0)
+
+  DataContainer::Pointer m2 = dca2->getDataContainer(DREAM3D::Defaults::ImageDataContainerName);
+  DREAM3D_REQUIRE_VALID_POINTER(m2.get())
+  ImageGeom::Pointer image2 = m2->getGeometryAs<ImageGeom>();
+  DREAM3D_REQUIRE_VALID_POINTER(image2.get())
+  size_t dims2[3] = { 0, 0, 0 };
+  float origin2[3] = { 0.0f, 0.0f, 0.0f };
+  image2->getDimensions(dims2);
+  image2->getOrigin(origin2);
+  DREAM3D_REQUIRE_EQUAL(dims2[0], 4)
+  DREAM3D_REQUIRE_EQUAL(dims2[1], 3)
+  DREAM3D_REQUIRE_EQUAL(dims2[2], 3)
+  DREAM3D_REQUIRE_EQUAL(origin2[0], 1.5f)
+  DREAM3D_REQUIRE_EQUAL(origin2[1], 2.5f)
+  DREAM3D_REQUIRE_EQUAL(origin2[2], 5.0f)
+
+  AttributeMatrix::Pointer cellAttrMat2 = m2->getAttributeMatrix(getCellAttributeMatrixName());
+  DREAM3D_REQUIRE_VALID_POINTER(cellAttrMat2.get())
+  DREAM3D_REQUIRE_EQUAL(cellAttrMat2->getNumTuples(), 36)
+  Int32ArrayType::Pointer indices2 = boost::dynamic_pointer_cast<Int32ArrayType>(cellAttrMat2->getAttributeArray("Indices"));
+  BoolArrayType::Pointer odd2 = boost::dynamic_pointer_cast<BoolArrayType>(cellAttrMat2->getAttributeArray(DREAM3D::CellData::BoundaryCells));
+  DREAM3D_REQUIRE_VALID_POINTER(indices2.get())
+  DREAM3D_REQUIRE_VALID_POINTER(odd2.get())
+  DREAM3D_REQUIRE_EQUAL(indices2->getNumberOfTuples(), 36)
+  DREAM3D_REQUIRE_EQUAL(indices2->getNumberOfComponents(), 3)
+
+  size_t index = 0;
+  for (size_t z = 0; z < dims2[2]; z++)
+  {
+    for (size_t y = 0; y < dims2[1]; y++)
+    {
+      for (size_t x = 0; x < dims2[0]; x++)
+      {
+        size_t source = ((z + subMin.z) * dims[1] + (y + subMin.y)) * dims[0] + (x + subMin.x);
+        for (int32_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(indices2->getComponent(index, c), static_cast<int32_t>(source * 3 + c))
+        }
+        DREAM3D_REQUIRE_EQUAL(odd2->getValue(index), (source % 2) == 1)
+        index++;
+      }
+    }
+  }
+
+  // Feature data is not part of the sub volume and is read in full
+  AttributeMatrix::Pointer featureAttrMat2 = m2->getAttributeMatrix(getCellFeatureAttributeMatrixName());
+  DREAM3D_REQUIRE_VALID_POINTER(featureAttrMat2.get())
+  DREAM3D_REQUIRE_EQUAL(featureAttrMat2->getNumTuples(), 4)
+
+  // A sub volume that does not fit inside the geometry is an error
+  subMax.z = 5;
+  DataContainerArray::Pointer dca3 = DataContainerArray::New();
+  reader->setDataContainerArray(dca3);
+  reader->setSubVolumeMax(subMax);
+  reader->execute();
+  DREAM3D_REQUIRE(reader->getErrorCondition() < 0)
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -920,6 +1054,7 @@ int main(int argc, char** argv)
   DREAM3D_REGISTER_TEST( TestDataContainerArrayProxy() )
 
   DREAM3D_REGISTER_TEST( TestDataContainerReader() )
+  DREAM3D_REGISTER_TEST( TestDataContainerReaderSubVolume() )
   DREAM3D_REGISTER_TEST(TestDataArrayPath() )
 
 #if REMOVE_TEST_FILES
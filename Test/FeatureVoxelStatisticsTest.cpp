@@ -0,0 +1,252 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/FeatureVoxelStatistics.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "DREAM3DTestFileLocations.h"
+
+/**
+ * @brief The BruteForceStats struct holds the per-feature quantities computed with a
+ * straight loop over the cells, the way the statistics filters used to compute them.
+ */
+struct BruteForceStats
+{
+  std::vector<int64_t> counts;
+  std::vector<double> centroids;  // N x 3
+  std::vector<double> moments;    // N x 6
+  std::vector<int64_t> minIndex;  // N x 3
+  std::vector<int64_t> maxIndex;  // N x 3
+};
+
+// -----------------------------------------------------------------------------
+//  Fills the feature ids with random blobs. A few cells are given ids outside of
+//  [0, numFeatures) which the engine must skip.
+// -----------------------------------------------------------------------------
+std::vector<int32_t> CreateFeatureIds(const size_t dims[3], int32_t numFeatures, unsigned int seed)
+{
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  std::vector<int32_t> featureIds(totalPoints, 0);
+  srand(seed);
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    int r = rand() % 100;
+    if (r == 0) { featureIds[i] = -1; }
+    else if (r == 1) { featureIds[i] = numFeatures; }
+    // Runs of equal ids make the features span several cells and rows
+    else if (r < 60 && i > 0) { featureIds[i] = featureIds[i - 1] < 0 || featureIds[i - 1] >= numFeatures ? 1 : featureIds[i - 1]; }
+    else { featureIds[i] = rand() % numFeatures; }
+  }
+  return featureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BruteForceStats ComputeBruteForce(const size_t dims[3], const float res[3], const std::vector<int32_t>& featureIds, int32_t numFeatures)
+{
+  BruteForceStats stats;
+  stats.counts.assign(numFeatures, 0);
+  stats.centroids.assign(numFeatures * 3, 0.0);
+  stats.moments.assign(numFeatures * 6, 0.0);
+  stats.minIndex.assign(numFeatures * 3, std::numeric_limits<int64_t>::max());
+  stats.maxIndex.assign(numFeatures * 3, std::numeric_limits<int64_t>::min());
+
+  for (size_t z = 0; z < dims[2]; z++)
+  {
+    for (size_t y = 0; y < dims[1]; y++)
+    {
+      for (size_t x = 0; x < dims[0]; x++)
+      {
+        int32_t feature = featureIds[(z * dims[1] + y) * dims[0] + x];
+        if (feature < 0 || feature >= numFeatures) { continue; }
+        int64_t index[3] = { static_cast<int64_t>(x), static_cast<int64_t>(y), static_cast<int64_t>(z) };
+        stats.counts[feature]++;
+        for (int d = 0; d < 3; d++)
+        {
+          stats.centroids[feature * 3 + d] += index[d] * res[d];
+          stats.minIndex[feature * 3 + d] = std::min(stats.minIndex[feature * 3 + d], index[d]);
+          stats.maxIndex[feature * 3 + d] = std::max(stats.maxIndex[feature * 3 + d], index[d]);
+        }
+      }
+    }
+  }
+  for (int32_t i = 0; i < numFeatures; i++)
+  {
+    for (int d = 0; d < 3; d++)
+    {
+      stats.centroids[i * 3 + d] /= static_cast<double>(stats.counts[i]);
+    }
+  }
+
+  for (size_t z = 0; z < dims[2]; z++)
+  {
+    for (size_t y = 0; y < dims[1]; y++)
+    {
+      for (size_t x = 0; x < dims[0]; x++)
+      {
+        int32_t feature = featureIds[(z * dims[1] + y) * dims[0] + x];
+        if (feature < 0 || feature >= numFeatures) { continue; }
+        double dx = x * res[0] - stats.centroids[feature * 3];
+        double dy = y * res[1] - stats.centroids[feature * 3 + 1];
+        double dz = z * res[2] - stats.centroids[feature * 3 + 2];
+        double* m = &(stats.moments[feature * 6]);
+        m[0] += dx * dx;
+        m[1] += dy * dy;
+        m[2] += dz * dz;
+        m[3] += dx * dy;
+        m[4] += dy * dz;
+        m[5] += dx * dz;
+      }
+    }
+  }
+  return stats;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CompareWithBruteForce(size_t xDim, size_t yDim, size_t zDim, int32_t numFeatures)
+{
+  size_t dims[3] = { xDim, yDim, zDim };
+  float res[3] = { 0.5f, 0.25f, 2.0f };
+  std::vector<int32_t> featureIds = CreateFeatureIds(dims, numFeatures, static_cast<unsigned int>(xDim * yDim * zDim));
+  BruteForceStats expected = ComputeBruteForce(dims, res, featureIds, numFeatures);
+
+  FeatureVoxelStatistics::Pointer stats = FeatureVoxelStatistics::New();
+  stats->compute(dims, &(featureIds.front()), numFeatures);
+  DREAM3D_REQUIRE_EQUAL(stats->getNumberOfFeatures(), static_cast<size_t>(numFeatures))
+
+  for (int32_t i = 0; i < numFeatures; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(stats->getNumberOfVoxels(i), expected.counts[i])
+
+    int64_t minIndex[3] = { 0, 0, 0 };
+    int64_t maxIndex[3] = { 0, 0, 0 };
+    stats->getBounds(i, minIndex, maxIndex);
+    for (int d = 0; d < 3; d++)
+    {
+      DREAM3D_REQUIRE_EQUAL(minIndex[d], expected.minIndex[i * 3 + d])
+      DREAM3D_REQUIRE_EQUAL(maxIndex[d], expected.maxIndex[i * 3 + d])
+    }
+
+    if (expected.counts[i] == 0) { continue; }
+
+    float centroid[3] = { 0.0f, 0.0f, 0.0f };
+    stats->getCentroid(i, res, centroid);
+    for (int d = 0; d < 3; d++)
+    {
+      float expectedCentroid = static_cast<float>(expected.centroids[i * 3 + d]);
+      DREAM3D_COMPARE_FLOATS(&expectedCentroid, &(centroid[d]), 4)
+    }
+
+    double moments[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    stats->getSecondMoments(i, res, centroid, moments);
+    for (int m = 0; m < 6; m++)
+    {
+      double tolerance = 1.0e-4 * std::max(1.0, std::fabs(expected.moments[i * 6 + m]));
+      DREAM3D_REQUIRED(std::fabs(moments[m] - expected.moments[i * 6 + m]), <=, tolerance)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestSmallVolume()
+{
+  CompareWithBruteForce(7, 5, 3, 6);
+  CompareWithBruteForce(1, 1, 9, 4);
+}
+
+// -----------------------------------------------------------------------------
+//  Large enough to be split into several chunks that are merged together
+// -----------------------------------------------------------------------------
+void TestChunkedVolume()
+{
+  CompareWithBruteForce(70, 60, 50, 40);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestEmptyFeature()
+{
+  size_t dims[3] = { 4, 4, 4 };
+  std::vector<int32_t> featureIds(64, 0);
+  featureIds[21] = 2;
+  featureIds[42] = 2;
+
+  FeatureVoxelStatistics::Pointer stats = FeatureVoxelStatistics::New();
+  stats->compute(dims, &(featureIds.front()), 3, FeatureVoxelStatistics::Counts | FeatureVoxelStatistics::Bounds);
+  DREAM3D_REQUIRE_EQUAL(stats->getNumberOfVoxels(0), 62)
+  DREAM3D_REQUIRE_EQUAL(stats->getNumberOfVoxels(1), 0)
+  DREAM3D_REQUIRE_EQUAL(stats->getNumberOfVoxels(2), 2)
+
+  int64_t minIndex[3] = { 0, 0, 0 };
+  int64_t maxIndex[3] = { 0, 0, 0 };
+  stats->getBounds(1, minIndex, maxIndex);
+  DREAM3D_REQUIRED(minIndex[0], >, maxIndex[0])
+  stats->getBounds(2, minIndex, maxIndex);
+  DREAM3D_REQUIRE_EQUAL(minIndex[0], 1)
+  DREAM3D_REQUIRE_EQUAL(maxIndex[0], 2)
+  DREAM3D_REQUIRE_EQUAL(minIndex[2], 1)
+  DREAM3D_REQUIRE_EQUAL(maxIndex[2], 2)
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestSmallVolume() )
+  DREAM3D_REGISTER_TEST( TestChunkedVolume() )
+  DREAM3D_REGISTER_TEST( TestEmptyFeature() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
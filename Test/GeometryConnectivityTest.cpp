@@ -0,0 +1,249 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include <QtCore/QDateTime>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/IGeometry2D.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Geometry/QuadGeom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "DREAM3DTestFileLocations.h"
+
+// Number of quads along each side of the test meshes
+static const int64_t k_MeshSize = 1000;
+
+// -----------------------------------------------------------------------------
+//  Fills the vertices of a flat (k_MeshSize + 1)^2 grid. The vertex ids are scrambled with a multiplicative
+//  permutation so that neighboring elements do not reference neighboring vertex ids.
+// -----------------------------------------------------------------------------
+int64_t GridVertexId(int64_t x, int64_t y)
+{
+  int64_t numVerts = (k_MeshSize + 1) * (k_MeshSize + 1);
+  return ((y * (k_MeshSize + 1) + x) * 7919) % numVerts;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SharedVertexList::Pointer CreateGridVertices()
+{
+  int64_t numVerts = (k_MeshSize + 1) * (k_MeshSize + 1);
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(numVerts);
+  float* verts = vertices->getPointer(0);
+  for (int64_t y = 0; y <= k_MeshSize; y++)
+  {
+    for (int64_t x = 0; x <= k_MeshSize; x++)
+    {
+      int64_t v = GridVertexId(x, y);
+      verts[v * 3] = static_cast<float>(x);
+      verts[v * 3 + 1] = static_cast<float>(y);
+      verts[v * 3 + 2] = 0.0f;
+    }
+  }
+  return vertices;
+}
+
+// -----------------------------------------------------------------------------
+//  Checks the connectivity of a flat grid mesh against what can be computed directly from the element list and
+//  prints how long each structure took to build
+// -----------------------------------------------------------------------------
+int CheckGridConnectivity(IGeometry2D::Pointer geom, Int64ArrayType::Pointer elemList)
+{
+  size_t numElems = elemList->getNumberOfTuples();
+  size_t numVertsPerElem = elemList->getNumberOfComponents();
+  size_t numVerts = static_cast<size_t>(geom->getNumberOfVertices());
+  int64_t* elems = elemList->getPointer(0);
+
+  qint64 start = QDateTime::currentMSecsSinceEpoch();
+  int err = geom->findElementsContainingVert();
+  qint64 containingVertMillis = QDateTime::currentMSecsSinceEpoch() - start;
+  DREAM3D_REQUIRED(err, >=, 0)
+
+  start = QDateTime::currentMSecsSinceEpoch();
+  err = geom->findElementNeighbors();
+  qint64 neighborsMillis = QDateTime::currentMSecsSinceEpoch() - start;
+  DREAM3D_REQUIRED(err, >=, 0)
+
+  start = QDateTime::currentMSecsSinceEpoch();
+  err = geom->findEdges();
+  qint64 edgesMillis = QDateTime::currentMSecsSinceEpoch() - start;
+  DREAM3D_REQUIRED(err, >=, 0)
+
+  start = QDateTime::currentMSecsSinceEpoch();
+  err = geom->findUnsharedEdges();
+  qint64 unsharedEdgesMillis = QDateTime::currentMSecsSinceEpoch() - start;
+  DREAM3D_REQUIRED(err, >=, 0)
+
+  // Every vertex must list exactly the elements that reference it, in ascending order
+  ElementDynamicList::Pointer elemsContainingVert = geom->getElementsContainingVert();
+  DREAM3D_REQUIRE_VALID_POINTER(elemsContainingVert.get())
+  std::vector<std::vector<int64_t> > reference(numVerts);
+  for (size_t e = 0; e < numElems; e++)
+  {
+    for (size_t j = 0; j < numVertsPerElem; j++)
+    {
+      reference[elems[e * numVertsPerElem + j]].push_back(static_cast<int64_t>(e));
+    }
+  }
+  for (size_t v = 0; v < numVerts; v++)
+  {
+    DREAM3D_REQUIRE_EQUAL(elemsContainingVert->getNumberOfElements(v), reference[v].size())
+    int64_t* list = elemsContainingVert->getElementListPointer(v);
+    for (size_t i = 0; i < reference[v].size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(list[i], reference[v][i])
+    }
+  }
+
+  // Every neighbor must share exactly one edge (two vertices) with its element, and on a flat manifold grid each
+  // edge is shared by at most two elements, so the neighbor pairs are the shared edges counted twice
+  ElementDynamicList::Pointer elemNeighbors = geom->getElementNeighbors();
+  DREAM3D_REQUIRE_VALID_POINTER(elemNeighbors.get())
+  size_t totalNeighbors = 0;
+  for (size_t e = 0; e < numElems; e++)
+  {
+    uint16_t nCount = elemNeighbors->getNumberOfElements(e);
+    int64_t* neighbors = elemNeighbors->getElementListPointer(e);
+    DREAM3D_REQUIRED(nCount, <=, numVertsPerElem)
+    for (uint16_t n = 0; n < nCount; n++)
+    {
+      size_t shared = 0;
+      for (size_t i = 0; i < numVertsPerElem; i++)
+      {
+        for (size_t j = 0; j < numVertsPerElem; j++)
+        {
+          if (elems[e * numVertsPerElem + i] == elems[neighbors[n] * numVertsPerElem + j]) { shared++; }
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(shared, 2)
+    }
+    totalNeighbors += nCount;
+  }
+
+  // Euler characteristic of a disk: V - E + F = 1. The boundary of the grid has 4 * k_MeshSize edges.
+  size_t numEdges = numVerts + numElems - 1;
+  size_t numUnsharedEdges = 4 * k_MeshSize;
+  DREAM3D_REQUIRE_EQUAL(geom->getEdges()->getNumberOfTuples(), numEdges)
+  DREAM3D_REQUIRE_EQUAL(geom->getUnsharedEdges()->getNumberOfTuples(), numUnsharedEdges)
+  DREAM3D_REQUIRE_EQUAL(totalNeighbors, 2 * (numEdges - numUnsharedEdges))
+
+  // Both edge lists are sorted and unique
+  int64_t* edges = geom->getEdges()->getPointer(0);
+  for (size_t i = 0; i < numEdges; i++)
+  {
+    DREAM3D_REQUIRED(edges[i * 2], <, edges[i * 2 + 1])
+    if (i > 0)
+    {
+      bool ascending = edges[i * 2 - 2] < edges[i * 2] || (edges[i * 2 - 2] == edges[i * 2] && edges[i * 2 - 1] < edges[i * 2 + 1]);
+      DREAM3D_REQUIRE_EQUAL(ascending, true)
+    }
+  }
+
+  std::cout << "  " << numElems << " elements, " << numVerts << " vertices" << std::endl;
+  std::cout << "  findElementsContainingVert: " << containingVertMillis << " ms" << std::endl;
+  std::cout << "  findElementNeighbors:       " << neighborsMillis << " ms" << std::endl;
+  std::cout << "  findEdges:                  " << edgesMillis << " ms" << std::endl;
+  std::cout << "  findUnsharedEdges:          " << unsharedEdgesMillis << " ms" << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestTriangleGeomConnectivity()
+{
+  SharedTriList::Pointer tris = TriangleGeom::CreateSharedTriList(2 * k_MeshSize * k_MeshSize);
+  int64_t* t = tris->getPointer(0);
+  for (int64_t y = 0; y < k_MeshSize; y++)
+  {
+    for (int64_t x = 0; x < k_MeshSize; x++)
+    {
+      t[0] = GridVertexId(x, y);
+      t[1] = GridVertexId(x + 1, y);
+      t[2] = GridVertexId(x + 1, y + 1);
+      t[3] = GridVertexId(x, y);
+      t[4] = GridVertexId(x + 1, y + 1);
+      t[5] = GridVertexId(x, y + 1);
+      t += 6;
+    }
+  }
+  TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(tris, CreateGridVertices(), DREAM3D::Geometry::TriangleGeometry);
+  return CheckGridConnectivity(triangleGeom, tris);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestQuadGeomConnectivity()
+{
+  SharedQuadList::Pointer quads = QuadGeom::CreateSharedQuadList(k_MeshSize * k_MeshSize);
+  int64_t* q = quads->getPointer(0);
+  for (int64_t y = 0; y < k_MeshSize; y++)
+  {
+    for (int64_t x = 0; x < k_MeshSize; x++)
+    {
+      q[0] = GridVertexId(x, y);
+      q[1] = GridVertexId(x + 1, y);
+      q[2] = GridVertexId(x + 1, y + 1);
+      q[3] = GridVertexId(x, y + 1);
+      q += 4;
+    }
+  }
+  QuadGeom::Pointer quadGeom = QuadGeom::CreateGeometry(quads, CreateGridVertices(), DREAM3D::Geometry::QuadGeometry);
+  return CheckGridConnectivity(quadGeom, quads);
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestTriangleGeomConnectivity() )
+  DREAM3D_REGISTER_TEST( TestQuadGeomConnectivity() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,341 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/ThresholdEvaluator.h"
+#include "SIMPLib/Common/ThresholdFilterHelper.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "DREAM3DTestFileLocations.h"
+
+// Spans several of the chunks the evaluator works on, with a partial last chunk
+static const size_t k_NumTuples = 50001;
+
+// -----------------------------------------------------------------------------
+//  Straightforward comparison that casts the value to the array type first, like
+//  ThresholdFilterHelper always did
+// -----------------------------------------------------------------------------
+template<typename T>
+bool Compare(T v, DREAM3D::Comparison::Enumeration compOperator, double value)
+{
+  T typedValue = static_cast<T>(value);
+  switch(compOperator)
+  {
+    case DREAM3D::Comparison::Operator_LessThan:
+      return v < typedValue;
+    case DREAM3D::Comparison::Operator_GreaterThan:
+      return v > typedValue;
+    case DREAM3D::Comparison::Operator_Equal:
+      return v == typedValue;
+    default:
+      return false;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+typename DataArray<T>::Pointer CreateRandomArray(const QString& name, int range, int offset)
+{
+  typename DataArray<T>::Pointer data = DataArray<T>::CreateArray(k_NumTuples, name);
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    data->setValue(i, static_cast<T>(rand() % range + offset));
+  }
+  return data;
+}
+
+/**
+ * @brief The TestArrays struct holds one scalar array of several of the supported types
+ */
+struct TestArrays
+{
+  FloatArrayType::Pointer floats;
+  DoubleArrayType::Pointer doubles;
+  Int8ArrayType::Pointer int8s;
+  UInt8ArrayType::Pointer uint8s;
+  Int16ArrayType::Pointer int16s;
+  UInt16ArrayType::Pointer uint16s;
+  Int32ArrayType::Pointer int32s;
+  UInt32ArrayType::Pointer uint32s;
+  Int64ArrayType::Pointer int64s;
+  UInt64ArrayType::Pointer uint64s;
+  BoolArrayType::Pointer bools;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TestArrays CreateTestArrays()
+{
+  srand(2015);
+  TestArrays arrays;
+  arrays.floats = FloatArrayType::CreateArray(k_NumTuples, "Floats");
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    arrays.floats->setValue(i, static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+  }
+  arrays.doubles = CreateRandomArray<double>("Doubles", 200, -100);
+  arrays.int8s = CreateRandomArray<int8_t>("Int8", 7, -3);
+  arrays.uint8s = CreateRandomArray<uint8_t>("UInt8", 5, 0);
+  arrays.int16s = CreateRandomArray<int16_t>("Int16", 11, -5);
+  arrays.uint16s = CreateRandomArray<uint16_t>("UInt16", 9, 0);
+  arrays.int32s = CreateRandomArray<int32_t>("Int32", 6, 0);
+  arrays.uint32s = CreateRandomArray<uint32_t>("UInt32", 6, 0);
+  arrays.int64s = CreateRandomArray<int64_t>("Int64", 13, -6);
+  arrays.uint64s = CreateRandomArray<uint64_t>("UInt64", 4, 0);
+  arrays.bools = CreateRandomArray<bool>("Bools", 2, 0);
+  return arrays;
+}
+
+// -----------------------------------------------------------------------------
+//  Runs a single comparison through the evaluator and through ThresholdFilterHelper
+//  and checks both against the straightforward comparison
+// -----------------------------------------------------------------------------
+template<typename T>
+void CheckSingleComparison(typename DataArray<T>::Pointer data, DREAM3D::Comparison::Enumeration compOperator, double value)
+{
+  BoolArrayType::Pointer mask = BoolArrayType::CreateArray(k_NumTuples, "Mask");
+  ThresholdEvaluator::Pointer evaluator = ThresholdEvaluator::New();
+  DREAM3D_REQUIRE_EQUAL(evaluator->addComparison(data.get(), compOperator, value), true)
+  DREAM3D_REQUIRE_EQUAL(evaluator->evaluate(mask.get()), 0)
+
+  BoolArrayType::Pointer helperMask = BoolArrayType::CreateArray(k_NumTuples, "HelperMask");
+  ThresholdFilterHelper helper(compOperator, value, helperMask.get());
+  DREAM3D_REQUIRE_EQUAL(helper.execute(data.get(), helperMask.get()), 1)
+
+  size_t numTrue = 0;
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    bool expected = Compare<T>(data->getValue(i), compOperator, value);
+    DREAM3D_REQUIRE_EQUAL(mask->getValue(i), expected)
+    DREAM3D_REQUIRE_EQUAL(helperMask->getValue(i), expected)
+    if (expected) { numTrue++; }
+  }
+  // Every comparison in the test is chosen to select some but not all of the tuples
+  DREAM3D_REQUIRED(numTrue, >, 0)
+  DREAM3D_REQUIRED(numTrue, <, k_NumTuples)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+void CheckAllOperators(typename DataArray<T>::Pointer data, double value)
+{
+  CheckSingleComparison<T>(data, DREAM3D::Comparison::Operator_LessThan, value);
+  CheckSingleComparison<T>(data, DREAM3D::Comparison::Operator_GreaterThan, value);
+  CheckSingleComparison<T>(data, DREAM3D::Comparison::Operator_Equal, value);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestAllOperators()
+{
+  TestArrays arrays = CreateTestArrays();
+  // The value is cast to the type of the array, so 2.7 is compared as 2 for the integer types
+  CheckAllOperators<double>(arrays.doubles, 17.0);
+  CheckAllOperators<int8_t>(arrays.int8s, -1.0);
+  CheckAllOperators<uint8_t>(arrays.uint8s, 2.0);
+  CheckAllOperators<int16_t>(arrays.int16s, 2.7);
+  CheckAllOperators<uint16_t>(arrays.uint16s, 4.0);
+  CheckAllOperators<int32_t>(arrays.int32s, 3.0);
+  CheckAllOperators<uint32_t>(arrays.uint32s, 1.0);
+  CheckAllOperators<int64_t>(arrays.int64s, -2.0);
+  CheckAllOperators<uint64_t>(arrays.uint64s, 2.0);
+
+  CheckSingleComparison<float>(arrays.floats, DREAM3D::Comparison::Operator_LessThan, 0.25);
+  CheckSingleComparison<float>(arrays.floats, DREAM3D::Comparison::Operator_GreaterThan, 0.25);
+  CheckSingleComparison<float>(arrays.floats, DREAM3D::Comparison::Operator_Equal, arrays.floats->getValue(k_NumTuples / 2));
+
+  CheckSingleComparison<bool>(arrays.bools, DREAM3D::Comparison::Operator_LessThan, 1.0);
+  CheckSingleComparison<bool>(arrays.bools, DREAM3D::Comparison::Operator_GreaterThan, 0.0);
+  CheckSingleComparison<bool>(arrays.bools, DREAM3D::Comparison::Operator_Equal, 1.0);
+}
+
+// -----------------------------------------------------------------------------
+//  All of the comparisons in one group are ANDed together
+// -----------------------------------------------------------------------------
+void TestAndGroup()
+{
+  TestArrays arrays = CreateTestArrays();
+  BoolArrayType::Pointer mask = BoolArrayType::CreateArray(k_NumTuples, "Mask");
+
+  ThresholdEvaluator::Pointer evaluator = ThresholdEvaluator::New();
+  evaluator->addComparison(arrays.floats.get(), DREAM3D::Comparison::Operator_GreaterThan, 0.2);
+  evaluator->addComparison(arrays.int32s.get(), DREAM3D::Comparison::Operator_LessThan, 4.0);
+  evaluator->addComparison(arrays.uint8s.get(), DREAM3D::Comparison::Operator_Equal, 1.0);
+  evaluator->addComparison(arrays.int64s.get(), DREAM3D::Comparison::Operator_GreaterThan, -4.0);
+  DREAM3D_REQUIRE_EQUAL(evaluator->getNumberOfComparisons(), 4)
+  DREAM3D_REQUIRE_EQUAL(evaluator->evaluate(mask.get()), 0)
+
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    bool expected = arrays.floats->getValue(i) > 0.2f && arrays.int32s->getValue(i) < 4
+                    && arrays.uint8s->getValue(i) == 1 && arrays.int64s->getValue(i) > -4;
+    DREAM3D_REQUIRE_EQUAL(mask->getValue(i), expected)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Single comparison groups are ORed together
+// -----------------------------------------------------------------------------
+void TestOrGroups()
+{
+  TestArrays arrays = CreateTestArrays();
+  BoolArrayType::Pointer mask = BoolArrayType::CreateArray(k_NumTuples, "Mask");
+
+  ThresholdEvaluator::Pointer evaluator = ThresholdEvaluator::New();
+  // A new group on an empty evaluator must not add an empty group that is always true
+  evaluator->addGroup();
+  evaluator->addComparison(arrays.doubles.get(), DREAM3D::Comparison::Operator_LessThan, -90.0);
+  evaluator->addGroup();
+  evaluator->addComparison(arrays.int16s.get(), DREAM3D::Comparison::Operator_Equal, 5.0);
+  evaluator->addGroup();
+  evaluator->addComparison(arrays.bools.get(), DREAM3D::Comparison::Operator_GreaterThan, 0.0);
+  // A trailing empty group must not turn every tuple on either
+  evaluator->addGroup();
+  DREAM3D_REQUIRE_EQUAL(evaluator->getNumberOfComparisons(), 3)
+  DREAM3D_REQUIRE_EQUAL(evaluator->evaluate(mask.get()), 0)
+
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    bool expected = arrays.doubles->getValue(i) < -90.0 || arrays.int16s->getValue(i) == 5 || arrays.bools->getValue(i) == true;
+    DREAM3D_REQUIRE_EQUAL(mask->getValue(i), expected)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  (A AND B) OR (C AND D) OR E
+// -----------------------------------------------------------------------------
+void TestMixedGroups()
+{
+  TestArrays arrays = CreateTestArrays();
+  BoolArrayType::Pointer mask = BoolArrayType::CreateArray(k_NumTuples, "Mask");
+
+  ThresholdEvaluator::Pointer evaluator = ThresholdEvaluator::New();
+  evaluator->addComparison(arrays.floats.get(), DREAM3D::Comparison::Operator_LessThan, 0.5);
+  evaluator->addComparison(arrays.uint16s.get(), DREAM3D::Comparison::Operator_GreaterThan, 5.0);
+  evaluator->addGroup();
+  evaluator->addComparison(arrays.int8s.get(), DREAM3D::Comparison::Operator_Equal, -3.0);
+  evaluator->addComparison(arrays.uint32s.get(), DREAM3D::Comparison::Operator_LessThan, 2.0);
+  evaluator->addGroup();
+  evaluator->addComparison(arrays.uint64s.get(), DREAM3D::Comparison::Operator_Equal, 3.0);
+  DREAM3D_REQUIRE_EQUAL(evaluator->getNumberOfComparisons(), 5)
+  DREAM3D_REQUIRE_EQUAL(evaluator->evaluate(mask.get()), 0)
+
+  size_t numTrue = 0;
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    bool expected = (arrays.floats->getValue(i) < 0.5f && arrays.uint16s->getValue(i) > 5)
+                    || (arrays.int8s->getValue(i) == -3 && arrays.uint32s->getValue(i) < 2)
+                    || arrays.uint64s->getValue(i) == 3;
+    DREAM3D_REQUIRE_EQUAL(mask->getValue(i), expected)
+    if (expected) { numTrue++; }
+  }
+  DREAM3D_REQUIRED(numTrue, >, 0)
+  DREAM3D_REQUIRED(numTrue, <, k_NumTuples)
+
+  // The evaluator can be cleared and reused
+  evaluator->clear();
+  DREAM3D_REQUIRE_EQUAL(evaluator->getNumberOfComparisons(), 0)
+  evaluator->addComparison(arrays.int32s.get(), DREAM3D::Comparison::Operator_Equal, 0.0);
+  DREAM3D_REQUIRE_EQUAL(evaluator->evaluate(mask.get()), 0)
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(mask->getValue(i), arrays.int32s->getValue(i) == 0)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestInvalidInputs()
+{
+  TestArrays arrays = CreateTestArrays();
+  BoolArrayType::Pointer mask = BoolArrayType::CreateArray(k_NumTuples, "Mask");
+  ThresholdEvaluator::Pointer evaluator = ThresholdEvaluator::New();
+
+  // Nothing to evaluate
+  DREAM3D_REQUIRE_EQUAL(evaluator->evaluate(mask.get()), -1)
+
+  // Only scalar arrays and known operators can be compared
+  FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(k_NumTuples, QVector<size_t>(1, 3), "Vectors");
+  DREAM3D_REQUIRE_EQUAL(evaluator->addComparison(vectors.get(), DREAM3D::Comparison::Operator_LessThan, 1.0), false)
+  DREAM3D_REQUIRE_EQUAL(evaluator->addComparison(arrays.floats.get(), DREAM3D::Comparison::Operator_Unknown, 1.0), false)
+  DREAM3D_REQUIRE_EQUAL(evaluator->addComparison(NULL, DREAM3D::Comparison::Operator_LessThan, 1.0), false)
+  DREAM3D_REQUIRE_EQUAL(evaluator->getNumberOfComparisons(), 0)
+
+  // The arrays must have the same number of tuples
+  Int32ArrayType::Pointer shortArray = Int32ArrayType::CreateArray(k_NumTuples - 1, "Short");
+  shortArray->initializeWithZeros();
+  DREAM3D_REQUIRE_EQUAL(evaluator->addComparison(arrays.floats.get(), DREAM3D::Comparison::Operator_LessThan, 1.0), true)
+  evaluator->addGroup();
+  DREAM3D_REQUIRE_EQUAL(evaluator->addComparison(shortArray.get(), DREAM3D::Comparison::Operator_Equal, 0.0), true)
+  DREAM3D_REQUIRE_EQUAL(evaluator->evaluate(mask.get()), -1)
+
+  // The output must be large enough
+  evaluator->clear();
+  evaluator->addComparison(arrays.floats.get(), DREAM3D::Comparison::Operator_LessThan, 1.0);
+  BoolArrayType::Pointer shortMask = BoolArrayType::CreateArray(k_NumTuples - 1, "ShortMask");
+  DREAM3D_REQUIRE_EQUAL(evaluator->evaluate(shortMask.get()), -1)
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestAllOperators() )
+  DREAM3D_REGISTER_TEST( TestAndGroup() )
+  DREAM3D_REGISTER_TEST( TestOrGroups() )
+  DREAM3D_REGISTER_TEST( TestMixedGroups() )
+  DREAM3D_REGISTER_TEST( TestInvalidInputs() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
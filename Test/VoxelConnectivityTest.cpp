@@ -0,0 +1,413 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <deque>
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/VoxelConnectivity.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "DREAM3DTestFileLocations.h"
+
+// -----------------------------------------------------------------------------
+//  Fills the 6 face neighbors of a cell in -z, -y, -x, +x, +y, +z order
+// -----------------------------------------------------------------------------
+int32_t FaceNeighbors(const size_t dims[3], int64_t index, int64_t neighbors[6])
+{
+  int64_t xDim = static_cast<int64_t>(dims[0]);
+  int64_t yDim = static_cast<int64_t>(dims[1]);
+  int64_t zDim = static_cast<int64_t>(dims[2]);
+  int64_t x = index % xDim;
+  int64_t y = (index / xDim) % yDim;
+  int64_t z = index / (xDim * yDim);
+  int32_t num = 0;
+  if (z > 0) { neighbors[num++] = index - xDim * yDim; }
+  if (y > 0) { neighbors[num++] = index - xDim; }
+  if (x > 0) { neighbors[num++] = index - 1; }
+  if (x < xDim - 1) { neighbors[num++] = index + 1; }
+  if (y < yDim - 1) { neighbors[num++] = index + xDim; }
+  if (z < zDim - 1) { neighbors[num++] = index + xDim * yDim; }
+  return num;
+}
+
+// -----------------------------------------------------------------------------
+//  Flood fills the cells with the given feature id in raster order, the way the
+//  cleanup filters found their regions before
+// -----------------------------------------------------------------------------
+int64_t FloodFillComponents(const size_t dims[3], const std::vector<int32_t>& featureIds, int32_t value, std::vector<int64_t>& labels)
+{
+  int64_t totalPoints = static_cast<int64_t>(featureIds.size());
+  labels.assign(totalPoints, -1);
+  int64_t numComponents = 0;
+  int64_t neighbors[6];
+  for (int64_t seed = 0; seed < totalPoints; seed++)
+  {
+    if (featureIds[seed] != value || labels[seed] >= 0) { continue; }
+    std::deque<int64_t> front(1, seed);
+    labels[seed] = numComponents;
+    while (front.empty() == false)
+    {
+      int64_t cell = front.front();
+      front.pop_front();
+      int32_t num = FaceNeighbors(dims, cell, neighbors);
+      for (int32_t n = 0; n < num; n++)
+      {
+        if (featureIds[neighbors[n]] == value && labels[neighbors[n]] < 0)
+        {
+          labels[neighbors[n]] = numComponents;
+          front.push_back(neighbors[n]);
+        }
+      }
+    }
+    numComponents++;
+  }
+  return numComponents;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CompareWithFloodFill(size_t xDim, size_t yDim, size_t zDim, int32_t numValues, unsigned int seed)
+{
+  size_t dims[3] = { xDim, yDim, zDim };
+  size_t totalPoints = xDim * yDim * zDim;
+  std::vector<int32_t> featureIds(totalPoints, 0);
+  bool* mask = new bool[totalPoints];
+  srand(seed);
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    featureIds[i] = rand() % numValues;
+    mask[i] = (featureIds[i] == 1);
+  }
+
+  VoxelConnectivity::Pointer connectivity = VoxelConnectivity::New();
+  std::vector<int64_t> expected;
+  for (int32_t value = 0; value < numValues; value++)
+  {
+    int64_t numComponents = FloodFillComponents(dims, featureIds, value, expected);
+    DREAM3D_REQUIRE_EQUAL(connectivity->labelComponents(dims, &(featureIds.front()), value), numComponents)
+    DREAM3D_REQUIRE_EQUAL(connectivity->getNumberOfComponents(), numComponents)
+    const std::vector<int64_t>& labels = connectivity->getLabels();
+    std::vector<int64_t> sizes(numComponents, 0);
+    for (size_t i = 0; i < totalPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(labels[i], expected[i])
+      if (expected[i] >= 0) { sizes[expected[i]]++; }
+    }
+    DREAM3D_REQUIRE(connectivity->getComponentSizes() == sizes)
+  }
+
+  int64_t numComponents = FloodFillComponents(dims, featureIds, 1, expected);
+  DREAM3D_REQUIRE_EQUAL(connectivity->labelComponents(dims, mask, true), numComponents)
+  DREAM3D_REQUIRE(connectivity->getLabels() == expected)
+  delete[] mask;
+}
+
+// -----------------------------------------------------------------------------
+//  Cells that only share an edge or a corner belong to different components
+// -----------------------------------------------------------------------------
+void TestFaceConnectivity()
+{
+  size_t dims[3] = { 4, 3, 2 };
+  bool mask[24] =
+  {
+    // z = 0
+    true,  true,  false, false,
+    false, false, true,  false,
+    false, false, true,  true,
+    // z = 1
+    false, false, false, false,
+    false, false, true,  false,
+    true,  false, false, false
+  };
+
+  VoxelConnectivity::Pointer connectivity = VoxelConnectivity::New();
+  DREAM3D_REQUIRE_EQUAL(connectivity->labelComponents(dims, mask, true), 3)
+
+  // Cell 6 only touches cell 1 along an edge, cell 20 only touches cell 10 along an edge
+  int64_t expected[24] =
+  {
+    0, 0, -1, -1,
+    -1, -1, 1, -1,
+    -1, -1, 1, 1,
+    -1, -1, -1, -1,
+    -1, -1, 1, -1,
+    2, -1, -1, -1
+  };
+  const std::vector<int64_t>& labels = connectivity->getLabels();
+  DREAM3D_REQUIRE_EQUAL(labels.size(), 24)
+  for (size_t i = 0; i < 24; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(labels[i], expected[i])
+  }
+  const std::vector<int64_t>& sizes = connectivity->getComponentSizes();
+  DREAM3D_REQUIRE_EQUAL(sizes.size(), 3)
+  DREAM3D_REQUIRE_EQUAL(sizes[0], 2)
+  DREAM3D_REQUIRE_EQUAL(sizes[1], 4)
+  DREAM3D_REQUIRE_EQUAL(sizes[2], 1)
+
+  // The unselected cells form one component that wraps around the selected ones
+  DREAM3D_REQUIRE_EQUAL(connectivity->labelComponents(dims, mask, false), 1)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getComponentSizes()[0], 17)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestBoundaryComponents()
+{
+  size_t dims[3] = { 5, 5, 5 };
+  std::vector<int32_t> featureIds(125, 0);
+  featureIds[0] = 1;                   // Corner cell
+  featureIds[(2 * 5 + 2) * 5 + 2] = 1; // Center cell
+  featureIds[(2 * 5 + 2) * 5 + 3] = 1; // Next to the center cell
+  featureIds[(3 * 5 + 2) * 5 + 4] = 1; // On the +x face
+
+  VoxelConnectivity::Pointer connectivity = VoxelConnectivity::New();
+  DREAM3D_REQUIRE_EQUAL(connectivity->labelComponents(dims, &(featureIds.front()), 1), 3)
+  std::vector<bool> touches = connectivity->findComponentsTouchingBoundary();
+  DREAM3D_REQUIRE_EQUAL(touches.size(), 3)
+  DREAM3D_REQUIRE_EQUAL(touches[0], true)
+  DREAM3D_REQUIRE_EQUAL(touches[1], false)
+  DREAM3D_REQUIRE_EQUAL(touches[2], true)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getComponentSizes()[1], 2)
+}
+
+// -----------------------------------------------------------------------------
+//  Random volumes, including single plane images that are split into slabs of rows
+// -----------------------------------------------------------------------------
+void TestRandomComponents()
+{
+  CompareWithFloodFill(30, 20, 40, 2, 1);
+  CompareWithFloodFill(17, 23, 9, 3, 2);
+  CompareWithFloodFill(64, 64, 1, 2, 3);
+  CompareWithFloodFill(1, 1, 50, 2, 4);
+  CompareWithFloodFill(1, 200, 1, 3, 5);
+}
+
+// -----------------------------------------------------------------------------
+//  Runs every step of the dilation and returns the final feature ids
+// -----------------------------------------------------------------------------
+std::vector<int32_t> Dilate(const size_t dims[3], std::vector<int32_t> featureIds, int32_t minSourceId, size_t& numSteps)
+{
+  VoxelConnectivity::Pointer connectivity = VoxelConnectivity::New();
+  connectivity->initializeDilation(dims, &(featureIds.front()), minSourceId);
+  numSteps = 0;
+  while (connectivity->nextDilationStep() > 0)
+  {
+    connectivity->applyDilationStep(&(featureIds.front()));
+    numSteps++;
+  }
+  return featureIds;
+}
+
+// -----------------------------------------------------------------------------
+//  Features grow one face neighbor per step and the first of the most common
+//  neighbors wins a tie
+// -----------------------------------------------------------------------------
+void TestFrontGrowth()
+{
+  size_t dims[3] = { 7, 1, 1 };
+  int32_t line[7] = { 1, -1, -1, -1, -1, -1, 2 };
+  std::vector<int32_t> featureIds(line, line + 7);
+
+  VoxelConnectivity::Pointer connectivity = VoxelConnectivity::New();
+  connectivity->initializeDilation(dims, &(featureIds.front()), 1);
+
+  DREAM3D_REQUIRE_EQUAL(connectivity->nextDilationStep(), 2)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getDilationTargets()[0], 1)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getDilationSources()[0], 0)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getDilationTargets()[1], 5)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getDilationSources()[1], 6)
+  connectivity->applyDilationStep(&(featureIds.front()));
+
+  DREAM3D_REQUIRE_EQUAL(connectivity->nextDilationStep(), 2)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getDilationTargets()[0], 2)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getDilationTargets()[1], 4)
+  connectivity->applyDilationStep(&(featureIds.front()));
+
+  // Cell 3 sees feature 1 on -x and feature 2 on +x. The -x neighbor comes first
+  DREAM3D_REQUIRE_EQUAL(connectivity->nextDilationStep(), 1)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getDilationTargets()[0], 3)
+  DREAM3D_REQUIRE_EQUAL(connectivity->getDilationSources()[0], 2)
+  connectivity->applyDilationStep(&(featureIds.front()));
+  DREAM3D_REQUIRE_EQUAL(connectivity->nextDilationStep(), 0)
+
+  int32_t expected[7] = { 1, 1, 1, 1, 2, 2, 2 };
+  for (size_t i = 0; i < 7; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(featureIds[i], expected[i])
+  }
+
+  // The majority of the face neighbors wins: cell 4 has three neighbors of feature 3
+  // and one of feature 2
+  size_t planeDims[3] = { 3, 3, 1 };
+  int32_t plane[9] =
+  {
+    2, 3, 2,
+    3, -1, 2,
+    2, 3, 2
+  };
+  featureIds.assign(plane, plane + 9);
+  connectivity->initializeDilation(planeDims, &(featureIds.front()), 1);
+  DREAM3D_REQUIRE_EQUAL(connectivity->nextDilationStep(), 1)
+  DREAM3D_REQUIRE_EQUAL(featureIds[connectivity->getDilationSources()[0]], 3)
+}
+
+// -----------------------------------------------------------------------------
+//  Only face neighbors feed the dilation and cells that no feature can reach stop it
+// -----------------------------------------------------------------------------
+void TestUnreachableCells()
+{
+  // Cell 4 only touches the feature along an edge. Feature 0 is below minSourceId
+  size_t dims[3] = { 3, 3, 1 };
+  int32_t plane[9] =
+  {
+    5, 0, 0,
+    0, -1, -1,
+    0, -1, -1
+  };
+  std::vector<int32_t> featureIds(plane, plane + 9);
+  size_t numSteps = 0;
+  std::vector<int32_t> result = Dilate(dims, featureIds, 1, numSteps);
+  DREAM3D_REQUIRE_EQUAL(numSteps, 0)
+  DREAM3D_REQUIRE(result == featureIds)
+
+  // With feature 0 allowed to grow every cell is filled
+  result = Dilate(dims, featureIds, 0, numSteps);
+  DREAM3D_REQUIRE_EQUAL(numSteps, 2)
+  for (size_t i = 1; i < 9; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(result[i], 0)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  The full volume sweep the cleanup filters used to run until nothing changed
+// -----------------------------------------------------------------------------
+std::vector<int32_t> SweepDilate(const size_t dims[3], std::vector<int32_t> featureIds, int32_t minSourceId, size_t& numSteps)
+{
+  int64_t totalPoints = static_cast<int64_t>(featureIds.size());
+  int64_t neighbors[6];
+  numSteps = 0;
+  while (true)
+  {
+    std::vector<int64_t> sources(totalPoints, -1);
+    bool changed = false;
+    for (int64_t i = 0; i < totalPoints; i++)
+    {
+      if (featureIds[i] >= 0) { continue; }
+      int32_t num = FaceNeighbors(dims, i, neighbors);
+      int32_t most = 0;
+      for (int32_t n = 0; n < num; n++)
+      {
+        int32_t feature = featureIds[neighbors[n]];
+        if (feature < minSourceId) { continue; }
+        int32_t count = 0;
+        for (int32_t m = 0; m <= n; m++)
+        {
+          if (featureIds[neighbors[m]] == feature) { count++; }
+        }
+        if (count > most)
+        {
+          most = count;
+          sources[i] = neighbors[n];
+        }
+      }
+      if (sources[i] >= 0) { changed = true; }
+    }
+    if (changed == false) { break; }
+    std::vector<int32_t> previous = featureIds;
+    for (int64_t i = 0; i < totalPoints; i++)
+    {
+      if (sources[i] >= 0) { featureIds[i] = previous[sources[i]]; }
+    }
+    numSteps++;
+  }
+  return featureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestRandomDilation()
+{
+  size_t dims[3] = { 40, 30, 25 };
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  std::vector<int32_t> featureIds(totalPoints, -1);
+  srand(7);
+  // Sparse seeds leave large negative regions that take many steps to fill. A few
+  // isolated negative pockets of feature 0 are never filled with minSourceId 1
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    int r = rand() % 200;
+    if (r < 2) { featureIds[i] = 1 + rand() % 20; }
+    else if (r < 4) { featureIds[i] = 0; }
+  }
+
+  for (int32_t minSourceId = 0; minSourceId < 2; minSourceId++)
+  {
+    size_t numSteps = 0;
+    size_t expectedSteps = 0;
+    std::vector<int32_t> expected = SweepDilate(dims, featureIds, minSourceId, expectedSteps);
+    std::vector<int32_t> result = Dilate(dims, featureIds, minSourceId, numSteps);
+    DREAM3D_REQUIRE(expectedSteps > 1)
+    DREAM3D_REQUIRE_EQUAL(numSteps, expectedSteps)
+    DREAM3D_REQUIRE(result == expected)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestFaceConnectivity() )
+  DREAM3D_REGISTER_TEST( TestBoundaryComponents() )
+  DREAM3D_REGISTER_TEST( TestRandomComponents() )
+  DREAM3D_REGISTER_TEST( TestFrontGrowth() )
+  DREAM3D_REGISTER_TEST( TestUnreachableCells() )
+  DREAM3D_REGISTER_TEST( TestRandomDilation() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,329 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdlib.h>
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/VoxelMorphology.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "DREAM3DTestFileLocations.h"
+
+// Number of random images compared against the full sweeps
+static const int32_t k_NumRandomImages = 400;
+
+// -----------------------------------------------------------------------------
+//  Fills the neighbors of cell (i, j, k) along the enabled directions in -z, -y, -x, +x, +y, +z order
+// -----------------------------------------------------------------------------
+int32_t SweepNeighbors(const int64_t dims[3], const bool dirOn[3], int64_t i, int64_t j, int64_t k, int64_t neighbors[6])
+{
+  int64_t index = (k * dims[1] + j) * dims[0] + i;
+  int32_t num = 0;
+  if (dirOn[2] && k > 0) { neighbors[num++] = index - dims[0] * dims[1]; }
+  if (dirOn[1] && j > 0) { neighbors[num++] = index - dims[0]; }
+  if (dirOn[0] && i > 0) { neighbors[num++] = index - 1; }
+  if (dirOn[0] && i < dims[0] - 1) { neighbors[num++] = index + 1; }
+  if (dirOn[1] && j < dims[1] - 1) { neighbors[num++] = index + dims[0]; }
+  if (dirOn[2] && k < dims[2] - 1) { neighbors[num++] = index + dims[0] * dims[1]; }
+  return num;
+}
+
+// -----------------------------------------------------------------------------
+//  The full volume sweep that ErodeDilateBadData used before VoxelMorphology. Direction 0 grows the cells with
+//  a feature id of 0, direction 1 shrinks them.
+// -----------------------------------------------------------------------------
+void SweepBadData(const int64_t dims[3], const bool dirOn[3], int32_t direction, int32_t numIterations, std::vector<int32_t>& featureIds)
+{
+  int64_t totalPoints = dims[0] * dims[1] * dims[2];
+  int32_t numFeatures = 0;
+  for (int64_t i = 0; i < totalPoints; i++)
+  {
+    if (featureIds[i] > numFeatures) { numFeatures = featureIds[i]; }
+  }
+  std::vector<int64_t> sources(totalPoints, -1);
+  std::vector<int32_t> n(numFeatures + 1, 0);
+  int64_t neighbors[6];
+
+  for (int32_t iteration = 0; iteration < numIterations; iteration++)
+  {
+    for (int64_t k = 0; k < dims[2]; k++)
+    {
+      for (int64_t j = 0; j < dims[1]; j++)
+      {
+        for (int64_t i = 0; i < dims[0]; i++)
+        {
+          int64_t count = (k * dims[1] + j) * dims[0] + i;
+          if (featureIds[count] != 0) { continue; }
+          int32_t most = 0;
+          int32_t num = SweepNeighbors(dims, dirOn, i, j, k, neighbors);
+          for (int32_t l = 0; l < num; l++)
+          {
+            int32_t feature = featureIds[neighbors[l]];
+            if (direction == 0 && feature > 0) { sources[neighbors[l]] = count; }
+            if (direction == 1 && feature > 0)
+            {
+              n[feature]++;
+              if (n[feature] > most)
+              {
+                most = n[feature];
+                sources[count] = neighbors[l];
+              }
+            }
+          }
+          for (int32_t l = 0; l < num; l++)
+          {
+            n[featureIds[neighbors[l]]] = 0;
+          }
+        }
+      }
+    }
+
+    for (int64_t j = 0; j < totalPoints; j++)
+    {
+      int64_t neighbor = sources[j];
+      if (neighbor < 0) { continue; }
+      if ((featureIds[j] == 0 && featureIds[neighbor] > 0 && direction == 1)
+          || (featureIds[j] > 0 && featureIds[neighbor] == 0 && direction == 0))
+      {
+        featureIds[j] = featureIds[neighbor];
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  The full volume sweep that ErodeDilateMask used before VoxelMorphology. Direction 0 grows the true cells,
+//  direction 1 shrinks them.
+// -----------------------------------------------------------------------------
+void SweepMask(const int64_t dims[3], const bool dirOn[3], int32_t direction, int32_t numIterations, std::vector<bool>& mask)
+{
+  int64_t neighbors[6];
+  for (int32_t iteration = 0; iteration < numIterations; iteration++)
+  {
+    std::vector<bool> maskCopy(mask);
+    for (int64_t k = 0; k < dims[2]; k++)
+    {
+      for (int64_t j = 0; j < dims[1]; j++)
+      {
+        for (int64_t i = 0; i < dims[0]; i++)
+        {
+          int64_t count = (k * dims[1] + j) * dims[0] + i;
+          if (mask[count] == true) { continue; }
+          int32_t num = SweepNeighbors(dims, dirOn, i, j, k, neighbors);
+          for (int32_t l = 0; l < num; l++)
+          {
+            if (direction == 0 && mask[neighbors[l]] == true) { maskCopy[count] = true; }
+            if (direction == 1 && mask[neighbors[l]] == true) { maskCopy[neighbors[l]] = false; }
+          }
+        }
+      }
+    }
+    mask = maskCopy;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Runs up to numIterations steps of VoxelMorphology on the feature ids
+// -----------------------------------------------------------------------------
+void MorphBadData(const size_t dims[3], const bool dirOn[3], int32_t direction, int32_t numIterations, std::vector<int32_t>& featureIds)
+{
+  VoxelMorphology::Operation operation = (direction == 0) ? VoxelMorphology::GrowRegion : VoxelMorphology::ShrinkRegion;
+  VoxelMorphology::Pointer morphology = VoxelMorphology::New();
+  morphology->initialize(dims, &(featureIds.front()), operation, dirOn);
+  for (int32_t iteration = 0; iteration < numIterations; iteration++)
+  {
+    if (morphology->nextStep() == 0) { break; }
+    const std::vector<int64_t>& targets = morphology->getTargets();
+    for (size_t t = 1; t < targets.size(); t++)
+    {
+      DREAM3D_REQUIRE(targets[t - 1] < targets[t])
+    }
+    morphology->applyStep(&(featureIds.front()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Runs up to numIterations steps of VoxelMorphology on the mask
+// -----------------------------------------------------------------------------
+void MorphMask(const size_t dims[3], const bool dirOn[3], int32_t direction, int32_t numIterations, std::vector<bool>& mask)
+{
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  bool* values = new bool[totalPoints];
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    values[i] = mask[i];
+  }
+
+  VoxelMorphology::Operation operation = (direction == 0) ? VoxelMorphology::GrowRegion : VoxelMorphology::ShrinkRegion;
+  VoxelMorphology::Pointer morphology = VoxelMorphology::New();
+  morphology->initialize(dims, values, operation, dirOn);
+  for (int32_t iteration = 0; iteration < numIterations; iteration++)
+  {
+    if (morphology->nextStep() == 0) { break; }
+    morphology->applyStep(values);
+  }
+
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    mask[i] = values[i];
+  }
+  delete[] values;
+}
+
+// -----------------------------------------------------------------------------
+//  A single bad cell in the middle of a 5x5x5 block grows into the cells along the enabled directions only
+// -----------------------------------------------------------------------------
+void TestGrowAlongDirections()
+{
+  size_t dims[3] = { 5, 5, 5 };
+  int64_t idims[3] = { 5, 5, 5 };
+  bool dirOn[3] = { true, false, true };
+  std::vector<int32_t> featureIds(125, 1);
+  featureIds[62] = 0;
+
+  std::vector<int32_t> expected(featureIds);
+  SweepBadData(idims, dirOn, 0, 1, expected);
+  MorphBadData(dims, dirOn, 0, 1, featureIds);
+  DREAM3D_REQUIRE(featureIds == expected)
+
+  int32_t numBad = 0;
+  for (size_t i = 0; i < featureIds.size(); i++)
+  {
+    if (featureIds[i] == 0) { numBad++; }
+  }
+  DREAM3D_REQUIRE_EQUAL(numBad, 5)
+  DREAM3D_REQUIRE_EQUAL(featureIds[61], 0)
+  DREAM3D_REQUIRE_EQUAL(featureIds[63], 0)
+  DREAM3D_REQUIRE_EQUAL(featureIds[37], 0)
+  DREAM3D_REQUIRE_EQUAL(featureIds[87], 0)
+  DREAM3D_REQUIRE_EQUAL(featureIds[57], 1)
+  DREAM3D_REQUIRE_EQUAL(featureIds[67], 1)
+}
+
+// -----------------------------------------------------------------------------
+//  Once the bad data is gone a shrink step changes nothing, and further iterations are skipped
+// -----------------------------------------------------------------------------
+void TestShrinkStops()
+{
+  size_t dims[3] = { 4, 3, 1 };
+  bool dirOn[3] = { true, true, true };
+  int32_t values[12] = { 0, 0, 2, 2,
+                         0, 0, 0, 3,
+                         1, 0, 0, 3 };
+  std::vector<int32_t> featureIds(values, values + 12);
+
+  VoxelMorphology::Pointer morphology = VoxelMorphology::New();
+  morphology->initialize(dims, &(featureIds.front()), VoxelMorphology::ShrinkRegion, dirOn);
+  int32_t numSteps = 0;
+  while (morphology->nextStep() > 0)
+  {
+    const std::vector<int64_t>& targets = morphology->getTargets();
+    const std::vector<int64_t>& sources = morphology->getSources();
+    for (size_t t = 0; t < targets.size(); t++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds[targets[t]], 0)
+      DREAM3D_REQUIRED(featureIds[sources[t]], >, 0)
+    }
+    morphology->applyStep(&(featureIds.front()));
+    numSteps++;
+  }
+  DREAM3D_REQUIRE_EQUAL(numSteps, 2)
+  for (size_t i = 0; i < featureIds.size(); i++)
+  {
+    DREAM3D_REQUIRED(featureIds[i], >, 0)
+  }
+  DREAM3D_REQUIRE_EQUAL(morphology->nextStep(), 0)
+}
+
+// -----------------------------------------------------------------------------
+//  Random images with random sizes, directions, iteration counts and amounts of bad data must give the same
+//  result as the full sweeps. Every 50th image is large enough to span several parallel chunks.
+// -----------------------------------------------------------------------------
+void TestRandomImages()
+{
+  srand(11);
+  for (int32_t image = 0; image < k_NumRandomImages; image++)
+  {
+    size_t dims[3] = { 0, 0, 0 };
+    int64_t idims[3] = { 0, 0, 0 };
+    for (int32_t d = 0; d < 3; d++)
+    {
+      dims[d] = (image % 50 == 0) ? static_cast<size_t>(24 + rand() % 16) : static_cast<size_t>(1 + rand() % 12);
+      idims[d] = static_cast<int64_t>(dims[d]);
+    }
+    bool dirOn[3] = { rand() % 4 != 0, rand() % 4 != 0, rand() % 4 != 0 };
+    int32_t direction = rand() % 2;
+    int32_t numIterations = 1 + rand() % 6;
+    int32_t badPercent = 5 + rand() % 60;
+    int32_t numFeatures = 1 + rand() % 8;
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    std::vector<int32_t> featureIds(totalPoints, 0);
+    std::vector<bool> mask(totalPoints, false);
+    for (size_t i = 0; i < totalPoints; i++)
+    {
+      if (rand() % 100 >= badPercent) { featureIds[i] = 1 + rand() % numFeatures; }
+      mask[i] = (featureIds[i] == 0);
+    }
+
+    std::vector<int32_t> expectedIds(featureIds);
+    SweepBadData(idims, dirOn, direction, numIterations, expectedIds);
+    MorphBadData(dims, dirOn, direction, numIterations, featureIds);
+    DREAM3D_REQUIRE(featureIds == expectedIds)
+
+    std::vector<bool> expectedMask(mask);
+    SweepMask(idims, dirOn, direction, numIterations, expectedMask);
+    MorphMask(dims, dirOn, direction, numIterations, mask);
+    DREAM3D_REQUIRE(mask == expectedMask)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestGrowAlongDirections() )
+  DREAM3D_REGISTER_TEST( TestShrinkStops() )
+  DREAM3D_REGISTER_TEST( TestRandomImages() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}